@@ -3,11 +3,15 @@
 #include "Actors/FireplaceActor.h"
 #include "Actors/WoodLog.h"
 #include "Components/SurvivalComponent.h"
+#include "Components/VRBuildSiteComponent.h"
+#include "Structures/VRConstructionRecipe.h"
+#include "Subsystems/VRVFXBudgetSubsystem.h"
 #include "Engine/Engine.h"
 
 AFireplaceActor::AFireplaceActor()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Log placement is driven by the logs' grab/release events and burning by UVRFireSubsystem, nothing to poll
+	PrimaryActorTick.bCanEverTick = false;
 
 	
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
@@ -16,27 +20,14 @@ AFireplaceActor::AFireplaceActor()
 	FireplaceMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("FireplaceMesh"));
 	FireplaceMesh->SetupAttachment(RootComponent);
 
-	// Wood log mesh components
-	WoodLog1 = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("WoodLog1"));
-	WoodLog1->SetupAttachment(FireplaceMesh);
+	// Two logs side by side with one across them
+	LogSlots.Add(FTransform(FRotator::ZeroRotator, FVector(0.0f, -15.0f, 10.0f)));
+	LogSlots.Add(FTransform(FRotator::ZeroRotator, FVector(0.0f, 15.0f, 10.0f)));
+	LogSlots.Add(FTransform(FRotator(0.0f, 90.0f, 0.0f), FVector(0.0f, 0.0f, 25.0f)));
 
-	WoodLog2 = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("WoodLog2"));
-	WoodLog2->SetupAttachment(FireplaceMesh);
-
-	WoodLog3 = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("WoodLog3"));
-	WoodLog3->SetupAttachment(FireplaceMesh);
-
-	// Fireplace detection sphere (for log placement)
-	FireplaceDetectionSphere = CreateDefaultSubobject<USphereComponent>(TEXT("FireplaceDetectionSphere"));
-	FireplaceDetectionSphere->SetupAttachment(FireplaceMesh);
-	FireplaceDetectionSphere->SetSphereRadius(100.0f);
-	FireplaceDetectionSphere->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
-
-	// Heat zone sphere (for warmth when fireplace complete)
-	HeatZoneSphere = CreateDefaultSubobject<USphereComponent>(TEXT("HeatZoneSphere"));
-	HeatZoneSphere->SetupAttachment(FireplaceMesh);
-	HeatZoneSphere->SetSphereRadius(150.0f);
-	HeatZoneSphere->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
+	// Build site for the logs, its slots are relative to the fireplace mesh like LogSlots
+	BuildSite = CreateDefaultSubobject<UVRBuildSiteComponent>(TEXT("BuildSite"));
+	BuildSite->SetupAttachment(FireplaceMesh);
 
 	// Sheltered zone box (for shelter)
 	ShelteredZoneBox = CreateDefaultSubobject<UBoxComponent>(TEXT("ShelteredZoneBox"));
@@ -49,6 +40,45 @@ AFireplaceActor::AFireplaceActor()
 	FireEffects->SetupAttachment(FireplaceMesh);
 }
 
+void AFireplaceActor::PostLoad()
+{
+	Super::PostLoad();
+
+#if WITH_EDITORONLY_DATA
+	// Fireplaces saved with the heat zone sphere. Its flat rate becomes the heat at the centre, which falls off from there
+	const FFireDescription Defaults;
+	if (IntenseHeatRecoveryRate_DEPRECATED != Defaults.HeatOutput)
+	{
+		FireDescription.HeatOutput = IntenseHeatRecoveryRate_DEPRECATED;
+		IntenseHeatRecoveryRate_DEPRECATED = Defaults.HeatOutput;
+	}
+
+	if (HeatZoneSphere_DEPRECATED)
+	{
+		FireDescription.HeatRadius = FMath::Max(HeatZoneSphere_DEPRECATED->GetUnscaledSphereRadius(), 1.0f);
+		HeatZoneSphere_DEPRECATED = nullptr;
+	}
+
+	// Fireplaces saved before the build site, it is the one place the recipe and the log volume live now
+	if (BuildSite)
+	{
+		if (Recipe_DEPRECATED && !BuildSite->GetRecipe())
+		{
+			BuildSite->SetRecipe(Recipe_DEPRECATED);
+		}
+
+		if (FireplaceDetectionSphere_DEPRECATED)
+		{
+			BuildSite->SetSphereRadius(FireplaceDetectionSphere_DEPRECATED->GetUnscaledSphereRadius(), false);
+		}
+	}
+	Recipe_DEPRECATED = nullptr;
+	FireplaceDetectionSphere_DEPRECATED = nullptr;
+	LogInstances_DEPRECATED = nullptr;
+	GhostLog_DEPRECATED = nullptr;
+#endif
+}
+
 void AFireplaceActor::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
@@ -62,25 +92,11 @@ void AFireplaceActor::OnConstruction(const FTransform& Transform)
 		FireplaceMesh->SetHiddenInGame(!bEnableFireplace);
 	}
 
-	// Hides the wood logs if fireplace is disabled
-	if (WoodLog1) WoodLog1->SetVisibility(bEnableFireplace);
-	if (WoodLog2) WoodLog2->SetVisibility(bEnableFireplace);
-	if (WoodLog3) WoodLog3->SetVisibility(bEnableFireplace);
-
-	// Hides fireplace detection collider
-	if (FireplaceDetectionSphere)
+	// Hides the build site collider
+	if (BuildSite)
 	{
-		FireplaceDetectionSphere->SetVisibility(bEnableFireplace, false); 
-		FireplaceDetectionSphere->SetHiddenInGame(true);
-	}
-
-	// HEAT ZONE VISIBILITY 
-	
-	// Hide heat zone collider 
-	if (HeatZoneSphere)
-	{
-		HeatZoneSphere->SetVisibility(bEnableHeatZone, false); 
-		HeatZoneSphere->SetHiddenInGame(true); 
+		BuildSite->SetVisibility(bEnableFireplace, false);
+		BuildSite->SetHiddenInGame(true);
 	}
 
 	// SHELTERED ZONE VISIBILITY
@@ -107,41 +123,49 @@ void AFireplaceActor::BeginPlay()
 
 	if (bEnableFireplace)
 	{
-		InitializeLogArrays();
-
-		// Hide all wood logs initially
-		for (int32 i = 0; i < LogMeshes.Num(); i++)
+		// The fireplace is one recipe among the others, it only adds what happens once the logs are in
+		if (!BuildSite->GetRecipe())
 		{
-			SetLogVisibilityAndMaterial(i, false, nullptr);
+			BuildSite->SetRecipe(MakeLogRecipe());
 		}
-
-		// Bind fireplace overlap events
-		FireplaceDetectionSphere->OnComponentBeginOverlap.AddDynamic(this, &AFireplaceActor::OnFireplaceDetectionBeginOverlap);
-		FireplaceDetectionSphere->OnComponentEndOverlap.AddDynamic(this, &AFireplaceActor::OnFireplaceDetectionEndOverlap);
+		BuildSite->OnInputPlaced.AddUObject(this, &AFireplaceActor::OnInputPlaced);
 	}
 	else
 	{
 		// Disable fireplace collision 
-		if (FireplaceDetectionSphere)
+		if (BuildSite)
 		{
-			FireplaceDetectionSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			BuildSite->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 		}
 	}
 
-	// Setup heat zone 
-	if (bEnableHeatZone)
+	// The budget decides when and at what quality the fire effect ticks
+	if (UVRVFXBudgetSubsystem* VFXBudget = UVRVFXBudgetSubsystem::Get(this))
+	{
+		VFXBudget->RegisterEffect(FireEffects, ReducedFireEffects);
+	}
+
+	// Every fire, lit or not, is one entry in the batched simulation
+	if (UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this))
 	{
-		// Heat zone starts inactive
+		FFireDescription Description = FireDescription;
+		if (!bEnableHeatZone)
+		{
+			Description.HeatOutput = 0.0f;
+		}
+
+		// Without logs to place, the heat source burns forever
 		if (!bEnableFireplace)
 		{
-			ActivateHeatZone();
+			Description.BurnRatePerHour = 0.0f;
 		}
-	}
-	else
-	{
-		if (HeatZoneSphere)
+
+		FireIndex = FireSubsystem->RegisterFire(this, Description);
+
+		if (!bEnableFireplace && bEnableHeatZone)
 		{
-			HeatZoneSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			FireSubsystem->AddLog(FireIndex);
+			FireSubsystem->Ignite(FireIndex);
 		}
 	}
 
@@ -160,295 +184,151 @@ void AFireplaceActor::BeginPlay()
 	}
 }
 
-void AFireplaceActor::Tick(float DeltaTime)
+void AFireplaceActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
-
-	if (bEnableFireplace && CurrentDetectedLog)
+	if (UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this))
 	{
-		// Check if log was released
-		if (!CurrentDetectedLog->IsBeingHeld())
-		{
-			PlaceLog();
-		}
+		FireSubsystem->UnregisterFire(this);
 	}
-}
-
-#pragma region Fireplace Implementation
-
-void AFireplaceActor::InitializeLogArrays()
-{
-	if (!bEnableFireplace) return;
+	FireIndex = INDEX_NONE;
 
-	// Clears and resize arrays
-	LogMeshes.Empty();
-	LogSlotStates.Empty();
-
-	LogMeshes.SetNum(RequiredLogsCount);
-	LogSlotStates.SetNum(RequiredLogsCount);
-
-	// Populates with references to existing components
-	LogMeshes[0] = WoodLog1;
-	LogMeshes[1] = WoodLog2;
-	LogMeshes[2] = WoodLog3;
-
-	// Initializes all slots as empty
-	for (int32 i = 0; i < RequiredLogsCount; i++)
+	if (UVRVFXBudgetSubsystem* VFXBudget = UVRVFXBudgetSubsystem::Get(this))
 	{
-		LogSlotStates[i] = false;
+		VFXBudget->UnregisterEffect(FireEffects);
 	}
 
+	Super::EndPlay(EndPlayReason);
 }
 
-void AFireplaceActor::OnFireplaceDetectionBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	if (!bEnableFireplace) return;
-
-	AWoodLog* WoodLog = Cast<AWoodLog>(OtherActor);
-	if (WoodLog && WoodLog->IsBeingHeld())
-	{
-		ShowGhostEffect(WoodLog);
-	}
-}
-
-void AFireplaceActor::OnFireplaceDetectionEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	if (!bEnableFireplace) return;
-
-	AWoodLog* WoodLog = Cast<AWoodLog>(OtherActor);
-	if (WoodLog && WoodLog == CurrentDetectedLog)
-	{
-		HideGhostEffect();
-	}
-}
+#pragma region Fireplace Implementation
 
-void AFireplaceActor::ShowGhostEffect(AWoodLog* WoodLog)
+UVRConstructionRecipe* AFireplaceActor::MakeLogRecipe()
 {
-	// Don't show ghost effect if fireplace is already complete
-	if (IsFireplaceComplete())
-	{
-		return;
-	}
+	UVRConstructionRecipe* LogRecipe = NewObject<UVRConstructionRecipe>(this, TEXT("LogRecipe"));
+	LogRecipe->DisplayName = NSLOCTEXT("Fireplace", "LogRecipeName", "Fireplace");
+	LogRecipe->GhostMaterial = GhostMaterial;
 
-	// If we're already showing a ghost effect, don't change it
-	if (CurrentDetectedLog != nullptr)
-	{
-		return;
-	}
+	FVRRecipeInput& Logs = LogRecipe->Inputs.AddDefaulted_GetRef();
+	Logs.ItemClass = AWoodLog::StaticClass();
+	Logs.Slots = LogSlots;
+	Logs.PlacedMesh = LogMesh;
+	Logs.PlacedMaterial = WoodMaterial;
 
-	// Find the next available slot
-	int32 NextSlot = GetNextAvailableSlot();
-	if (NextSlot == -1)
-	{
-		return; 
-	}
+	// More logs than slots could never be placed
+	Logs.RequiredCount = FMath::Clamp(RequiredLogsCount, 1, FMath::Max(LogSlots.Num(), 1));
 
-	// Store references
-	CurrentDetectedLog = WoodLog;
-	CurrentGhostSlot = NextSlot;
-
-	// Show the ghost effect
-	SetLogVisibilityAndMaterial(NextSlot, true, GhostMaterial);
+	return LogRecipe;
 }
 
-void AFireplaceActor::HideGhostEffect()
+void AFireplaceActor::OnInputPlaced(UVRBuildSiteComponent* Site, int32 InputIndex)
 {
-	if (CurrentGhostSlot != -1)
+	// Only the fuel input feeds the fire, other inputs (stones, a pot) just have to be there
+	if (InputIndex == 0)
 	{
-		// Check if slot is already placed
-		bool bSlotIsPlaced = LogSlotStates.IsValidIndex(CurrentGhostSlot) && LogSlotStates[CurrentGhostSlot];
-
-		if (!bSlotIsPlaced)
-		{
-			SetLogVisibilityAndMaterial(CurrentGhostSlot, false, nullptr);
-		}
+		// The simulation owns the fuel, a low fire may absorb the log into the one already showing
+		UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this);
+		PlacedLogsCount = FireSubsystem ? FireSubsystem->AddLog(FireIndex) : PlacedLogsCount + 1;
+		BuildSite->SetPlacedCount(0, PlacedLogsCount);
 	}
 
-	// Reset references
-	CurrentDetectedLog = nullptr;
-	CurrentGhostSlot = -1;
-}
-
-void AFireplaceActor::PlaceLog()
-{
-	if (CurrentDetectedLog && CurrentGhostSlot != -1)
+	// Lit fires are simply refuelled, unlit ones light once the recipe is complete
+	if (!IsBurning() && IsFireplaceComplete())
 	{
-		int32 PlacingSlot = CurrentGhostSlot;
-
-		// Change ghost to wood material
-		SetLogVisibilityAndMaterial(PlacingSlot, true, WoodMaterial);
-
-		// Update array state
-		LogSlotStates[PlacingSlot] = true;
-		PlacedLogsCount++;
-
-		// Store reference and cleanup
-		AWoodLog* LogToDestroy = CurrentDetectedLog;
-		CurrentDetectedLog = nullptr;
-		CurrentGhostSlot = -1;
-
-		// Safely destroy the held log
-		LogToDestroy->NotifyPlaced();
-
-		// Safety check that fireplace log stays visible
-		SetLogVisibilityAndMaterial(PlacingSlot, true, WoodMaterial);
-
-		// Check if fireplace is complete
-		if (IsFireplaceComplete())
-		{
-			OnFireplaceComplete();
-		}
+		OnFireplaceComplete();
 	}
 }
 
 void AFireplaceActor::OnFireplaceComplete()
 {
+	UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this);
+	if (!FireSubsystem || !FireSubsystem->Ignite(FireIndex))
+		return;
+
 	bFireplaceComplete = true;
 
 	// Activate fire effects
-	if (FireEffects)
-	{
-		FireEffects->SetVisibility(true);
-		FireEffects->SetHiddenInGame(false);
-		FireEffects->Activate();
-	}
-
-	// Activate heat zone if enabled
-	if (bEnableHeatZone)
-	{
-		ActivateHeatZone();
-	}
+	SetFireEffectsActive(true);
 
 	OnFireComplete.Broadcast();
 
-	UE_LOG(LogTemp, Warning, TEXT("Fireplace construction complete - heat zone activated!"));
+	UE_LOG(LogTemp, Warning, TEXT("Fireplace lit - burning for %.1f game hours"), FireSubsystem->GetRemainingBurnHours(FireIndex));
 }
 
-int32 AFireplaceActor::GetNextAvailableSlot() const
+bool AFireplaceActor::IsFireplaceComplete() const
 {
-	for (int32 i = 0; i < LogSlotStates.Num(); i++)
-	{
-		if (!LogSlotStates[i])
-		{
-			return i;
-		}
-	}
-	return -1;
-}
+	if (!bEnableFireplace) return false;
 
-UStaticMeshComponent* AFireplaceActor::GetLogMeshByIndex(int32 Index) const
-{
-	if (LogMeshes.IsValidIndex(Index))
-	{
-		return LogMeshes[Index];
-	}
-	return nullptr;
+	return BuildSite->IsComplete();
 }
 
-void AFireplaceActor::SetLogVisibilityAndMaterial(int32 LogIndex, bool bVisible, UMaterialInterface* Material)
+bool AFireplaceActor::IsBurning() const
 {
-	UStaticMeshComponent* LogMesh = GetLogMeshByIndex(LogIndex);
-	if (LogMesh)
-	{
-		LogMesh->SetVisibility(bVisible);
-		LogMesh->SetHiddenInGame(!bVisible);
-
-		if (Material && bVisible)
-		{
-			LogMesh->SetMaterial(0, Material);
-		}
-	}
+	const UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this);
+	return FireSubsystem && FireSubsystem->IsBurning(FireIndex);
 }
 
-bool AFireplaceActor::IsFireplaceComplete() const
+float AFireplaceActor::GetRemainingBurnHours() const
 {
-	if (!bEnableFireplace) return false;
-
-	for (bool SlotFilled : LogSlotStates)
-	{
-		if (!SlotFilled)
-		{
-			return false;
-		}
-	}
-	return true;
+	const UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this);
+	return FireSubsystem ? FireSubsystem->GetRemainingBurnHours(FireIndex) : 0.0f;
 }
 
 #pragma endregion
 
-#pragma region Heat Zone Implementation
+#pragma region Fire Simulation
 
-void AFireplaceActor::ActivateHeatZone()
+void AFireplaceActor::OnLogCountChanged(int32 NewLogCount)
 {
-	if (!bEnableHeatZone) return;
-
-	bHeatZoneActive = true;
+	PlacedLogsCount = NewLogCount;
 
-	// Enable heat zone collision
-	if (HeatZoneSphere)
-	{
-		HeatZoneSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-		HeatZoneSphere->OnComponentBeginOverlap.AddDynamic(this, &AFireplaceActor::OnHeatZoneBeginOverlap);
-		HeatZoneSphere->OnComponentEndOverlap.AddDynamic(this, &AFireplaceActor::OnHeatZoneEndOverlap);
+	// Also moves the ghost, which may now sit on a slot that just burnt free
+	BuildSite->SetPlacedCount(0, NewLogCount);
+}
 
-		// Checks for actors already inside the heat zone
-		TArray<AActor*> OverlappingActors;
-		HeatZoneSphere->GetOverlappingActors(OverlappingActors);
+void AFireplaceActor::OnBurntOut()
+{
+	bFireplaceComplete = false;
+	SetFireEffectsActive(false);
 
-		for (AActor* Actor : OverlappingActors)
-		{
-			if (Actor)
-			{
-				USurvivalComponent* SurvivalComp = Actor->FindComponentByClass<USurvivalComponent>();
-				if (SurvivalComp)
-				{
-					SurvivalComp->SetIsInIntenseHeatZone(true);
-					SurvivalComp->SetIntenseHeatRecoveryRate(IntenseHeatRecoveryRate);
-				}
-			}
-		}
-	}
+	OnFireBurntOut.Broadcast();
 
-	UE_LOG(LogTemp, Warning, TEXT("Heat zone activated"));
+	UE_LOG(LogTemp, Warning, TEXT("Fireplace burnt out"));
 }
 
-void AFireplaceActor::DeactivateHeatZone()
+void AFireplaceActor::OnRestored(int32 NewLogCount, bool bLit)
 {
-	bHeatZoneActive = false;
+	OnLogCountChanged(NewLogCount);
 
-	if (HeatZoneSphere)
-	{
-		HeatZoneSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	}
+	bFireplaceComplete = bLit;
+	SetFireEffectsActive(bLit);
 }
 
-void AFireplaceActor::OnHeatZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AFireplaceActor::SetFireEffectsActive(bool bActive)
 {
-	if (!bHeatZoneActive) return;
+	if (!FireEffects)
+		return;
 
-	USurvivalComponent* SurvivalComp = OtherActor->FindComponentByClass<USurvivalComponent>();
-	if (SurvivalComp)
+	FireEffects->SetVisibility(bActive);
+	FireEffects->SetHiddenInGame(!bActive);
+
+	if (UVRVFXBudgetSubsystem* VFXBudget = UVRVFXBudgetSubsystem::Get(this))
 	{
-		SurvivalComp->SetIsInIntenseHeatZone(true);
-		SurvivalComp->SetIntenseHeatRecoveryRate(IntenseHeatRecoveryRate);
+		VFXBudget->SetEffectWanted(FireEffects, bActive);
 	}
-}
-
-void AFireplaceActor::OnHeatZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	if (!bHeatZoneActive) return;
-
-	USurvivalComponent* SurvivalComp = OtherActor->FindComponentByClass<USurvivalComponent>();
-	if (SurvivalComp)
+	else if (bActive)
 	{
-		SurvivalComp->SetIsInIntenseHeatZone(false);
+		FireEffects->Activate();
+	}
+	else
+	{
+		FireEffects->Deactivate();
 	}
 }
 
+#pragma endregion
+
+#pragma region Sheltered Zone Implementation
+
 void AFireplaceActor::OnShelteredZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
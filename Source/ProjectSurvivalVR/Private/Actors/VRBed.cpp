@@ -7,6 +7,8 @@
 #include "Environment/DayNightManager.h"
 #include "Engine/Engine.h"
 #include "Blueprint/UserWidget.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "HUD/VRUILayerComponent.h"
 #include "TimerManager.h"
 
 AVRBed::AVRBed()
@@ -23,9 +25,6 @@ AVRBed::AVRBed()
 	ActorMesh->SetSimulatePhysics(false);
 	ActorMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 	ActorMesh->SetCollisionObjectType(ECC_WorldStatic);
-
-	// Set grab behavior to none so it acts as an interaction object
-	GrabPointBehavior = EGrabPointBehavior::None;
 }
 
 void AVRBed::BeginPlay()
@@ -46,6 +45,11 @@ void AVRBed::BeginPlay()
 		//SleepInteractionSphere->OnComponentEndOverlap.AddDynamic(this, &AVRBed::OnSleepInteractionEndOverlap);
 	}
 
+	// Built now so going to sleep never constructs a widget mid-game
+	if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+	{
+		Pool->PrewarmWidgets(GetWorld()->GetFirstPlayerController(), SleepFadeWidgetClass, 1);
+	}
 }
 
 void AVRBed::OnGrab(USkeletalMeshComponent* InComponent, const FVector& GrabLocation, bool bIsLeftHand, ECollisionChannel HandChannel)
@@ -161,13 +165,24 @@ void AVRBed::StartSleepFade()
 {
 	if (SleepFadeWidgetClass)
 	{
-		if (APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+		APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+		UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+		if (PlayerController && Pool)
 		{
-			CurrentFadeWidget = CreateWidget<UUserWidget>(PlayerController, SleepFadeWidgetClass);
+			CurrentFadeWidget = Pool->AcquireWidget(PlayerController, SleepFadeWidgetClass);
 			if (CurrentFadeWidget)
 			{
-				CurrentFadeWidget->AddToViewport(1000);
-				UE_LOG(LogTemp, Warning, TEXT("VRBed: Fade widget created and added to viewport"));
+				// The fade animates, so its layer is redrawn every frame while it is up
+				AVRCharacterBase* Character = Cast<AVRCharacterBase>(CurrentSleepingActor);
+				if (Character && Character->GetMenuLayer())
+				{
+					Character->GetMenuLayer()->SetWidget(CurrentFadeWidget, true);
+				}
+				else
+				{
+					CurrentFadeWidget->AddToViewport(1000);
+				}
+				UE_LOG(LogTemp, Warning, TEXT("VRBed: Fade widget shown"));
 			}
 		}
 	}
@@ -254,6 +269,7 @@ void AVRBed::ApplySleepBenefits(AActor* Player)
 				SurvivalComp->MaxTemperature
 			);
 			SurvivalComp->Temperature = NewTemperature;
+			SurvivalComp->RefreshViewModel();
 
 			// To add: HUD Hint that temperature was restored
 	}
@@ -300,7 +316,20 @@ void AVRBed::RemoveFadeWidget()
 {
 	if (CurrentFadeWidget)
 	{
-		CurrentFadeWidget->RemoveFromParent();
+		AVRCharacterBase* Character = Cast<AVRCharacterBase>(CurrentSleepingActor);
+		if (Character && Character->GetMenuLayer() && Character->GetMenuLayer()->GetWidget() == CurrentFadeWidget)
+		{
+			Character->GetMenuLayer()->ClearWidget();
+		}
+
+		if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+		{
+			Pool->ReleaseWidget(CurrentFadeWidget);
+		}
+		else
+		{
+			CurrentFadeWidget->RemoveFromParent();
+		}
 		CurrentFadeWidget = nullptr;
 	}
 }
\ No newline at end of file
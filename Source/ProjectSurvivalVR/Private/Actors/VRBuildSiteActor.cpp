@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actors/VRBuildSiteActor.h"
+#include "Components/VRBuildSiteComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Structures/VRConstructionRecipe.h"
+#include "Engine/World.h"
+
+AVRBuildSiteActor::AVRBuildSiteActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	BuildSite = CreateDefaultSubobject<UVRBuildSiteComponent>(TEXT("BuildSite"));
+	SetRootComponent(BuildSite);
+
+	SiteMarker = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("SiteMarker"));
+	SiteMarker->SetupAttachment(BuildSite);
+	SiteMarker->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SiteMarker->SetCastShadow(false);
+}
+
+void AVRBuildSiteActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	BuildSite->OnCompleted.AddDynamic(this, &AVRBuildSiteActor::OnSiteCompleted);
+}
+
+void AVRBuildSiteActor::OnSiteCompleted(UVRBuildSiteComponent* Site)
+{
+	const UVRConstructionRecipe* Recipe = Site->GetRecipe();
+
+	AActor* Result = nullptr;
+	if (Recipe && Recipe->ResultClass)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Result = GetWorld()->SpawnActor<AActor>(Recipe->ResultClass, Recipe->ResultTransform * GetActorTransform(), SpawnParams);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("VRBuildSite: %s built %s"), *GetName(), Result ? *Result->GetName() : TEXT("nothing"));
+
+	OnConstructionFinished.Broadcast(Result);
+	Destroy();
+}
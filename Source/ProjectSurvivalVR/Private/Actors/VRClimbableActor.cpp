@@ -1,8 +1,11 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Actors/VRClimbableActor.h"
+#include "ProjectSurvivalVR.h"
+#include "Core/VRRenderState.h"
 #include "Characters/VRCharacterBase.h"
 #include "Hands/VRHand.h"
+#include "Components/CapsuleComponent.h"
 
 AVRClimbableActor::AVRClimbableActor()
 {
@@ -14,6 +17,11 @@ AVRClimbableActor::AVRClimbableActor()
 void AVRClimbableActor::BeginPlay()
 {
     Super::BeginPlay();
+
+    GrabbingHands.Reserve(2);
+
+    BuildHoldIndex();
+    BuildStandPointIndex();
 }
 
 void AVRClimbableActor::OnGrab(USkeletalMeshComponent* InComponent, const FVector& GrabLocation, bool bIsLeftHand, ECollisionChannel HandChannel)
@@ -26,14 +34,15 @@ void AVRClimbableActor::OnGrab(USkeletalMeshComponent* InComponent, const FVecto
     if (!Character)
         return;
 
-    // Temporarily disable collision with player and this specific hand during climbing
+    // Ignore the player per pair while climbing. Collision responses stay untouched, changing them
+    // would rebuild the climbable's filter data on every hand-over-hand grab. The hand needs nothing
+    // here, its bodies are blended out and asleep until it lets go
     if (GrabbingHands.Num() == 0)
     {
-        // First hand grabbing - disable Pawn collision
-        ActorMesh->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+        // First hand grabbing - the capsule stops sweeping and depenetrating against us
+        Character->GetCapsuleComponent()->IgnoreActorWhenMoving(this, true);
         ShowCanBeGrabbed(false);
     }
-    ActorMesh->SetCollisionResponseToChannel(HandChannel, ECR_Ignore);
 
     // Track this hand
     if (!GrabbingHands.Contains(InComponent))
@@ -48,7 +57,7 @@ void AVRClimbableActor::OnGrab(USkeletalMeshComponent* InComponent, const FVecto
     }
     else // EClimbType::Point
     {
-        if (ActorMesh->GetAllSocketNames().Num() > 0)
+        if (!HoldIndex.IsEmpty())
         {
             bGrabSucceeded = true;
         }
@@ -59,7 +68,7 @@ void AVRClimbableActor::OnGrab(USkeletalMeshComponent* InComponent, const FVecto
         // Tell the character to enter the climbing state
         Character->StartClimbing(Hand);
 
-        UE_LOG(LogTemp, Display, TEXT("%s: Climbing grab by %s hand"),
+        VR_INTERACTION_LOG(Display, TEXT("%s: Climbing grab by %s hand"),
             *GetName(), bIsLeftHand ? TEXT("LEFT") : TEXT("RIGHT"));
     }
 }
@@ -70,19 +79,15 @@ void AVRClimbableActor::OnRelease(USkeletalMeshComponent* InComponent)
     if (!Hand)
         return;
 
-    // Get hand channel and restore collision with this specific hand
-    ECollisionChannel HandChannel = InComponent->GetCollisionObjectType();
-    ActorMesh->SetCollisionResponseToChannel(HandChannel, ECR_Block);
-
     // Remove this hand from tracking
-    GrabbingHands.Remove(InComponent);
+    GrabbingHands.RemoveSingleSwap(InComponent, EAllowShrinking::No);
 
     AVRCharacterBase* Character = Cast<AVRCharacterBase>(Hand->GetOwner());
     if (Character)
     {
-        Character->StopClimbing(Hand);
+        Character->StopClimbing(Hand, this);
 
-        UE_LOG(LogTemp, Display, TEXT("%s: Climbing release by %s hand"),
+        VR_INTERACTION_LOG(Display, TEXT("%s: Climbing release by %s hand"),
             *GetName(), Hand->GetHandType() == EControllerHand::Left ? TEXT("LEFT") : TEXT("RIGHT"));
     }
     else
@@ -91,10 +96,10 @@ void AVRClimbableActor::OnRelease(USkeletalMeshComponent* InComponent)
     }
 
     // If no hands are grabbing, restore Pawn collision
-    if (GrabbingHands.Num() == 0)
+    if (GrabbingHands.Num() == 0 && Character)
     {
-        ActorMesh->SetCollisionResponseToChannel(ECC_Pawn, ECR_Block);
-        UE_LOG(LogTemp, Display, TEXT("%s: All climbing hands released - Pawn collision restored"), *GetName());
+        Character->GetCapsuleComponent()->IgnoreActorWhenMoving(this, false);
+        VR_INTERACTION_LOG(Display, TEXT("%s: All climbing hands released - Pawn collision restored"), *GetName());
     }
 }
 
@@ -115,36 +120,132 @@ float AVRClimbableActor::GetObjectWeight() const
 
 void AVRClimbableActor::ShowCanBeGrabbed_Implementation(bool bIsGrabbable)
 {
-    ActorMesh->SetRenderCustomDepth(bIsGrabbable);
+    VRRenderState::SetRenderCustomDepth(ActorMesh, bIsGrabbable);
 }
 
 FName AVRClimbableActor::GetClosestSocketToHand(const FVector& HandLocation) const
 {
-    if (!ActorMesh)
+    if (!ActorMesh || HoldIndex.IsEmpty())
     {
         return NAME_None;
     }
 
-    TArray<FName> SocketNames = ActorMesh->GetAllSocketNames();
-    if (SocketNames.Num() == 0)
+    return GetHoldSocketName(HoldIndex.FindNearest(ToHoldSpace(HandLocation)));
+}
+
+int32 AVRClimbableActor::GetHoldsInRadius(const FVector& WorldLocation, float Radius, TArray<int32>& OutHoldIndices) const
+{
+    if (!ActorMesh || HoldIndex.IsEmpty())
     {
-        return NAME_None;
+        return 0;
     }
 
-    FName ClosestSocket = NAME_None;
-    float ClosestDistance = FLT_MAX;
+    return HoldIndex.FindInRadius(ToHoldSpace(WorldLocation), Radius, OutHoldIndices);
+}
+
+FVector AVRClimbableActor::GetHoldLocation(int32 Index) const
+{
+    return ActorMesh ? ActorMesh->GetSocketLocation(GetHoldSocketName(Index)) : FVector::ZeroVector;
+}
+
+void AVRClimbableActor::BuildHoldIndex()
+{
+    HoldSocketNames.Reset();
+    HoldIndex.Reset();
+
+    if (!ActorMesh)
+        return;
+
+    // Only place that enumerates sockets, every later query goes through the index
+    HoldSocketNames = ActorMesh->GetAllSocketNames();
+
+    const FVector Scale = ActorMesh->GetComponentScale();
 
-    for (const FName& SocketName : SocketNames)
+    TArray<FClimbHoldIndex::FHold> Holds;
+    Holds.Reserve(HoldSocketNames.Num());
+
+    for (int32 Index = 0; Index < HoldSocketNames.Num(); ++Index)
     {
-        FVector SocketLocation = ActorMesh->GetSocketLocation(SocketName);
-        float Distance = FVector::Distance(HandLocation, SocketLocation);
+        const FVector SocketLocation = ActorMesh->GetSocketTransform(HoldSocketNames[Index], RTS_Component).GetLocation();
+        Holds.Add({ FVector3f(SocketLocation * Scale), Index });
+    }
+
+    HoldIndex.Build(MoveTemp(Holds));
 
-        if (Distance < ClosestDistance)
+    VR_INTERACTION_LOG(Verbose, TEXT("%s: Indexed %d climb holds"), *GetName(), HoldIndex.Num());
+}
+
+FVector3f AVRClimbableActor::ToHoldSpace(const FVector& WorldLocation) const
+{
+    const FTransform& ComponentTransform = ActorMesh->GetComponentTransform();
+    return FVector3f(ComponentTransform.GetRotation().UnrotateVector(WorldLocation - ComponentTransform.GetLocation()));
+}
+
+void AVRClimbableActor::BuildStandPointIndex()
+{
+    StandPointIndex.Reset();
+
+    const UStaticMesh* StaticMesh = ActorMesh ? ActorMesh->GetStaticMesh() : nullptr;
+    bUseBakedMetadata = StaticMesh && ClimbMetadata.bIsBaked && ClimbMetadata.SourceMesh == StaticMesh->GetFName();
+
+    if (!bUseBakedMetadata)
+        return;
+
+    const FVector Scale = ActorMesh->GetComponentScale();
+
+    TArray<FClimbHoldIndex::FHold> StandPoints;
+    StandPoints.Reserve(ClimbMetadata.StandPoints.Num());
+
+    for (int32 Index = 0; Index < ClimbMetadata.StandPoints.Num(); ++Index)
+    {
+        StandPoints.Add({ FVector3f(ClimbMetadata.StandPoints[Index] * Scale), Index });
+    }
+
+    StandPointIndex.Build(MoveTemp(StandPoints));
+}
+
+bool AVRClimbableActor::FindStandPoint(const FVector& WorldLocation, float Radius, FVector& OutStandLocation) const
+{
+    if (!bUseBakedMetadata || StandPointIndex.IsEmpty())
+        return false;
+
+    const int32 StandPoint = StandPointIndex.FindNearest(ToHoldSpace(WorldLocation), Radius);
+    if (StandPoint == INDEX_NONE)
+        return false;
+
+    OutStandLocation = ActorMesh->GetComponentTransform().TransformPosition(ClimbMetadata.StandPoints[StandPoint]);
+    return true;
+}
+
+bool AVRClimbableActor::LineTraceHandProxies(const FVector& Start, const FVector& End, float& OutTime) const
+{
+    if (!HasHandProxies())
+        return false;
+
+    // Proxies live in component space, the hit fraction survives the affine transform unchanged
+    const FTransform& ComponentTransform = ActorMesh->GetComponentTransform();
+    const FVector LocalStart = ComponentTransform.InverseTransformPosition(Start);
+    const FVector LocalEnd = ComponentTransform.InverseTransformPosition(End);
+
+    bool bHit = false;
+    OutTime = 1.0f;
+
+    for (const FKBoxElem& Proxy : ClimbMetadata.HandProxies)
+    {
+        const FTransform ProxyTransform = Proxy.GetTransform();
+        const FVector HalfExtent(Proxy.X * 0.5f, Proxy.Y * 0.5f, Proxy.Z * 0.5f);
+
+        FVector HitLocation;
+        FVector HitNormal;
+        float HitTime;
+        if (FMath::LineExtentBoxIntersection(FBox(-HalfExtent, HalfExtent),
+            ProxyTransform.InverseTransformPosition(LocalStart), ProxyTransform.InverseTransformPosition(LocalEnd),
+            FVector::ZeroVector, HitLocation, HitNormal, HitTime) && HitTime < OutTime)
         {
-            ClosestDistance = Distance;
-            ClosestSocket = SocketName;
+            OutTime = HitTime;
+            bHit = true;
         }
     }
 
-    return ClosestSocket;
-}
\ No newline at end of file
+    return bHit;
+}
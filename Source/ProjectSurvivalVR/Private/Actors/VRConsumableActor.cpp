@@ -3,12 +3,19 @@
 #include "Actors/VRConsumableActor.h"
 #include "Components/SurvivalComponent.h"
 #include "Characters/VRCharacterBase.h"
+#include "Subsystems/InteractionEventSubsystem.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "Structures/VRItemDefinition.h"
 #include "Engine/World.h"
 
-TArray<AVRConsumableActor*> AVRConsumableActor::ReusableConsumables;
-
 AVRConsumableActor::AVRConsumableActor()
 {
+    bCanBecomeInstance = true;
+}
+
+float AVRConsumableActor::GetStaminaRestorationValue() const
+{
+    return GetItemDefinition().StaminaRestorationValue;
 }
 
 void AVRConsumableActor::BeginPlay()
@@ -28,38 +35,36 @@ void AVRConsumableActor::BeginPlay()
 
 AVRConsumableActor* AVRConsumableActor::GetOrCreate(UWorld* World, TSubclassOf<AVRConsumableActor> ConsumableClass, FVector Location)
 {
-    for (AVRConsumableActor* Item : ReusableConsumables)
-    {
-        if (Item && Item->IsHidden() && Item->GetClass() == ConsumableClass)
-        {
-            Item->Reactivate(Location);
-            return Item;
-        }
-    }
+    UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(World);
+    if (!Pool)
+        return nullptr;
 
-    FActorSpawnParameters Params;
-    AVRConsumableActor* NewItem = World->SpawnActor<AVRConsumableActor>(ConsumableClass, Location, FRotator::ZeroRotator, Params);
-    if (NewItem)
-    {
-        ReusableConsumables.Add(NewItem);
-    }
-    return NewItem;
+    return Pool->AcquireActor<AVRConsumableActor>(ConsumableClass, FTransform(Location));
 }
 
-void AVRConsumableActor::Deactivate()
+void AVRConsumableActor::NotifyConsumed()
 {
-    ForceRelease();
-    SetActorHiddenInGame(true);
-    SetActorEnableCollision(false);
-    SetActorTickEnabled(false);
+    // Call blueprint event
+    OnConsumed();
+
+    OnItemConsumed.Broadcast(this);
+
+    if (UInteractionEventSubsystem* EventSubsystem = UInteractionEventSubsystem::Get(this))
+    {
+        EventSubsystem->OnAnyConsumed.Broadcast(this);
+    }
 }
 
-void AVRConsumableActor::Reactivate(FVector NewLocation)
+void AVRConsumableActor::Deactivate()
 {
-    SetActorLocation(NewLocation);
-    SetActorHiddenInGame(false);
-    SetActorEnableCollision(true);
-    SetActorTickEnabled(true);
+    if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+    {
+        Pool->ReleaseActor(this);
+    }
+    else
+    {
+        SafeDestroy();
+    }
 }
 
 void AVRConsumableActor::OnConstruction(const FTransform& Transform)
@@ -70,13 +75,6 @@ void AVRConsumableActor::OnConstruction(const FTransform& Transform)
 void AVRConsumableActor::PrepareForDestroy()
 {
     Super::PrepareForDestroy();
-    ReusableConsumables.Remove(this);
     CharacterReference = nullptr;
     SurvivalComponent = nullptr;
 }
-
-void AVRConsumableActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
-{
-    ReusableConsumables.Remove(this);
-    Super::EndPlay(EndPlayReason);
-}
\ No newline at end of file
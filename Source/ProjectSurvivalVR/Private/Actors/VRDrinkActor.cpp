@@ -2,7 +2,8 @@
 
 #include "Actors/VRDrinkActor.h"
 #include "Components/SurvivalComponent.h"
-#include "Characters/VRCharacterBase.h"
+#include "Structures/VRItemDefinition.h"
+#include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 
@@ -13,8 +14,23 @@ AVRDrinkActor::AVRDrinkActor()
 void AVRDrinkActor::BeginPlay()
 {
     Super::BeginPlay();
-    UE_LOG(LogTemp, Warning, TEXT("VRDrinkActor BeginPlay - %s"), *GetName());
+
+    // Letting go always ends a drinking session, no need to re-check held state per sip
+    OnReleased.AddDynamic(this, &AVRDrinkActor::HandleReleased);
+}
+
+#if WITH_EDITOR
+void AVRDrinkActor::CopyLegacyItemSettings(FVRItemDefinition& OutDefinition) const
+{
+    Super::CopyLegacyItemSettings(OutDefinition);
+
+    OutDefinition.HydrationValue = HydrationValue_DEPRECATED;
+    OutDefinition.WaterDecreaseRate = WaterDecreaseRate_DEPRECATED;
+    OutDefinition.MinimumTiltAngleForDrinking = MinimumTiltAngleForDrinking_DEPRECATED;
+    OutDefinition.SipInterval = SipInterval_DEPRECATED;
+    OutDefinition.StaminaRestorationValue = StaminaRestorationValue_DEPRECATED;
 }
+#endif
 
 bool AVRDrinkActor::IsProperlyTiltedForDrinking() const
 {
@@ -24,40 +40,44 @@ bool AVRDrinkActor::IsProperlyTiltedForDrinking() const
         return false;
     }
 
-    // Get all the different transforms we can think of
-    FVector ActorUp = GetActorUpVector();
-    FVector MeshUp = ActorMesh->GetUpVector();
-    FVector MeshForward = ActorMesh->GetForwardVector();
-    FVector MeshRight = ActorMesh->GetRightVector();
+    // Angle between the bottle's up axis and world up
+    const FVector ComponentUp = ActorMesh->GetComponentTransform().GetUnitAxis(EAxis::Z);
+    const float ComponentDot = FVector::DotProduct(ComponentUp, FVector::UpVector);
+    const float ComponentAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(ComponentDot, -1.0f, 1.0f)));
 
-    // Also check component transform
-    FTransform MeshTransform = ActorMesh->GetComponentTransform();
-    FVector ComponentUp = MeshTransform.GetUnitAxis(EAxis::Z);
-
-    // Try relative transform too
-    FTransform RelativeTransform = ActorMesh->GetRelativeTransform();
-    FVector RelativeUp = RelativeTransform.GetUnitAxis(EAxis::Z);
+    return ComponentAngle >= GetItemDefinition().MinimumTiltAngleForDrinking;
+}
 
-    FVector WorldUp = FVector::UpVector;
+void AVRDrinkActor::OnMouthContactBegin()
+{
+    if (GetWorld()->GetTimerManager().IsTimerActive(ConsumptionTimerHandle))
+        return;
 
-    // Test all of them
-    float ActorDot = FVector::DotProduct(ActorUp, WorldUp);
-    float MeshDot = FVector::DotProduct(MeshUp, WorldUp);
-    float ComponentDot = FVector::DotProduct(ComponentUp, WorldUp);
-    float RelativeDot = FVector::DotProduct(RelativeUp, WorldUp);
+    // First sip right away, then one per interval until contact ends, the bottle is released or empty
+    Consume();
 
-    float ActorAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(ActorDot, -1.0f, 1.0f)));
-    float MeshAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(MeshDot, -1.0f, 1.0f)));
-    float ComponentAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(ComponentDot, -1.0f, 1.0f)));
-    float RelativeAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(RelativeDot, -1.0f, 1.0f)));
+    if (TotalWaterPercentage > 0.0f)
+    {
+        GetWorld()->GetTimerManager().SetTimer(ConsumptionTimerHandle, this, &AVRDrinkActor::Consume, GetItemDefinition().SipInterval, true);
+    }
+}
 
-    // Use the one that shows the most variation (probably component or relative)
-    bool bIsTilted = ComponentAngle >= MinimumTiltAngleForDrinking;
+void AVRDrinkActor::OnMouthContactEnd()
+{
+    StopDrinking();
+}
 
-    UE_LOG(LogTemp, Warning, TEXT("Using Component Angle: %.2f >= %.2f = %s"),
-        ComponentAngle, MinimumTiltAngleForDrinking, bIsTilted ? TEXT("YES") : TEXT("NO"));
+void AVRDrinkActor::HandleReleased(AVRGrabbableActor* ReleasedActor, USkeletalMeshComponent* HandMesh)
+{
+    StopDrinking();
+}
 
-    return bIsTilted;
+void AVRDrinkActor::StopDrinking()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(ConsumptionTimerHandle);
+    }
 }
 
 void AVRDrinkActor::Consume()
@@ -68,81 +88,62 @@ void AVRDrinkActor::Consume()
         return;
     }
 
-    // Store initial thirst value
-    float InitialThirst = SurvivalComponent->Thirst;
-
-    // Check all conditions
-    bool bThirstNotFull = SurvivalComponent->Thirst < SurvivalComponent->MaxThirst;
-    bool bHasWater = TotalWaterPercentage > 0.0f;
-    bool bOverlappingMouth = CharacterReference->IsOverlappingMouth();
-    bool bProperlyTilted = IsProperlyTiltedForDrinking();
-    bool bCurrentlyHeld = IsBeingHeld();
-
-    // If all conditions are met, consume and start/continue timer
-    if (bCurrentlyHeld && bThirstNotFull && bHasWater && bOverlappingMouth && bProperlyTilted)
+    if (TotalWaterPercentage <= 0.0f)
     {
-        UE_LOG(LogTemp, Error, TEXT("*** ALL CONDITIONS MET - CONSUMING! ***"));
-
-        // Consume the drink
-        SurvivalComponent->ConsumeDrink(HydrationValue);
+        StopDrinking();
+        return;
+    }
 
-        // Adds stamina restoration from drink
-        SurvivalComponent->RestoreStaminaFromDrink(StaminaRestorationValue);
+    // Tilt is the only per-sip condition, held and mouth contact are tracked by events
+    if (SurvivalComponent->Thirst >= SurvivalComponent->MaxThirst || !IsProperlyTiltedForDrinking())
+        return;
 
-        TotalWaterPercentage -= WaterDecreaseRate;
+    const FVRItemDefinition& Definition = GetItemDefinition();
 
-        // Call blueprint event
-        OnConsumed();
+    // Consume the drink
+    SurvivalComponent->ConsumeDrink(Definition.HydrationValue);
 
-        // Check if thirst actually changed
-        float NewThirst = SurvivalComponent->Thirst;
-        float ThirstChange = NewThirst - InitialThirst;
+    // Adds stamina restoration from drink
+    SurvivalComponent->RestoreStaminaFromDrink(Definition.StaminaRestorationValue);
 
-        // Check if empty
-        if (TotalWaterPercentage <= 0.0f)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("Water bottle is empty"));
+    TotalWaterPercentage -= Definition.WaterDecreaseRate;
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("Water bottle is empty"));
-            }
+    NotifyConsumed();
 
-            // Stop any ongoing consumption
-            GetWorld()->GetTimerManager().ClearTimer(ConsumptionTimerHandle);
-            return;
-        }
+    // Check if empty
+    if (TotalWaterPercentage <= 0.0f)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Water bottle is empty"));
 
-        // Start timer to call Consume again in 1 second (for continuous drinking)
-        if (!GetWorld()->GetTimerManager().IsTimerActive(ConsumptionTimerHandle))
+        if (GEngine)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Starting consumption timer"));
-            GetWorld()->GetTimerManager().SetTimer(ConsumptionTimerHandle, this, &AVRDrinkActor::Consume, 1.0f, true);
+            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("Water bottle is empty"));
         }
-    }
-    else
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Conditions not met - stopping consumption"));
 
-        // Stop the consumption timer
-        GetWorld()->GetTimerManager().ClearTimer(ConsumptionTimerHandle);
+        StopDrinking();
     }
 }
 
+void AVRDrinkActor::SaveState(FGrabbableStateRecord& OutRecord) const
+{
+    Super::SaveState(OutRecord);
+    OutRecord.StateValue = TotalWaterPercentage;
+}
+
+void AVRDrinkActor::LoadState(const FGrabbableStateRecord& Record)
+{
+    Super::LoadState(Record);
+    TotalWaterPercentage = Record.StateValue;
+}
+
 void AVRDrinkActor::PrepareForDestroy()
 {
-    if (GetWorld())
-    {
-        GetWorld()->GetTimerManager().ClearTimer(ConsumptionTimerHandle);
-    }
+    StopDrinking();
     Super::PrepareForDestroy();
 }
 
 void AVRDrinkActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    if (GetWorld())
-    {
-        GetWorld()->GetTimerManager().ClearTimer(ConsumptionTimerHandle);
-    }
+    StopDrinking();
     Super::EndPlay(EndPlayReason);
 }
\ No newline at end of file
@@ -2,33 +2,45 @@
 
 #include "Actors/VRFoodActor.h"
 #include "Components/SurvivalComponent.h"
+#include "Structures/VRItemDefinition.h"
 
 AVRFoodActor::AVRFoodActor()
 {
 }
 
+#if WITH_EDITOR
+void AVRFoodActor::CopyLegacyItemSettings(FVRItemDefinition& OutDefinition) const
+{
+    Super::CopyLegacyItemSettings(OutDefinition);
+
+    OutDefinition.NutritionValue = NutritionValue_DEPRECATED;
+    OutDefinition.StaminaRestorationValue = StaminaRestorationValue_DEPRECATED;
+}
+#endif
+
 void AVRFoodActor::Consume()
 {
     if (!SurvivalComponent || !CharacterReference) return;
 
     if (SurvivalComponent->Hunger < SurvivalComponent->MaxHunger)
     {
-        SurvivalComponent->ConsumeFood(NutritionValue);
-        UE_LOG(LogTemp, Warning, TEXT("Food consumed: %f"), NutritionValue);
+        const FVRItemDefinition& Definition = GetItemDefinition();
+
+        SurvivalComponent->ConsumeFood(Definition.NutritionValue);
+        UE_LOG(LogTemp, Warning, TEXT("Food consumed: %f"), Definition.NutritionValue);
 
         // Restore stamina with the specific value for this food
-        SurvivalComponent->RestoreStaminaFromFood(StaminaRestorationValue);
+        SurvivalComponent->RestoreStaminaFromFood(Definition.StaminaRestorationValue);
 
-        UE_LOG(LogTemp, Warning, TEXT("Food consumed: Nutrition=%.2f, Stamina=%.2f"),NutritionValue, StaminaRestorationValue);
+        UE_LOG(LogTemp, Warning, TEXT("Food consumed: Nutrition=%.2f, Stamina=%.2f"), Definition.NutritionValue, Definition.StaminaRestorationValue);
 
         if (GEngine)
         {
             GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green,
-                FString::Printf(TEXT("Food restored %.0f stamina"), StaminaRestorationValue));
+                FString::Printf(TEXT("Food restored %.0f stamina"), Definition.StaminaRestorationValue));
         }
 
-        // Call blueprint event
-        OnConsumed();
+        NotifyConsumed();
 
         Deactivate();
     }
@@ -0,0 +1,338 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actors/VRForageSpawner.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Components/BoxComponent.h"
+#include "Core/VRCollisionQuery.h"
+#include "Environment/DayNightManager.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
+
+AVRForageSpawner::AVRForageSpawner()
+{
+	// Cells follow the player on a timer, nothing happens per frame
+	PrimaryActorTick.bCanEverTick = false;
+
+	ForageArea = CreateDefaultSubobject<UBoxComponent>(TEXT("ForageArea"));
+	ForageArea->SetBoxExtent(FVector(5000.0f, 5000.0f, 1000.0f));
+	ForageArea->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	ForageArea->SetHiddenInGame(true);
+	SetRootComponent(ForageArea);
+}
+
+void AVRForageSpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	SlotCount = 0;
+	for (const FVRForageEntry& Entry : Entries)
+	{
+		SlotCount += Entry.CountPerCell;
+	}
+
+	// The depletion mask has one bit per spawn point
+	if (SlotCount > MaxSlotsPerCell)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("VRForage: %s has %d spawn points per cell, only the first %d are used"), *GetName(), SlotCount, MaxSlotsPerCell);
+		SlotCount = MaxSlotsPerCell;
+	}
+
+	if (SlotCount > 0)
+	{
+		GetWorldTimerManager().SetTimer(UpdateTimerHandle, this, &AVRForageSpawner::UpdateCells, UpdateInterval, true);
+	}
+}
+
+void AVRForageSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(UpdateTimerHandle);
+
+	// Streamed out or removed, the world goes on and gets the items back through the pool
+	if (EndPlayReason == EEndPlayReason::Destroyed || EndPlayReason == EEndPlayReason::RemovedFromWorld)
+	{
+		ReleaseAll();
+	}
+
+	LiveItems.Reset();
+	LiveCells.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+#pragma region Cells
+
+void AVRForageSpawner::UpdateCells()
+{
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	if (!PlayerPawn)
+		return;
+
+	RespawnDueCells(GetGameHours());
+
+	const FBox Area = ForageArea->Bounds.GetBox();
+	const FVector2D PlayerLocation(PlayerPawn->GetActorLocation());
+	const double ActivationRadiusSquared = FMath::Square(ActivationRadius);
+
+	// Only the cells of the area around the player, empty once the player is far outside it
+	const int32 MinX = FMath::FloorToInt32(FMath::Max(PlayerLocation.X - ActivationRadius, Area.Min.X) / CellSize);
+	const int32 MinY = FMath::FloorToInt32(FMath::Max(PlayerLocation.Y - ActivationRadius, Area.Min.Y) / CellSize);
+	const int32 MaxX = FMath::FloorToInt32(FMath::Min(PlayerLocation.X + ActivationRadius, Area.Max.X) / CellSize);
+	const int32 MaxY = FMath::FloorToInt32(FMath::Min(PlayerLocation.Y + ActivationRadius, Area.Max.Y) / CellSize);
+
+	TArray<FIntPoint, TInlineAllocator<32>> WantedCells;
+	for (int32 X = MinX; X <= MaxX; ++X)
+	{
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			const FVector2D CellCentre = (FVector2D(X, Y) + FVector2D(0.5, 0.5)) * CellSize;
+			if (FVector2D::DistSquared(CellCentre, PlayerLocation) <= ActivationRadiusSquared)
+			{
+				WantedCells.Add(FIntPoint(X, Y));
+			}
+		}
+	}
+
+	// Cells left behind go first, so the pool has their actors ready for the new ones
+	TArray<FIntPoint, TInlineAllocator<32>> LeftCells;
+	for (const FIntPoint& Cell : LiveCells)
+	{
+		if (!WantedCells.Contains(Cell))
+		{
+			LeftCells.Add(Cell);
+		}
+	}
+
+	for (const FIntPoint& Cell : LeftCells)
+	{
+		ReleaseCell(Cell);
+		LiveCells.Remove(Cell);
+	}
+
+	const uint32 AllSlots = (1u << SlotCount) - 1;
+	for (const FIntPoint& Cell : WantedCells)
+	{
+		bool bAlreadyLive = false;
+		LiveCells.Add(Cell, &bAlreadyLive);
+		if (bAlreadyLive)
+			continue;
+
+		const FVRSavedForageCell* State = CellStates.Find(Cell);
+		SpawnSlots(Cell, AllSlots & ~static_cast<uint32>(State ? State->DepletedMask : 0));
+	}
+}
+
+void AVRForageSpawner::RespawnDueCells(double Now)
+{
+	if (Now < NextRespawnHour)
+		return;
+
+	NextRespawnHour = TNumericLimits<double>::Max();
+
+	for (auto It = CellStates.CreateIterator(); It; ++It)
+	{
+		FVRSavedForageCell& State = It.Value();
+
+		uint32 DueSlots = 0;
+		for (int32 Slot = 0; Slot < MaxSlotsPerCell; ++Slot)
+		{
+			if ((State.DepletedMask & (1u << Slot)) == 0)
+				continue;
+
+			const double RespawnHour = State.RespawnHours.IsValidIndex(Slot) ? State.RespawnHours[Slot] : 0.0;
+			if (RespawnHour > Now)
+			{
+				NextRespawnHour = FMath::Min(NextRespawnHour, RespawnHour);
+			}
+			else
+			{
+				DueSlots |= 1u << Slot;
+			}
+		}
+
+		// Cells out of range simply forget those points were picked, they spawn whole next time
+		if (DueSlots != 0 && LiveCells.Contains(It.Key()))
+		{
+			SpawnSlots(It.Key(), DueSlots);
+		}
+
+		State.DepletedMask &= ~DueSlots;
+		if (State.DepletedMask == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void AVRForageSpawner::SpawnSlots(const FIntPoint& Cell, uint32 SlotMask)
+{
+	UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+	if (!Pool || SlotMask == 0)
+		return;
+
+	const FBox Area = ForageArea->Bounds.GetBox();
+	const FCollisionObjectQueryParams GroundParams(ECC_WorldStatic);
+
+	FRandomStream Stream(static_cast<int32>(HashCombine(GetTypeHash(Cell), GetTypeHash(Seed))));
+	for (int32 Slot = 0; Slot < SlotCount; ++Slot)
+	{
+		// Every point draws the same numbers whether it spawns or not, so points never shift each other
+		const float Roll = Stream.FRand();
+		const FVector2D Location((Cell.X + Stream.FRand()) * CellSize, (Cell.Y + Stream.FRand()) * CellSize);
+		const float Yaw = Stream.FRandRange(0.0f, 360.0f);
+
+		if ((SlotMask & (1u << Slot)) == 0)
+			continue;
+
+		const FVRForageEntry& Entry = Entries[GetSlotEntry(Slot)];
+		if (!Entry.ItemClass || Roll >= Entry.Density)
+			continue;
+
+		if (Location.X < Area.Min.X || Location.X > Area.Max.X || Location.Y < Area.Min.Y || Location.Y > Area.Max.Y)
+			continue;
+
+		FHitResult Hit;
+		if (!VRCollisionQuery::LineTraceSingleByObjectType(GetWorld(), Hit, FVector(Location, Area.Max.Z), FVector(Location, Area.Min.Z), GroundParams))
+			continue;
+
+		const FTransform SpawnTransform(FRotator(0.0f, Yaw, 0.0f), Hit.ImpactPoint + FVector(0.0f, 0.0f, SurfaceOffset));
+		AVRGrabbableActor* Item = Pool->AcquireActor<AVRGrabbableActor>(Entry.ItemClass, SpawnTransform, this);
+		if (!Item)
+			continue;
+
+		Item->OnGrabbed.AddUniqueDynamic(this, &AVRForageSpawner::HandleItemGrabbed);
+		LiveItems.Add(Item, FForageSlot{Cell, Slot});
+	}
+}
+
+void AVRForageSpawner::ReleaseCell(const FIntPoint& Cell)
+{
+	for (auto It = LiveItems.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Cell == Cell)
+		{
+			ReleaseItem(It.Key().Get());
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void AVRForageSpawner::ReleaseAll()
+{
+	for (const TPair<TWeakObjectPtr<AVRGrabbableActor>, FForageSlot>& Pair : LiveItems)
+	{
+		ReleaseItem(Pair.Key.Get());
+	}
+
+	LiveItems.Reset();
+	LiveCells.Reset();
+}
+
+void AVRForageSpawner::ReleaseItem(AVRGrabbableActor* Item)
+{
+	// A checkpoint restore may have pooled it already and someone else may be using it by now
+	if (!Item || Item->GetOwner() != this)
+		return;
+
+	Item->OnGrabbed.RemoveDynamic(this, &AVRForageSpawner::HandleItemGrabbed);
+
+	UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+	if (Pool && !Pool->IsPooled(Item))
+	{
+		Pool->ReleaseActor(Item);
+	}
+}
+
+int32 AVRForageSpawner::GetSlotEntry(int32 Slot) const
+{
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		Slot -= Entries[EntryIndex].CountPerCell;
+		if (Slot < 0)
+			return EntryIndex;
+	}
+
+	return INDEX_NONE;
+}
+
+uint32 AVRForageSpawner::GetEntrySlots(int32 EntryIndex) const
+{
+	int32 FirstSlot = 0;
+	for (int32 Index = 0; Index < EntryIndex; ++Index)
+	{
+		FirstSlot += Entries[Index].CountPerCell;
+	}
+
+	uint32 Slots = 0;
+	for (int32 Slot = FirstSlot; Slot < FMath::Min(FirstSlot + Entries[EntryIndex].CountPerCell, SlotCount); ++Slot)
+	{
+		Slots |= 1u << Slot;
+	}
+	return Slots;
+}
+
+void AVRForageSpawner::HandleItemGrabbed(AVRGrabbableActor* GrabbedActor, USkeletalMeshComponent* HandMesh)
+{
+	FForageSlot ForageSlot;
+	if (!LiveItems.RemoveAndCopyValue(GrabbedActor, ForageSlot))
+		return;
+
+	// From now on an ordinary item, saved and pooled like any other
+	GrabbedActor->OnGrabbed.RemoveDynamic(this, &AVRForageSpawner::HandleItemGrabbed);
+	GrabbedActor->SetOwner(nullptr);
+
+	// An entry's first pick in the cell starts its regrowth, later picks of the same entry join it
+	const int32 EntryIndex = GetSlotEntry(ForageSlot.Slot);
+	FVRSavedForageCell& State = CellStates.FindOrAdd(ForageSlot.Cell);
+	State.RespawnHours.SetNumZeroed(FMath::Max(State.RespawnHours.Num(), ForageSlot.Slot + 1));
+
+	const uint32 PickedEntrySlots = State.DepletedMask & GetEntrySlots(EntryIndex);
+	const int32 JoinedSlot = PickedEntrySlots != 0 ? FMath::CountTrailingZeros(PickedEntrySlots) : INDEX_NONE;
+	const float RespawnHour = State.RespawnHours.IsValidIndex(JoinedSlot)
+		? State.RespawnHours[JoinedSlot]
+		: static_cast<float>(GetGameHours() + Entries[EntryIndex].RespawnHours);
+
+	State.RespawnHours[ForageSlot.Slot] = RespawnHour;
+	State.DepletedMask |= 1u << ForageSlot.Slot;
+	NextRespawnHour = FMath::Min(NextRespawnHour, static_cast<double>(RespawnHour));
+}
+
+double AVRForageSpawner::GetGameHours() const
+{
+	if (!DayNightManager.IsValid())
+	{
+		DayNightManager = ADayNightManager::GetInstance(GetWorld());
+	}
+
+	// Without a clock regrowth runs on real time
+	const ADayNightManager* Clock = DayNightManager.Get();
+	return Clock ? Clock->GetTotalGameHours() : GetWorld()->GetTimeSeconds() / 3600.0;
+}
+
+#pragma endregion
+
+#pragma region Save
+
+void AVRForageSpawner::SaveCells(FVRSavedForage& OutForage) const
+{
+	OutForage.SpawnerName = GetFName();
+	OutForage.Cells = CellStates;
+}
+
+void AVRForageSpawner::RestoreCells(const FVRSavedForage& Forage)
+{
+	ReleaseAll();
+
+	CellStates = Forage.Cells;
+
+	// The next update's scan finds the actual earliest one
+	NextRespawnHour = CellStates.IsEmpty() ? TNumericLimits<double>::Max() : 0.0;
+
+	if (HasActorBegunPlay() && SlotCount > 0)
+	{
+		UpdateCells();
+	}
+}
+
+#pragma endregion
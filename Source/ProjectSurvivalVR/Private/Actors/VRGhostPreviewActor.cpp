@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actors/VRGhostPreviewActor.h"
+#include "Components/StaticMeshComponent.h"
+
+AVRGhostPreviewActor::AVRGhostPreviewActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	GhostMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("GhostMesh"));
+	GhostMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GhostMesh->SetGenerateOverlapEvents(false);
+	GhostMesh->SetCastShadow(false);
+	GhostMesh->SetMobility(EComponentMobility::Movable);
+	SetRootComponent(GhostMesh);
+}
+
+void AVRGhostPreviewActor::Show(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	GhostMesh->SetStaticMesh(Mesh);
+
+	if (Material)
+	{
+		for (int32 MaterialIndex = 0; MaterialIndex < GhostMesh->GetNumMaterials(); ++MaterialIndex)
+		{
+			GhostMesh->SetMaterial(MaterialIndex, Material);
+		}
+	}
+}
+
+void AVRGhostPreviewActor::OnReleasedToPool()
+{
+	// The next site sets its own mesh, nothing of this one should render meanwhile
+	GhostMesh->SetStaticMesh(nullptr);
+	GhostMesh->EmptyOverrideMaterials();
+}
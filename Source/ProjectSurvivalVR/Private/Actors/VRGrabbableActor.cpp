@@ -1,9 +1,18 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Actors/VRGrabbableActor.h"
+#include "ProjectSurvivalVR.h"
+#include "Core/VRRenderState.h"
+#include "Core/VRPhysicsState.h"
 #include "Components/BoxComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Hands/VRHand.h"
+#include "Subsystems/InteractionEventSubsystem.h"
+#include "Subsystems/VRPhysicsLODSubsystem.h"
+#include "Subsystems/VRPropInstancingSubsystem.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "Subsystems/VRWorldSaveSubsystem.h"
+#include "Subsystems/VRItemRegistrySubsystem.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
 
 AVRGrabbableActor::AVRGrabbableActor()
@@ -17,6 +26,34 @@ AVRGrabbableActor::AVRGrabbableActor()
     GrabPointSecond->SetupAttachment(ActorMesh);
     GrabPointSecond->SetCollisionProfileName(TEXT("NoCollision"));
     GrabPointSecond->SetHiddenInGame(true);
+
+    // Second hand constraints are created once here and only re-targeted on grab
+    MainHandConstraint = CreateDefaultSubobject<UPhysicsConstraintComponent>("MainHandConstraint");
+    MainHandConstraint->SetupAttachment(ActorMesh);
+
+    SecondaryHandConstraint = CreateDefaultSubobject<UPhysicsConstraintComponent>("SecondaryHandConstraint");
+    SecondaryHandConstraint->SetupAttachment(ActorMesh);
+
+    for (UPhysicsConstraintComponent* HandConstraint : { MainHandConstraint.Get(), SecondaryHandConstraint.Get() })
+    {
+        // Configure constraint limits for rigid attachment
+        HandConstraint->SetLinearXLimit(ELinearConstraintMotion::LCM_Locked, 0.0f);
+        HandConstraint->SetLinearYLimit(ELinearConstraintMotion::LCM_Locked, 0.0f);
+        HandConstraint->SetLinearZLimit(ELinearConstraintMotion::LCM_Locked, 0.0f);
+        HandConstraint->SetAngularSwing1Limit(EAngularConstraintMotion::ACM_Locked, 0.0f);
+        HandConstraint->SetAngularSwing2Limit(EAngularConstraintMotion::ACM_Locked, 0.0f);
+        HandConstraint->SetAngularTwistLimit(EAngularConstraintMotion::ACM_Locked, 0.0f);
+
+        // Configure drive parameters for stable attachment
+        HandConstraint->SetLinearPositionDrive(true, true, true);
+        HandConstraint->SetLinearVelocityDrive(true, true, true);
+        HandConstraint->SetLinearDriveParams(1200.0f, 120.0f, 0.0f);
+
+        HandConstraint->SetAngularDriveMode(EAngularDriveMode::TwistAndSwing);
+        HandConstraint->SetAngularOrientationDrive(true, true);
+        HandConstraint->SetAngularVelocityDrive(true, true);
+        HandConstraint->SetAngularDriveParams(1200.0f, 120.0f, 0.0f);
+    }
 }
 
 void AVRGrabbableActor::OnConstruction(const FTransform& Transform)
@@ -32,12 +69,52 @@ void AVRGrabbableActor::BeginPlay()
     SetupPhysics();
     bWasSimulatingPhysics = ActorMesh->IsSimulatingPhysics();
 
+    // Both hands fit, grabbing never grows it
+    FreeGrabbingHands.Reserve(2);
+
     // Initialize grip transform
     InitialGripTransform = FTransform::Identity;
     SecondaryGripTransform = FTransform::Identity;
 
     // Grabbables never collide with Pawn (player character)
     ActorMesh->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+
+    if (UVRPhysicsLODSubsystem* PhysicsLOD = UVRPhysicsLODSubsystem::Get(this))
+    {
+        PhysicsLOD->RegisterGrabbable(this);
+    }
+
+    if (bCanBecomeInstance)
+    {
+        if (UVRPropInstancingSubsystem* PropInstancing = UVRPropInstancingSubsystem::Get(this))
+        {
+            PropInstancing->RegisterGrabbable(this);
+        }
+    }
+
+    // Last, a placed actor the save says is gone goes straight back to the pool
+    if (UVRWorldSaveSubsystem* WorldSave = UVRWorldSaveSubsystem::Get(this))
+    {
+        WorldSave->NotifyGrabbableBeganPlay(this);
+    }
+}
+
+void AVRGrabbableActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UVRPhysicsLODSubsystem* PhysicsLOD = UVRPhysicsLODSubsystem::Get(this))
+    {
+        PhysicsLOD->UnregisterGrabbable(this);
+    }
+
+    if (bCanBecomeInstance)
+    {
+        if (UVRPropInstancingSubsystem* PropInstancing = UVRPropInstancingSubsystem::Get(this))
+        {
+            PropInstancing->UnregisterGrabbable(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AVRGrabbableActor::SetupPhysics()
@@ -77,18 +154,31 @@ void AVRGrabbableActor::Tick(float DeltaTime)
 
 void AVRGrabbableActor::OnGrab(USkeletalMeshComponent* InComponent, const FVector& GrabLocation, bool bIsLeftHand, ECollisionChannel HandChannel)
 {
-    bIsHeld = true;
+    // Something dormant is being picked up, wake it before touching its physics state
+    if (bPhysicsDemoted)
+    {
+        if (UVRPhysicsLODSubsystem* PhysicsLOD = UVRPhysicsLODSubsystem::Get(this))
+        {
+            PhysicsLOD->PromoteGrabbable(this);
+        }
+    }
+
+    if (!bIsHeld)
+    {
+        bIsHeld = true;
+        NotifyGrabbed(InComponent);
+    }
 
     // Apply physics settings on grab
     if (bSimulatePhysicsOnGrab && !ActorMesh->IsSimulatingPhysics())
     {
-        ActorMesh->SetSimulatePhysics(true);
+        VRPhysicsState::SetSimulatePhysics(ActorMesh, true);
         ActorMesh->SetEnableGravity(true);
-        ActorMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+        VRPhysicsState::SetCollisionEnabled(ActorMesh, ECollisionEnabled::QueryAndPhysics);
     }
 
     // Just ignore collision with this specific hand channel
-    ActorMesh->SetCollisionResponseToChannel(HandChannel, ECR_Ignore);
+    VRPhysicsState::SetCollisionResponseToChannel(ActorMesh, HandChannel, ECR_Ignore);
 
     ShowCanBeGrabbed(false);
 }
@@ -100,43 +190,33 @@ void AVRGrabbableActor::OnRelease(USkeletalMeshComponent* InComponent)
 
     // Get hand channel and restore collision with this specific hand
     ECollisionChannel HandChannel = InComponent->GetCollisionObjectType();
-    ActorMesh->SetCollisionResponseToChannel(HandChannel, ECR_Block);
+    VRPhysicsState::SetCollisionResponseToChannel(ActorMesh, HandChannel, ECR_Block);
 
     // Remove from free grabbing hands if present
-    bool bWasInFreeGrabbingHands = FreeGrabbingHands.Remove(InComponent) > 0;
+    bool bWasInFreeGrabbingHands = FreeGrabbingHands.RemoveSingleSwap(InComponent, EAllowShrinking::No) > 0;
 
     // Only handle grab point releases for actual snap grabs (not free grabs)
     if (!bWasInFreeGrabbingHands)
     {
+        // Breaking a slot that was never constrained (first hand is attached, not constrained) is a no-op
         if (InComponent == MainGrabPointHand)
         {
-            UE_LOG(LogTemp, Display, TEXT("%s: Main grab point hand released"), *GetName());
+            VR_INTERACTION_LOG(Display, TEXT("%s: Main grab point hand released"), *GetName());
             bMainGrabPointOccupied = false;
             MainGrabPointHand = nullptr;
+            MainHandConstraint->BreakConstraint();
         }
         else if (InComponent == SecondaryGrabPointHand)
         {
-            UE_LOG(LogTemp, Display, TEXT("%s: Secondary grab point hand released"), *GetName());
+            VR_INTERACTION_LOG(Display, TEXT("%s: Secondary grab point hand released"), *GetName());
             bSecondaryGrabPointOccupied = false;
             SecondaryGrabPointHand = nullptr;
-        }
-
-        // Clean up second hand constraint if it exists
-        if (SecondHandConstraints.Contains(InComponent))
-        {
-            UPhysicsConstraintComponent* ConstraintToRemove = SecondHandConstraints[InComponent];
-            if (ConstraintToRemove)
-            {
-                ConstraintToRemove->BreakConstraint();
-                ConstraintToRemove->DestroyComponent();
-                UE_LOG(LogTemp, Display, TEXT("Destroyed second hand constraint"));
-            }
-            SecondHandConstraints.Remove(InComponent);
+            SecondaryHandConstraint->BreakConstraint();
         }
     }
     else
     {
-        UE_LOG(LogTemp, Display, TEXT("%s: Free grabbing hand released (hands remaining: %d)"), *GetName(), FreeGrabbingHands.Num());
+        VR_INTERACTION_LOG(Display, TEXT("%s: Free grabbing hand released (hands remaining: %d)"), *GetName(), FreeGrabbingHands.Num());
     }
 
     // Update grab state based on what's left
@@ -158,28 +238,76 @@ void AVRGrabbableActor::OnRelease(USkeletalMeshComponent* InComponent)
         // Restore original physics state if not using bSimulatePhysicsOnGrab
         if (!bSimulatePhysicsOnGrab && !bStartSimulatePhysics)
         {
-            ActorMesh->SetSimulatePhysics(false);
+            VRPhysicsState::SetSimulatePhysics(ActorMesh, false);
             ActorMesh->SetEnableGravity(false);
-            ActorMesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+            VRPhysicsState::SetCollisionEnabled(ActorMesh, ECollisionEnabled::QueryOnly);
         }
-        else if (!ActorMesh->IsSimulatingPhysics())
+        else
         {
-            ActorMesh->SetSimulatePhysics(true);
+            VRPhysicsState::SetSimulatePhysics(ActorMesh, true);
         }
 
-        UE_LOG(LogTemp, Display, TEXT("%s: Fully released"), *GetName());
+        VR_INTERACTION_LOG(Display, TEXT("%s: Fully released"), *GetName());
+
+        NotifyReleased(InComponent);
     }
     else if (bHasSnapGrabs)
     {
         // Still have snap grabs
         CurrentGrabState = EGrabState::SnapGrab;
-        UE_LOG(LogTemp, Display, TEXT("%s: Still snap grabbed after release"), *GetName());
+        VR_INTERACTION_LOG(Display, TEXT("%s: Still snap grabbed after release"), *GetName());
     }
     else if (bHasFreeGrabs)
     {
         // Only free grabs remaining
         CurrentGrabState = EGrabState::FreeGrab;
-        UE_LOG(LogTemp, Display, TEXT("%s: Still free grabbed after release (hands remaining: %d)"), *GetName(), FreeGrabbingHands.Num());
+        VR_INTERACTION_LOG(Display, TEXT("%s: Still free grabbed after release (hands remaining: %d)"), *GetName(), FreeGrabbingHands.Num());
+    }
+}
+
+void AVRGrabbableActor::OnHoverBegin(USkeletalMeshComponent* InComponent)
+{
+    if (HoveringHandCount++ == 0)
+    {
+        OnHoverChanged.Broadcast(this, true);
+
+        if (UInteractionEventSubsystem* EventSubsystem = UInteractionEventSubsystem::Get(this))
+        {
+            EventSubsystem->OnAnyHoverChanged.Broadcast(this, true);
+        }
+    }
+}
+
+void AVRGrabbableActor::OnHoverEnd(USkeletalMeshComponent* InComponent)
+{
+    if (HoveringHandCount > 0 && --HoveringHandCount == 0)
+    {
+        OnHoverChanged.Broadcast(this, false);
+
+        if (UInteractionEventSubsystem* EventSubsystem = UInteractionEventSubsystem::Get(this))
+        {
+            EventSubsystem->OnAnyHoverChanged.Broadcast(this, false);
+        }
+    }
+}
+
+void AVRGrabbableActor::NotifyGrabbed(USkeletalMeshComponent* HandMesh)
+{
+    OnGrabbed.Broadcast(this, HandMesh);
+
+    if (UInteractionEventSubsystem* EventSubsystem = UInteractionEventSubsystem::Get(this))
+    {
+        EventSubsystem->OnAnyGrabbed.Broadcast(this, HandMesh);
+    }
+}
+
+void AVRGrabbableActor::NotifyReleased(USkeletalMeshComponent* HandMesh)
+{
+    OnReleased.Broadcast(this, HandMesh);
+
+    if (UInteractionEventSubsystem* EventSubsystem = UInteractionEventSubsystem::Get(this))
+    {
+        EventSubsystem->OnAnyReleased.Broadcast(this, HandMesh);
     }
 }
 
@@ -218,10 +346,10 @@ void AVRGrabbableActor::UpdateTwoHandedRotation()
         FQuat TargetRotation = RotationBetweenVectors * CurrentRotation;
         FQuat NewRotation = FQuat::Slerp(CurrentRotation, TargetRotation, RotationStrength * DeltaTime * 10.0f);
 
-        // Apply the new rotation
+        // Apply the new rotation, hands holding still leave the transform untouched
         FTransform NewRelativeTransform = CurrentRelativeTransform;
         NewRelativeTransform.SetRotation(NewRotation);
-        ActorMesh->SetRelativeTransform(NewRelativeTransform);
+        VRRenderState::SetRelativeTransform(ActorMesh, NewRelativeTransform);
 
         // Update the initial transforms for next frame
         InitialGripTransform = CurrentMainTransform;
@@ -272,16 +400,9 @@ void AVRGrabbableActor::CreateSecondHandConstraint(USkeletalMeshComponent* HandM
         return;
     }
 
-    // Initialize constraint component
-    UPhysicsConstraintComponent* SecondHandConstraint = NewObject<UPhysicsConstraintComponent>(this);
-    if (!SecondHandConstraint)
-    {
-        UE_LOG(LogTemp, Error, TEXT("Failed to create second hand constraint"));
-        return;
-    }
-
-    SecondHandConstraint->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::KeepWorldTransform);
-    SecondHandConstraint->RegisterComponent();
+    // Reuse the preallocated slot of this grab point
+    UPhysicsConstraintComponent* SecondHandConstraint = GetHandConstraintSlot(
+        GrabPointComponent == GrabPointSecond ? EGrabPointType::Secondary : EGrabPointType::Main);
 
     // Get socket and bone names from hand
     FName HandSocketName = Hand->GetHandGripSocketName();
@@ -311,7 +432,7 @@ void AVRGrabbableActor::CreateSecondHandConstraint(USkeletalMeshComponent* HandM
     else
     {
         GrabPointWorldTransform = GrabPointComponent->GetComponentTransform();
-        UE_LOG(LogTemp, Warning, TEXT("Using fallback transform for unknown grab point component"));
+        VR_INTERACTION_LOG(Warning, TEXT("Using fallback transform for unknown grab point component"));
     }
 
     FTransform ObjectWorldTransform = ActorMesh->GetComponentTransform();
@@ -326,29 +447,24 @@ void AVRGrabbableActor::CreateSecondHandConstraint(USkeletalMeshComponent* HandM
     SecondHandConstraint->SetConstraintReferenceFrame(EConstraintFrame::Frame1, Frame1);
     SecondHandConstraint->SetConstraintReferenceFrame(EConstraintFrame::Frame2, Frame2);
 
-    // Configure constraint limits for rigid attachment
-    SecondHandConstraint->SetLinearXLimit(ELinearConstraintMotion::LCM_Locked, 0.0f);
-    SecondHandConstraint->SetLinearYLimit(ELinearConstraintMotion::LCM_Locked, 0.0f);
-    SecondHandConstraint->SetLinearZLimit(ELinearConstraintMotion::LCM_Locked, 0.0f);
-    SecondHandConstraint->SetAngularSwing1Limit(EAngularConstraintMotion::ACM_Locked, 0.0f);
-    SecondHandConstraint->SetAngularSwing2Limit(EAngularConstraintMotion::ACM_Locked, 0.0f);
-    SecondHandConstraint->SetAngularTwistLimit(EAngularConstraintMotion::ACM_Locked, 0.0f);
-
-    // Configure drive parameters for stable attachment
-    SecondHandConstraint->SetLinearPositionDrive(true, true, true);
-    SecondHandConstraint->SetLinearVelocityDrive(true, true, true);
-    SecondHandConstraint->SetLinearDriveParams(1200.0f, 120.0f, 0.0f);
+    VR_INTERACTION_LOG(Display, TEXT("Set up second hand constraint for %s hand using bone %s"),
+        bIsLeftHand ? TEXT("LEFT") : TEXT("RIGHT"), *HandBoneName.ToString());
+}
 
-    SecondHandConstraint->SetAngularDriveMode(EAngularDriveMode::TwistAndSwing);
-    SecondHandConstraint->SetAngularOrientationDrive(true, true);
-    SecondHandConstraint->SetAngularVelocityDrive(true, true);
-    SecondHandConstraint->SetAngularDriveParams(1200.0f, 120.0f, 0.0f);
+UPhysicsConstraintComponent* AVRGrabbableActor::GetHandConstraintSlot(EGrabPointType GrabPointType) const
+{
+    return (GrabPointType == EGrabPointType::Secondary) ? SecondaryHandConstraint : MainHandConstraint;
+}
 
-    // Register constraint for lifecycle management
-    SecondHandConstraints.Add(HandMesh, SecondHandConstraint);
+UPhysicsConstraintComponent* AVRGrabbableActor::GetSecondHandConstraint(USkeletalMeshComponent* Hand) const
+{
+    const EGrabPointType GrabPointType = GetHandGrabPointType(Hand);
+    if (GrabPointType == EGrabPointType::None)
+        return nullptr;
 
-    UE_LOG(LogTemp, Display, TEXT("Created second hand constraint for %s hand using bone %s"),
-        bIsLeftHand ? TEXT("LEFT") : TEXT("RIGHT"), *HandBoneName.ToString());
+    // Slots stay around broken while their grab point is free or held by the attached first hand
+    UPhysicsConstraintComponent* Constraint = GetHandConstraintSlot(GrabPointType);
+    return Constraint && Constraint->ConstraintInstance.IsValidConstraintInstance() ? Constraint : nullptr;
 }
 
 bool AVRGrabbableActor::CanAcceptGrab(bool bIncomingIsSnap, EGrabPointType IncomingGrabPoint, USkeletalMeshComponent* IncomingHand) const
@@ -397,13 +513,13 @@ bool AVRGrabbableActor::CanAcceptGrab(bool bIncomingIsSnap, EGrabPointType Incom
 
 void AVRGrabbableActor::HandleGrabConflicts(USkeletalMeshComponent* IncomingHand, bool bIncomingIsSnap, EGrabPointType IncomingGrabPoint)
 {
-    UE_LOG(LogTemp, Warning, TEXT("%s: Handling grab conflicts - Incoming: %s, Current State: %d"),
+    VR_INTERACTION_LOG(Warning, TEXT("%s: Handling grab conflicts - Incoming: %s, Current State: %d"),
         *GetName(), bIncomingIsSnap ? TEXT("SNAP") : TEXT("FREE"), (int32)CurrentGrabState);
 
     // Snap grabs override all free grabs
     if (CurrentGrabState == EGrabState::FreeGrab && bIncomingIsSnap)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Snap grab on free grabbed object - releasing all free grabs"));
+        VR_INTERACTION_LOG(Warning, TEXT("Snap grab on free grabbed object - releasing all free grabs"));
         ForceReleaseAllFreeGrabs();
     }
     // Handle force-switching between snap grabs
@@ -411,12 +527,12 @@ void AVRGrabbableActor::HandleGrabConflicts(USkeletalMeshComponent* IncomingHand
     {
         if (IncomingGrabPoint == EGrabPointType::Main && bMainGrabPointOccupied)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Force switching to main grab point"));
+            VR_INTERACTION_LOG(Warning, TEXT("Force switching to main grab point"));
             ForceReleaseHand(MainGrabPointHand);
         }
         else if (IncomingGrabPoint == EGrabPointType::Secondary && bSecondaryGrabPointOccupied)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Force switching to secondary grab point"));
+            VR_INTERACTION_LOG(Warning, TEXT("Force switching to secondary grab point"));
             ForceReleaseHand(SecondaryGrabPointHand);
         }
     }
@@ -427,7 +543,7 @@ void AVRGrabbableActor::ForceReleaseHand(USkeletalMeshComponent* HandToRelease)
     if (!HandToRelease)
         return;
 
-    UE_LOG(LogTemp, Warning, TEXT("Force releasing hand: %s"), *HandToRelease->GetOwner()->GetName());
+    VR_INTERACTION_LOG(Warning, TEXT("Force releasing hand: %s"), *HandToRelease->GetOwner()->GetName());
 
     // Find the VRHand actor and call ReleaseObject
     if (AVRHand* Hand = Cast<AVRHand>(HandToRelease->GetOwner()))
@@ -438,10 +554,10 @@ void AVRGrabbableActor::ForceReleaseHand(USkeletalMeshComponent* HandToRelease)
 
 void AVRGrabbableActor::ForceReleaseAllFreeGrabs()
 {
-    UE_LOG(LogTemp, Warning, TEXT("Force releasing all free grabs (%d hands)"), FreeGrabbingHands.Num());
+    VR_INTERACTION_LOG(Warning, TEXT("Force releasing all free grabs (%d hands)"), FreeGrabbingHands.Num());
 
     // Make a copy since ReleaseObject will modify the array
-    TArray<USkeletalMeshComponent*> HandsToRelease = FreeGrabbingHands;
+    TArray<TObjectPtr<USkeletalMeshComponent>, TInlineAllocator<2>> HandsToRelease(FreeGrabbingHands);
 
     for (USkeletalMeshComponent* Hand : HandsToRelease)
     {
@@ -463,20 +579,31 @@ EGrabPointType AVRGrabbableActor::GetHandGrabPointType(USkeletalMeshComponent* H
     return EGrabPointType::None;
 }
 
+const FVRItemDefinition& AVRGrabbableActor::GetItemDefinition() const
+{
+    return UVRItemRegistrySubsystem::GetDefinition(GetClass(), ItemId);
+}
+
+EGrabPointBehavior AVRGrabbableActor::GetGrabPointBehavior() const
+{
+    return GetItemDefinition().GrabPointBehavior;
+}
+
 bool AVRGrabbableActor::ShouldUseGrabPoints() const
 {
-    return GrabPointBehavior != EGrabPointBehavior::None;
+    return GetGrabPointBehavior() != EGrabPointBehavior::None;
 }
 
 bool AVRGrabbableActor::ShouldUseMainGrabPoint() const
 {
+    const EGrabPointBehavior GrabPointBehavior = GetGrabPointBehavior();
     return GrabPointBehavior == EGrabPointBehavior::MainOnly ||
         GrabPointBehavior == EGrabPointBehavior::DualHanded;
 }
 
 bool AVRGrabbableActor::ShouldUseSecondaryGrabPoint() const
 {
-    return GrabPointBehavior == EGrabPointBehavior::DualHanded;
+    return GetGrabPointBehavior() == EGrabPointBehavior::DualHanded;
 }
 
 UPrimitiveComponent* AVRGrabbableActor::GetGrabCollisionComponent()
@@ -491,7 +618,8 @@ UPrimitiveComponent* AVRGrabbableActor::GetPhysicsComponent()
 
 float AVRGrabbableActor::GetObjectWeight() const
 {
-    return ActorMesh->GetMass();
+    const FVRItemDefinition& Definition = GetItemDefinition();
+    return Definition.bUseCustomWeight ? Definition.Weight : ActorMesh->GetMass();
 }
 
 bool AVRGrabbableActor::HasMainGrabSocket(bool bIsLeftHand) const
@@ -510,6 +638,32 @@ bool AVRGrabbableActor::HasSecondaryGrabSocket(bool bIsLeftHand) const
 	return true;
 }
 
+const FGrabPointData& AVRGrabbableActor::GetGrabPointData(EGrabPointType GrabPointType) const
+{
+    return (GrabPointType == EGrabPointType::Secondary) ? SecondaryGrabData : MainGrabData;
+}
+
+#if WITH_EDITOR
+void AVRGrabbableActor::CopyLegacyItemSettings(FVRItemDefinition& OutDefinition) const
+{
+    OutDefinition.GrabPointBehavior = GrabPointBehavior_DEPRECATED;
+    OutDefinition.bUseCustomWeight = bUseCustomWeight_DEPRECATED;
+    OutDefinition.Weight = Weight_DEPRECATED;
+}
+
+void AVRGrabbableActor::SetBakedGrasp(EGrabPointType GrabPointType, const FBakedGrasp& InBakedGrasp)
+{
+    FGrabPointData& GrabData = (GrabPointType == EGrabPointType::Secondary) ? SecondaryGrabData : MainGrabData;
+    GrabData.BakedGrasp = InBakedGrasp;
+}
+
+void AVRGrabbableActor::SetGrabAnimation(EGrabPointType GrabPointType, const TSoftObjectPtr<UAnimationAsset>& InGrabAnimation)
+{
+    FGrabPointData& GrabData = (GrabPointType == EGrabPointType::Secondary) ? SecondaryGrabData : MainGrabData;
+    GrabData.GrabAnimation = InGrabAnimation;
+}
+#endif
+
 FVector AVRGrabbableActor::GetMainGrabPointLocation_Implementation() const
 {
     return GetMainGrabPointTransform().GetLocation();
@@ -548,14 +702,14 @@ FTransform AVRGrabbableActor::GetSecondaryGrabSocketTransform_Implementation(boo
 
 void AVRGrabbableActor::OnUnifiedGrab_Implementation(USkeletalMeshComponent* HandMesh, bool bIsLeftHand, bool bIsSnapping, EGrabPointType GrabPointType)
 {
-    UE_LOG(LogTemp, Display, TEXT("%s: Unified grab - Hand: %s, Snapping: %s, GrabPoint: %d, Current State: %d"),
+    VR_INTERACTION_LOG(Display, TEXT("%s: Unified grab - Hand: %s, Snapping: %s, GrabPoint: %d, Current State: %d"),
         *GetName(), *HandMesh->GetOwner()->GetName(), bIsSnapping ? TEXT("YES") : TEXT("NO"),
         (int32)GrabPointType, (int32)CurrentGrabState);
 
     // Validate grab attempt against current object state
     if (!CanAcceptGrab(bIsSnapping, GrabPointType, HandMesh))
     {
-        UE_LOG(LogTemp, Warning, TEXT("Grab rejected - conflicts with current state"));
+        VR_INTERACTION_LOG(Warning, TEXT("Grab rejected - conflicts with current state"));
         return;
     }
 
@@ -569,18 +723,18 @@ void AVRGrabbableActor::OnUnifiedGrab_Implementation(USkeletalMeshComponent* Han
         if (!FreeGrabbingHands.Contains(HandMesh))
         {
             FreeGrabbingHands.Add(HandMesh);
-            UE_LOG(LogTemp, Display, TEXT("%s: Added hand to free grabbing list (total: %d)"), *GetName(), FreeGrabbingHands.Num());
+            VR_INTERACTION_LOG(Display, TEXT("%s: Added hand to free grabbing list (total: %d)"), *GetName(), FreeGrabbingHands.Num());
         }
 
         // Log proximity to grab points for debugging
-        UE_LOG(LogTemp, Display, TEXT("%s: Free grab near %s grab point"), *GetName(),
+        VR_INTERACTION_LOG(Display, TEXT("%s: Free grab near %s grab point"), *GetName(),
             GrabPointType == EGrabPointType::Main ? TEXT("MAIN") : TEXT("SECONDARY"));
 
         // Update state if transitioning from ungrabbed
         if (CurrentGrabState == EGrabState::NotGrabbed)
         {
             CurrentGrabState = EGrabState::FreeGrab;
-            UE_LOG(LogTemp, Display, TEXT("%s: Set to FreeGrab state"), *GetName());
+            VR_INTERACTION_LOG(Display, TEXT("%s: Set to FreeGrab state"), *GetName());
         }
 
         bIsHeld = true;
@@ -600,7 +754,7 @@ void AVRGrabbableActor::OnUnifiedGrab_Implementation(USkeletalMeshComponent* Han
 
     if (!GrabPointToAlign)
     {
-        UE_LOG(LogTemp, Warning, TEXT("OnUnifiedGrab: Snap failed, no valid GrabPointComponent for the given type."));
+        VR_INTERACTION_LOG(Warning, TEXT("OnUnifiedGrab: Snap failed, no valid GrabPointComponent for the given type."));
         return;
     }
 
@@ -615,7 +769,7 @@ void AVRGrabbableActor::OnUnifiedGrab_Implementation(USkeletalMeshComponent* Han
     // Handle secondary hand attachment to already-attached object
     if (ActorMesh->GetAttachParent() != nullptr)
     {
-        UE_LOG(LogTemp, Display, TEXT("%s: Second hand snap grab detected"), *GetName());
+        VR_INTERACTION_LOG(Display, TEXT("%s: Second hand snap grab detected"), *GetName());
 
         // Create physics constraint for secondary hand
         if (GrabPointType == EGrabPointType::Secondary && IsSecondaryGrabPointAvailable())
@@ -626,7 +780,7 @@ void AVRGrabbableActor::OnUnifiedGrab_Implementation(USkeletalMeshComponent* Han
 
             CreateSecondHandConstraint(HandMesh, GrabPointToAlign, bIsLeftHand);
 
-            UE_LOG(LogTemp, Display, TEXT("%s: Second-hand snap to secondary point complete"), *GetName());
+            VR_INTERACTION_LOG(Display, TEXT("%s: Second-hand snap to secondary point complete"), *GetName());
         }
         else if (GrabPointType == EGrabPointType::Main && IsMainGrabPointAvailable())
         {
@@ -636,7 +790,7 @@ void AVRGrabbableActor::OnUnifiedGrab_Implementation(USkeletalMeshComponent* Han
 
             CreateSecondHandConstraint(HandMesh, GrabPointToAlign, bIsLeftHand);
 
-            UE_LOG(LogTemp, Display, TEXT("%s: Second-hand snap to main point complete"), *GetName());
+            VR_INTERACTION_LOG(Display, TEXT("%s: Second-hand snap to main point complete"), *GetName());
         }
 
         CurrentGrabState = EGrabState::SnapGrab;
@@ -679,10 +833,7 @@ void AVRGrabbableActor::OnUnifiedGrab_Implementation(USkeletalMeshComponent* Han
 
     // Perform attachment with physics state management
     bWasSimulatingPhysics = ActorMesh->IsSimulatingPhysics();
-    if (bWasSimulatingPhysics)
-    {
-        ActorMesh->SetSimulatePhysics(false);
-    }
+    VRPhysicsState::SetSimulatePhysics(ActorMesh, false);
 
     // Store original scale and update the target transform
     FVector OriginalScale = ActorMesh->GetRelativeScale3D();
@@ -704,12 +855,99 @@ void AVRGrabbableActor::OnUnifiedGrab_Implementation(USkeletalMeshComponent* Han
     CurrentGrabState = EGrabState::SnapGrab;
     bIsHeld = true;
 
-    UE_LOG(LogTemp, Display, TEXT("%s: First-Hand Snap Grab complete."), *GetName());
+    VR_INTERACTION_LOG(Display, TEXT("%s: First-Hand Snap Grab complete."), *GetName());
 }
 
 void AVRGrabbableActor::ShowCanBeGrabbed_Implementation(bool bIsGrabbable)
 {
-    GetGrabCollisionComponent()->SetRenderCustomDepth(bIsGrabbable);
+    VRRenderState::SetRenderCustomDepth(GetGrabCollisionComponent(), bIsGrabbable);
+}
+
+void AVRGrabbableActor::SaveState(FGrabbableStateRecord& OutRecord) const
+{
+    OutRecord.ActorClass = GetClass();
+    OutRecord.Transform = GetActorTransform();
+}
+
+void AVRGrabbableActor::LoadState(const FGrabbableStateRecord& Record)
+{
+    SetActorTransform(Record.Transform, false, nullptr, ETeleportType::ResetPhysics);
+}
+
+void AVRGrabbableActor::NotifyPlaced()
+{
+    // Parked for the next forage spawn or instance promotion instead of being destroyed
+    if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+    {
+        Pool->ReleaseActor(this);
+    }
+    else
+    {
+        SafeDestroy();
+    }
+}
+
+void AVRGrabbableActor::OnReleasedToPool()
+{
+    if (bIsHeld)
+    {
+        ForceRelease();
+    }
+
+    // Parked as a dormant body so it costs nothing while hidden, the LOD promotes it again near the player
+    UVRPhysicsLODSubsystem* PhysicsLOD = UVRPhysicsLODSubsystem::Get(this);
+    if (PhysicsLOD && ActorMesh && ActorMesh->IsSimulatingPhysics())
+    {
+        PhysicsLOD->DemoteGrabbable(this);
+    }
+
+    // Whatever it was doing before the pool must not carry over into its next life
+    DemotedLinearVelocity = FVector::ZeroVector;
+    DemotedAngularVelocity = FVector::ZeroVector;
+
+    // A placed actor leaving the world (eaten, burnt, collapsed to an instance) is now a save delta
+    if (UVRWorldSaveSubsystem* WorldSave = UVRWorldSaveSubsystem::Get(this))
+    {
+        WorldSave->NotifyGrabbableRemoved(this);
+    }
+}
+
+bool AVRGrabbableActor::DestroyFromFullPool()
+{
+    SafeDestroy();
+    return true;
+}
+
+void AVRGrabbableActor::DemotePhysics()
+{
+    if (bPhysicsDemoted || !ActorMesh)
+        return;
+
+    DemotedLinearVelocity = ActorMesh->GetPhysicsLinearVelocity();
+    DemotedAngularVelocity = ActorMesh->GetPhysicsAngularVelocityInDegrees();
+    bDemotedGenerateOverlapEvents = ActorMesh->GetGenerateOverlapEvents();
+
+    VRPhysicsState::SetSimulatePhysics(ActorMesh, false);
+    VRPhysicsState::SetCollisionEnabled(ActorMesh, ECollisionEnabled::QueryOnly);
+    ActorMesh->SetGenerateOverlapEvents(false);
+
+    bPhysicsDemoted = true;
+}
+
+void AVRGrabbableActor::PromotePhysics()
+{
+    if (!bPhysicsDemoted || !ActorMesh)
+        return;
+
+    bPhysicsDemoted = false;
+
+    VRPhysicsState::SetCollisionEnabled(ActorMesh, ECollisionEnabled::QueryAndPhysics);
+    ActorMesh->SetGenerateOverlapEvents(bDemotedGenerateOverlapEvents);
+    VRPhysicsState::SetSimulatePhysics(ActorMesh, true);
+
+    // Resting bodies were demoted with zero velocity, far-away ones carry on where they left off
+    ActorMesh->SetPhysicsLinearVelocity(DemotedLinearVelocity);
+    ActorMesh->SetPhysicsAngularVelocityInDegrees(DemotedAngularVelocity);
 }
 
 void AVRGrabbableActor::ForceRelease()
@@ -718,7 +956,7 @@ void AVRGrabbableActor::ForceRelease()
     ReleaseFromHand(SecondaryGrabPointHand);
 
     // Release all free grabbing hands
-    TArray<USkeletalMeshComponent*> HandsToRelease = FreeGrabbingHands;
+    TArray<TObjectPtr<USkeletalMeshComponent>, TInlineAllocator<2>> HandsToRelease(FreeGrabbingHands);
     for (USkeletalMeshComponent* Hand : HandsToRelease)
     {
         ReleaseFromHand(Hand);
@@ -738,7 +976,7 @@ void AVRGrabbableActor::ReleaseFromHand(USkeletalMeshComponent* HandMesh)
 
 void AVRGrabbableActor::PrepareForDestroy()
 {
-    UE_LOG(LogTemp, Warning, TEXT("Preparing %s for destruction"), *GetName());
+    VR_INTERACTION_LOG(Warning, TEXT("Preparing %s for destruction"), *GetName());
 
     // Only force release if object is being held
     if (bIsHeld)
@@ -756,26 +994,27 @@ void AVRGrabbableActor::PrepareForDestroy()
         ActorMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
     }
 
-    // Clears any remaining references
-    bIsHeld = false;
-    MainGrabPointHand = nullptr;
-    SecondaryGrabPointHand = nullptr;
-    FreeGrabbingHands.Empty();
-    CurrentGrabState = EGrabState::NotGrabbed;
+    // Clears any remaining references, listeners still get their release if a hand never let go
+    if (bIsHeld)
+    {
+        bIsHeld = false;
+        NotifyReleased(nullptr);
+    }
 
-    // Clean up all second hand constraints
-    for (auto& ConstraintPair : SecondHandConstraints)
+    if (HoveringHandCount > 0)
     {
-        if (ConstraintPair.Value)
-        {
-            ConstraintPair.Value->BreakConstraint();
-            ConstraintPair.Value->DestroyComponent();
-        }
+        HoveringHandCount = 1;
+        OnHoverEnd(nullptr);
     }
-    SecondHandConstraints.Empty();
 
-    // Disable tick
-    SetActorTickEnabled(false);
+    MainGrabPointHand = nullptr;
+    SecondaryGrabPointHand = nullptr;
+    FreeGrabbingHands.Reset();
+    CurrentGrabState = EGrabState::NotGrabbed;
+
+    // Clean up both second hand constraint slots
+    MainHandConstraint->BreakConstraint();
+    SecondaryHandConstraint->BreakConstraint();
 }
 
 void AVRGrabbableActor::SafeDestroy()
@@ -784,13 +1023,11 @@ void AVRGrabbableActor::SafeDestroy()
     PrepareForDestroy();
 
     // Delay just to ensure constraint cleanup is complete 
-    FTimerHandle DestroyTimer;
-    GetWorld()->GetTimerManager().SetTimer(DestroyTimer, [this]()
-        {
-            if (IsValid(this))
-            {
-                UE_LOG(LogTemp, Warning, TEXT("Safe destroying %s"), *GetName());
-                Destroy();
-            }
-        }, 0.05f, false);
-}
\ No newline at end of file
+    GetWorld()->GetTimerManager().SetTimer(SafeDestroyTimerHandle, this, &AVRGrabbableActor::FinishSafeDestroy, 0.05f, false);
+}
+
+void AVRGrabbableActor::FinishSafeDestroy()
+{
+    VR_INTERACTION_LOG(Warning, TEXT("Safe destroying %s"), *GetName());
+    Destroy();
+}
@@ -5,6 +5,7 @@
 
 AWoodLog::AWoodLog()
 {
+    bCanBecomeInstance = true;
     UE_LOG(LogTemp, Warning, TEXT("WoodLog Constructor - Created wood log"));
 }
 
@@ -21,8 +22,3 @@ void AWoodLog::BeginPlay()
             FString::Printf(TEXT("Wood log spawned at: %s"), *GetActorLocation().ToString()));
     }
 }
-
-void AWoodLog::NotifyPlaced()
-{
-    SafeDestroy();
-}
@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Characters/VRCharacterBase.h"
+#include "ProjectSurvivalVR.h"
 #include "Camera/CameraComponent.h"
 #include "Hands/VRHand.h"
 #include "EnhancedInputComponent.h"
@@ -17,6 +18,12 @@
 #include "Engine/Engine.h"
 #include "Actors/VRClimbableActor.h"
 #include "Blueprint/UserWidget.h"
+#include "Core/VRRenderState.h"
+#include "Core/VRCollisionQuery.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "HUD/VRUILayerComponent.h"
+#include "Subsystems/VRCheckpointSubsystem.h"
+#include "Components/VRInventoryComponent.h"
 
 AVRCharacterBase::AVRCharacterBase()
 {
@@ -40,6 +47,17 @@ AVRCharacterBase::AVRCharacterBase()
     MouthCollider->OnComponentEndOverlap.AddDynamic(this, &AVRCharacterBase::OnMouthEndOverlap);
 
     SurvivalComponent = CreateDefaultSubobject<USurvivalComponent>("SurvivalComponent");
+    Inventory = CreateDefaultSubobject<UVRInventoryComponent>("Inventory");
+
+    HUDLayer = CreateDefaultSubobject<UVRUILayerComponent>("HUDLayer");
+    HUDLayer->SetupAttachment(VROrigin);
+    HUDLayer->SetRelativeLocation(FVector(100.0f, 0.0f, -30.0f));
+    HUDLayer->SetQuadSize(FVector2D(60.0f, 30.0f));
+
+    MenuLayer = CreateDefaultSubobject<UVRUILayerComponent>("MenuLayer");
+    MenuLayer->SetupAttachment(VROrigin);
+    MenuLayer->SetPriority(10);
+    MenuLayer->SetViewportZOrder(1000);
 
     TeleportTraceNiagaraSystem = CreateDefaultSubobject<UNiagaraComponent>("TeleportTraceNiagaraSystem");
     TeleportTraceNiagaraSystem->SetupAttachment(GetRootComponent());
@@ -69,6 +87,13 @@ void AVRCharacterBase::BeginPlay()
         bOriginalEnableGravity = GetCapsuleComponent()->IsGravityEnabled();
         OriginalCollisionEnabled = GetCapsuleComponent()->GetCollisionEnabled();
     }
+
+    // The visualizer and death screen are built up front so showing them never spawns or constructs anything
+    if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+    {
+        Pool->PrewarmActors(TeleportVisualizerClass, 1);
+        Pool->PrewarmWidgets(GetWorld()->GetFirstPlayerController(), DeathScreenWidgetClass, 1);
+    }
 }
 
 void AVRCharacterBase::Tick(float DeltaTime)
@@ -294,7 +319,8 @@ bool AVRCharacterBase::IsHeadNearWall(FVector& OutWallNormal, float& OutDistance
 
     // Sphere sweep to detect nearby walls
     FHitResult SweepResult;
-    bool bHitFound = GetWorld()->SweepSingleByChannel(
+    bool bHitFound = VRCollisionQuery::SweepSingleByChannel(
+        GetWorld(),
         SweepResult,
         CameraLocation,
         CameraLocation,
@@ -350,7 +376,8 @@ bool AVRCharacterBase::IsHeadNearWall(FVector& OutWallNormal, float& OutDistance
         FVector TraceEnd = CameraLocation + (Direction * HeadCollisionDistance);
 
         FHitResult HitResult;
-        bool bHit = GetWorld()->LineTraceSingleByChannel(
+        bool bHit = VRCollisionQuery::LineTraceSingleByChannel(
+            GetWorld(),
             HitResult,
             CameraLocation,
             TraceEnd,
@@ -463,7 +490,8 @@ FVector AVRCharacterBase::CalculateHeadWallPenetration() const
         FVector TraceEnd = HeadPosition + (Direction * HeadWallDetectionDistance);
 
         FHitResult HitResult;
-        bool bHit = GetWorld()->LineTraceSingleByChannel(
+        bool bHit = VRCollisionQuery::LineTraceSingleByChannel(
+            GetWorld(),
             HitResult,
             TraceStart,
             TraceEnd,
@@ -520,7 +548,8 @@ FVector AVRCharacterBase::GetCompensatedMovement(const FVector& HeadMovement, co
         QueryParams.AddIgnoredActor(this);
 
         TArray<FOverlapResult> OverlapResults;
-        bool bWouldOverlap = GetWorld()->OverlapMultiByChannel(
+        bool bWouldOverlap = VRCollisionQuery::OverlapMultiByChannel(
+            GetWorld(),
             OverlapResults,
             PredictedHeadPosition,
             FQuat::Identity,
@@ -552,7 +581,8 @@ FVector AVRCharacterBase::GetCompensatedMovement(const FVector& HeadMovement, co
                     FVector DirectionToComponent = (ComponentCenter - PredictedHeadPosition).GetSafeNormal();
 
                     FHitResult NormalHit;
-                    bool bGotNormal = GetWorld()->LineTraceSingleByChannel(
+                    bool bGotNormal = VRCollisionQuery::LineTraceSingleByChannel(
+                        GetWorld(),
                         NormalHit,
                         PredictedHeadPosition,
                         PredictedHeadPosition + DirectionToComponent * HeadCollisionRadius * 2,
@@ -622,7 +652,8 @@ bool AVRCharacterBase::IsCharacterAtEdge() const
         FVector TraceEnd = CharacterLocation + (Direction * EdgeDetectionDistance);
 
         FHitResult HitResult;
-        bool bHit = GetWorld()->LineTraceSingleByChannel(
+        bool bHit = VRCollisionQuery::LineTraceSingleByChannel(
+            GetWorld(),
             HitResult,
             TraceStart,
             TraceEnd,
@@ -654,7 +685,8 @@ bool AVRCharacterBase::WouldCharacterGetPushedSideways() const
     if (RightHand) QueryParams.AddIgnoredActor(RightHand);
 
     TArray<FOverlapResult> OverlapResults;
-    bool bIsOverlapping = GetWorld()->OverlapMultiByChannel(
+    bool bIsOverlapping = VRCollisionQuery::OverlapMultiByChannel(
+        GetWorld(),
         OverlapResults,
         CapsuleCenter,
         FQuat::Identity,
@@ -708,7 +740,8 @@ FVector AVRCharacterBase::GetEdgeAvoidanceDirection() const
         FVector TraceEnd = CharacterLocation + (Direction * EdgeDetectionDistance * 2.0f);
 
         FHitResult HitResult;
-        bool bHit = GetWorld()->LineTraceSingleByChannel(
+        bool bHit = VRCollisionQuery::LineTraceSingleByChannel(
+            GetWorld(),
             HitResult,
             TraceStart,
             TraceEnd,
@@ -917,19 +950,10 @@ void AVRCharacterBase::StartTeleport()
     bTeleportTraceActive = true;
     TeleportTraceNiagaraSystem->SetVisibility(true);
 
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.Owner = this;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::Undefined,
-        SpawnParams.TransformScaleMethod = ESpawnActorScaleMethod::OverrideRootScale;
-
-    if (TeleportVisualizerClass)
+    UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+    if (TeleportVisualizerClass && Pool && !TeleportViasualizerReference)
     {
-        TeleportViasualizerReference = GetWorld()->SpawnActor<AActor>(
-            TeleportVisualizerClass,
-            FVector::ZeroVector,
-            FRotator::ZeroRotator,
-            SpawnParams
-        );
+        TeleportViasualizerReference = Pool->AcquireActor(TeleportVisualizerClass, FTransform::Identity, this);
     }
 }
 
@@ -939,40 +963,32 @@ TArray<FVector> AVRCharacterBase::TeleportTrace(FVector StartPosition, FVector F
     {
         if (TeleportViasualizerReference)
         {
-            TeleportViasualizerReference->GetRootComponent()->SetVisibility(false, true);
+            VRRenderState::SetVisibility(TeleportViasualizerReference->GetRootComponent(), false, true);
         }
         return TArray<FVector>();
     }
 
     FVector LaunchVelocity = ForwardVector * TeleportLaunchSpeed;
-    FHitResult HitResult;
-    TArray<FVector> PathPositions;
-    FVector LastTraceDestination;
 
-    TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-    ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
+    FPredictProjectilePathParams PredictParams(TeleportProjectileRadius, StartPosition, LaunchVelocity, 2.0f);
+    PredictParams.bTraceWithCollision = true;
+    PredictParams.bTraceComplex = true;
+    PredictParams.ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
+    PredictParams.ActorsToIgnore.Add(this);
+    PredictParams.SimFrequency = 15.0f;
+    PredictParams.OverrideGravityZ = 0.0f;
 
-    TArray<AActor*> ActorsToIgnore;
-    ActorsToIgnore.Add(this);
+    FPredictProjectilePathResult PredictResult;
+    bool bHit = VRCollisionQuery::PredictProjectilePath(GetWorld(), PredictParams, PredictResult);
 
-    bool bHit = UGameplayStatics::Blueprint_PredictProjectilePath_ByObjectType(
-        GetWorld(),
-        HitResult,
-        PathPositions,
-        LastTraceDestination,
-        StartPosition,
-        LaunchVelocity,
-        true,
-        TeleportProjectileRadius,
-        ObjectTypes,
-        true,
-        ActorsToIgnore,
-        EDrawDebugTrace::None,
-        0.0f,
-        15.0f,
-        2.0f,
-        0.0f
-    );
+    const FHitResult& HitResult = PredictResult.HitResult;
+    const FVector LastTraceDestination = PredictResult.LastTraceDestination.Location;
+    TArray<FVector> PathPositions;
+    PathPositions.Reserve(PredictResult.PathData.Num());
+    for (const FPredictProjectilePathPointData& PathPoint : PredictResult.PathData)
+    {
+        PathPositions.Add(PathPoint.Location);
+    }
 
     bValidTeleportTrace = false;
 
@@ -1019,10 +1035,12 @@ TArray<FVector> AVRCharacterBase::TeleportTrace(FVector StartPosition, FVector F
         bValidTeleportTrace = false;
     }
 
+    // Runs every frame while aiming, only touch the visualizer when the target actually moved or validity flipped
     if (TeleportViasualizerReference)
     {
-        TeleportViasualizerReference->SetActorLocation(ProjectedTeleportLocation);
-        TeleportViasualizerReference->GetRootComponent()->SetVisibility(bValidTeleportTrace, true);
+        USceneComponent* VisualizerRoot = TeleportViasualizerReference->GetRootComponent();
+        VRRenderState::SetWorldLocation(VisualizerRoot, ProjectedTeleportLocation);
+        VRRenderState::SetVisibility(VisualizerRoot, bValidTeleportTrace, true);
     }
 
     return PathPositions;
@@ -1033,20 +1051,15 @@ void AVRCharacterBase::TryTeleport()
 	if (!IsTeleportAllowed())
 	{
 		bTeleportTraceActive = false;
-		if (TeleportViasualizerReference)
-		{
-			GetWorld()->DestroyActor(TeleportViasualizerReference);
-		}
+		ReleaseTeleportVisualizer();
 		TeleportTraceNiagaraSystem->SetVisibility(false);
 		return;
 	}
 
 	bTeleportTraceActive = false;
 
-	if (TeleportViasualizerReference)
-	{
-		GetWorld()->DestroyActor(TeleportViasualizerReference);
-	}
+	const bool bHadVisualizer = (TeleportViasualizerReference != nullptr);
+	ReleaseTeleportVisualizer();
 
 	TeleportTraceNiagaraSystem->SetVisibility(false);
 
@@ -1077,14 +1090,30 @@ void AVRCharacterBase::TryTeleport()
 
 	FixHeightAfterClimbing();
 
-	if (TeleportViasualizerReference)
+	if (bHadVisualizer)
 	{
 		SetActorLocationAndRotation(DestLocation, DestRotation, false, nullptr, ETeleportType::TeleportPhysics);
 		bTeleportTraceActive = false;
-		TeleportViasualizerReference->SetActorHiddenInGame(true);
 	}
 }
 
+void AVRCharacterBase::ReleaseTeleportVisualizer()
+{
+	if (!TeleportViasualizerReference)
+		return;
+
+	if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+	{
+		Pool->ReleaseActor(TeleportViasualizerReference);
+	}
+	else
+	{
+		GetWorld()->DestroyActor(TeleportViasualizerReference);
+	}
+
+	TeleportViasualizerReference = nullptr;
+}
+
 void AVRCharacterBase::OnMouthBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
     if (!SurvivalComponent || !OtherActor) return;
@@ -1093,13 +1122,18 @@ void AVRCharacterBase::OnMouthBeginOverlap(UPrimitiveComponent* OverlappedCompon
     if (Consumable && Consumable->IsBeingHeld())
     {
         bIsOverlappingMouth = true;
-        Consumable->Consume();
+        Consumable->OnMouthContactBegin();
     }
 }
 
 void AVRCharacterBase::OnMouthEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
     bIsOverlappingMouth = false;
+
+    if (AVRConsumableActor* Consumable = Cast<AVRConsumableActor>(OtherActor))
+    {
+        Consumable->OnMouthContactEnd();
+    }
 }
 
 void AVRCharacterBase::UpdateFallDetection()
@@ -1140,12 +1174,13 @@ void AVRCharacterBase::TriggerDeathScreen()
     if (DeathScreenWidgetClass)
     {
         APlayerController* PC = Cast<APlayerController>(GetController());
-        if (PC)
+        UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+        if (PC && Pool)
         {
-            DeathScreenWidget = CreateWidget<UUserWidget>(PC, DeathScreenWidgetClass);
+            DeathScreenWidget = Pool->AcquireWidget(PC, DeathScreenWidgetClass);
             if (DeathScreenWidget)
             {
-                DeathScreenWidget->AddToViewport(999);
+                MenuLayer->SetWidget(DeathScreenWidget);
             }
         }
     }
@@ -1157,6 +1192,62 @@ void AVRCharacterBase::TriggerDeathScreen()
 
     GetCharacterMovement()->SetMovementMode(MOVE_None);
     OnDeath();
+
+    const UVRCheckpointSubsystem* Checkpoints = UVRCheckpointSubsystem::Get(this);
+    if (DeathRespawnDelay > 0.0f && Checkpoints && Checkpoints->HasCheckpoint())
+    {
+        GetWorldTimerManager().SetTimer(DeathRespawnTimerHandle, FTimerDelegate::CreateWeakLambda(this, [this]()
+        {
+            RespawnFromCheckpoint();
+        }), DeathRespawnDelay, false);
+    }
+}
+
+bool AVRCharacterBase::RespawnFromCheckpoint()
+{
+    UVRCheckpointSubsystem* Checkpoints = UVRCheckpointSubsystem::Get(this);
+    FTransform RespawnTransform;
+    FRotator RespawnControlRotation;
+    if (!Checkpoints || !Checkpoints->RestoreCheckpoint(0, RespawnTransform, RespawnControlRotation))
+        return false;
+
+    GetWorldTimerManager().ClearTimer(DeathRespawnTimerHandle);
+
+    if (DeathScreenWidget)
+    {
+        MenuLayer->ClearWidget();
+        if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+        {
+            Pool->ReleaseWidget(DeathScreenWidget);
+        }
+        DeathScreenWidget = nullptr;
+    }
+
+    // Whatever the hands were climbing is gone from under them
+    ClimbingHand_Left = nullptr;
+    ClimbingHand_Right = nullptr;
+    PrimaryClimbingHand = nullptr;
+    if (SurvivalComponent)
+    {
+        SurvivalComponent->SetClimbingState(false);
+    }
+
+    TeleportTo(RespawnTransform.GetLocation(), RespawnTransform.Rotator(), false, true);
+    GetCharacterMovement()->StopMovementImmediately();
+    GetCharacterMovement()->GravityScale = 1.0f;
+    GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+    CurrentMovementState = EVRMovementState::Locomotion;
+
+    bFallDetectionTriggered = false;
+    ResetFallDetection();
+
+    if (APlayerController* PC = Cast<APlayerController>(GetController()))
+    {
+        PC->SetControlRotation(RespawnControlRotation);
+        PC->EnableInput(PC);
+    }
+
+    return true;
 }
 
 void AVRCharacterBase::ResetFallDetection()
@@ -1237,7 +1328,7 @@ void AVRCharacterBase::StartClimbing(AVRHand* GrabbingHand)
     }
 }
 
-void AVRCharacterBase::StopClimbing(AVRHand* ReleasingHand)
+void AVRCharacterBase::StopClimbing(AVRHand* ReleasingHand, const AVRClimbableActor* Climbable)
 {
     if (!ReleasingHand)
         return;
@@ -1276,6 +1367,17 @@ void AVRCharacterBase::StopClimbing(AVRHand* ReleasingHand)
             SurvivalComponent->SetClimbingState(false);
         }
 
+        // Baked ledge first, the trace-based edge avoidance only runs for climbables without a bake
+        if (TryStandOnBakedLedge(ReleasingHand, Climbable))
+        {
+            CurrentMovementState = EVRMovementState::Falling;
+            GetCharacterMovement()->SetMovementMode(MOVE_Falling);
+            GetCharacterMovement()->GravityScale = 1.0f;
+
+            PrimaryClimbingHand = nullptr;
+            return;
+        }
+
         // Simple edge avoidance
         bool bAtEdge = IsCharacterAtEdge();
         bool bWouldGetPushed = WouldCharacterGetPushedSideways();
@@ -1300,6 +1402,27 @@ void AVRCharacterBase::StopClimbing(AVRHand* ReleasingHand)
     }
 }
 
+bool AVRCharacterBase::TryStandOnBakedLedge(const AVRHand* ReleasingHand, const AVRClimbableActor* Climbable)
+{
+    if (!Climbable || !ReleasingHand || !GetCapsuleComponent())
+        return false;
+
+    FVector StandLocation;
+    if (!Climbable->FindStandPoint(ReleasingHand->GetActorLocation(), LedgeStandSearchRadius, StandLocation))
+        return false;
+
+    // Only mantle up, a stand point below the feet means the player let go somewhere else on the climbable
+    const float CapsuleHalfHeight = GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+    if (StandLocation.Z < GetActorLocation().Z - CapsuleHalfHeight)
+        return false;
+
+    // Headroom was verified by the bake, no ground or clearance traces needed
+    SetActorLocation(StandLocation + FVector(0.0f, 0.0f, CapsuleHalfHeight), false, nullptr, ETeleportType::TeleportPhysics);
+
+    VR_INTERACTION_LOG(Display, TEXT("%s: Mantled onto baked stand point of %s"), *GetName(), *Climbable->GetName());
+    return true;
+}
+
 // VRCharacterBase.cpp - Updated IsCharacterStuckInGeometry function
 
 bool AVRCharacterBase::IsCharacterStuckInGeometry() const
@@ -1319,7 +1442,8 @@ bool AVRCharacterBase::IsCharacterStuckInGeometry() const
     QueryParams.AddIgnoredActor(this);
 
     FHitResult HitResult;
-    bool bHit = GetWorld()->LineTraceSingleByProfile(
+    bool bHit = VRCollisionQuery::LineTraceSingleByProfile(
+        GetWorld(),
         HitResult,
         TraceStart,
         TraceEnd,
@@ -1387,7 +1511,8 @@ void AVRCharacterBase::FixHeightAfterClimbing()
     QueryParams.AddIgnoredActor(this);
 
     FHitResult GroundHit;
-    bool bFoundGround = GetWorld()->LineTraceSingleByProfile(
+    bool bFoundGround = VRCollisionQuery::LineTraceSingleByProfile(
+        GetWorld(),
         GroundHit,
         TraceStart,
         TraceEnd,
@@ -1411,7 +1536,8 @@ void AVRCharacterBase::FixHeightAfterClimbing()
         {
             // Try again ignoring this grabbable
             QueryParams.AddIgnoredActor(HitActor);
-            bFoundGround = GetWorld()->LineTraceSingleByProfile(
+            bFoundGround = VRCollisionQuery::LineTraceSingleByProfile(
+                GetWorld(),
                 GroundHit,
                 TraceStart,
                 TraceEnd,
@@ -1439,7 +1565,8 @@ void AVRCharacterBase::FixHeightAfterClimbing()
     FVector HeadCheckEnd = HeadCheckStart + FVector(0, 0, MinHeadClearance);
 
     FHitResult HeadHit;
-    bool bHeadBlocked = GetWorld()->LineTraceSingleByProfile(
+    bool bHeadBlocked = VRCollisionQuery::LineTraceSingleByProfile(
+        GetWorld(),
         HeadHit,
         HeadCheckStart,
         HeadCheckEnd,
@@ -1583,4 +1710,11 @@ bool AVRCharacterBase::IsHeadlightEnabled() const
     return HeadlightComponent && HeadlightComponent->Intensity > 0.0f;
 }
 
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+#if !UE_BUILD_SHIPPING
+void AVRCharacterBase::TestSetMovementInput(float Forward, float Right)
+{
+    VerticalMovementInput(FInputActionValue(Forward));
+    HorizontalMovementInput(FInputActionValue(Right));
+}
+#endif
@@ -1,6 +1,8 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Components/SurvivalComponent.h"
+#include "Subsystems/VRFireSubsystem.h"
+#include "HUD/SurvivalViewModel.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 
@@ -21,6 +23,21 @@ void USurvivalComponent::BeginPlay()
     {
         UE_LOG(LogTemp, Warning, TEXT("SurvivalComponent: No DayNightManager found in world"));
     }
+
+    if (UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this))
+    {
+        FireSubsystem->RegisterHeatReceiver(this);
+    }
+}
+
+void USurvivalComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this))
+    {
+        FireSubsystem->UnregisterHeatReceiver(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void USurvivalComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -36,6 +53,7 @@ void USurvivalComponent::InitializeSurvivalStats()
     Thirst = MaxThirst;
 	Temperature = NeutralTemperature;
     Stamina = MaxStamina;
+    RefreshViewModel();
 
     GetWorld()->GetTimerManager().SetTimer(SurvivalUpdateTimerHandle, this, &USurvivalComponent::UpdateSurvivalStats, 1.0f, true);
 }
@@ -50,6 +68,7 @@ void USurvivalComponent::UpdateSurvivalStats()
 	ProcessTemperature();
     ProcessStamina();
 
+    RefreshViewModel();
 }
 
 void USurvivalComponent::ProcessHunger()
@@ -91,10 +110,19 @@ void USurvivalComponent::ProcessTemperature()
         // Character is in intense heat zone (near fire) - overrides time modifier
         temperatureChange = IntenseHeatRecoveryRate;
     }
-    else if (bIsInShelteredZone)
+    else
     {
-        // Character is in sheltered zone - combines with time modifier
-        temperatureChange = FMath::Max(temperatureChange, ShelteredHeatRecoveryRate);
+        if (bIsInShelteredZone)
+        {
+            // Character is in sheltered zone - combines with time modifier
+            temperatureChange = FMath::Max(temperatureChange, ShelteredHeatRecoveryRate);
+        }
+
+        // Nearby fires warm by their falloff-weighted heat, a dying fire gives less
+        if (FireHeatRecoveryRate > 0.0f)
+        {
+            temperatureChange = FMath::Max(temperatureChange, FireHeatRecoveryRate);
+        }
     }
 
     // Apply the temperature change (either depletion or recovery)
@@ -109,6 +137,7 @@ void USurvivalComponent::ConsumeFood(float NutritionValue)
 {
     Hunger = FMath::Min(MaxHunger, Hunger + NutritionValue);
 
+    // Pushes hunger along with the stamina
     RestoreStaminaFromFood();
 }
 
@@ -116,9 +145,33 @@ void USurvivalComponent::ConsumeDrink(float HydrationValue)
 {
     Thirst = FMath::Min(MaxThirst, Thirst + HydrationValue);
 
+    // Pushes thirst along with the stamina
     RestoreStaminaFromDrink();
 }
 
+USurvivalViewModel* USurvivalComponent::GetViewModel()
+{
+    if (!ViewModel)
+    {
+        ViewModel = NewObject<USurvivalViewModel>(this);
+        RefreshViewModel();
+    }
+    return ViewModel;
+}
+
+void USurvivalComponent::RefreshViewModel()
+{
+    // Nobody is showing the stats yet
+    if (!ViewModel)
+        return;
+
+    // Each setter only broadcasts when the displayed value moves
+    ViewModel->SetHunger(Hunger, MaxHunger);
+    ViewModel->SetThirst(Thirst, MaxThirst);
+    ViewModel->SetStamina(Stamina, MaxStamina);
+    ViewModel->SetTemperature(Temperature);
+}
+
 #pragma region Stamina System Functions
 
 void USurvivalComponent::ProcessStamina()
@@ -193,12 +246,14 @@ bool USurvivalComponent::ShouldForceStopClimbing() const
 void USurvivalComponent::ConsumeStamina(float Amount)
 {
     Stamina = FMath::Max(MinStamina, Stamina - Amount);
+    RefreshViewModel();
     UE_LOG(LogTemp, VeryVerbose, TEXT("Consumed %.2f stamina. Current: %.2f"), Amount, Stamina);
 }
 
 void USurvivalComponent::RestoreStamina(float Amount)
 {
     Stamina = FMath::Min(MaxStamina, Stamina + Amount);
+    RefreshViewModel();
     UE_LOG(LogTemp, Warning, TEXT("Restored %.2f stamina. Current: %.2f"), Amount, Stamina);
 }
 
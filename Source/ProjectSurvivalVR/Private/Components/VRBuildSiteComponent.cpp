@@ -0,0 +1,311 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Components/VRBuildSiteComponent.h"
+#include "Structures/VRConstructionRecipe.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Actors/VRGhostPreviewActor.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "Subsystems/VRWorldSaveSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+UVRBuildSiteComponent::UVRBuildSiteComponent()
+{
+	// Placement follows the items' grab and release events, nothing to poll
+	PrimaryComponentTick.bCanEverTick = false;
+
+	SetSphereRadius(100.0f);
+	SetCollisionProfileName(TEXT("OverlapAllDynamic"));
+	SetHiddenInGame(true);
+}
+
+void UVRBuildSiteComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	RebuildForRecipe();
+
+	OnComponentBeginOverlap.AddDynamic(this, &UVRBuildSiteComponent::OnSiteBeginOverlap);
+	OnComponentEndOverlap.AddDynamic(this, &UVRBuildSiteComponent::OnSiteEndOverlap);
+
+	if (UVRWorldSaveSubsystem* WorldSave = UVRWorldSaveSubsystem::Get(this))
+	{
+		WorldSave->NotifyBuildSiteBeganPlay(this);
+	}
+}
+
+void UVRBuildSiteComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	EndPreview();
+
+	if (UVRWorldSaveSubsystem* WorldSave = UVRWorldSaveSubsystem::Get(this))
+	{
+		WorldSave->NotifyBuildSiteEndPlay(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UVRBuildSiteComponent::SetRecipe(UVRConstructionRecipe* NewRecipe)
+{
+	Recipe = NewRecipe;
+
+	if (HasBegunPlay())
+	{
+		RebuildForRecipe();
+	}
+}
+
+void UVRBuildSiteComponent::RebuildForRecipe()
+{
+	EndPreview();
+
+	for (UInstancedStaticMeshComponent* Instances : PlacedInstances)
+	{
+		if (Instances)
+		{
+			Instances->DestroyComponent();
+		}
+	}
+
+	const int32 InputCount = Recipe ? Recipe->GetInputCount() : 0;
+	PlacedInstances.Reset();
+	PlacedInstances.SetNum(InputCount);
+	PlacedCounts.Init(0, InputCount);
+	InputByClass.Reset();
+
+	SatisfiedMask = 0;
+	RequiredMask = Recipe ? Recipe->GetRequiredMask() : 0;
+}
+
+#pragma region Counts
+
+int32 UVRBuildSiteComponent::GetPlacedCount(int32 InputIndex) const
+{
+	return PlacedCounts.IsValidIndex(InputIndex) ? PlacedCounts[InputIndex] : 0;
+}
+
+void UVRBuildSiteComponent::SetPlacedCount(int32 InputIndex, int32 Count)
+{
+	if (!PlacedCounts.IsValidIndex(InputIndex))
+		return;
+
+	PlacedCounts[InputIndex] = FMath::Clamp(Count, 0, Recipe->GetCapacity(InputIndex));
+	OnCountChanged(InputIndex);
+
+	// The ghost may now sit on a slot that just freed up, or past the end of the filled ones
+	if (AVRGrabbableActor* Item = PreviewItem)
+	{
+		EndPreview();
+		BeginPreview(Item);
+	}
+}
+
+void UVRBuildSiteComponent::RestorePlacedCounts(TConstArrayView<int32> Counts)
+{
+	for (int32 InputIndex = 0; InputIndex < PlacedCounts.Num(); ++InputIndex)
+	{
+		const int32 Count = Counts.IsValidIndex(InputIndex) ? Counts[InputIndex] : 0;
+		PlacedCounts[InputIndex] = FMath::Clamp(Count, 0, Recipe->GetCapacity(InputIndex));
+		OnCountChanged(InputIndex);
+	}
+
+	if (AVRGrabbableActor* Item = PreviewItem)
+	{
+		EndPreview();
+		BeginPreview(Item);
+	}
+}
+
+void UVRBuildSiteComponent::OnCountChanged(int32 InputIndex)
+{
+	const FVRRecipeInput& Input = Recipe->Inputs[InputIndex];
+
+	if (PlacedCounts[InputIndex] >= Input.RequiredCount)
+	{
+		SatisfiedMask |= 1u << InputIndex;
+	}
+	else
+	{
+		SatisfiedMask &= ~(1u << InputIndex);
+	}
+
+	// Slots fill from the first, so the instances always match the first placed slots
+	const int32 TargetCount = FMath::Min(PlacedCounts[InputIndex], Input.Slots.Num());
+	TObjectPtr<UInstancedStaticMeshComponent>& Instances = PlacedInstances[InputIndex];
+
+	if (!Instances)
+	{
+		if (TargetCount == 0 || !Input.PlacedMesh)
+			return;
+
+		Instances = NewObject<UInstancedStaticMeshComponent>(GetOwner());
+		Instances->SetupAttachment(this);
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetStaticMesh(Input.PlacedMesh);
+		if (Input.PlacedMaterial)
+		{
+			Instances->SetMaterial(0, Input.PlacedMaterial);
+		}
+		Instances->RegisterComponent();
+	}
+
+	while (Instances->GetInstanceCount() > TargetCount)
+	{
+		Instances->RemoveInstance(Instances->GetInstanceCount() - 1);
+	}
+
+	while (Instances->GetInstanceCount() < TargetCount)
+	{
+		Instances->AddInstance(Input.Slots[Instances->GetInstanceCount()], false);
+	}
+}
+
+int32 UVRBuildSiteComponent::ResolveInput(const AVRGrabbableActor* Item)
+{
+	if (!Recipe || !Item)
+		return INDEX_NONE;
+
+	// Resolved once per class, after that a single lookup
+	UClass* ItemClass = Item->GetClass();
+	const int32* CachedIndex = InputByClass.Find(ItemClass);
+	return CachedIndex ? *CachedIndex : InputByClass.Add(ItemClass, Recipe->FindInputIndex(ItemClass));
+}
+
+int32 UVRBuildSiteComponent::FindOpenInput(const AVRGrabbableActor* Item)
+{
+	const int32 InputIndex = ResolveInput(Item);
+	if (InputIndex == INDEX_NONE || PlacedCounts[InputIndex] >= Recipe->GetCapacity(InputIndex))
+		return INDEX_NONE;
+
+	return InputIndex;
+}
+
+#pragma endregion
+
+#pragma region Items
+
+void UVRBuildSiteComponent::OnSiteBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	AVRGrabbableActor* Item = Cast<AVRGrabbableActor>(OtherActor);
+	if (ResolveInput(Item) == INDEX_NONE)
+		return;
+
+	// An item resting inside can still be picked up and dropped, so listen for as long as it overlaps
+	BindItemEvents(Item);
+
+	if (Item->IsBeingHeld())
+	{
+		BeginPreview(Item);
+	}
+}
+
+void UVRBuildSiteComponent::OnSiteEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	AVRGrabbableActor* Item = Cast<AVRGrabbableActor>(OtherActor);
+	if (!Item)
+		return;
+
+	UnbindItemEvents(Item);
+
+	if (Item == PreviewItem)
+	{
+		EndPreview();
+	}
+}
+
+void UVRBuildSiteComponent::OnItemGrabbed(AVRGrabbableActor* GrabbedActor, USkeletalMeshComponent* HandMesh)
+{
+	BeginPreview(GrabbedActor);
+}
+
+void UVRBuildSiteComponent::OnItemReleased(AVRGrabbableActor* ReleasedActor, USkeletalMeshComponent* HandMesh)
+{
+	if (ReleasedActor && ReleasedActor == PreviewItem && !ReleasedActor->IsBeingHeld())
+	{
+		PlacePreviewItem();
+	}
+}
+
+void UVRBuildSiteComponent::BindItemEvents(AVRGrabbableActor* Item)
+{
+	Item->OnGrabbed.AddUniqueDynamic(this, &UVRBuildSiteComponent::OnItemGrabbed);
+	Item->OnReleased.AddUniqueDynamic(this, &UVRBuildSiteComponent::OnItemReleased);
+}
+
+void UVRBuildSiteComponent::UnbindItemEvents(AVRGrabbableActor* Item)
+{
+	Item->OnGrabbed.RemoveDynamic(this, &UVRBuildSiteComponent::OnItemGrabbed);
+	Item->OnReleased.RemoveDynamic(this, &UVRBuildSiteComponent::OnItemReleased);
+}
+
+void UVRBuildSiteComponent::BeginPreview(AVRGrabbableActor* Item)
+{
+	// One item previews at a time
+	if (!Item || PreviewItem)
+		return;
+
+	const int32 InputIndex = FindOpenInput(Item);
+	if (InputIndex == INDEX_NONE)
+		return;
+
+	PreviewItem = Item;
+	PreviewInput = InputIndex;
+
+	// Inputs without a slot or mesh for the next item are still placed, just without a ghost
+	const FVRRecipeInput& Input = Recipe->Inputs[InputIndex];
+	const int32 Slot = PlacedCounts[InputIndex];
+	UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+	if (!Input.Slots.IsValidIndex(Slot) || !Input.PlacedMesh || !Pool)
+		return;
+
+	Ghost = Pool->AcquireActor<AVRGhostPreviewActor>(AVRGhostPreviewActor::StaticClass(), Input.Slots[Slot] * GetComponentTransform());
+	if (Ghost)
+	{
+		Ghost->Show(Input.PlacedMesh, Recipe->GhostMaterial);
+	}
+}
+
+void UVRBuildSiteComponent::EndPreview()
+{
+	if (Ghost)
+	{
+		if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+		{
+			Pool->ReleaseActor(Ghost);
+		}
+		else
+		{
+			Ghost->Destroy();
+		}
+	}
+
+	Ghost = nullptr;
+	PreviewItem = nullptr;
+	PreviewInput = INDEX_NONE;
+}
+
+void UVRBuildSiteComponent::PlacePreviewItem()
+{
+	AVRGrabbableActor* Item = PreviewItem;
+	const int32 InputIndex = PreviewInput;
+	EndPreview();
+
+	UnbindItemEvents(Item);
+	Item->NotifyPlaced();
+
+	const bool bWasComplete = IsComplete();
+	++PlacedCounts[InputIndex];
+	OnCountChanged(InputIndex);
+
+	OnInputPlaced.Broadcast(this, InputIndex);
+
+	// Listeners may have changed the counts, only a site still complete after them counts as built
+	if (!bWasComplete && IsComplete())
+	{
+		OnCompleted.Broadcast(this);
+	}
+}
+
+#pragma endregion
@@ -0,0 +1,314 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Components/VRInventoryComponent.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "Camera/CameraComponent.h"
+
+UVRInventoryComponent::UVRInventoryComponent()
+{
+	// Everything happens on store and withdraw, nothing to do per frame
+	PrimaryComponentTick.bCanEverTick = false;
+
+	FVRHolster& LeftHip = Holsters.AddDefaulted_GetRef();
+	LeftHip.Name = TEXT("LeftHip");
+	LeftHip.Offset = FVector(5.0f, -22.0f, -75.0f);
+
+	FVRHolster& RightHip = Holsters.AddDefaulted_GetRef();
+	RightHip.Name = TEXT("RightHip");
+	RightHip.Offset = FVector(5.0f, 22.0f, -75.0f);
+
+	FVRHolster& Chest = Holsters.AddDefaulted_GetRef();
+	Chest.Name = TEXT("Chest");
+	Chest.Offset = FVector(15.0f, 0.0f, -35.0f);
+}
+
+void UVRInventoryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Camera = GetOwner()->FindComponentByClass<UCameraComponent>();
+}
+
+#pragma region Storing
+
+bool UVRInventoryComponent::TryStore(AVRGrabbableActor* Grabbable, const FVector& HandLocation)
+{
+	const int32 HolsterIndex = FindHolsterAt(HandLocation);
+	if (HolsterIndex != INDEX_NONE)
+		return StoreInHolster(Grabbable, HolsterIndex);
+
+	if (IsInBackpackReach(HandLocation))
+		return StoreInBackpack(Grabbable);
+
+	return false;
+}
+
+bool UVRInventoryComponent::StoreInHolster(AVRGrabbableActor* Grabbable, int32 HolsterIndex)
+{
+	if (!CanStore(Grabbable) || !Holsters.IsValidIndex(HolsterIndex))
+		return false;
+
+	FVRHolster& Holster = Holsters[HolsterIndex];
+	if (Holster.AllowedClasses.Num() > 0 && !Holster.AllowedClasses.ContainsByPredicate([Grabbable](const TSubclassOf<AVRGrabbableActor>& AllowedClass)
+	{
+		return Grabbable->IsA(AllowedClass);
+	}))
+		return false;
+
+	FGrabbableStateRecord Record;
+	Grabbable->SaveState(Record);
+
+	if (Holster.Item.IsEmpty())
+	{
+		Holster.Item = FVRInventoryItem::FromRecord(Record);
+	}
+	else if (!AddToStack(Holster.Item, Record))
+	{
+		return false;
+	}
+
+	Dematerialize(Grabbable);
+	OnInventoryChanged.Broadcast();
+	return true;
+}
+
+bool UVRInventoryComponent::StoreInBackpack(AVRGrabbableActor* Grabbable)
+{
+	if (!CanStore(Grabbable))
+		return false;
+
+	FGrabbableStateRecord Record;
+	Grabbable->SaveState(Record);
+
+	FVRInventoryItem* Stack = Backpack.FindByPredicate([this, &Record](const FVRInventoryItem& Item)
+	{
+		return Item.CanStackWith(Record) && Item.Quantity < MaxStackSize;
+	});
+
+	if (Stack)
+	{
+		++Stack->Quantity;
+	}
+	else if (Backpack.Num() < BackpackCapacity)
+	{
+		Backpack.Add(FVRInventoryItem::FromRecord(Record));
+	}
+	else
+	{
+		return false;
+	}
+
+	Dematerialize(Grabbable);
+	OnInventoryChanged.Broadcast();
+	return true;
+}
+
+bool UVRInventoryComponent::CanStore(const AVRGrabbableActor* Grabbable) const
+{
+	// Still in another hand, or on its way out of the world
+	return IsValid(Grabbable) && !Grabbable->IsBeingHeld() && !Grabbable->IsActorBeingDestroyed();
+}
+
+bool UVRInventoryComponent::AddToStack(FVRInventoryItem& Item, const FGrabbableStateRecord& Record) const
+{
+	if (!Item.CanStackWith(Record) || Item.Quantity >= MaxStackSize)
+		return false;
+
+	++Item.Quantity;
+	return true;
+}
+
+void UVRInventoryComponent::Dematerialize(AVRGrabbableActor* Grabbable)
+{
+	if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+	{
+		Pool->ReleaseActor(Grabbable);
+	}
+	else
+	{
+		Grabbable->Destroy();
+	}
+}
+
+#pragma endregion
+
+#pragma region Withdrawing
+
+AVRGrabbableActor* UVRInventoryComponent::TryWithdraw(const FVector& HandLocation, const FTransform& SpawnTransform)
+{
+	const int32 HolsterIndex = FindHolsterAt(HandLocation);
+	if (HolsterIndex != INDEX_NONE)
+		return WithdrawFromHolster(HolsterIndex, SpawnTransform);
+
+	// Over the shoulder the hand gets whatever went in last
+	if (IsInBackpackReach(HandLocation) && Backpack.Num() > 0)
+		return WithdrawFromBackpack(Backpack.Num() - 1, SpawnTransform);
+
+	return nullptr;
+}
+
+AVRGrabbableActor* UVRInventoryComponent::WithdrawFromHolster(int32 HolsterIndex, const FTransform& SpawnTransform)
+{
+	if (!Holsters.IsValidIndex(HolsterIndex) || Holsters[HolsterIndex].Item.IsEmpty())
+		return nullptr;
+
+	FVRInventoryItem& Item = Holsters[HolsterIndex].Item;
+	AVRGrabbableActor* Grabbable = Materialize(Item, SpawnTransform);
+	if (Item.Quantity <= 0)
+	{
+		Item = FVRInventoryItem();
+	}
+
+	OnInventoryChanged.Broadcast();
+	return Grabbable;
+}
+
+AVRGrabbableActor* UVRInventoryComponent::WithdrawFromBackpack(int32 Slot, const FTransform& SpawnTransform)
+{
+	if (!Backpack.IsValidIndex(Slot))
+		return nullptr;
+
+	AVRGrabbableActor* Grabbable = Materialize(Backpack[Slot], SpawnTransform);
+	if (Backpack[Slot].Quantity <= 0)
+	{
+		Backpack.RemoveAt(Slot);
+	}
+
+	OnInventoryChanged.Broadcast();
+	return Grabbable;
+}
+
+AVRGrabbableActor* UVRInventoryComponent::Materialize(FVRInventoryItem& Item, const FTransform& SpawnTransform)
+{
+	UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+	AVRGrabbableActor* Grabbable = Pool ? Pool->AcquireActor<AVRGrabbableActor>(Item.ItemClass, SpawnTransform) : nullptr;
+	if (!Grabbable)
+		return nullptr;
+
+	Grabbable->LoadState(Item.ToRecord(SpawnTransform));
+	--Item.Quantity;
+	return Grabbable;
+}
+
+#pragma endregion
+
+#pragma region Body Locations
+
+FTransform UVRInventoryComponent::GetBodyTransform() const
+{
+	if (!Camera)
+		return GetOwner()->GetActorTransform();
+
+	return FTransform(FRotator(0.0f, Camera->GetComponentRotation().Yaw, 0.0f), Camera->GetComponentLocation());
+}
+
+FVector UVRInventoryComponent::GetHolsterLocation(int32 HolsterIndex) const
+{
+	return Holsters.IsValidIndex(HolsterIndex) ? GetBodyTransform().TransformPosition(Holsters[HolsterIndex].Offset) : FVector::ZeroVector;
+}
+
+FVector UVRInventoryComponent::GetBackpackLocation() const
+{
+	return GetBodyTransform().TransformPosition(BackpackOffset);
+}
+
+int32 UVRInventoryComponent::FindHolsterAt(const FVector& Location) const
+{
+	const FTransform BodyTransform = GetBodyTransform();
+
+	int32 ClosestIndex = INDEX_NONE;
+	double ClosestDistanceSquared = TNumericLimits<double>::Max();
+
+	for (int32 HolsterIndex = 0; HolsterIndex < Holsters.Num(); ++HolsterIndex)
+	{
+		const double DistanceSquared = FVector::DistSquared(BodyTransform.TransformPosition(Holsters[HolsterIndex].Offset), Location);
+		if (DistanceSquared <= FMath::Square(Holsters[HolsterIndex].Radius) && DistanceSquared < ClosestDistanceSquared)
+		{
+			ClosestIndex = HolsterIndex;
+			ClosestDistanceSquared = DistanceSquared;
+		}
+	}
+
+	return ClosestIndex;
+}
+
+bool UVRInventoryComponent::IsInBackpackReach(const FVector& Location) const
+{
+	return FVector::DistSquared(GetBackpackLocation(), Location) <= FMath::Square(BackpackRadius);
+}
+
+#pragma endregion
+
+#pragma region Save
+
+namespace
+{
+	void SaveItem(const FVRInventoryItem& Item, FVRSavedInventoryItem& OutSaved)
+	{
+		if (Item.IsEmpty())
+			return;
+
+		OutSaved.ClassPath = Item.ItemClass->GetPathName();
+		OutSaved.Quantity = Item.Quantity;
+		OutSaved.StateValue = Item.StateValue;
+		OutSaved.StateFlags = Item.StateFlags;
+	}
+
+	FVRInventoryItem LoadItem(const FVRSavedInventoryItem& Saved)
+	{
+		FVRInventoryItem Item;
+		if (Saved.ClassPath.IsEmpty())
+			return Item;
+
+		const TSoftClassPtr<AVRGrabbableActor> ItemClass{FSoftObjectPath(Saved.ClassPath)};
+		Item.ItemClass = ItemClass.LoadSynchronous();
+		if (!Item.ItemClass)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("VRInventory: Saved item class %s no longer exists"), *Saved.ClassPath);
+			return Item;
+		}
+
+		Item.Quantity = Saved.Quantity;
+		Item.StateValue = Saved.StateValue;
+		Item.StateFlags = Saved.StateFlags;
+		return Item;
+	}
+}
+
+void UVRInventoryComponent::SaveInventory(FVRInventorySave& OutSave) const
+{
+	OutSave.Holsters.SetNum(Holsters.Num());
+	for (int32 HolsterIndex = 0; HolsterIndex < Holsters.Num(); ++HolsterIndex)
+	{
+		SaveItem(Holsters[HolsterIndex].Item, OutSave.Holsters[HolsterIndex]);
+	}
+
+	OutSave.Backpack.SetNum(Backpack.Num());
+	for (int32 Slot = 0; Slot < Backpack.Num(); ++Slot)
+	{
+		SaveItem(Backpack[Slot], OutSave.Backpack[Slot]);
+	}
+}
+
+void UVRInventoryComponent::LoadInventory(const FVRInventorySave& Save)
+{
+	for (int32 HolsterIndex = 0; HolsterIndex < Holsters.Num(); ++HolsterIndex)
+	{
+		Holsters[HolsterIndex].Item = Save.Holsters.IsValidIndex(HolsterIndex) ? LoadItem(Save.Holsters[HolsterIndex]) : FVRInventoryItem();
+	}
+
+	Backpack.Reset();
+	for (const FVRSavedInventoryItem& Saved : Save.Backpack)
+	{
+		FVRInventoryItem Item = LoadItem(Saved);
+		if (!Item.IsEmpty())
+		{
+			Backpack.Add(Item);
+		}
+	}
+
+	OnInventoryChanged.Broadcast();
+}
+
+#pragma endregion
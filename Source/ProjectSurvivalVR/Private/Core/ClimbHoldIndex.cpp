@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/ClimbHoldIndex.h"
+#include "Algo/Sort.h"
+
+void FClimbHoldIndex::Build(TArray<FHold>&& Holds)
+{
+    Nodes.Reset(Holds.Num());
+    for (const FHold& Hold : Holds)
+    {
+        FNode& Node = Nodes.AddDefaulted_GetRef();
+        Node.Hold = Hold;
+    }
+    Holds.Reset();
+
+    BuildRange(0, Nodes.Num());
+    Nodes.Shrink();
+}
+
+void FClimbHoldIndex::Reset()
+{
+    Nodes.Reset();
+}
+
+void FClimbHoldIndex::BuildRange(int32 Begin, int32 End)
+{
+    if (End - Begin <= 1)
+        return;
+
+    // Split along the widest axis of the range so walls and ledges both get balanced trees
+    FBox3f Bounds(ForceInit);
+    for (int32 Index = Begin; Index < End; ++Index)
+    {
+        Bounds += Nodes[Index].Hold.Position;
+    }
+
+    const FVector3f Extent = Bounds.GetSize();
+    const uint8 Axis = (Extent.X >= Extent.Y && Extent.X >= Extent.Z) ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+
+    // Runs once per climbable at load, a full sort of the range is simpler than a selection and cheap enough
+    TArrayView<FNode> Range(Nodes.GetData() + Begin, End - Begin);
+    Algo::SortBy(Range, [Axis](const FNode& Node) { return Node.Hold.Position[Axis]; });
+
+    const int32 Mid = Begin + (End - Begin) / 2;
+    Nodes[Mid].SplitAxis = Axis;
+
+    BuildRange(Begin, Mid);
+    BuildRange(Mid + 1, End);
+}
+
+int32 FClimbHoldIndex::FindNearest(const FVector3f& Point, float MaxDistance) const
+{
+    int32 BestNode = INDEX_NONE;
+    float BestDistanceSquared = (MaxDistance < FLT_MAX) ? FMath::Square(MaxDistance) : FLT_MAX;
+
+    SearchNearest(0, Nodes.Num(), Point, BestNode, BestDistanceSquared);
+
+    return BestNode != INDEX_NONE ? Nodes[BestNode].Hold.Payload : INDEX_NONE;
+}
+
+void FClimbHoldIndex::SearchNearest(int32 Begin, int32 End, const FVector3f& Point, int32& BestNode, float& BestDistanceSquared) const
+{
+    if (Begin >= End)
+        return;
+
+    const int32 Mid = Begin + (End - Begin) / 2;
+    const FNode& Node = Nodes[Mid];
+
+    const float DistanceSquared = FVector3f::DistSquared(Node.Hold.Position, Point);
+    if (DistanceSquared <= BestDistanceSquared)
+    {
+        BestDistanceSquared = DistanceSquared;
+        BestNode = Mid;
+    }
+
+    const float Delta = Point[Node.SplitAxis] - Node.Hold.Position[Node.SplitAxis];
+    const bool bGoLeft = Delta < 0.0f;
+
+    // Near half first so the far half can usually be pruned by the split plane distance
+    SearchNearest(bGoLeft ? Begin : Mid + 1, bGoLeft ? Mid : End, Point, BestNode, BestDistanceSquared);
+
+    if (FMath::Square(Delta) < BestDistanceSquared)
+    {
+        SearchNearest(bGoLeft ? Mid + 1 : Begin, bGoLeft ? End : Mid, Point, BestNode, BestDistanceSquared);
+    }
+}
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/VRAllocationCounter.h"
+#include "HAL/MemoryBase.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+    // Blocks allocated before Start or after Stop are freed by the same allocator underneath
+    class FCountingMalloc final : public FMalloc
+    {
+    public:
+        explicit FCountingMalloc(FMalloc* InInner)
+            : Inner(InInner)
+        {
+        }
+
+        FMalloc* GetInner() const { return Inner; }
+        uint64 GetAllocations() const { return Allocations; }
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->TryMalloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            // A realloc to nothing is a free
+            if (Count > 0)
+            {
+                CountAllocation();
+            }
+
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count > 0)
+            {
+                CountAllocation();
+            }
+
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void MarkTLSCachesAsUsedOnCurrentThread() override { Inner->MarkTLSCachesAsUsedOnCurrentThread(); }
+        virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { Inner->MarkTLSCachesAsUnusedOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual void UpdateStats() override { Inner->UpdateStats(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+        virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+    private:
+        void CountAllocation()
+        {
+            // The task graph, the log and render threads keep allocating meanwhile
+            if (IsInGameThread())
+            {
+                ++Allocations;
+            }
+        }
+
+        FMalloc* Inner;
+        uint64 Allocations = 0;
+    };
+
+    // Never deleted, another thread may still be inside it when GMalloc is put back
+    FCountingMalloc* CountingMalloc = nullptr;
+}
+
+void FVRAllocationCounter::Start()
+{
+    check(IsInGameThread());
+
+    if (IsStarted())
+        return;
+
+    if (!CountingMalloc)
+    {
+        CountingMalloc = new FCountingMalloc(GMalloc);
+    }
+
+    GMalloc = CountingMalloc;
+}
+
+void FVRAllocationCounter::Stop()
+{
+    check(IsInGameThread());
+
+    if (IsStarted())
+    {
+        GMalloc = CountingMalloc->GetInner();
+    }
+}
+
+bool FVRAllocationCounter::IsStarted()
+{
+    return CountingMalloc && GMalloc == CountingMalloc;
+}
+
+uint64 FVRAllocationCounter::GetAllocations()
+{
+    return CountingMalloc ? CountingMalloc->GetAllocations() : 0;
+}
+#endif
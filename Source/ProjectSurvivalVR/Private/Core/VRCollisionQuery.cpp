@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/VRCollisionQuery.h"
+#include "Core/VRPerfCounters.h"
+#include "Engine/World.h"
+#include "Engine/OverlapResult.h"
+#include "Components/PrimitiveComponent.h"
+#include "Kismet/GameplayStatics.h"
+
+namespace VRCollisionQuery
+{
+    bool LineTraceSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel TraceChannel,
+        const FCollisionQueryParams& Params)
+    {
+        FVRPerfCounters::CountCollisionQueries();
+        return World->LineTraceSingleByChannel(OutHit, Start, End, TraceChannel, Params);
+    }
+
+    bool LineTraceSingleByObjectType(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, const FCollisionObjectQueryParams& ObjectQueryParams,
+        const FCollisionQueryParams& Params)
+    {
+        FVRPerfCounters::CountCollisionQueries();
+        return World->LineTraceSingleByObjectType(OutHit, Start, End, ObjectQueryParams, Params);
+    }
+
+    bool LineTraceSingleByProfile(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, FName ProfileName,
+        const FCollisionQueryParams& Params)
+    {
+        FVRPerfCounters::CountCollisionQueries();
+        return World->LineTraceSingleByProfile(OutHit, Start, End, ProfileName, Params);
+    }
+
+    bool SweepSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, const FQuat& Rot, ECollisionChannel TraceChannel,
+        const FCollisionShape& CollisionShape, const FCollisionQueryParams& Params)
+    {
+        FVRPerfCounters::CountCollisionQueries();
+        return World->SweepSingleByChannel(OutHit, Start, End, Rot, TraceChannel, CollisionShape, Params);
+    }
+
+    bool OverlapMultiByChannel(const UWorld* World, TArray<FOverlapResult>& OutOverlaps, const FVector& Pos, const FQuat& Rot, ECollisionChannel TraceChannel,
+        const FCollisionShape& CollisionShape, const FCollisionQueryParams& Params)
+    {
+        FVRPerfCounters::CountCollisionQueries();
+        return World->OverlapMultiByChannel(OutOverlaps, Pos, Rot, TraceChannel, CollisionShape, Params);
+    }
+
+    bool OverlapMultiByObjectType(const UWorld* World, TArray<FOverlapResult>& OutOverlaps, const FVector& Pos, const FQuat& Rot, const FCollisionObjectQueryParams& ObjectQueryParams,
+        const FCollisionShape& CollisionShape, const FCollisionQueryParams& Params)
+    {
+        FVRPerfCounters::CountCollisionQueries();
+        return World->OverlapMultiByObjectType(OutOverlaps, Pos, Rot, ObjectQueryParams, CollisionShape, Params);
+    }
+
+    bool LineTraceComponent(UPrimitiveComponent* Component, FHitResult& OutHit, const FVector& Start, const FVector& End, const FCollisionQueryParams& Params)
+    {
+        FVRPerfCounters::CountCollisionQueries();
+        return Component->LineTraceComponent(OutHit, Start, End, Params);
+    }
+
+    float GetClosestPointOnCollision(const UPrimitiveComponent* Component, const FVector& Point, FVector& OutPointOnBody)
+    {
+        FVRPerfCounters::CountCollisionQueries();
+        return Component->GetClosestPointOnCollision(Point, OutPointOnBody);
+    }
+
+    bool PredictProjectilePath(const UObject* WorldContextObject, const FPredictProjectilePathParams& PredictParams, FPredictProjectilePathResult& PredictResult)
+    {
+        FVRPerfCounters::CountCollisionQueries();
+        return UGameplayStatics::PredictProjectilePath(WorldContextObject, PredictParams, PredictResult);
+    }
+}
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/VRFocusPoints.h"
+#include "Hands/VRHand.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+void FVRFocusPoints::Gather(const UWorld* World)
+{
+    Points.Reset();
+
+    if (!World)
+        return;
+
+    if (const APlayerController* PlayerController = World->GetFirstPlayerController())
+    {
+        if (const APawn* Pawn = PlayerController->GetPawn())
+        {
+            Points.Add(Pawn->GetActorLocation());
+        }
+    }
+
+    for (const AVRHand* Hand : AVRHand::GetAllHands())
+    {
+        if (Hand && Hand->GetHandOriginPoint() && Hand->GetWorld() == World)
+        {
+            Points.Add(Hand->GetHandOriginPoint()->GetComponentLocation());
+        }
+    }
+}
+
+float FVRFocusPoints::GetDistanceSquared(const FVector& Location) const
+{
+    float ClosestSquared = FLT_MAX;
+    for (const FVector& Point : Points)
+    {
+        ClosestSquared = FMath::Min(ClosestSquared, static_cast<float>(FVector::DistSquared(Point, Location)));
+    }
+    return ClosestSquared;
+}
@@ -1,5 +1,13 @@
 #include "Core/VRGameInstance.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/Engine.h"
+#include "Subsystems/VRWorldSaveSubsystem.h"
+#include "StereoLayerFunctionLibrary.h"
+#include "Misc/PackageName.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "TimerManager.h"
+
+CSV_DEFINE_CATEGORY(VRLevelTransition, true);
 
 UVRGameInstance::UVRGameInstance()
 {
@@ -8,9 +16,33 @@ UVRGameInstance::UVRGameInstance()
 void UVRGameInstance::Init()
 {
     Super::Init();
+
+    FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UVRGameInstance::OnPostLoadMap);
+    if (GEngine)
+    {
+        GEngine->OnTravelFailure().AddUObject(this, &UVRGameInstance::OnTravelFailure);
+    }
+
+    // The compositor also shows the splash during the (short) blocking part of OpenLevel
+    if (LoadingSplashTexture)
+    {
+        UStereoLayerFunctionLibrary::SetSplashScreen(LoadingSplashTexture);
+        UStereoLayerFunctionLibrary::EnableAutoLoadingSplashScreen(true);
+    }
+
     UE_LOG(LogTemp, Log, TEXT("VRGameInstance initialized"));
 }
 
+void UVRGameInstance::Shutdown()
+{
+    FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+    if (GEngine)
+    {
+        GEngine->OnTravelFailure().RemoveAll(this);
+    }
+    Super::Shutdown();
+}
+
 void UVRGameInstance::ReturnToGame()
 {
     UE_LOG(LogTemp, Log, TEXT("Returning to game"));
@@ -27,24 +59,184 @@ void UVRGameInstance::GoToMenu()
 
 void UVRGameInstance::TransitionToLevel(const FString& LevelName, float DelaySeconds)
 {
+    if (IsTransitionInProgress())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Already transitioning to %s, ignoring %s"), *PendingLevelName, *LevelName);
+        return;
+    }
+
     OnLevelTransition.Broadcast(LevelName);
 
+    // The world is about to go, its state is captured now and written while the next map loads
+    if (UVRWorldSaveSubsystem* WorldSave = UVRWorldSaveSubsystem::Get(GetWorld()))
+    {
+        WorldSave->SaveNow();
+    }
+
+    PendingLevelName = LevelName;
+    bLevelPackageLoaded = false;
+    bTransitionDelayElapsed = false;
+    TransitionRequestTime = FPlatformTime::Seconds();
+
+    // Short names like "MainLevel" are resolved to their long package name for the async loader
+    FString PackageName = LevelName;
+    if (!FPackageName::IsValidLongPackageName(PackageName))
+    {
+        FString LongPackageName;
+        if (FPackageName::SearchForPackageOnDisk(LevelName, &LongPackageName))
+        {
+            PackageName = LongPackageName;
+        }
+    }
+
+    if (LoadingSplashTexture)
+    {
+        UStereoLayerFunctionLibrary::ShowSplashScreen();
+    }
+
+    if (FPackageName::IsValidLongPackageName(PackageName))
+    {
+        PendingPackageName = FName(*PackageName);
+        LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateUObject(this, &UVRGameInstance::OnLevelPackageLoaded));
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Could not resolve level %s, it will load synchronously"), *LevelName);
+        bLevelPackageLoaded = true;
+        LevelLoadedTime = TransitionRequestTime;
+    }
+
     GetWorld()->GetTimerManager().SetTimer(
         LevelTransitionTimer,
-        [this, LevelName]() { ExecuteLevelTransition(LevelName); },
-        DelaySeconds,
+        this,
+        &UVRGameInstance::OnTransitionDelayElapsed,
+        FMath::Max(DelaySeconds, KINDA_SMALL_NUMBER),
         false
     );
 }
 
 void UVRGameInstance::TransitionToLevelImmediate(const FString& LevelName)
 {
+    // Overrides a delayed transition, its timer and package load must not open the other level afterwards
+    if (IsTransitionInProgress())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cancelling transition to %s for %s"), *PendingLevelName, *LevelName);
+        ResetTransition();
+    }
+
     OnLevelTransition.Broadcast(LevelName);
+
+    if (UVRWorldSaveSubsystem* WorldSave = UVRWorldSaveSubsystem::Get(GetWorld()))
+    {
+        WorldSave->SaveNow();
+    }
+
+    PendingLevelName = LevelName;
+    bLevelPackageLoaded = true;
+    bTransitionDelayElapsed = true;
+    TransitionRequestTime = LevelLoadedTime = FPlatformTime::Seconds();
     ExecuteLevelTransition(LevelName);
 }
 
+void UVRGameInstance::OnLevelPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+    // A stale load finishing after the transition already happened or was replaced
+    if (!IsTransitionInProgress() || bLevelPackageLoaded || PackageName != PendingPackageName)
+        return;
+
+    if (Result == EAsyncLoadingResult::Succeeded)
+    {
+        PreloadedLevelPackage = LoadedPackage;
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Async load of %s failed, it will load synchronously"), *PackageName.ToString());
+    }
+
+    bLevelPackageLoaded = true;
+    LevelLoadedTime = FPlatformTime::Seconds();
+    TryFinishTransition();
+}
+
+void UVRGameInstance::OnTransitionDelayElapsed()
+{
+    // Fired and done, a handle kept past the map change could match a timer of the next world
+    LevelTransitionTimer.Invalidate();
+    bTransitionDelayElapsed = true;
+    TryFinishTransition();
+}
+
+void UVRGameInstance::TryFinishTransition()
+{
+    if (!IsTransitionInProgress())
+        return;
+
+    if (bLevelPackageLoaded && bTransitionDelayElapsed)
+    {
+        ExecuteLevelTransition(PendingLevelName);
+    }
+}
+
 void UVRGameInstance::ExecuteLevelTransition(const FString& LevelName)
 {
     UE_LOG(LogTemp, Warning, TEXT("Transitioning to level: %s"), *LevelName);
+    OpenLevelTime = FPlatformTime::Seconds();
     UGameplayStatics::OpenLevel(this, FName(*LevelName));
-}
\ No newline at end of file
+}
+
+void UVRGameInstance::OnTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString)
+{
+    if (!IsTransitionInProgress())
+        return;
+
+    // OpenLevel only reports failure here, without a reset every later transition would be ignored
+    UE_LOG(LogTemp, Error, TEXT("Transition to %s failed: %s"), *PendingLevelName, *ErrorString);
+    ResetTransition();
+}
+
+void UVRGameInstance::ResetTransition()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(LevelTransitionTimer);
+    }
+
+    PendingLevelName.Reset();
+    PendingPackageName = NAME_None;
+    PreloadedLevelPackage = nullptr;
+    bLevelPackageLoaded = false;
+    bTransitionDelayElapsed = false;
+
+    if (LoadingSplashTexture)
+    {
+        UStereoLayerFunctionLibrary::HideSplashScreen();
+    }
+}
+
+void UVRGameInstance::OnPostLoadMap(UWorld* LoadedWorld)
+{
+    if (!IsTransitionInProgress())
+        return;
+
+    const double Now = FPlatformTime::Seconds();
+
+    LastTransitionTiming.LevelName = PendingLevelName;
+    LastTransitionTiming.AsyncLoadSeconds = LevelLoadedTime - TransitionRequestTime;
+    LastTransitionTiming.WaitSeconds = OpenLevelTime - LevelLoadedTime;
+    LastTransitionTiming.MapLoadSeconds = Now - OpenLevelTime;
+    LastTransitionTiming.TotalSeconds = Now - TransitionRequestTime;
+    LastTransitionTiming.bWasPreloaded = PreloadedLevelPackage != nullptr;
+
+    UE_LOG(LogTemp, Log, TEXT("Level %s ready in %.2fs (async load %.2fs, wait %.2fs, blocking map load %.2fs%s)"),
+        *LastTransitionTiming.LevelName, LastTransitionTiming.TotalSeconds, LastTransitionTiming.AsyncLoadSeconds,
+        LastTransitionTiming.WaitSeconds, LastTransitionTiming.MapLoadSeconds,
+        LastTransitionTiming.bWasPreloaded ? TEXT("") : TEXT(", not preloaded"));
+
+    CSV_CUSTOM_STAT(VRLevelTransition, AsyncLoadMs, LastTransitionTiming.AsyncLoadSeconds * 1000.0f, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(VRLevelTransition, MapLoadMs, LastTransitionTiming.MapLoadSeconds * 1000.0f, ECsvCustomStatOp::Set);
+    CSV_EVENT(VRLevelTransition, TEXT("LevelReady %s"), *LastTransitionTiming.LevelName);
+
+    ResetTransition();
+
+    OnLevelTransitionCompleted.Broadcast(LastTransitionTiming);
+}
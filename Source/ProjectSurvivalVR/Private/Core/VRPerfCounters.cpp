@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/VRPerfCounters.h"
+
+DEFINE_STAT(STAT_VRRenderWritesAvoided);
+DEFINE_STAT(STAT_VRPhysicsStateRebuilds);
+DEFINE_STAT(STAT_VRPoolHits);
+DEFINE_STAT(STAT_VRPoolMisses);
+DEFINE_STAT(STAT_VRUILayerRedraws);
+DEFINE_STAT(STAT_VRCollisionQueries);
+DEFINE_STAT(STAT_VRTickDemandActiveActors);
+DEFINE_STAT(STAT_VRPhysicsActiveBodies);
+DEFINE_STAT(STAT_VRPhysicsDormantBodies);
+DEFINE_STAT(STAT_VRInstancedProps);
+DEFINE_STAT(STAT_VRBurningFires);
+DEFINE_STAT(STAT_VRVFXFullQuality);
+DEFINE_STAT(STAT_VRVFXReducedQuality);
+DEFINE_STAT(STAT_VRVFXPaused);
+
+uint64 FVRPerfCounters::RenderWritesAvoided = 0;
+uint64 FVRPerfCounters::PhysicsStateRebuilds = 0;
+uint64 FVRPerfCounters::PoolHits = 0;
+uint64 FVRPerfCounters::PoolMisses = 0;
+uint64 FVRPerfCounters::UILayerRedraws = 0;
+uint64 FVRPerfCounters::CollisionQueries = 0;
+int32 FVRPerfCounters::TickDemandActiveActors = 0;
+int32 FVRPerfCounters::PhysicsActiveBodies = 0;
+int32 FVRPerfCounters::PhysicsDormantBodies = 0;
+int32 FVRPerfCounters::InstancedProps = 0;
+int32 FVRPerfCounters::BurningFires = 0;
+int32 FVRPerfCounters::VFXFullQuality = 0;
+int32 FVRPerfCounters::VFXReducedQuality = 0;
+int32 FVRPerfCounters::VFXPaused = 0;
+
+void FVRPerfCounters::ResetAll()
+{
+    // Gauges are left alone, they describe the live world rather than a measurement window
+    RenderWritesAvoided = 0;
+    PhysicsStateRebuilds = 0;
+    PoolHits = 0;
+    PoolMisses = 0;
+    UILayerRedraws = 0;
+    CollisionQueries = 0;
+}
+
+void FVRPerfCounters::CountCollisionQueries(uint32 Count)
+{
+    INC_DWORD_STAT_BY(STAT_VRCollisionQueries, Count);
+    CollisionQueries += Count;
+}
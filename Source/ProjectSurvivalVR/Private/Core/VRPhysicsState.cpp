@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/VRPhysicsState.h"
+#include "Core/VRPerfCounters.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+
+namespace
+{
+    void CountRebuild()
+    {
+        INC_DWORD_STAT(STAT_VRPhysicsStateRebuilds);
+        ++FVRPerfCounters::PhysicsStateRebuilds;
+    }
+}
+
+namespace VRPhysicsState
+{
+    bool SetCollisionResponseToChannel(UPrimitiveComponent* Component, ECollisionChannel Channel, ECollisionResponse NewResponse)
+    {
+        if (!Component || Component->GetCollisionResponseToChannel(Channel) == NewResponse)
+            return false;
+
+        Component->SetCollisionResponseToChannel(Channel, NewResponse);
+        CountRebuild();
+        return true;
+    }
+
+    bool SetCollisionEnabled(UPrimitiveComponent* Component, ECollisionEnabled::Type NewType)
+    {
+        if (!Component || Component->GetCollisionEnabled() == NewType)
+            return false;
+
+        Component->SetCollisionEnabled(NewType);
+        CountRebuild();
+        return true;
+    }
+
+    bool SetSimulatePhysics(UPrimitiveComponent* Component, bool bSimulate)
+    {
+        if (!Component || Component->IsSimulatingPhysics() == bSimulate)
+            return false;
+
+        Component->SetSimulatePhysics(bSimulate);
+        CountRebuild();
+        return true;
+    }
+
+    bool SetAllBodiesBelowSimulatePhysics(USkeletalMeshComponent* Component, FName BoneName, bool bSimulate)
+    {
+        if (!Component)
+            return false;
+
+        bool bAllMatch = true;
+        Component->ForEachBodyBelow(BoneName, true, true, [&bAllMatch, bSimulate](FBodyInstance* Body)
+        {
+            bAllMatch &= Body->IsInstanceSimulatingPhysics() == bSimulate;
+        });
+        if (bAllMatch)
+            return false;
+
+        Component->SetAllBodiesBelowSimulatePhysics(BoneName, bSimulate);
+        CountRebuild();
+        return true;
+    }
+}
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/VRRenderState.h"
+#include "Core/VRPerfCounters.h"
+#include "Components/SceneComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/LightComponent.h"
+
+namespace VRRenderState
+{
+    void CountAvoidedWrite()
+    {
+        INC_DWORD_STAT(STAT_VRRenderWritesAvoided);
+        ++FVRPerfCounters::RenderWritesAvoided;
+    }
+
+    bool SetWorldLocation(USceneComponent* Component, const FVector& NewLocation, double Tolerance)
+    {
+        if (!Component)
+            return false;
+
+        if (Component->GetComponentLocation().Equals(NewLocation, Tolerance))
+        {
+            CountAvoidedWrite();
+            return false;
+        }
+
+        Component->SetWorldLocation(NewLocation);
+        return true;
+    }
+
+    bool SetWorldRotation(USceneComponent* Component, const FQuat& NewRotation, double Tolerance)
+    {
+        if (!Component)
+            return false;
+
+        // Compare as quaternions, rotators over 90 degrees pitch come back from the component re-expressed
+        if (Component->GetComponentQuat().AngularDistance(NewRotation) <= Tolerance)
+        {
+            CountAvoidedWrite();
+            return false;
+        }
+
+        Component->SetWorldRotation(NewRotation);
+        return true;
+    }
+
+    bool SetRelativeTransform(USceneComponent* Component, const FTransform& NewTransform, double Tolerance)
+    {
+        if (!Component)
+            return false;
+
+        if (Component->GetRelativeTransform().Equals(NewTransform, Tolerance))
+        {
+            CountAvoidedWrite();
+            return false;
+        }
+
+        Component->SetRelativeTransform(NewTransform);
+        return true;
+    }
+
+    bool SetVisibility(USceneComponent* Component, bool bNewVisibility, bool bPropagateToChildren)
+    {
+        if (!Component)
+            return false;
+
+        if (Component->GetVisibleFlag() == bNewVisibility)
+        {
+            CountAvoidedWrite();
+            return false;
+        }
+
+        Component->SetVisibility(bNewVisibility, bPropagateToChildren);
+        return true;
+    }
+
+    bool SetRenderCustomDepth(UPrimitiveComponent* Component, bool bNewRenderCustomDepth)
+    {
+        if (!Component)
+            return false;
+
+        if (Component->bRenderCustomDepth == bNewRenderCustomDepth)
+        {
+            CountAvoidedWrite();
+            return false;
+        }
+
+        Component->SetRenderCustomDepth(bNewRenderCustomDepth);
+        return true;
+    }
+
+    bool SetIntensity(ULightComponent* Component, float NewIntensity, float Tolerance)
+    {
+        if (!Component)
+            return false;
+
+        if (FMath::IsNearlyEqual(Component->Intensity, NewIntensity, Tolerance))
+        {
+            CountAvoidedWrite();
+            return false;
+        }
+
+        Component->SetIntensity(NewIntensity);
+        return true;
+    }
+}
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/VRTickDemand.h"
+#include "Core/VRPerfCounters.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+
+void FTickDemand::Initialize(AActor* InOwner, ETickReason InOwnerReasons)
+{
+    Owner = InOwner;
+    OwnerReasons = InOwnerReasons;
+
+    if (InOwner)
+    {
+        InOwner->SetActorTickEnabled(EnumHasAnyFlags(ActiveReasons, OwnerReasons));
+
+        if (EnumHasAnyFlags(ActiveReasons, OwnerReasons))
+        {
+            INC_DWORD_STAT(STAT_VRTickDemandActiveActors);
+            ++FVRPerfCounters::TickDemandActiveActors;
+        }
+    }
+}
+
+void FTickDemand::AddDependentComponent(UActorComponent* Component, ETickReason Reasons)
+{
+    if (!Component)
+        return;
+
+    DependentComponents.Add({ Component, Reasons });
+    Component->SetActive(EnumHasAnyFlags(ActiveReasons, Reasons));
+}
+
+void FTickDemand::SetReason(ETickReason Reason, bool bActive)
+{
+    const ETickReason PreviousReasons = ActiveReasons;
+
+    if (bActive)
+    {
+        EnumAddFlags(ActiveReasons, Reason);
+    }
+    else
+    {
+        EnumRemoveFlags(ActiveReasons, Reason);
+    }
+
+    if (ActiveReasons != PreviousReasons)
+    {
+        Apply(PreviousReasons);
+    }
+}
+
+void FTickDemand::Reset()
+{
+    const ETickReason PreviousReasons = ActiveReasons;
+    ActiveReasons = ETickReason::None;
+
+    if (PreviousReasons != ETickReason::None)
+    {
+        Apply(PreviousReasons);
+    }
+}
+
+void FTickDemand::Apply(ETickReason PreviousReasons)
+{
+    const bool bWasTicking = EnumHasAnyFlags(PreviousReasons, OwnerReasons);
+    const bool bShouldTick = EnumHasAnyFlags(ActiveReasons, OwnerReasons);
+
+    AActor* OwnerActor = Owner.Get();
+    if (OwnerActor && bWasTicking != bShouldTick)
+    {
+        OwnerActor->SetActorTickEnabled(bShouldTick);
+
+        if (bShouldTick)
+        {
+            INC_DWORD_STAT(STAT_VRTickDemandActiveActors);
+            ++FVRPerfCounters::TickDemandActiveActors;
+        }
+        else
+        {
+            DEC_DWORD_STAT(STAT_VRTickDemandActiveActors);
+            --FVRPerfCounters::TickDemandActiveActors;
+        }
+    }
+
+    for (const FDependentComponent& Dependent : DependentComponents)
+    {
+        UActorComponent* Component = Dependent.Component.Get();
+        if (!Component)
+            continue;
+
+        const bool bWasActive = EnumHasAnyFlags(PreviousReasons, Dependent.Reasons);
+        const bool bShouldBeActive = EnumHasAnyFlags(ActiveReasons, Dependent.Reasons);
+
+        if (bWasActive != bShouldBeActive)
+        {
+            Component->SetActive(bShouldBeActive);
+        }
+    }
+}
@@ -4,11 +4,13 @@
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/Engine.h"
+#include "Components/LightComponent.h"
+#include "Core/VRRenderState.h"
 
 ADayNightManager::ADayNightManager()
 {
 	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.bStartWithTickEnabled = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 }
 
 void ADayNightManager::BeginPlay()
@@ -46,10 +48,20 @@ void ADayNightManager::BeginPlay()
 	// Set initial day/night state
 	bWasNight = IsNight();
 
+	SetActorTickInterval(TimeUpdateInterval);
+	TickDemand.Initialize(this, ETickReason::TimeOfDay);
+	TickDemand.AddReason(ETickReason::TimeOfDay);
+
 	UE_LOG(LogTemp, Warning, TEXT("DayNightManager initialized - Starting hour: %.2f, Is Night: %s"),
 		CurrentHour, IsNight() ? TEXT("Yes") : TEXT("No"));
 }
 
+void ADayNightManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	TickDemand.Reset();
+	Super::EndPlay(EndPlayReason);
+}
+
 void ADayNightManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -72,14 +84,10 @@ void ADayNightManager::UpdateTime(float DeltaTime)
 		UpdateCachedValues();
 	}
 
-	// Calculate base time progression
-	float HoursPerSecond = 24.0f / CachedDayLengthInSeconds;
-
-	// Apply night speed multiplier if it's night
-	float TimeMultiplier = IsNight() ? NightSpeedMultiplier : 1.0f;
-
-	// Update current hour with speed modifier
-	CurrentHour += HoursPerSecond * DeltaTime * TimeMultiplier;
+	// Update current hour, night speed multiplier included
+	const float ElapsedHours = GetGameHoursPerSecond() * DeltaTime;
+	CurrentHour += ElapsedHours;
+	TotalGameHours += ElapsedHours;
 
 	// Wrap around 24 hours
 	if (CurrentHour >= 24.0f)
@@ -99,9 +107,10 @@ void ADayNightManager::UpdateSunRotation()
 
 	float SunAngle = (CurrentHour / 24.0f) * 360.0f;
 
-	// Apply rotation - sun moves in a full circle
+	// Apply rotation - sun moves in a full circle, only once it has moved past the tolerance
 	FRotator NewRotation = FRotator(SunAngle, 0.0f, 0.0f);
-	SunLight->SetActorRotation(NewRotation);
+	VRRenderState::SetWorldRotation(SunLight->GetRootComponent(), NewRotation.Quaternion(),
+		FMath::DegreesToRadians(SunRotationToleranceDegrees));
 }
 
 void ADayNightManager::UpdateSunIntensity()
@@ -112,8 +121,8 @@ void ADayNightManager::UpdateSunIntensity()
 	// Simple intensity based on day/night
 	float TargetIntensity = IsDay() ? DayLightIntensity : NightLightIntensity;
 
-	// Set the intensity
-	SunLight->GetLightComponent()->SetIntensity(TargetIntensity);
+	// Set the intensity, it only actually changes at sunrise and sunset
+	VRRenderState::SetIntensity(SunLight->GetLightComponent(), TargetIntensity);
 }
 
 void ADayNightManager::CheckDayNightTransition()
@@ -144,6 +153,17 @@ void ADayNightManager::UpdateCachedValues()
 	CachedDayLengthInSeconds = DayLengthInMinutes * 60.0f;
 }
 
+float ADayNightManager::GetGameHoursPerSecond() const
+{
+	const float DayLengthInSeconds = (CachedDayLengthInSeconds > 0.0f) ? CachedDayLengthInSeconds : DayLengthInMinutes * 60.0f;
+	if (DayLengthInSeconds <= 0.0f)
+		return 0.0f;
+
+	// Apply night speed multiplier if it's night
+	const float TimeMultiplier = IsNight() ? NightSpeedMultiplier : 1.0f;
+	return (24.0f / DayLengthInSeconds) * TimeMultiplier;
+}
+
 FString ADayNightManager::GetFormattedTime() const
 {
 	int32 Hours = FMath::FloorToInt(CurrentHour);
@@ -166,6 +186,15 @@ void ADayNightManager::SetCurrentHour(float NewHour)
 	CheckDayNightTransition();
 }
 
+void ADayNightManager::RestoreClock(float Hour, double InTotalGameHours)
+{
+	// A loaded clock is not a sunrise or sunset, so no transition event for it
+	CurrentHour = FMath::Fmod(Hour, 24.0f);
+	bWasNight = IsNight();
+	SetCurrentHour(CurrentHour);
+	TotalGameHours = InTotalGameHours;
+}
+
 bool ADayNightManager::SleepUntilMorning()
 {
 	if (!IsNight())
@@ -174,8 +203,15 @@ bool ADayNightManager::SleepUntilMorning()
 		return false;
 	}
 
+	// Hours until DayStartHour, wrapping past midnight
+	const float SkippedHours = FMath::Fmod(DayStartHour - CurrentHour + 24.0f, 24.0f);
+
 	// Set time to morning (DayStartHour)
 	SetCurrentHour(DayStartHour);
+	TotalGameHours += SkippedHours;
+
+	// Systems that simulate over time (fires, ...) catch up in one step
+	OnTimeSkipped.Broadcast(SkippedHours);
 
 	UE_LOG(LogTemp, Warning, TEXT("Player slept until morning - Time set to %.2f:00"), DayStartHour);
 	return true;
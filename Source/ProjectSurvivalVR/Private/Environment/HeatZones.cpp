@@ -1,5 +1,6 @@
 #include "Environment/HeatZones.h"
 #include "Components/SurvivalComponent.h"
+#include "Subsystems/VRVFXBudgetSubsystem.h"
 
 
 AHeatZones::AHeatZones()
@@ -70,6 +71,21 @@ void AHeatZones::BeginPlay()
         ShelteredBoxCollider->SetCollisionEnabled(ECollisionEnabled::NoCollision);
     }
 
+    // The zone's effect is always wanted, the budget pauses or downgrades it when it is far or off-screen
+    if (UVRVFXBudgetSubsystem* VFXBudget = UVRVFXBudgetSubsystem::Get(this))
+    {
+        VFXBudget->RegisterEffect(NiagaraComponent, ReducedNiagaraSystem, true);
+    }
+}
+
+void AHeatZones::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UVRVFXBudgetSubsystem* VFXBudget = UVRVFXBudgetSubsystem::Get(this))
+    {
+        VFXBudget->UnregisterEffect(NiagaraComponent);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AHeatZones::OnHeatZoneOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
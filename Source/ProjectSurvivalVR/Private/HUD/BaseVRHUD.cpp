@@ -1,6 +1,8 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "HUD/BaseVRHUD.h"
+#include "HUD/SurvivalViewModel.h"
+#include "Subsystems/InteractionEventSubsystem.h"
 
 void UBaseVRHUD::NativeConstruct()
 {
@@ -18,60 +20,105 @@ void UBaseVRHUD::NativeConstruct()
 
     if (SurvivalComponent)
     {
-        GetWorld()->GetTimerManager().SetTimer(UpdateUITimer, this, &UBaseVRHUD::RefreshUI, 1.0f, true);
+        ViewModel = SurvivalComponent->GetViewModel();
+        ViewModel->OnHungerChanged.AddUniqueDynamic(this, &UBaseVRHUD::HandleHungerChanged);
+        ViewModel->OnThirstChanged.AddUniqueDynamic(this, &UBaseVRHUD::HandleThirstChanged);
+        ViewModel->OnStaminaChanged.AddUniqueDynamic(this, &UBaseVRHUD::HandleStaminaChanged);
+        ViewModel->OnTemperatureChanged.AddUniqueDynamic(this, &UBaseVRHUD::HandleTemperatureChanged);
+
+        // Events only fire on change, so show what is there now
+        HandleHungerChanged(ViewModel->GetHungerPercent());
+        HandleThirstChanged(ViewModel->GetThirstPercent());
+        HandleStaminaChanged(ViewModel->GetStaminaPercent());
+        HandleTemperatureChanged(ViewModel->GetTemperatureDegrees(), ViewModel->GetTemperatureText());
     }
 
+    if (UInteractionEventSubsystem* EventSubsystem = UInteractionEventSubsystem::Get(this))
+    {
+        EventSubsystem->OnAnyHoverChanged.AddUniqueDynamic(this, &UBaseVRHUD::HandleHoverChanged);
+        EventSubsystem->OnAnyGrabbed.AddUniqueDynamic(this, &UBaseVRHUD::HandleGrabbed);
+    }
 }
 
-void UBaseVRHUD::RefreshUI()
+void UBaseVRHUD::NativeDestruct()
 {
-    Hunger = GetHungerPercentage();
-    Thirst = GetThirstPercentage();
-   // Temperature = GetTemperatureText();
-    Stamina = GetStaminaPercentage();
-}
+    if (ViewModel)
+    {
+        ViewModel->OnHungerChanged.RemoveDynamic(this, &UBaseVRHUD::HandleHungerChanged);
+        ViewModel->OnThirstChanged.RemoveDynamic(this, &UBaseVRHUD::HandleThirstChanged);
+        ViewModel->OnStaminaChanged.RemoveDynamic(this, &UBaseVRHUD::HandleStaminaChanged);
+        ViewModel->OnTemperatureChanged.RemoveDynamic(this, &UBaseVRHUD::HandleTemperatureChanged);
+        ViewModel = nullptr;
+    }
 
-float UBaseVRHUD::GetHungerPercentage()
-{
-    if (SurvivalComponent && SurvivalComponent->MaxHunger > 0)
+    if (UInteractionEventSubsystem* EventSubsystem = UInteractionEventSubsystem::Get(this))
     {
-        float HungerPercentage = SurvivalComponent->Hunger / SurvivalComponent->MaxHunger;
-        return FMath::Clamp(HungerPercentage, 0.0f, 1.0f); 
+        EventSubsystem->OnAnyHoverChanged.RemoveDynamic(this, &UBaseVRHUD::HandleHoverChanged);
+        EventSubsystem->OnAnyGrabbed.RemoveDynamic(this, &UBaseVRHUD::HandleGrabbed);
     }
 
-    return 0.0f; 
+    Super::NativeDestruct();
 }
 
-float UBaseVRHUD::GetThirstPercentage()
+void UBaseVRHUD::HandleHoverChanged(AVRGrabbableActor* HoveredActor, bool bIsHovered)
 {
-    if (SurvivalComponent && SurvivalComponent->MaxThirst > 0)
-    {
-        float ThirstPercentage = SurvivalComponent->Thirst / SurvivalComponent->MaxThirst;
-        return FMath::Clamp(ThirstPercentage, 0.0f, 1.0f);
-    }
+    // Nothing to hint for objects already in hand
+    OnInteractionHintChanged(HoveredActor, bIsHovered && HoveredActor && !HoveredActor->IsBeingHeld());
+    OnDisplayChanged.Broadcast();
+}
 
-    return 0.0f;
+void UBaseVRHUD::HandleGrabbed(AVRGrabbableActor* GrabbedActor, USkeletalMeshComponent* HandMesh)
+{
+    OnInteractionHintChanged(GrabbedActor, false);
+    OnDisplayChanged.Broadcast();
 }
 
+void UBaseVRHUD::HandleHungerChanged(float Percent)
+{
+    Hunger = Percent;
+    OnHungerDisplayChanged(Percent);
+    OnDisplayChanged.Broadcast();
+}
 
-FString UBaseVRHUD::GetTemperatureText() const
+void UBaseVRHUD::HandleThirstChanged(float Percent)
 {
-    if (SurvivalComponent)
-    {
-        int32 TempValue = FMath::RoundToInt(SurvivalComponent->Temperature);
-        return FString::Printf(TEXT("%dC"), TempValue);
-    }
-    return TEXT("0C");
+    Thirst = Percent;
+    OnThirstDisplayChanged(Percent);
+    OnDisplayChanged.Broadcast();
+}
+
+void UBaseVRHUD::HandleStaminaChanged(float Percent)
+{
+    Stamina = Percent;
+    OnStaminaDisplayChanged(Percent);
+    OnDisplayChanged.Broadcast();
 }
 
+void UBaseVRHUD::HandleTemperatureChanged(int32 Degrees, const FText& Text)
+{
+    Temperature = Degrees;
+    OnTemperatureDisplayChanged(Degrees, Text);
+    OnDisplayChanged.Broadcast();
+}
 
-float UBaseVRHUD::GetStaminaPercentage()
+float UBaseVRHUD::GetHungerPercentage()
 {
-    if (SurvivalComponent)
-    {
-        return SurvivalComponent->GetStaminaPercentage();
-    }
+    return ViewModel ? ViewModel->GetHungerPercent() : 0.0f;
+}
+
+float UBaseVRHUD::GetThirstPercentage()
+{
+    return ViewModel ? ViewModel->GetThirstPercent() : 0.0f;
+}
 
-    return 0.0f;
+
+FString UBaseVRHUD::GetTemperatureText() const
+{
+    return ViewModel ? ViewModel->GetTemperatureText().ToString() : FString(TEXT("0\u00B0C"));
 }
 
+
+float UBaseVRHUD::GetStaminaPercentage()
+{
+    return ViewModel ? ViewModel->GetStaminaPercent() : 0.0f;
+}
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HUD/SurvivalViewModel.h"
+
+#define LOCTEXT_NAMESPACE "SurvivalViewModel"
+
+int32 USurvivalViewModel::Quantize(float Value, float MaxValue)
+{
+    if (MaxValue <= 0.0f)
+        return 0;
+
+    return FMath::RoundToInt(FMath::Clamp(Value / MaxValue, 0.0f, 1.0f) * PercentSteps);
+}
+
+void USurvivalViewModel::SetHunger(float Value, float MaxValue)
+{
+    const int32 Steps = Quantize(Value, MaxValue);
+    if (Steps != HungerSteps)
+    {
+        HungerSteps = Steps;
+        OnHungerChanged.Broadcast(GetHungerPercent());
+    }
+}
+
+void USurvivalViewModel::SetThirst(float Value, float MaxValue)
+{
+    const int32 Steps = Quantize(Value, MaxValue);
+    if (Steps != ThirstSteps)
+    {
+        ThirstSteps = Steps;
+        OnThirstChanged.Broadcast(GetThirstPercent());
+    }
+}
+
+void USurvivalViewModel::SetStamina(float Value, float MaxValue)
+{
+    const int32 Steps = Quantize(Value, MaxValue);
+    if (Steps != StaminaSteps)
+    {
+        StaminaSteps = Steps;
+        OnStaminaChanged.Broadcast(GetStaminaPercent());
+    }
+}
+
+void USurvivalViewModel::SetTemperature(float Value)
+{
+    // The HUD shows whole degrees
+    const int32 Degrees = FMath::RoundToInt(Value);
+    if (Degrees != TemperatureDegrees)
+    {
+        TemperatureDegrees = Degrees;
+        TemperatureText = FText::Format(LOCTEXT("TemperatureFormat", "{0}\u00B0C"), FText::AsNumber(Degrees));
+        OnTemperatureChanged.Broadcast(TemperatureDegrees, TemperatureText);
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,218 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HUD/VRUILayerComponent.h"
+#include "HUD/BaseVRHUD.h"
+#include "Core/VRPerfCounters.h"
+#include "Blueprint/UserWidget.h"
+#include "Slate/WidgetRenderer.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "StereoRendering.h"
+#include "IStereoLayers.h"
+#include "ImageUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+    FAutoConsoleCommandWithWorldAndArgs DumpLayersCommand(
+        TEXT("VR.UI.DumpLayers"),
+        TEXT("Renders every VR UI layer offscreen and writes it as PNG. Usage: VR.UI.DumpLayers [OutputDir]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            const FString OutputDir = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("UILayers");
+
+            int32 DumpedCount = 0;
+            for (TObjectIterator<UVRUILayerComponent> It; It; ++It)
+            {
+                UVRUILayerComponent* Layer = *It;
+                if (Layer->GetWorld() != World || !Layer->GetWidget())
+                    continue;
+
+                const FString Filename = OutputDir / FString::Printf(TEXT("%s_%s.png"), *GetNameSafe(Layer->GetOwner()), *Layer->GetName());
+                if (Layer->DumpToPNG(Filename))
+                {
+                    ++DumpedCount;
+                }
+            }
+
+            UE_LOG(LogTemp, Display, TEXT("VRUILayer: Dumped %d layers to %s"), DumpedCount, *OutputDir);
+        }));
+}
+
+UVRUILayerComponent::UVRUILayerComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+
+    // Head locked like a HUD, the texture only changes when we redraw it
+    StereoLayerType = SLT_FaceLocked;
+    bLiveTexture = false;
+    SetRelativeLocation(FVector(100.0f, 0.0f, 0.0f));
+}
+
+void UVRUILayerComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (WidgetClass)
+    {
+        APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+        if (UUserWidget* NewWidget = CreateWidget<UUserWidget>(PlayerController, WidgetClass))
+        {
+            SetWidget(NewWidget);
+        }
+    }
+    else
+    {
+        SetVisibility(false);
+    }
+}
+
+void UVRUILayerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ClearWidget();
+
+    if (WidgetRenderer)
+    {
+        BeginCleanup(WidgetRenderer);
+        WidgetRenderer = nullptr;
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UVRUILayerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    TimeSinceDraw += DeltaTime;
+
+    // Drawn before the layer update below so the new texture is submitted this frame
+    if (bUsingStereoLayer && Widget && (bRedrawRequested || bAnimated))
+    {
+        if (DrawLayer(TimeSinceDraw))
+        {
+            MarkTextureForUpdate();
+        }
+    }
+
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+void UVRUILayerComponent::SetWidget(UUserWidget* InWidget, bool bInAnimated)
+{
+    if (Widget != InWidget)
+    {
+        ClearWidget();
+    }
+
+    if (!InWidget)
+        return;
+
+    Widget = InWidget;
+    bAnimated = bInAnimated;
+    bUsingStereoLayer = ShouldUseStereoLayer();
+
+    // The HUD tells us when something it shows moved, everything else redraws on request.
+    // Setting the same widget again keeps it, so its old binding goes first
+    if (UBaseVRHUD* HUD = Cast<UBaseVRHUD>(Widget))
+    {
+        HUD->OnDisplayChanged.Remove(DisplayChangedHandle);
+        DisplayChangedHandle = HUD->OnDisplayChanged.AddUObject(this, &UVRUILayerComponent::HandleDisplayChanged);
+    }
+
+    if (bUsingStereoLayer)
+    {
+        EnsureRenderTarget();
+        TimeSinceDraw = 0.0f;
+        bRedrawRequested = true;
+        SetVisibility(true);
+    }
+    else if (!Widget->IsInViewport())
+    {
+        Widget->AddToViewport(ViewportZOrder);
+    }
+}
+
+void UVRUILayerComponent::ClearWidget()
+{
+    SetVisibility(false);
+
+    if (!Widget)
+        return;
+
+    if (UBaseVRHUD* HUD = Cast<UBaseVRHUD>(Widget))
+    {
+        HUD->OnDisplayChanged.Remove(DisplayChangedHandle);
+    }
+    DisplayChangedHandle.Reset();
+
+    if (!bUsingStereoLayer)
+    {
+        Widget->RemoveFromParent();
+    }
+
+    Widget = nullptr;
+    bAnimated = false;
+    bRedrawRequested = false;
+}
+
+bool UVRUILayerComponent::DumpToPNG(const FString& Filename)
+{
+    if (!Widget)
+        return false;
+
+    EnsureRenderTarget();
+    if (!DrawLayer(0.0f))
+        return false;
+
+    TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*Filename));
+    if (!FileWriter)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("VRUILayer: Could not open %s for writing"), *Filename);
+        return false;
+    }
+
+    return FImageUtils::ExportRenderTarget2DAsPNG(RenderTarget, *FileWriter);
+}
+
+bool UVRUILayerComponent::ShouldUseStereoLayer() const
+{
+    if (!bUseStereoLayers || !GEngine || !GEngine->StereoRenderingDevice.IsValid())
+        return false;
+
+    return GEngine->StereoRenderingDevice->IsStereoEnabled() && GEngine->StereoRenderingDevice->GetStereoLayers() != nullptr;
+}
+
+void UVRUILayerComponent::EnsureRenderTarget()
+{
+    if (!WidgetRenderer)
+    {
+        WidgetRenderer = new FWidgetRenderer(true);
+    }
+
+    if (!RenderTarget)
+    {
+        RenderTarget = FWidgetRenderer::CreateTargetFor(FVector2D(DrawSize), TF_Bilinear, true);
+        RenderTarget->ClearColor = FLinearColor::Transparent;
+        SetTexture(RenderTarget);
+    }
+}
+
+bool UVRUILayerComponent::DrawLayer(float DeltaTime)
+{
+    // -nullrhi has no Slate renderer to draw with
+    if (!WidgetRenderer || !RenderTarget || !FSlateApplication::IsInitialized() || !FSlateApplication::Get().GetRenderer())
+        return false;
+
+    WidgetRenderer->DrawWidget(RenderTarget, Widget->TakeWidget(), FVector2D(DrawSize), DeltaTime);
+
+    bRedrawRequested = false;
+    TimeSinceDraw = 0.0f;
+
+    INC_DWORD_STAT(STAT_VRUILayerRedraws);
+    ++FVRPerfCounters::UILayerRedraws;
+    return true;
+}
@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Hands/VRHand.h"
+#include "ProjectSurvivalVR.h"
 #include "MotionControllerComponent.h"
 #include "Components/WidgetInteractionComponent.h"
 #include "Components/SphereComponent.h"
@@ -11,12 +12,17 @@
 #include "Structures/FingerData.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
 #include "Actors/VRClimbableActor.h"
+#include "Components/VRInventoryComponent.h"
+#include "Core/VRCollisionQuery.h"
+#include "Core/VRPhysicsState.h"
 
 TArray<AVRHand*> AVRHand::VRHands;
 
 AVRHand::AVRHand()
 {
+    // Switched on by TickDemand while an interactable is in grab range
     PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
 
     VROrigin = CreateDefaultSubobject<USceneComponent>("VROrigin");
     SetRootComponent(VROrigin);
@@ -92,6 +98,13 @@ void AVRHand::BeginPlay()
     SetupFingerAnimationData();
     VRHands.AddUnique(this);
 
+    // Reserve once so overlap churn while hovering never reallocates
+    OverlappingInteractables.Reserve(8);
+
+    TickDemand.Initialize(this, ETickReason::Hovering);
+    TickDemand.AddDependentComponent(WidgetInteraction, ETickReason::MenuOpen);
+    TickDemand.SetReason(ETickReason::MenuOpen, bAlwaysEnableWidgetInteraction);
+
     if (GrabSphere)
     {
         GrabSphere->OnComponentBeginOverlap.AddDynamic(this, &AVRHand::OnGrabSphereBeginOverlap);
@@ -101,10 +114,23 @@ void AVRHand::BeginPlay()
 
 void AVRHand::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    TickDemand.Reset();
     Super::EndPlay(EndPlayReason);
     VRHands.Remove(this);
 }
 
+void AVRHand::SetMenuOpen(bool bIsOpen)
+{
+    bMenuOpen = bIsOpen;
+    TickDemand.SetReason(ETickReason::MenuOpen, bIsOpen || bAlwaysEnableWidgetInteraction);
+}
+
+void AVRHand::HandleMenuInput()
+{
+    SetMenuOpen(!bMenuOpen);
+    ToggleMenu();
+}
+
 void AVRHand::OnConstruction(const FTransform& Transform)
 {
     Super::OnConstruction(Transform);
@@ -143,31 +169,44 @@ void AVRHand::Tick(float DeltaTime)
             if (NearbyGrabPoint.bIsAvailable)
             {
                 // Show grab point indicator (for snap grabs)
-                GrabPointIndicator->SetWorldLocation(NearbyGrabPoint.Location);
-                GrabPointIndicator->SetHiddenInGame(false);
+                SetGrabPointIndicatorLocation(NearbyGrabPoint.Location);
+                SetGrabPointIndicatorHidden(false);
                 CurrentTargetGrabPoint = NearbyGrabPoint.Type;
             }
             else
             {
                 // No grab point available, hide indicator (outline will show via OnHoverChanged for free grabs)
-                GrabPointIndicator->SetHiddenInGame(true);
+                SetGrabPointIndicatorHidden(true);
                 CurrentTargetGrabPoint = EGrabPointType::None;
             }
         }
         else // This means we are hovering over something else (like a VRClimbableActor) or are grabbing.
         {
             // Hide the grab point indicator because climbables don't use it.
-            GrabPointIndicator->SetHiddenInGame(true);
+            SetGrabPointIndicatorHidden(true);
             CurrentTargetGrabPoint = EGrabPointType::None;
         }
     }
     else // Not hovering over anything.
     {
-        GrabPointIndicator->SetHiddenInGame(true);
+        SetGrabPointIndicatorHidden(true);
         CurrentTargetGrabPoint = EGrabPointType::None;
     }
 }
 
+void AVRHand::SetGrabPointIndicatorHidden(bool bHidden)
+{
+    if (GrabPointIndicatorHidden.Update(bHidden))
+    {
+        GrabPointIndicator->SetHiddenInGame(bHidden);
+    }
+}
+
+void AVRHand::SetGrabPointIndicatorLocation(const FVector& Location)
+{
+    VRRenderState::SetWorldLocation(GrabPointIndicator, Location);
+}
+
 void AVRHand::SetupInputBindings()
 {
     APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
@@ -177,8 +216,8 @@ void AVRHand::SetupInputBindings()
     if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerController->InputComponent))
     {
         EnhancedInputComponent->BindAction(GrabPressed, ETriggerEvent::Triggered, this, &AVRHand::GrabObject);
-        EnhancedInputComponent->BindAction(GrabReleased, ETriggerEvent::Triggered, this, &AVRHand::ReleaseObject);
-        EnhancedInputComponent->BindAction(OpenMenu, ETriggerEvent::Triggered, this, &AVRHand::ToggleMenu);
+        EnhancedInputComponent->BindAction(GrabReleased, ETriggerEvent::Triggered, this, &AVRHand::ReleaseObjectFromInput);
+        EnhancedInputComponent->BindAction(OpenMenu, ETriggerEvent::Triggered, this, &AVRHand::HandleMenuInput);
     }
 }
 
@@ -203,7 +242,7 @@ FGrabPointInfo AVRHand::GetClosestAvailableGrabPoint(AVRGrabbableActor* Object)
     FVector HandLocation = HandOriginPoint->GetComponentLocation();
     bool bIsLeftHand = (HandType == EControllerHand::Left);
 
-    TArray<FGrabPointInfo> AvailablePoints;
+    // Candidates are compared as they are found, this runs every hovered frame so nothing is collected
 
     // Check main grab point
     if (Object->ShouldUseMainGrabPoint() && Object->HasMainGrabSocket(bIsLeftHand))
@@ -223,13 +262,17 @@ FGrabPointInfo AVRHand::GetClosestAvailableGrabPoint(AVRGrabbableActor* Object)
 
         if (bCanGrabMain)
         {
-            FGrabPointInfo MainInfo;
-            MainInfo.bIsAvailable = true;
-            MainInfo.Location = Object->GetMainGrabPointTransform().GetLocation();
-            MainInfo.Type = EGrabPointType::Main;
-            MainInfo.Distance = FVector::Distance(HandLocation, MainInfo.Location);
-            MainInfo.SocketTransform = Object->GetMainGrabSocketTransform(bIsLeftHand);
-            AvailablePoints.Add(MainInfo);
+            const FVector MainLocation = Object->GetMainGrabPointTransform().GetLocation();
+            const float MainDistance = FVector::Distance(HandLocation, MainLocation);
+
+            if (MainDistance < SnapRange && MainDistance < Result.Distance)
+            {
+                Result.bIsAvailable = true;
+                Result.Location = MainLocation;
+                Result.Type = EGrabPointType::Main;
+                Result.Distance = MainDistance;
+                Result.SocketTransform = Object->GetMainGrabSocketTransform(bIsLeftHand);
+            }
         }
     }
 
@@ -251,22 +294,17 @@ FGrabPointInfo AVRHand::GetClosestAvailableGrabPoint(AVRGrabbableActor* Object)
 
         if (bCanGrabSecondary)
         {
-            FGrabPointInfo SecondInfo;
-            SecondInfo.bIsAvailable = true;
-            SecondInfo.Location = Object->GetSecondaryGrabPointTransform().GetLocation();
-            SecondInfo.Type = EGrabPointType::Secondary;
-            SecondInfo.Distance = FVector::Distance(HandLocation, SecondInfo.Location);
-            SecondInfo.SocketTransform = Object->GetSecondaryGrabSocketTransform(bIsLeftHand);
-            AvailablePoints.Add(SecondInfo);
-        }
-    }
+            const FVector SecondLocation = Object->GetSecondaryGrabPointTransform().GetLocation();
+            const float SecondDistance = FVector::Distance(HandLocation, SecondLocation);
 
-    // Find closest point within snap range
-    for (const auto& Point : AvailablePoints)
-    {
-        if (Point.Distance < SnapRange && Point.Distance < Result.Distance)
-        {
-            Result = Point;
+            if (SecondDistance < SnapRange && SecondDistance < Result.Distance)
+            {
+                Result.bIsAvailable = true;
+                Result.Location = SecondLocation;
+                Result.Type = EGrabPointType::Secondary;
+                Result.Distance = SecondDistance;
+                Result.SocketTransform = Object->GetSecondaryGrabSocketTransform(bIsLeftHand);
+            }
         }
     }
 
@@ -283,6 +321,7 @@ void AVRHand::OnGrabSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent,
         if (!OverlappingInteractables.Contains(Interactable))
         {
             OverlappingInteractables.Add(Interactable);
+            TickDemand.AddReason(ETickReason::Hovering);
             UpdateHoveredGrabbable();
         }
     }
@@ -293,8 +332,16 @@ void AVRHand::OnGrabSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, A
 {
     if (OtherActor && OtherActor->Implements<UInteractable>())
     {
-        OverlappingInteractables.Remove(TScriptInterface<IInteractable>(OtherActor));
+        OverlappingInteractables.RemoveSingleSwap(TScriptInterface<IInteractable>(OtherActor), EAllowShrinking::No);
         UpdateHoveredGrabbable();
+
+        // Nothing left in range, the indicator is settled here since Tick stops with the last overlap
+        if (OverlappingInteractables.Num() == 0)
+        {
+            SetGrabPointIndicatorHidden(true);
+            CurrentTargetGrabPoint = EGrabPointType::None;
+            TickDemand.RemoveReason(ETickReason::Hovering);
+        }
     }
 }
 
@@ -307,7 +354,7 @@ void AVRHand::UpdateHoveredGrabbable()
         float ClosestDistance = FLT_MAX;
         FVector HandOriginLocation = HandOriginPoint->GetComponentLocation();
 
-        for (TScriptInterface<IInteractable> Interactable : OverlappingInteractables)
+        for (const TScriptInterface<IInteractable>& Interactable : OverlappingInteractables)
         {
             if (Interactable.GetInterface())
             {
@@ -315,7 +362,7 @@ void AVRHand::UpdateHoveredGrabbable()
                 if (CollisionComponent)
                 {
                     FVector ClosestPoint;
-                    CollisionComponent->GetClosestPointOnCollision(HandOriginLocation, ClosestPoint);
+                    VRCollisionQuery::GetClosestPointOnCollision(CollisionComponent, HandOriginLocation, ClosestPoint);
                     float Distance = FVector::Distance(HandOriginLocation, ClosestPoint);
 
                     if (Distance < ClosestDistance)
@@ -334,6 +381,7 @@ void AVRHand::UpdateHoveredGrabbable()
             if (HoveredInteractable.GetInterface())
             {
                 OnHoverCleared();
+                NotifyHoverEnd();
             }
 
             // Set new hover
@@ -341,6 +389,7 @@ void AVRHand::UpdateHoveredGrabbable()
 
             if (HoveredInteractable.GetInterface())
             {
+                HoveredInteractable->OnHoverBegin(HandMesh);
                 OnHoverChanged();
             }
         }
@@ -350,34 +399,58 @@ void AVRHand::UpdateHoveredGrabbable()
         if (HoveredInteractable.GetInterface())
         {
             OnHoverCleared();
+            NotifyHoverEnd();
             HoveredInteractable = nullptr;
         }
     }
 }
 
+void AVRHand::NotifyHoverEnd()
+{
+    // The hovered actor may already be gone, its interface pointer is only safe while the object is valid
+    if (IsValid(HoveredInteractable.GetObject()))
+    {
+        HoveredInteractable->OnHoverEnd(HandMesh);
+    }
+}
+
 void AVRHand::GrabObject()
 {
-    if (GrabbedActor || !HoveredInteractable)
+    if (GrabbedActor)
         return;
 
+    // Nothing in reach, the hand may be at a holster or over the shoulder
+    if (!HoveredInteractable)
+    {
+        AVRGrabbableActor* Withdrawn = WithdrawFromInventory();
+        if (!Withdrawn)
+            return;
+
+        HoveredInteractable = Withdrawn;
+    }
+
     // Handle climbing interactions
     AVRClimbableActor* ClimbableActor = Cast<AVRClimbableActor>(HoveredInteractable.GetObject());
     if (ClimbableActor)
     {
         bIsGrabbing = true;
-        GrabbedActor = TScriptInterface<IInteractable>(ClimbableActor);
-        GrabbedPrimitiveComponent = GrabbedActor->GetGrabCollisionComponent();
-        GrabPointIndicator->SetHiddenInGame(true);
+        GrabbedActor = HoveredInteractable;
+        GrabbedPrimitiveComponent = ClimbableActor->GetGrabCollisionComponent();
+        SetGrabPointIndicatorHidden(true);
         OnGrab();
         OnGrabClimbable(ClimbableActor);
 
-        // Freeze hand mesh at current position for climbing
+        // Freeze hand mesh at current position for climbing. The bodies keep simulating but are
+        // blended out and put to sleep, toggling simulation would recreate them on every grab.
+        // The simulate write is dropped while the hand already simulates, a counted one means churn
         if (HandMesh)
         {
             FrozenHandTransform = HandMesh->GetComponentTransform();
             HandMesh->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
-            HandMesh->SetAllBodiesBelowSimulatePhysics(RootBoneName, false);
-            UE_LOG(LogTemp, Warning, TEXT("VRHand: Hand mesh frozen at climbing position"));
+            VRPhysicsState::SetAllBodiesBelowSimulatePhysics(HandMesh, RootBoneName, true);
+            HandMesh->SetAllBodiesBelowPhysicsBlendWeight(RootBoneName, 0.0f);
+            HandMesh->PutAllRigidBodiesToSleep();
+            VR_INTERACTION_LOG(Warning, TEXT("VRHand: Hand mesh frozen at climbing position"));
         }
 
         // Register climb interaction with character controller
@@ -395,7 +468,7 @@ void AVRHand::GrabObject()
 
         TraceFingerData();
 
-        UE_LOG(LogTemp, Warning, TEXT("VRHand: Climbing grab setup complete"));
+        VR_INTERACTION_LOG(Warning, TEXT("VRHand: Climbing grab setup complete"));
         return;
     }
 
@@ -404,12 +477,12 @@ void AVRHand::GrabObject()
     if (!IsValid(TargetGrabbable))
     {
         UE_LOG(LogTemp, Error, TEXT("TargetGrabbable is invalid!"));
+        NotifyHoverEnd();
         HoveredInteractable = nullptr;
         return;
     }
 
-    TScriptInterface<IInteractable> InteractableObject(TargetGrabbable);
-    UPrimitiveComponent* ObjectPhysicsComponent = InteractableObject->GetPhysicsComponent();
+    UPrimitiveComponent* ObjectPhysicsComponent = TargetGrabbable->GetPhysicsComponent();
     if (!ObjectPhysicsComponent)
     {
         UE_LOG(LogTemp, Error, TEXT("No physics component found on grabbable object"));
@@ -424,13 +497,13 @@ void AVRHand::GrabObject()
     // Validate grab attempt against object state rules
     EGrabState CurrentObjectState = TargetGrabbable->GetCurrentGrabState();
 
-    UE_LOG(LogTemp, Warning, TEXT("Attempting grab - Will Snap: %s, Target Point: %d, Object State: %d"),
+    VR_INTERACTION_LOG(Warning, TEXT("Attempting grab - Will Snap: %s, Target Point: %d, Object State: %d"),
         bWillSnap ? TEXT("YES") : TEXT("NO"), (int32)GrabPointTypeForAttempt, (int32)CurrentObjectState);
 
     // Enforce grab state restrictions
     if (CurrentObjectState == EGrabState::SnapGrab && !bWillSnap)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Free grab rejected - object is snap grabbed"));
+        VR_INTERACTION_LOG(Warning, TEXT("Free grab rejected - object is snap grabbed"));
         return;
     }
 
@@ -457,9 +530,9 @@ void AVRHand::GrabObject()
 
     // Initialize grab state
     bIsGrabbing = true;
-    GrabbedActor = InteractableObject;
-    GrabbedPrimitiveComponent = GrabbedActor->GetGrabCollisionComponent();
-    GrabPointIndicator->SetHiddenInGame(true);
+    GrabbedActor = HoveredInteractable;
+    GrabbedPrimitiveComponent = TargetGrabbable->GetGrabCollisionComponent();
+    SetGrabPointIndicatorHidden(true);
     OnGrab();
     OnGrabGrabbable(TargetGrabbable);
 
@@ -467,7 +540,7 @@ void AVRHand::GrabObject()
     bool bIsLeftHand = (HandType == EControllerHand::Left);
     ECollisionChannel HandChannel = HandMesh->GetCollisionObjectType();
 
-    InteractableObject->OnGrab(HandMesh, HandMesh->GetComponentLocation(), bIsLeftHand, HandChannel);
+    TargetGrabbable->OnGrab(HandMesh, HandMesh->GetComponentLocation(), bIsLeftHand, HandChannel);
 
     // Execute unified grab with conflict resolution
     TargetGrabbable->OnUnifiedGrab(HandMesh, bIsLeftHand, bWillSnap, GrabPointTypeForAttempt);
@@ -475,7 +548,7 @@ void AVRHand::GrabObject()
     // Validate grab acceptance
     if (!TargetGrabbable->IsBeingHeld())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Grab was rejected by object - cleaning up"));
+        VR_INTERACTION_LOG(Warning, TEXT("Grab was rejected by object - cleaning up"));
 
         // Cleanup failed grab attempt
         bIsGrabbing = false;
@@ -499,9 +572,13 @@ void AVRHand::GrabObject()
         true
     );
 
-    TraceFingerData();
+    // Snap grabs use the baked grasp when available, free grabs always trace
+    if (!bWillSnap || !ApplyBakedGrasp(TargetGrabbable, GrabPointTypeForAttempt))
+    {
+        TraceFingerData();
+    }
 
-    UE_LOG(LogTemp, Display, TEXT("Grab complete - Hand: %s, Snapping: %s, Type: %d"),
+    VR_INTERACTION_LOG(Display, TEXT("Grab complete - Hand: %s, Snapping: %s, Type: %d"),
         *GetName(), bWillSnap ? TEXT("YES") : TEXT("NO"), (int32)GrabPointTypeForAttempt);
 }
 
@@ -541,7 +618,7 @@ void AVRHand::SetupGrabConstraint(UPrimitiveComponent* ObjectPhysicsComponent, b
     GrabConstraint->SetAngularVelocityDrive(true, true);
     GrabConstraint->SetAngularDriveParams(AngularStrength, AngularDamping, 0.0f);
 
-    UE_LOG(LogTemp, Display, TEXT("Grab constraint setup - Snapping: %s"), bIsSnapping ? TEXT("YES") : TEXT("NO"));
+    VR_INTERACTION_LOG(Display, TEXT("Grab constraint setup - Snapping: %s"), bIsSnapping ? TEXT("YES") : TEXT("NO"));
 }
 
 void AVRHand::ReleaseObject()
@@ -549,7 +626,7 @@ void AVRHand::ReleaseObject()
     if (!GrabbedActor.GetObject())
         return;
 
-    UE_LOG(LogTemp, Warning, TEXT("VRHand: Releasing object with %s hand"),
+    VR_INTERACTION_LOG(Warning, TEXT("VRHand: Releasing object with %s hand"),
         (HandType == EControllerHand::Left) ? TEXT("LEFT") : TEXT("RIGHT"));
 
     OnRelease();
@@ -565,17 +642,21 @@ void AVRHand::ReleaseObject()
 
     if (ClimbableActor)
     {
-        // For climbing, just re-enable physics on the hand mesh.
-        // The hand will snap back to the motion controller's position.
+        // For climbing, snap the hand back to the motion controller and wake its bodies.
+        // Teleporting first carries the sleeping bodies along, attaching alone would leave them behind.
+        FTransform ControllerTransform = MotionController->GetSocketTransform(RootBoneName);
+        ControllerTransform.SetScale3D(HandMesh->GetComponentScale());
+        HandMesh->SetWorldTransform(ControllerTransform, false, nullptr, ETeleportType::TeleportPhysics);
 
         HandMesh->AttachToComponent(MotionController, FAttachmentTransformRules::SnapToTargetNotIncludingScale, RootBoneName);
-        HandMesh->SetAllBodiesBelowSimulatePhysics(RootBoneName, true);
+        VRPhysicsState::SetAllBodiesBelowSimulatePhysics(HandMesh, RootBoneName, true);
         HandMesh->SetAllBodiesBelowPhysicsBlendWeight(RootBoneName, PhysicsBlendWeight);
+        HandMesh->WakeAllRigidBodies();
     }
     else if (GrabbableActor)
     {
         // Break physics constraint for grabbable objects
-        UE_LOG(LogTemp, VeryVerbose, TEXT("VRHand: Breaking physics constraint for grabbable"));
+        VR_INTERACTION_LOG(VeryVerbose, TEXT("VRHand: Breaking physics constraint for grabbable"));
         GrabConstraint->BreakConstraint();
     }
 
@@ -590,8 +671,41 @@ void AVRHand::ReleaseObject()
     FingerData.Middle = 0.0f;
     FingerData.Ring = 0.0f;
     FingerData.Pinky = 0.0f;
+    ActiveGrabAnimation.Reset();
 
-    UE_LOG(LogTemp, Warning, TEXT("VRHand: Release complete"));
+    VR_INTERACTION_LOG(Warning, TEXT("VRHand: Release complete"));
+}
+
+void AVRHand::ReleaseObjectFromInput()
+{
+    AVRGrabbableActor* GrabbableActor = Cast<AVRGrabbableActor>(GrabbedActor.GetObject());
+
+    ReleaseObject();
+
+    // Only the last hand to let go stores it, forced releases never do
+    if (GrabbableActor && !GrabbableActor->IsBeingHeld())
+    {
+        if (UVRInventoryComponent* Inventory = GetInventory())
+        {
+            Inventory->TryStore(GrabbableActor, HandOriginPoint->GetComponentLocation());
+        }
+    }
+}
+
+AVRGrabbableActor* AVRHand::WithdrawFromInventory()
+{
+    UVRInventoryComponent* Inventory = GetInventory();
+    if (!Inventory)
+        return nullptr;
+
+    const FTransform HandTransform(HandOriginPoint->GetComponentQuat(), HandOriginPoint->GetComponentLocation());
+    return Inventory->TryWithdraw(HandTransform.GetLocation(), HandTransform);
+}
+
+UVRInventoryComponent* AVRHand::GetInventory() const
+{
+    // Hands are spawned with the character as owner
+    return GetOwner() ? GetOwner()->FindComponentByClass<UVRInventoryComponent>() : nullptr;
 }
 
 bool AVRHand::IsClimbing() const
@@ -619,7 +733,7 @@ void AVRHand::CheckHandControllerDistance()
 
         if (Distance > EffectiveThreshold)
         {
-            UE_LOG(LogTemp, Display, TEXT("Auto-release: %.2f > %.2f"), Distance, EffectiveThreshold);
+            VR_INTERACTION_LOG(Display, TEXT("Auto-release: %.2f > %.2f"), Distance, EffectiveThreshold);
             ReleaseObject();
         }
     }
@@ -732,22 +846,80 @@ TArray<FVector> AVRHand::GetFingerSteps(USplineComponent* FingerSpline)
 
 void AVRHand::TraceFingerData()
 {
-    FingerData.Thumb = TraceFingerSegment(FingerCache_Thumb);
-    FingerData.Index = TraceFingerSegment(FingerCache_Index);
-    FingerData.Middle = TraceFingerSegment(FingerCache_Middle);
-    FingerData.Ring = TraceFingerSegment(FingerCache_Ring);
-    FingerData.Pinky = TraceFingerSegment(FingerCache_Pinky);
+    const FTransform HandTransform = HandMesh->GetComponentTransform();
+
+    FingerData.Thumb = TraceFingerSegment(FingerCache_Thumb, HandTransform, GrabbedPrimitiveComponent);
+    FingerData.Index = TraceFingerSegment(FingerCache_Index, HandTransform, GrabbedPrimitiveComponent);
+    FingerData.Middle = TraceFingerSegment(FingerCache_Middle, HandTransform, GrabbedPrimitiveComponent);
+    FingerData.Ring = TraceFingerSegment(FingerCache_Ring, HandTransform, GrabbedPrimitiveComponent);
+    FingerData.Pinky = TraceFingerSegment(FingerCache_Pinky, HandTransform, GrabbedPrimitiveComponent);
+}
+
+bool AVRHand::ApplyBakedGrasp(const AVRGrabbableActor* GrabbableActor, EGrabPointType GrabPointType)
+{
+    if (!GrabbableActor || GrabPointType == EGrabPointType::None)
+        return false;
+
+    const FGrabPointData& GrabData = GrabbableActor->GetGrabPointData(GrabPointType);
+    if (!GrabData.BakedGrasp.bIsBaked)
+        return false;
+
+    FingerData = GrabData.BakedGrasp.GetFingerData(HandType == EControllerHand::Left);
+    ActiveGrabAnimation = GrabData.GrabAnimation;
+    return true;
+}
+
+#if WITH_EDITOR
+FFingerData AVRHand::ComputeGraspAgainst(UPrimitiveComponent* TargetComponent, const FTransform& GripWorldTransform)
+{
+    FFingerData Result;
+    if (!TargetComponent || !HandMesh)
+        return Result;
+
+    // Outside of play the splines are still alive, build the caches from them once
+    if (FingerCache_Thumb.Num() == 0 && Spline_Thumb && Spline_Index && Spline_Middle && Spline_Ring && Spline_Pinky)
+    {
+        FingerCache_Thumb = GetFingerSteps(Spline_Thumb);
+        FingerCache_Index = GetFingerSteps(Spline_Index);
+        FingerCache_Middle = GetFingerSteps(Spline_Middle);
+        FingerCache_Ring = GetFingerSteps(Spline_Ring);
+        FingerCache_Pinky = GetFingerSteps(Spline_Pinky);
+    }
+
+    // Place the hand so its grip socket matches the grab point, the same alignment a snap grab produces
+    const FTransform SocketToComponent = HandMesh->GetSocketTransform(GetHandGripSocketName(), RTS_Component);
+    const FTransform HandTransform = SocketToComponent.Inverse() * GripWorldTransform;
+
+    Result.Thumb = TraceFingerSegment(FingerCache_Thumb, HandTransform, TargetComponent);
+    Result.Index = TraceFingerSegment(FingerCache_Index, HandTransform, TargetComponent);
+    Result.Middle = TraceFingerSegment(FingerCache_Middle, HandTransform, TargetComponent);
+    Result.Ring = TraceFingerSegment(FingerCache_Ring, HandTransform, TargetComponent);
+    Result.Pinky = TraceFingerSegment(FingerCache_Pinky, HandTransform, TargetComponent);
+    return Result;
 }
+#endif
 
-float AVRHand::TraceFingerSegment(TArray<FVector> FingerCacheArray)
+float AVRHand::TraceFingerSegment(const TArray<FVector>& FingerCacheArray, const FTransform& HandTransform, UPrimitiveComponent* TargetComponent) const
 {
-    if (!GrabbedPrimitiveComponent)
+    if (!TargetComponent)
     {
         return 1.0f;
     }
 
     float BendValue = 0.0f;
-    FTransform HandTransform = HandMesh->GetComponentTransform();
+
+    FCollisionQueryParams Params;
+    Params.AddIgnoredActor(this);
+    Params.bTraceComplex = true;
+
+    FHitResult HitResult;
+
+    // Climbables with a bake are traced against their box proxies instead of the complex mesh
+    const AVRClimbableActor* ProxyClimbable = Cast<AVRClimbableActor>(TargetComponent->GetOwner());
+    if (ProxyClimbable && (!ProxyClimbable->HasHandProxies() || ProxyClimbable->GetActorMesh() != TargetComponent))
+    {
+        ProxyClimbable = nullptr;
+    }
 
     for (int32 i = 0; i < FingerCacheArray.Num() - 1; i++)
     {
@@ -757,23 +929,29 @@ float AVRHand::TraceFingerSegment(TArray<FVector> FingerCacheArray)
         FVector Start = HandTransform.TransformPosition(StartLocal);
         FVector End = HandTransform.TransformPosition(EndLocal);
 
-        FCollisionQueryParams Params;
-        Params.AddIgnoredActor(this);
-        Params.bTraceComplex = true;
+        float HitTime = 0.0f;
+        bool bHit = false;
 
-        FHitResult HitResult;
-
-        bool bHit = GrabbedPrimitiveComponent->LineTraceComponent(
-            HitResult,
-            Start,
-            End,
-            Params
-        );
+        if (ProxyClimbable)
+        {
+            bHit = ProxyClimbable->LineTraceHandProxies(Start, End, HitTime);
+        }
+        else
+        {
+            bHit = VRCollisionQuery::LineTraceComponent(
+                TargetComponent,
+                HitResult,
+                Start,
+                End,
+                Params
+            );
+            HitTime = HitResult.Time;
+        }
 
         if (bHit)
         {
             BendValue = static_cast<float>(i) / static_cast<float>(FingerCacheArray.Num() - 1);
-            float SegmentFraction = HitResult.Time;
+            float SegmentFraction = HitTime;
             float SegmentContribution = 1.0f / static_cast<float>(FingerCacheArray.Num() - 1);
             BendValue += SegmentContribution * SegmentFraction;
             break;
@@ -786,4 +964,4 @@ float AVRHand::TraceFingerSegment(TArray<FVector> FingerCacheArray)
     }
 
     return BendValue;
-}
\ No newline at end of file
+}
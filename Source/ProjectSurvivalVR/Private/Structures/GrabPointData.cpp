@@ -1 +1,46 @@
-// Fill out your copyright notice in the Description page of Project Settings.
\ No newline at end of file
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Structures/GrabPointData.h"
+
+namespace
+{
+	uint8 QuantizeCurl(float Curl)
+	{
+		return static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Curl, 0.0f, 1.0f) * 255.0f));
+	}
+
+	float DequantizeCurl(uint8 Curl)
+	{
+		return static_cast<float>(Curl) / 255.0f;
+	}
+}
+
+FBakedGrasp::FBakedGrasp()
+{
+	FMemory::Memzero(LeftHandCurls);
+	FMemory::Memzero(RightHandCurls);
+}
+
+FFingerData FBakedGrasp::GetFingerData(bool bIsLeftHand) const
+{
+	const uint8* Curls = bIsLeftHand ? LeftHandCurls : RightHandCurls;
+
+	FFingerData Result;
+	Result.Thumb = DequantizeCurl(Curls[0]);
+	Result.Index = DequantizeCurl(Curls[1]);
+	Result.Middle = DequantizeCurl(Curls[2]);
+	Result.Ring = DequantizeCurl(Curls[3]);
+	Result.Pinky = DequantizeCurl(Curls[4]);
+	return Result;
+}
+
+void FBakedGrasp::SetFingerData(bool bIsLeftHand, const FFingerData& InFingerData)
+{
+	uint8* Curls = bIsLeftHand ? LeftHandCurls : RightHandCurls;
+
+	Curls[0] = QuantizeCurl(InFingerData.Thumb);
+	Curls[1] = QuantizeCurl(InFingerData.Index);
+	Curls[2] = QuantizeCurl(InFingerData.Middle);
+	Curls[3] = QuantizeCurl(InFingerData.Ring);
+	Curls[4] = QuantizeCurl(InFingerData.Pinky);
+}
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Structures/VRConstructionRecipe.h"
+#include "Actors/VRGrabbableActor.h"
+
+int32 UVRConstructionRecipe::GetCapacity(int32 InputIndex) const
+{
+	if (!Inputs.IsValidIndex(InputIndex))
+		return 0;
+
+	return FMath::Max(Inputs[InputIndex].Slots.Num(), Inputs[InputIndex].RequiredCount);
+}
+
+int32 UVRConstructionRecipe::FindInputIndex(const UClass* ItemClass) const
+{
+	if (!ItemClass)
+		return INDEX_NONE;
+
+	for (int32 InputIndex = 0; InputIndex < GetInputCount(); ++InputIndex)
+	{
+		if (Inputs[InputIndex].ItemClass && ItemClass->IsChildOf(Inputs[InputIndex].ItemClass))
+			return InputIndex;
+	}
+
+	return INDEX_NONE;
+}
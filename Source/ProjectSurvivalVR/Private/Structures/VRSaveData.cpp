@@ -0,0 +1,321 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Structures/VRSaveData.h"
+
+namespace
+{
+	// Smallest each element can be on disk, names and strings are at least their length
+	constexpr int64 MinStringSize = sizeof(int32);
+	constexpr int64 MinItemSize = sizeof(uint16) + 10 * sizeof(double) + sizeof(float) + sizeof(int32);
+	constexpr int64 MinFireSize = MinStringSize + sizeof(float) + sizeof(uint32);
+	constexpr int64 MinCellDeltaSize = sizeof(FIntPoint) + sizeof(int32);
+	constexpr int64 MinLevelSize = MinStringSize + 4 * sizeof(int32);
+	constexpr int64 MinForageCellSize = sizeof(FIntPoint) + sizeof(uint16) + sizeof(int32);
+	constexpr int64 MinForageSize = MinStringSize + sizeof(int32);
+	constexpr int64 MinBuildSiteSize = 2 * MinStringSize + sizeof(int32);
+	constexpr int64 MinInventoryItemSize = MinStringSize + sizeof(int32) + sizeof(float) + sizeof(int32);
+
+	// Reads or writes an element count. A loaded count the bytes left could not hold fails the archive,
+	// so a corrupt file is rejected before anything is allocated for it
+	bool SerializeCount(FArchive& Ar, int32& Count, int64 MinElementSize)
+	{
+		Ar << Count;
+		if (Ar.IsLoading() && (Count < 0 || Count * MinElementSize > Ar.TotalSize() - Ar.Tell()))
+		{
+			Ar.SetError();
+			Count = 0;
+		}
+		return !Ar.IsError();
+	}
+}
+
+void FVRSavedItem::Serialize(FArchive& Ar, int32 Version)
+{
+	Ar << ClassIndex;
+	Ar << Transform;
+	Ar << StateValue;
+	Ar << StateFlags;
+}
+
+void FVRSavedFire::Serialize(FArchive& Ar, int32 Version)
+{
+	Ar << FireplaceName;
+	Ar << FuelMass;
+	Ar << bLit;
+}
+
+void FVRSavedForageCell::Serialize(FArchive& Ar, int32 Version)
+{
+	Ar << DepletedMask;
+
+	// Older saves kept one time for the whole cell
+	if (Version < static_cast<int32>(EVRSaveVersion::ForageSlotRespawn))
+	{
+		float RespawnHour = 0.0f;
+		Ar << RespawnHour;
+		RespawnHours.Init(RespawnHour, sizeof(DepletedMask) * 8);
+		return;
+	}
+
+	int32 SlotCount = RespawnHours.Num();
+	if (!SerializeCount(Ar, SlotCount, sizeof(float)))
+		return;
+
+	if (Ar.IsLoading())
+	{
+		RespawnHours.SetNum(SlotCount);
+	}
+	for (float& RespawnHour : RespawnHours)
+	{
+		Ar << RespawnHour;
+	}
+}
+
+void FVRSavedForage::Serialize(FArchive& Ar, int32 Version)
+{
+	Ar << SpawnerName;
+
+	int32 CellCount = Cells.Num();
+	if (!SerializeCount(Ar, CellCount, MinForageCellSize))
+		return;
+
+	if (Ar.IsLoading())
+	{
+		Cells.Reset();
+		Cells.Reserve(CellCount);
+		for (int32 Index = 0; Index < CellCount; ++Index)
+		{
+			FIntPoint Cell;
+			Ar << Cell;
+			Cells.Add(Cell).Serialize(Ar, Version);
+		}
+	}
+	else
+	{
+		for (TPair<FIntPoint, FVRSavedForageCell>& Pair : Cells)
+		{
+			Ar << Pair.Key;
+			Pair.Value.Serialize(Ar, Version);
+		}
+	}
+}
+
+void FVRSavedBuildSite::Serialize(FArchive& Ar, int32 Version)
+{
+	Ar << OwnerName;
+	Ar << SiteName;
+
+	int32 InputCount = PlacedCounts.Num();
+	if (!SerializeCount(Ar, InputCount, sizeof(int32)))
+		return;
+
+	if (Ar.IsLoading())
+	{
+		PlacedCounts.SetNum(InputCount);
+	}
+	for (int32& Count : PlacedCounts)
+	{
+		Ar << Count;
+	}
+}
+
+void FVRCellDelta::Serialize(FArchive& Ar, int32 Version)
+{
+	int32 ItemCount = Items.Num();
+	if (!SerializeCount(Ar, ItemCount, MinItemSize))
+		return;
+
+	if (Ar.IsLoading())
+	{
+		Items.SetNum(ItemCount);
+	}
+
+	for (FVRSavedItem& Item : Items)
+	{
+		Item.Serialize(Ar, Version);
+	}
+}
+
+void FVRLevelSave::Serialize(FArchive& Ar, int32 Version)
+{
+	// Same layout as the engine's container operators, counted by hand so they are checked like the rest
+	int32 ClassPathCount = ClassPaths.Num();
+	if (!SerializeCount(Ar, ClassPathCount, MinStringSize))
+		return;
+
+	if (Ar.IsLoading())
+	{
+		ClassPaths.SetNum(ClassPathCount);
+	}
+	for (FString& ClassPath : ClassPaths)
+	{
+		Ar << ClassPath;
+	}
+
+	int32 RemovedCount = RemovedPlacedActors.Num();
+	if (!SerializeCount(Ar, RemovedCount, MinStringSize))
+		return;
+
+	if (Ar.IsLoading())
+	{
+		RemovedPlacedActors.Reset();
+		RemovedPlacedActors.Reserve(RemovedCount);
+		for (int32 Index = 0; Index < RemovedCount; ++Index)
+		{
+			FName ActorName;
+			Ar << ActorName;
+			RemovedPlacedActors.Add(ActorName);
+		}
+	}
+	else
+	{
+		for (FName& ActorName : RemovedPlacedActors)
+		{
+			Ar << ActorName;
+		}
+	}
+
+	int32 FireCount = Fires.Num();
+	if (!SerializeCount(Ar, FireCount, MinFireSize))
+		return;
+
+	if (Ar.IsLoading())
+	{
+		Fires.SetNum(FireCount);
+	}
+	for (FVRSavedFire& Fire : Fires)
+	{
+		Fire.Serialize(Ar, Version);
+	}
+
+	int32 CellCount = Cells.Num();
+	if (!SerializeCount(Ar, CellCount, MinCellDeltaSize))
+		return;
+
+	if (Ar.IsLoading())
+	{
+		Cells.Reset();
+		Cells.Reserve(CellCount);
+		for (int32 Index = 0; Index < CellCount; ++Index)
+		{
+			FIntPoint Cell;
+			Ar << Cell;
+			Cells.Add(Cell).Serialize(Ar, Version);
+		}
+	}
+	else
+	{
+		for (TPair<FIntPoint, FVRCellDelta>& Pair : Cells)
+		{
+			Ar << Pair.Key;
+			Pair.Value.Serialize(Ar, Version);
+		}
+	}
+
+	if (Version >= static_cast<int32>(EVRSaveVersion::Forage))
+	{
+		int32 ForageCount = Forage.Num();
+		if (!SerializeCount(Ar, ForageCount, MinForageSize))
+			return;
+
+		if (Ar.IsLoading())
+		{
+			Forage.SetNum(ForageCount);
+		}
+		for (FVRSavedForage& Spawner : Forage)
+		{
+			Spawner.Serialize(Ar, Version);
+		}
+	}
+
+	if (Version >= static_cast<int32>(EVRSaveVersion::BuildSites))
+	{
+		int32 BuildSiteCount = BuildSites.Num();
+		if (!SerializeCount(Ar, BuildSiteCount, MinBuildSiteSize))
+			return;
+
+		if (Ar.IsLoading())
+		{
+			BuildSites.SetNum(BuildSiteCount);
+		}
+		for (FVRSavedBuildSite& BuildSite : BuildSites)
+		{
+			BuildSite.Serialize(Ar, Version);
+		}
+	}
+}
+
+void FVRSurvivalSave::Serialize(FArchive& Ar, int32 Version)
+{
+	Ar << Hunger;
+	Ar << Thirst;
+	Ar << Temperature;
+	Ar << Stamina;
+}
+
+void FVRSavedInventoryItem::Serialize(FArchive& Ar, int32 Version)
+{
+	Ar << ClassPath;
+	Ar << Quantity;
+	Ar << StateValue;
+	Ar << StateFlags;
+}
+
+void FVRInventorySave::Serialize(FArchive& Ar, int32 Version)
+{
+	for (TArray<FVRSavedInventoryItem>* Items : { &Holsters, &Backpack })
+	{
+		int32 ItemCount = Items->Num();
+		if (!SerializeCount(Ar, ItemCount, MinInventoryItemSize))
+			return;
+
+		if (Ar.IsLoading())
+		{
+			Items->SetNum(ItemCount);
+		}
+		for (FVRSavedInventoryItem& Item : *Items)
+		{
+			Item.Serialize(Ar, Version);
+		}
+	}
+}
+
+void FVRSaveGame::Serialize(FArchive& Ar)
+{
+	Ar << Version;
+
+	Ar << bHasPlayerState;
+	Survival.Serialize(Ar, Version);
+
+	if (Version >= static_cast<int32>(EVRSaveVersion::Inventory))
+	{
+		Inventory.Serialize(Ar, Version);
+	}
+
+	Ar << CurrentHour;
+	Ar << TotalGameHours;
+
+	int32 LevelCount = Levels.Num();
+	if (!SerializeCount(Ar, LevelCount, MinLevelSize))
+		return;
+
+	if (Ar.IsLoading())
+	{
+		Levels.Reset();
+		Levels.Reserve(LevelCount);
+		for (int32 Index = 0; Index < LevelCount; ++Index)
+		{
+			FString LevelName;
+			Ar << LevelName;
+			Levels.Add(LevelName).Serialize(Ar, Version);
+		}
+	}
+	else
+	{
+		for (TPair<FString, FVRLevelSave>& Pair : Levels)
+		{
+			Ar << Pair.Key;
+			Pair.Value.Serialize(Ar, Version);
+		}
+	}
+}
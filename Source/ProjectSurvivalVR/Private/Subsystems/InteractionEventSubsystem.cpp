@@ -0,0 +1,10 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/InteractionEventSubsystem.h"
+#include "Engine/World.h"
+
+UInteractionEventSubsystem* UInteractionEventSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UInteractionEventSubsystem>() : nullptr;
+}
@@ -0,0 +1,177 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRCheckpointSubsystem.h"
+#include "Subsystems/VRWorldSaveSubsystem.h"
+#include "Characters/VRCharacterBase.h"
+#include "Components/SurvivalComponent.h"
+#include "Components/VRInventoryComponent.h"
+#include "Environment/DayNightManager.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+
+UVRCheckpointSubsystem* UVRCheckpointSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVRCheckpointSubsystem>() : nullptr;
+}
+
+bool UVRCheckpointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UVRCheckpointSubsystem::Deinitialize()
+{
+	Checkpoints.Empty();
+	bCapturing = false;
+
+	Super::Deinitialize();
+}
+
+TStatId UVRCheckpointSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRCheckpointSubsystem, STATGROUP_Tickables);
+}
+
+void UVRCheckpointSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (CheckpointInterval <= 0.0f || MaxCheckpoints <= 0)
+		return;
+
+	AVRCharacterBase* Character = Cast<AVRCharacterBase>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+	if (!Character)
+		return;
+
+	TimeSinceCheckpoint += DeltaTime;
+	SafeTime = IsPlayerSafe(Character) ? SafeTime + DeltaTime : 0.0f;
+
+	if (!bCapturing && TimeSinceCheckpoint >= CheckpointInterval && SafeTime >= SafeGroundedSeconds)
+	{
+		BeginCheckpoint(Character);
+	}
+}
+
+bool UVRCheckpointSubsystem::IsPlayerSafe(const AVRCharacterBase* Character) const
+{
+	const UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+	return !Character->HasDied()
+		&& Character->GetMovementState() == EVRMovementState::Locomotion
+		&& Movement && Movement->IsMovingOnGround();
+}
+
+void UVRCheckpointSubsystem::BeginCheckpoint(AVRCharacterBase* Character)
+{
+	UVRWorldSaveSubsystem* WorldSave = UVRWorldSaveSubsystem::Get(this);
+	if (!WorldSave)
+		return;
+
+	// Busy with an autosave, try again next frame
+	if (!WorldSave->RequestCapture(FOnLevelCaptured::CreateUObject(this, &UVRCheckpointSubsystem::OnLevelCaptured)))
+		return;
+
+	bCapturing = true;
+	TimeSinceCheckpoint = 0.0f;
+
+	// The player is taken now, while it is known to be safe, the level follows over the next frames
+	PendingCheckpoint = FVRCheckpoint();
+	PendingCheckpoint.PlayerTransform = Character->GetActorTransform();
+	PendingCheckpoint.ControlRotation = Character->GetControlRotation();
+
+	if (const USurvivalComponent* Survival = Character->FindComponentByClass<USurvivalComponent>())
+	{
+		PendingCheckpoint.Survival.Hunger = Survival->Hunger;
+		PendingCheckpoint.Survival.Thirst = Survival->Thirst;
+		PendingCheckpoint.Survival.Temperature = Survival->Temperature;
+		PendingCheckpoint.Survival.Stamina = Survival->Stamina;
+	}
+
+	// Carried items are part of the player, restoring the level alone would duplicate or lose them
+	if (const UVRInventoryComponent* Inventory = Character->GetInventory())
+	{
+		Inventory->SaveInventory(PendingCheckpoint.Inventory);
+	}
+
+	if (const ADayNightManager* DayNightManager = ADayNightManager::GetInstance(GetWorld()))
+	{
+		PendingCheckpoint.CurrentHour = DayNightManager->GetCurrentHour();
+		PendingCheckpoint.TotalGameHours = DayNightManager->GetTotalGameHours();
+	}
+}
+
+void UVRCheckpointSubsystem::OnLevelCaptured(FVRLevelSave& LevelState)
+{
+	bCapturing = false;
+
+	// Died while the level was being captured, the level half of it may already show the death
+	const AVRCharacterBase* Character = Cast<AVRCharacterBase>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+	if (!Character || Character->HasDied())
+		return;
+
+	PendingCheckpoint.World = MoveTemp(LevelState);
+
+	if (Checkpoints.Num() >= MaxCheckpoints)
+	{
+		Checkpoints.RemoveAt(0, Checkpoints.Num() - MaxCheckpoints + 1, EAllowShrinking::No);
+	}
+	Checkpoints.Add(MoveTemp(PendingCheckpoint));
+	PendingCheckpoint = FVRCheckpoint();
+}
+
+bool UVRCheckpointSubsystem::RestoreCheckpoint(int32 StepsBack, FTransform& OutTransform, FRotator& OutControlRotation)
+{
+	const int32 CheckpointIndex = Checkpoints.Num() - 1 - StepsBack;
+	if (!Checkpoints.IsValidIndex(CheckpointIndex))
+		return false;
+
+	UVRWorldSaveSubsystem* WorldSave = UVRWorldSaveSubsystem::Get(this);
+	if (!WorldSave)
+		return false;
+
+	// Newer checkpoints describe a future that no longer happens
+	Checkpoints.SetNum(CheckpointIndex + 1, EAllowShrinking::No);
+	const FVRCheckpoint& Checkpoint = Checkpoints[CheckpointIndex];
+
+	// Restoring the level cancels a checkpoint still being captured
+	bCapturing = false;
+	WorldSave->RestoreLevel(Checkpoint.World);
+
+	if (const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0))
+	{
+		if (USurvivalComponent* Survival = PlayerPawn->FindComponentByClass<USurvivalComponent>())
+		{
+			Survival->Hunger = Checkpoint.Survival.Hunger;
+			Survival->Thirst = Checkpoint.Survival.Thirst;
+			Survival->Temperature = Checkpoint.Survival.Temperature;
+			Survival->Stamina = Checkpoint.Survival.Stamina;
+			Survival->RefreshViewModel();
+		}
+
+		if (UVRInventoryComponent* Inventory = PlayerPawn->FindComponentByClass<UVRInventoryComponent>())
+		{
+			Inventory->LoadInventory(Checkpoint.Inventory);
+		}
+	}
+
+	if (Checkpoint.TotalGameHours > 0.0)
+	{
+		if (ADayNightManager* DayNightManager = ADayNightManager::GetInstance(GetWorld()))
+		{
+			DayNightManager->RestoreClock(Checkpoint.CurrentHour, Checkpoint.TotalGameHours);
+		}
+	}
+
+	OutTransform = Checkpoint.PlayerTransform;
+	OutControlRotation = Checkpoint.ControlRotation;
+
+	TimeSinceCheckpoint = 0.0f;
+	SafeTime = 0.0f;
+	return true;
+}
+
+void UVRCheckpointSubsystem::ClearCheckpoints()
+{
+	Checkpoints.Reset();
+}
@@ -0,0 +1,293 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRFireSubsystem.h"
+#include "Actors/FireplaceActor.h"
+#include "Components/SurvivalComponent.h"
+#include "Environment/DayNightManager.h"
+#include "Core/VRPerfCounters.h"
+#include "Engine/World.h"
+
+UVRFireSubsystem* UVRFireSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVRFireSubsystem>() : nullptr;
+}
+
+void UVRFireSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	DayNightManager = ADayNightManager::GetInstance(&InWorld);
+	if (DayNightManager)
+	{
+		DayNightManager->OnTimeSkipped.AddDynamic(this, &UVRFireSubsystem::HandleTimeSkipped);
+	}
+}
+
+void UVRFireSubsystem::Deinitialize()
+{
+	if (DayNightManager)
+	{
+		DayNightManager->OnTimeSkipped.RemoveDynamic(this, &UVRFireSubsystem::HandleTimeSkipped);
+		DayNightManager = nullptr;
+	}
+
+	AdjustBurningCount(-BurningFireCount);
+
+	Fires.Reset();
+	Locations.Reset();
+	FuelMasses.Reset();
+	LogFuelMasses.Reset();
+	BurnRates.Reset();
+	HeatOutputs.Reset();
+	HeatRadii.Reset();
+	VisibleLogCounts.Reset();
+	LitFlags.Reset();
+	HeatReceivers.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UVRFireSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRFireSubsystem, STATGROUP_Tickables);
+}
+
+#pragma region Registration
+
+int32 UVRFireSubsystem::RegisterFire(AFireplaceActor* Fire, const FFireDescription& Description)
+{
+	if (!Fire)
+		return INDEX_NONE;
+
+	const int32 FireIndex = Fires.Add(Fire);
+	Locations.Add(Fire->GetActorLocation());
+	FuelMasses.Add(0.0f);
+	LogFuelMasses.Add(FMath::Max(Description.LogFuelMass, UE_KINDA_SMALL_NUMBER));
+	BurnRates.Add(FMath::Max(Description.BurnRatePerHour, 0.0f));
+	HeatOutputs.Add(Description.HeatOutput);
+	HeatRadii.Add(FMath::Max(Description.HeatRadius, 1.0f));
+	VisibleLogCounts.Add(0);
+	LitFlags.Add(false);
+
+	return FireIndex;
+}
+
+void UVRFireSubsystem::UnregisterFire(AFireplaceActor* Fire)
+{
+	const int32 FireIndex = Fires.Find(Fire);
+	if (FireIndex != INDEX_NONE)
+	{
+		RemoveFireAt(FireIndex);
+	}
+}
+
+void UVRFireSubsystem::RemoveFireAt(int32 FireIndex)
+{
+	if (LitFlags[FireIndex])
+	{
+		AdjustBurningCount(-1);
+	}
+
+	Fires.RemoveAtSwap(FireIndex, 1, EAllowShrinking::No);
+	Locations.RemoveAtSwap(FireIndex, 1, EAllowShrinking::No);
+	FuelMasses.RemoveAtSwap(FireIndex, 1, EAllowShrinking::No);
+	LogFuelMasses.RemoveAtSwap(FireIndex, 1, EAllowShrinking::No);
+	BurnRates.RemoveAtSwap(FireIndex, 1, EAllowShrinking::No);
+	HeatOutputs.RemoveAtSwap(FireIndex, 1, EAllowShrinking::No);
+	HeatRadii.RemoveAtSwap(FireIndex, 1, EAllowShrinking::No);
+	VisibleLogCounts.RemoveAtSwap(FireIndex, 1, EAllowShrinking::No);
+	LitFlags.RemoveAtSwap(FireIndex, 1, EAllowShrinking::No);
+
+	// The last fire moved into the freed slot
+	if (Fires.IsValidIndex(FireIndex) && Fires[FireIndex])
+	{
+		Fires[FireIndex]->SetFireIndex(FireIndex);
+	}
+}
+
+void UVRFireSubsystem::RegisterHeatReceiver(USurvivalComponent* Receiver)
+{
+	if (Receiver)
+	{
+		HeatReceivers.AddUnique(Receiver);
+	}
+}
+
+void UVRFireSubsystem::UnregisterHeatReceiver(USurvivalComponent* Receiver)
+{
+	HeatReceivers.RemoveSingleSwap(Receiver, EAllowShrinking::No);
+}
+
+#pragma endregion
+
+#pragma region Fuel
+
+int32 UVRFireSubsystem::AddLog(int32 FireIndex)
+{
+	if (!Fires.IsValidIndex(FireIndex))
+		return 0;
+
+	// A half-burnt log still shows, so refuelling a low fire may not add a visible log
+	FuelMasses[FireIndex] += LogFuelMasses[FireIndex];
+	VisibleLogCounts[FireIndex] = FMath::CeilToInt(FuelMasses[FireIndex] / LogFuelMasses[FireIndex]);
+	return VisibleLogCounts[FireIndex];
+}
+
+bool UVRFireSubsystem::Ignite(int32 FireIndex)
+{
+	if (!Fires.IsValidIndex(FireIndex) || LitFlags[FireIndex] || FuelMasses[FireIndex] <= 0.0f)
+		return false;
+
+	LitFlags[FireIndex] = true;
+	AdjustBurningCount(1);
+	return true;
+}
+
+void UVRFireSubsystem::RestoreFire(int32 FireIndex, float FuelMass, bool bLit)
+{
+	if (!Fires.IsValidIndex(FireIndex))
+		return;
+
+	FuelMasses[FireIndex] = FMath::Max(0.0f, FuelMass);
+	VisibleLogCounts[FireIndex] = FMath::CeilToInt(FuelMasses[FireIndex] / LogFuelMasses[FireIndex]);
+
+	const bool bNowLit = bLit && FuelMasses[FireIndex] > 0.0f;
+	if (bNowLit != LitFlags[FireIndex])
+	{
+		LitFlags[FireIndex] = bNowLit;
+		AdjustBurningCount(bNowLit ? 1 : -1);
+	}
+
+	if (AFireplaceActor* Fire = Fires[FireIndex])
+	{
+		Fire->OnRestored(VisibleLogCounts[FireIndex], bNowLit);
+	}
+}
+
+bool UVRFireSubsystem::IsBurning(int32 FireIndex) const
+{
+	return LitFlags.IsValidIndex(FireIndex) && LitFlags[FireIndex];
+}
+
+float UVRFireSubsystem::GetFuelMass(int32 FireIndex) const
+{
+	return FuelMasses.IsValidIndex(FireIndex) ? FuelMasses[FireIndex] : 0.0f;
+}
+
+float UVRFireSubsystem::GetRemainingBurnHours(int32 FireIndex) const
+{
+	if (!IsBurning(FireIndex))
+		return 0.0f;
+
+	return BurnRates[FireIndex] > 0.0f ? FuelMasses[FireIndex] / BurnRates[FireIndex] : TNumericLimits<float>::Max();
+}
+
+#pragma endregion
+
+#pragma region Simulation
+
+void UVRFireSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceSimulation += DeltaTime;
+	if (TimeSinceSimulation < SimulationInterval)
+		return;
+
+	const float GameHoursPerSecond = DayNightManager ? DayNightManager->GetGameHoursPerSecond() : FallbackGameHoursPerSecond;
+	AdvanceFires(TimeSinceSimulation * GameHoursPerSecond);
+	TimeSinceSimulation = 0.0f;
+
+	UpdateHeatReceivers();
+}
+
+void UVRFireSubsystem::AdvanceFires(float GameHours)
+{
+	if (GameHours <= 0.0f || BurningFireCount == 0)
+		return;
+
+	// Fuel burns linearly, so any step length gives the same result as many small ones
+	TArray<int32, TInlineAllocator<16>> ChangedFires;
+	for (int32 FireIndex = 0; FireIndex < Fires.Num(); ++FireIndex)
+	{
+		if (!LitFlags[FireIndex])
+			continue;
+
+		FuelMasses[FireIndex] = FMath::Max(0.0f, FuelMasses[FireIndex] - BurnRates[FireIndex] * GameHours);
+
+		const int32 LogCount = FMath::CeilToInt(FuelMasses[FireIndex] / LogFuelMasses[FireIndex]);
+		if (LogCount != VisibleLogCounts[FireIndex])
+		{
+			VisibleLogCounts[FireIndex] = LogCount;
+			ChangedFires.Add(FireIndex);
+		}
+	}
+
+	// Fires are told after the pass, a callback must never see half-advanced state
+	for (const int32 FireIndex : ChangedFires)
+	{
+		AFireplaceActor* Fire = Fires[FireIndex];
+		if (!Fire)
+			continue;
+
+		Fire->OnLogCountChanged(VisibleLogCounts[FireIndex]);
+
+		if (FuelMasses[FireIndex] <= 0.0f)
+		{
+			LitFlags[FireIndex] = false;
+			AdjustBurningCount(-1);
+			Fire->OnBurntOut();
+		}
+	}
+}
+
+float UVRFireSubsystem::GetHeatAtLocation(const FVector& Location) const
+{
+	float Heat = 0.0f;
+	for (int32 FireIndex = 0; FireIndex < Fires.Num(); ++FireIndex)
+	{
+		if (!LitFlags[FireIndex])
+			continue;
+
+		const float DistanceSquared = FVector::DistSquared(Locations[FireIndex], Location);
+		const float RadiusSquared = FMath::Square(HeatRadii[FireIndex]);
+		if (DistanceSquared >= RadiusSquared)
+			continue;
+
+		// The last log gives less as it burns down
+		const float Intensity = FMath::Min(1.0f, FuelMasses[FireIndex] / LogFuelMasses[FireIndex]);
+		Heat += HeatOutputs[FireIndex] * Intensity * (1.0f - DistanceSquared / RadiusSquared);
+	}
+	return Heat;
+}
+
+void UVRFireSubsystem::UpdateHeatReceivers()
+{
+	for (int32 Index = HeatReceivers.Num() - 1; Index >= 0; --Index)
+	{
+		USurvivalComponent* Receiver = HeatReceivers[Index].Get();
+		if (!Receiver || !Receiver->GetOwner())
+		{
+			HeatReceivers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		Receiver->SetFireHeatRecoveryRate(GetHeatAtLocation(Receiver->GetOwner()->GetActorLocation()));
+	}
+}
+
+void UVRFireSubsystem::HandleTimeSkipped(float SkippedHours)
+{
+	AdvanceFires(SkippedHours);
+	UpdateHeatReceivers();
+}
+
+void UVRFireSubsystem::AdjustBurningCount(int32 Delta)
+{
+	BurningFireCount += Delta;
+	INC_DWORD_STAT_BY(STAT_VRBurningFires, Delta);
+	FVRPerfCounters::BurningFires += Delta;
+}
+
+#pragma endregion
@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRItemRegistrySubsystem.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Actors/VRFoodActor.h"
+#include "Actors/VRDrinkActor.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+
+namespace
+{
+	// Used before the engine is up, e.g. while class defaults are constructed
+	const FVRItemDefinition DefaultDefinition;
+}
+
+UVRItemRegistrySubsystem* UVRItemRegistrySubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UVRItemRegistrySubsystem>() : nullptr;
+}
+
+const FVRItemDefinition& UVRItemRegistrySubsystem::GetDefinition(const UClass* ItemClass, uint16& InOutItemId)
+{
+	UVRItemRegistrySubsystem* Registry = Get();
+	if (!Registry)
+		return DefaultDefinition;
+
+	if (InOutItemId == FVRItemDefinition::InvalidId)
+	{
+		InOutItemId = Registry->FindItemId(ItemClass);
+	}
+
+	return Registry->GetDefinition(InOutItemId);
+}
+
+void UVRItemRegistrySubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	if (UDataTable* Table = ItemTable.Get())
+	{
+		Table->OnDataTableChanged().RemoveAll(this);
+	}
+#endif
+
+	Definitions.Reset();
+	IdByClassPath.Reset();
+	IdByClass.Reset();
+	bLoaded = false;
+
+	Super::Deinitialize();
+}
+
+uint16 UVRItemRegistrySubsystem::FindItemId(const UClass* ItemClass)
+{
+	if (!bLoaded)
+	{
+		LoadDefinitions();
+	}
+
+	if (const uint16* CachedId = IdByClass.Find(ItemClass))
+		return *CachedId;
+
+	// Closest class with a row, the native grabbable one at the latest
+	uint16 ItemId = 0;
+	for (const UClass* Class = ItemClass; Class; Class = Class->GetSuperClass())
+	{
+		if (const uint16* RowId = IdByClassPath.Find(FSoftObjectPath(Class)))
+		{
+			ItemId = *RowId;
+			break;
+		}
+	}
+
+	IdByClass.Add(ItemClass, ItemId);
+	return ItemId;
+}
+
+#if WITH_EDITOR
+void UVRItemRegistrySubsystem::SetItemTable(UDataTable* Table)
+{
+	UVRItemRegistrySubsystem* Defaults = GetMutableDefault<UVRItemRegistrySubsystem>();
+	Defaults->ItemTable = Table;
+	Defaults->TryUpdateDefaultConfigFile();
+}
+
+uint16 UVRItemRegistrySubsystem::AddFixtureDefinition(const UClass* ItemClass, const FVRItemDefinition& Definition)
+{
+	if (!bLoaded)
+	{
+		LoadDefinitions();
+	}
+
+	const uint16 ItemId = AddDefinition(FSoftObjectPath(ItemClass), Definition);
+
+	// Subclasses may have resolved to a parent's row before
+	IdByClass.Reset();
+	return ItemId;
+}
+#endif
+
+const FVRItemDefinition& UVRItemRegistrySubsystem::GetDefinition(uint16 ItemId) const
+{
+	return Definitions.IsValidIndex(ItemId) ? Definitions[ItemId] : DefaultDefinition;
+}
+
+void UVRItemRegistrySubsystem::LoadDefinitions()
+{
+	bLoaded = true;
+
+	// The native classes come first so every item resolves to something, table rows for them replace these
+	AddDefinition(FSoftObjectPath(AVRGrabbableActor::StaticClass()), FVRItemDefinition());
+	AddDefinition(FSoftObjectPath(AVRFoodActor::StaticClass()), FVRItemDefinition());
+
+	FVRItemDefinition DrinkDefinition;
+	DrinkDefinition.StaminaRestorationValue = 8.0f;
+	AddDefinition(FSoftObjectPath(AVRDrinkActor::StaticClass()), DrinkDefinition);
+
+	if (ItemTable.IsNull())
+		return;
+
+	UDataTable* Table = ItemTable.LoadSynchronous();
+	if (!Table || !Table->GetRowStruct() || !Table->GetRowStruct()->IsChildOf(FVRItemDefinition::StaticStruct()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("VRItemRegistry: %s is not a table of FVRItemDefinition"), *ItemTable.ToString());
+		return;
+	}
+
+	ReadTable(*Table);
+
+#if WITH_EDITOR
+	// Balance gets tweaked with PIE running. Rows are updated in place so ids cached on actors stay valid
+	Table->OnDataTableChanged().AddWeakLambda(this, [this, Table]()
+	{
+		ReadTable(*Table);
+		IdByClass.Reset();
+	});
+#endif
+
+	UE_LOG(LogTemp, Log, TEXT("VRItemRegistry: %d item definitions"), Definitions.Num());
+}
+
+void UVRItemRegistrySubsystem::ReadTable(const UDataTable& Table)
+{
+	Table.ForeachRow<FVRItemDefinition>(TEXT("VRItemRegistry"), [this](const FName& RowName, const FVRItemDefinition& Row)
+	{
+		if (Row.ItemClass.IsNull())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("VRItemRegistry: Row %s has no item class"), *RowName.ToString());
+			return;
+		}
+
+		AddDefinition(Row.ItemClass.ToSoftObjectPath(), Row);
+	});
+}
+
+uint16 UVRItemRegistrySubsystem::AddDefinition(const FSoftObjectPath& ClassPath, const FVRItemDefinition& Definition)
+{
+	if (const uint16* ExistingId = IdByClassPath.Find(ClassPath))
+	{
+		Definitions[*ExistingId] = Definition;
+		return *ExistingId;
+	}
+
+	if (Definitions.Num() >= FVRItemDefinition::InvalidId)
+	{
+		UE_LOG(LogTemp, Error, TEXT("VRItemRegistry: Too many item definitions, %s is ignored"), *ClassPath.ToString());
+		return 0;
+	}
+
+	const uint16 ItemId = static_cast<uint16>(Definitions.Add(Definition));
+	IdByClassPath.Add(ClassPath, ItemId);
+	return ItemId;
+}
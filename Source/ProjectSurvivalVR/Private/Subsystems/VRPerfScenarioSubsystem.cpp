@@ -0,0 +1,783 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRPerfScenarioSubsystem.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "Characters/VRCharacterBase.h"
+#include "Hands/VRHand.h"
+#include "Interfaces/Interactable.h"
+#include "Actors/VRBed.h"
+#include "Actors/VRClimbableActor.h"
+#include "Actors/VRConsumableActor.h"
+#include "Actors/VRDrinkActor.h"
+#include "Actors/VRFoodActor.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Core/VRAllocationCounter.h"
+#include "Core/VRCollisionQuery.h"
+#include "Core/VRPerfCounters.h"
+#include "Environment/DayNightManager.h"
+#include "Camera/CameraComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "MotionControllerComponent.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Serialization/JsonSerializer.h"
+
+CSV_DEFINE_CATEGORY(VRPerf, true);
+
+namespace
+{
+	// Nearest rank, Sorted must be ascending and not empty
+	float GetPercentile(const TArray<float>& Sorted, float Percent)
+	{
+		const int32 Rank = FMath::CeilToInt(Percent / 100.0f * Sorted.Num()) - 1;
+		return Sorted[FMath::Clamp(Rank, 0, Sorted.Num() - 1)];
+	}
+
+	TSharedRef<FJsonObject> MakeDistribution(TArray<float> Values)
+	{
+		TSharedRef<FJsonObject> Distribution = MakeShared<FJsonObject>();
+		if (Values.IsEmpty())
+			return Distribution;
+
+		Values.Sort();
+
+		double Sum = 0.0;
+		for (const float Value : Values)
+		{
+			Sum += Value;
+		}
+
+		Distribution->SetNumberField(TEXT("Mean"), Sum / Values.Num());
+		Distribution->SetNumberField(TEXT("P50"), GetPercentile(Values, 50.0f));
+		Distribution->SetNumberField(TEXT("P90"), GetPercentile(Values, 90.0f));
+		Distribution->SetNumberField(TEXT("P95"), GetPercentile(Values, 95.0f));
+		Distribution->SetNumberField(TEXT("P99"), GetPercentile(Values, 99.0f));
+		Distribution->SetNumberField(TEXT("Max"), Values.Last());
+		return Distribution;
+	}
+
+	// Hand distance in front of the eyes for the mouth, and for an item being looked at
+	constexpr float MouthDistance = 8.0f;
+	constexpr float InspectDistance = 40.0f;
+
+	// Gap left between a target's bounds and the character after a warp
+	constexpr float WarpClearance = 60.0f;
+
+	// How far the hand pulls down on a hold, lifting the character by as much
+	constexpr float ClimbPullDistance = 40.0f;
+}
+
+UVRPerfScenarioSubsystem* UVRPerfScenarioSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVRPerfScenarioSubsystem>() : nullptr;
+}
+
+bool UVRPerfScenarioSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return FParse::Param(FCommandLine::Get(), TEXT("VRPerfScenario")) && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+bool UVRPerfScenarioSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UVRPerfScenarioSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!FApp::IsBenchmarking())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("VRPerfScenario: running without -benchmark, the route and timings will vary with the frame rate"));
+	}
+
+	FString Label;
+	FParse::Value(FCommandLine::Get(), TEXT("VRPerfLabel="), Label);
+	RunName = FString::Printf(TEXT("%s-%s%s%s"), *UGameplayStatics::GetCurrentLevelName(&InWorld), *FDateTime::Now().ToString(),
+		Label.IsEmpty() ? TEXT("") : TEXT("-"), *Label);
+
+	bRunning = true;
+	CompletedSteps = 0;
+	EnterStep(EStep::Settle);
+}
+
+void UVRPerfScenarioSubsystem::Deinitialize()
+{
+	// The world went away mid route (travel, quit), the partial run is not worth a summary
+	if (bMeasuring)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("VRPerfScenario: world torn down during %s, no summary written"), GetStepName(Step));
+		StopMeasuring();
+	}
+
+	bRunning = false;
+	Character.Reset();
+	Target.Reset();
+	Samples.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UVRPerfScenarioSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRPerfScenarioSubsystem, STATGROUP_Tickables);
+}
+
+void UVRPerfScenarioSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bRunning)
+		return;
+
+#if !UE_BUILD_SHIPPING
+	StepTime += DeltaTime;
+	PhaseTime += DeltaTime;
+
+	const bool bStepDone = TickStep();
+	++StepFrame;
+
+	if (bStepDone)
+	{
+		EnterStep(static_cast<EStep>(static_cast<uint8>(Step) + 1));
+	}
+#endif
+}
+
+#pragma region Route
+
+const TCHAR* UVRPerfScenarioSubsystem::GetStepName(EStep InStep)
+{
+	switch (InStep)
+	{
+	case EStep::Settle:		return TEXT("Settle");
+	case EStep::Walk:		return TEXT("Walk");
+	case EStep::Teleport:	return TEXT("Teleport");
+	case EStep::Climb:		return TEXT("Climb");
+	case EStep::Grab:		return TEXT("Grab");
+	case EStep::Eat:		return TEXT("Eat");
+	case EStep::Drink:		return TEXT("Drink");
+	case EStep::Sleep:		return TEXT("Sleep");
+	default:				return TEXT("Done");
+	}
+}
+
+void UVRPerfScenarioSubsystem::EnterStep(EStep NewStep)
+{
+	Step = NewStep;
+	StepTime = 0.0f;
+	StepFrame = 0;
+	ReachPhase = EReachPhase::Reach;
+	PhaseTime = 0.0f;
+	Target.Reset();
+
+	CSV_EVENT(VRPerf, TEXT("%s"), GetStepName(Step));
+
+	switch (Step)
+	{
+	case EStep::Climb:
+		Target = FindNearest(AVRClimbableActor::StaticClass());
+		break;
+	case EStep::Grab:
+		// Something plain, consumables and beds get their own steps
+		Target = FindNearest(AVRGrabbableActor::StaticClass(), { AVRConsumableActor::StaticClass(), AVRBed::StaticClass() });
+		break;
+	case EStep::Eat:
+		Target = FindNearest(AVRFoodActor::StaticClass());
+		break;
+	case EStep::Drink:
+		Target = FindNearest(AVRDrinkActor::StaticClass());
+		break;
+	case EStep::Sleep:
+		Target = FindNearest(AVRBed::StaticClass());
+		break;
+	case EStep::Done:
+		StopMeasuring();
+		WriteSummary();
+		bRunning = false;
+
+		if (bExitWhenDone)
+		{
+			RequestEngineExit(TEXT("VRPerfScenario finished"));
+		}
+		return;
+	default:
+		return;
+	}
+
+	if (!Target.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("VRPerfScenario: nothing to %s on this map, step skipped"), GetStepName(Step));
+		return;
+	}
+
+	WarpNextTo(Target.Get());
+
+	if (Step == EStep::Sleep)
+	{
+		StartSleep(Cast<AVRBed>(Target.Get()));
+	}
+}
+
+void UVRPerfScenarioSubsystem::StartSleep(AVRBed* Bed)
+{
+	// Beds only take sleepers at night, the route must not depend on the hour the map starts at
+	ADayNightManager* DayNightManager = ADayNightManager::GetInstance(GetWorld());
+	if (!DayNightManager)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("VRPerfScenario: no DayNightManager on this map, %s will refuse to let the character sleep"), *Bed->GetName());
+	}
+	else if (!DayNightManager->IsNight())
+	{
+		DayNightManager->SetCurrentHour(SleepHour);
+	}
+
+	// Sleep starts synchronously inside TriggerSleep, whose return value does not tell whether it did
+	Bed->OnSleepStarted.AddDynamic(this, &UVRPerfScenarioSubsystem::HandleSleepStarted);
+	Bed->TriggerSleep(Character.Get());
+	Bed->OnSleepStarted.RemoveDynamic(this, &UVRPerfScenarioSubsystem::HandleSleepStarted);
+
+	if (!(CompletedSteps & (1u << static_cast<uint8>(EStep::Sleep))))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("VRPerfScenario: %s refused to let the character sleep"), *Bed->GetName());
+	}
+}
+
+void UVRPerfScenarioSubsystem::HandleSleepStarted()
+{
+	CompletedSteps |= 1u << static_cast<uint8>(EStep::Sleep);
+}
+
+// The route drives the character and hands through their test hooks, which Shipping compiles out
+#if !UE_BUILD_SHIPPING
+bool UVRPerfScenarioSubsystem::TickStep()
+{
+	switch (Step)
+	{
+	case EStep::Settle:
+	{
+		// The game mode may not have spawned the pawn on the first frames
+		if (!Character.IsValid() && !PossessCharacter())
+		{
+			if (StepTime < SettleSeconds * 2.0f)
+				return false;
+
+			UE_LOG(LogTemp, Error, TEXT("VRPerfScenario: no player controller to possess a VR character with, giving up"));
+			bRunning = false;
+
+			if (bExitWhenDone)
+			{
+				RequestEngineExit(TEXT("VRPerfScenario failed"));
+			}
+			return false;
+		}
+
+		if (StepTime < SettleSeconds)
+			return false;
+
+		StartMeasuring();
+		CompletedSteps |= 1u << static_cast<uint8>(Step);
+		return true;
+	}
+
+	case EStep::Walk:
+	{
+		AVRCharacterBase* Player = Character.Get();
+		if (!Player)
+			return true;
+
+		// Straight ahead first, then diagonally to the right
+		const bool bStrafing = StepTime > WalkSeconds * 0.5f;
+		Player->TestSetMovementInput(bStrafing ? 0.5f : 1.0f, bStrafing ? 1.0f : 0.0f);
+
+		if (StepTime < WalkSeconds)
+			return false;
+
+		Player->TestSetMovementInput(0.0f, 0.0f);
+		CompletedSteps |= 1u << static_cast<uint8>(Step);
+		return true;
+	}
+
+	case EStep::Teleport:
+	{
+		AVRCharacterBase* Player = Character.Get();
+		if (!Player)
+			return true;
+
+		// Per teleport: start, aim for TeleportAimFrames, teleport. Each one turns a quarter further
+		const int32 FramesPerTeleport = FMath::Max(TeleportAimFrames, 1) + 2;
+		const int32 Teleport = StepFrame / FramesPerTeleport;
+		if (Teleport >= TeleportCount)
+		{
+			CompletedSteps |= 1u << static_cast<uint8>(Step);
+			return true;
+		}
+
+		const int32 Frame = StepFrame % FramesPerTeleport;
+		if (Frame == 0)
+		{
+			Player->TestStartTeleport();
+		}
+		else if (Frame < FramesPerTeleport - 1)
+		{
+			const FRotator Aim(20.0f, Player->GetActorRotation().Yaw + 90.0f * Teleport, 0.0f);
+			Player->TestTeleportTrace(Player->TestGetCamera()->GetComponentLocation(), Aim.Vector());
+		}
+		else
+		{
+			Player->TestTryTeleport();
+		}
+		return false;
+	}
+
+	case EStep::Climb:
+	case EStep::Grab:
+	case EStep::Eat:
+	case EStep::Drink:
+		return TickReachStep();
+
+	case EStep::Sleep:
+		return !Target.IsValid() || StepTime >= SleepSeconds;
+
+	default:
+		return true;
+	}
+}
+
+bool UVRPerfScenarioSubsystem::TickReachStep()
+{
+	AVRHand* Hand = GetHand();
+	AActor* Item = Target.Get();
+	if (!Hand || !Item)
+		return true;
+
+	UMotionControllerComponent* MotionController = Hand->GetMotionController();
+	const uint32 StepBit = 1u << static_cast<uint8>(Step);
+
+	if (ReachPhase == EReachPhase::Reach)
+	{
+		// Nothing tracks the controller under -nullrhi, it stays where it is put
+		FVector ReachPoint = Item->GetActorLocation();
+		IInteractable* Interactable = Cast<IInteractable>(Item);
+		if (UPrimitiveComponent* GrabComponent = Interactable ? Interactable->GetGrabCollisionComponent() : nullptr)
+		{
+			FVector ClosestPoint;
+			if (VRCollisionQuery::GetClosestPointOnCollision(GrabComponent, MotionController->GetComponentLocation(), ClosestPoint) >= 0.0f)
+			{
+				ReachPoint = ClosestPoint;
+			}
+		}
+		MotionController->SetWorldLocation(ReachPoint);
+
+		if (Hand->TestIsHovering(Item))
+		{
+			Hand->TestGrabHovered();
+			if (!Hand->IsGrabbing() || Hand->GetGrabbedActor().GetObject() != Item)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("VRPerfScenario: the hand hovered %s but did not hold it, %s step given up"), *Item->GetName(), GetStepName(Step));
+				return true;
+			}
+
+			// Climbing and picking up are done once the grab holds, eating and drinking wait for the mouth
+			if (Step == EStep::Climb || Step == EStep::Grab)
+			{
+				CompletedSteps |= StepBit;
+			}
+
+			GrabTransform = MotionController->GetComponentTransform();
+			ReachPhase = EReachPhase::Hold;
+			PhaseTime = 0.0f;
+			return false;
+		}
+
+		if (PhaseTime < ReachTimeout)
+			return false;
+
+		UE_LOG(LogTemp, Warning, TEXT("VRPerfScenario: the hand never reached %s, %s step given up"), *Item->GetName(), GetStepName(Step));
+		return true;
+	}
+
+	MotionController->SetWorldTransform(GetHoldTransform());
+
+	// Eating and drinking count once the item is at the mouth, the item may be used up and pooled right there
+	const bool bAtMouth = (Step == EStep::Eat || Step == EStep::Drink) && Character.IsValid() && Character->IsOverlappingMouth();
+	if (bAtMouth)
+	{
+		CompletedSteps |= StepBit;
+	}
+
+	const UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+	const bool bConsumed = Pool && Pool->IsPooled(Item);
+	if (!bConsumed && PhaseTime < HoldSeconds)
+		return false;
+
+	if (Hand->IsGrabbing())
+	{
+		Hand->ReleaseObject();
+	}
+	return true;
+}
+
+FTransform UVRPerfScenarioSubsystem::GetHoldTransform() const
+{
+	const float Alpha = HoldSeconds > 0.0f ? FMath::Clamp(PhaseTime / HoldSeconds, 0.0f, 1.0f) : 1.0f;
+	const UCameraComponent* Camera = Character.IsValid() ? Character->TestGetCamera() : nullptr;
+	if (!Camera)
+		return GrabTransform;
+
+	const FVector Eyes = Camera->GetComponentLocation();
+	const FRotator View = Camera->GetComponentRotation();
+
+	switch (Step)
+	{
+	case EStep::Climb:
+	{
+		FTransform Pulled = GrabTransform;
+		Pulled.AddToTranslation(FVector(0.0f, 0.0f, -ClimbPullDistance * Alpha));
+		return Pulled;
+	}
+
+	case EStep::Grab:
+	{
+		// Held up in front of the eyes and turned over
+		const FVector Location = Eyes + View.Vector() * InspectDistance;
+		const FRotator Rotation = View + FRotator(0.0f, 0.0f, 180.0f * Alpha);
+		return FTransform(Rotation, FMath::Lerp(GrabTransform.GetLocation(), Location, FMath::Min(Alpha * 2.0f, 1.0f)));
+	}
+
+	default:
+	{
+		// To the mouth over the first half, drinks are tipped up on the way
+		const FVector Mouth = Eyes + View.Vector() * MouthDistance - FVector(0.0f, 0.0f, MouthDistance);
+		const float Tilt = Step == EStep::Drink ? 110.0f * Alpha : 0.0f;
+		const FRotator Rotation = View + FRotator(Tilt, 0.0f, 0.0f);
+		return FTransform(Rotation, FMath::Lerp(GrabTransform.GetLocation(), Mouth, FMath::Min(Alpha * 2.0f, 1.0f)));
+	}
+	}
+}
+
+AVRHand* UVRPerfScenarioSubsystem::GetHand() const
+{
+	return Character.IsValid() ? Character->TestGetRightHand() : nullptr;
+}
+#endif
+
+bool UVRPerfScenarioSubsystem::PossessCharacter()
+{
+	UWorld* World = GetWorld();
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PlayerController)
+		return false;
+
+	APawn* Pawn = PlayerController->GetPawn();
+	if (AVRCharacterBase* Possessed = Cast<AVRCharacterBase>(Pawn))
+	{
+		Character = Possessed;
+		return true;
+	}
+
+	// Late spawn, items that cached the pawn on BeginPlay keep the old one. Prefer a game mode that spawns the VR character
+	UClass* Class = CharacterClass.LoadSynchronous();
+	if (!Class)
+	{
+		Class = AVRCharacterBase::StaticClass();
+	}
+
+	FTransform SpawnTransform = Pawn ? Pawn->GetActorTransform() : FTransform::Identity;
+	if (!Pawn)
+	{
+		AGameModeBase* GameMode = World->GetAuthGameMode();
+		if (AActor* PlayerStart = GameMode ? GameMode->FindPlayerStart(PlayerController) : nullptr)
+		{
+			SpawnTransform = PlayerStart->GetActorTransform();
+		}
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AVRCharacterBase* Spawned = World->SpawnActor<AVRCharacterBase>(Class, SpawnTransform, SpawnParameters);
+	if (!Spawned)
+		return false;
+
+	PlayerController->Possess(Spawned);
+	if (Pawn)
+	{
+		Pawn->Destroy();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("VRPerfScenario: spawned and possessed %s"), *Class->GetName());
+	Character = Spawned;
+	return true;
+}
+
+AActor* UVRPerfScenarioSubsystem::FindNearest(UClass* Class, TArrayView<UClass* const> ExcludedClasses) const
+{
+	UWorld* World = GetWorld();
+	if (!World || !Character.IsValid())
+		return nullptr;
+
+	const FVector Origin = Character->GetActorLocation();
+	const UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+
+	AActor* Nearest = nullptr;
+	double NearestDistanceSquared = TNumericLimits<double>::Max();
+
+	for (TActorIterator<AActor> It(World, Class); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (Actor->IsHidden() || (Pool && Pool->IsPooled(Actor)))
+			continue;
+
+		if (ExcludedClasses.ContainsByPredicate([Actor](const UClass* Excluded) { return Actor->IsA(Excluded); }))
+			continue;
+
+		// Held or worn already
+		if (Actor->GetAttachParentActor())
+			continue;
+
+		const double DistanceSquared = FVector::DistSquared(Origin, Actor->GetActorLocation());
+		if (DistanceSquared < NearestDistanceSquared
+			|| (DistanceSquared == NearestDistanceSquared && Nearest && Actor->GetFName().LexicalLess(Nearest->GetFName())))
+		{
+			Nearest = Actor;
+			NearestDistanceSquared = DistanceSquared;
+		}
+	}
+
+	return Nearest;
+}
+
+void UVRPerfScenarioSubsystem::WarpNextTo(const AActor* InTarget)
+{
+	AVRCharacterBase* Player = Character.Get();
+	if (!Player || !InTarget)
+		return;
+
+	const FBox Bounds = InTarget->GetComponentsBoundingBox();
+	const FVector Center = Bounds.GetCenter();
+
+	// Stay on the side the character is on, facing the target
+	FVector Away = (Player->GetActorLocation() - Center).GetSafeNormal2D();
+	if (Away.IsNearlyZero())
+	{
+		Away = -FVector::ForwardVector;
+	}
+
+	FVector Destination = Center + Away * (Bounds.GetExtent().Size2D() + WarpClearance);
+	Destination.Z = Bounds.Min.Z + Player->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+	// TeleportTo moves the capsule out of anything it would end up in
+	Player->TeleportTo(Destination, (-Away).Rotation());
+}
+
+#pragma endregion
+
+#pragma region Measuring
+
+void UVRPerfScenarioSubsystem::StartMeasuring()
+{
+	// Ahead of time, so the sample array does not show up in the allocations it records
+	Samples.Reset();
+	// Timed steps at the fixed frame rate (120 fps at least), teleports run by frame count
+	const double FramesPerSecond = FMath::Max(FApp::IsBenchmarking() ? 1.0 / FApp::GetFixedDeltaTime() : 0.0, 120.0);
+	const float TimedSeconds = WalkSeconds + (ReachTimeout + HoldSeconds) * 4.0f + SleepSeconds;
+	const int32 TeleportFrames = FMath::Max(TeleportCount, 0) * (FMath::Max(TeleportAimFrames, 1) + 2);
+	Samples.Reserve(FMath::CeilToInt(TimedSeconds * FramesPerSecond) + TeleportFrames + 1024);
+
+	StartPoolHits = FVRPerfCounters::PoolHits;
+	StartPoolMisses = FVRPerfCounters::PoolMisses;
+	StartPhysicsStateRebuilds = FVRPerfCounters::PhysicsStateRebuilds;
+	StartRenderWritesAvoided = FVRPerfCounters::RenderWritesAvoided;
+	StartUILayerRedraws = FVRPerfCounters::UILayerRedraws;
+	LastCollisionQueries = FVRPerfCounters::CollisionQueries;
+
+#if !UE_BUILD_SHIPPING
+	FVRAllocationCounter::Start();
+	LastAllocations = FVRAllocationCounter::GetAllocations();
+#endif
+
+	bFrameStarted = false;
+	BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddUObject(this, &UVRPerfScenarioSubsystem::HandleBeginFrame);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UVRPerfScenarioSubsystem::HandleEndFrame);
+
+#if CSV_PROFILER
+	if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get())
+	{
+		CsvProfiler->BeginCapture(-1, FPaths::ProfilingDir() / TEXT("VRPerf"), RunName + TEXT(".csv"));
+		CSV_METADATA(TEXT("VRPerfRun"), *RunName);
+	}
+#else
+	UE_LOG(LogTemp, Warning, TEXT("VRPerfScenario: this build has no CSV profiler, only the summary is written"));
+#endif
+
+	RunStartSeconds = FPlatformTime::Seconds();
+	bMeasuring = true;
+}
+
+void UVRPerfScenarioSubsystem::StopMeasuring()
+{
+	if (!bMeasuring)
+		return;
+
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	BeginFrameHandle.Reset();
+	EndFrameHandle.Reset();
+
+#if !UE_BUILD_SHIPPING
+	FVRAllocationCounter::Stop();
+#endif
+
+#if CSV_PROFILER
+	if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get())
+	{
+		CsvProfiler->EndCapture();
+	}
+#endif
+
+	bMeasuring = false;
+}
+
+void UVRPerfScenarioSubsystem::HandleBeginFrame()
+{
+	bFrameStarted = true;
+}
+
+void UVRPerfScenarioSubsystem::HandleEndFrame()
+{
+	// Measuring started mid frame
+	if (!bFrameStarted)
+		return;
+
+	// The engine's own game thread time, the same figure "stat unit" and the CSV GameThreadTime stat show
+	const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+	const uint64 CollisionQueries = FVRPerfCounters::CollisionQueries;
+#if !UE_BUILD_SHIPPING
+	const uint64 Allocations = FVRAllocationCounter::GetAllocations();
+#else
+	const uint64 Allocations = 0;
+#endif
+
+	FFrameSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.GameThreadMs = static_cast<float>(GameThreadMs);
+	Sample.CollisionQueries = static_cast<uint32>(CollisionQueries - LastCollisionQueries);
+	Sample.Allocations = static_cast<uint32>(Allocations - LastAllocations);
+	Sample.Step = Step;
+
+	LastCollisionQueries = CollisionQueries;
+	LastAllocations = Allocations;
+
+	CSV_CUSTOM_STAT(VRPerf, GameThreadMs, Sample.GameThreadMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRPerf, CollisionQueries, static_cast<int32>(Sample.CollisionQueries), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRPerf, Allocations, static_cast<int32>(Sample.Allocations), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRPerf, Step, static_cast<int32>(Step), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRPerf, PhysicsActiveBodies, FVRPerfCounters::PhysicsActiveBodies, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRPerf, TickDemandActiveActors, FVRPerfCounters::TickDemandActiveActors, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRPerf, InstancedProps, FVRPerfCounters::InstancedProps, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRPerf, BurningFires, FVRPerfCounters::BurningFires, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRPerf, VFXFullQuality, FVRPerfCounters::VFXFullQuality, ECsvCustomStatOp::Set);
+}
+
+void UVRPerfScenarioSubsystem::WriteSummary() const
+{
+	TArray<float> GameThreadMs;
+	TArray<float> CollisionQueries;
+	TArray<float> Allocations;
+	uint64 TotalCollisionQueries = 0;
+	uint64 TotalAllocations = 0;
+
+	for (const FFrameSample& Sample : Samples)
+	{
+		GameThreadMs.Add(Sample.GameThreadMs);
+		CollisionQueries.Add(Sample.CollisionQueries);
+		Allocations.Add(Sample.Allocations);
+		TotalCollisionQueries += Sample.CollisionQueries;
+		TotalAllocations += Sample.Allocations;
+	}
+
+	TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+	Summary->SetStringField(TEXT("Run"), RunName);
+	Summary->SetStringField(TEXT("Map"), UGameplayStatics::GetCurrentLevelName(this));
+	Summary->SetStringField(TEXT("Configuration"), LexToString(FApp::GetBuildConfiguration()));
+	Summary->SetBoolField(TEXT("FixedTimestep"), FApp::IsBenchmarking());
+	Summary->SetNumberField(TEXT("Frames"), Samples.Num());
+	Summary->SetNumberField(TEXT("Seconds"), FPlatformTime::Seconds() - RunStartSeconds);
+	Summary->SetObjectField(TEXT("GameThreadMs"), MakeDistribution(GameThreadMs));
+	Summary->SetObjectField(TEXT("CollisionQueriesPerFrame"), MakeDistribution(CollisionQueries));
+	Summary->SetObjectField(TEXT("AllocationsPerFrame"), MakeDistribution(Allocations));
+
+	TSharedRef<FJsonObject> Totals = MakeShared<FJsonObject>();
+	Totals->SetNumberField(TEXT("CollisionQueries"), TotalCollisionQueries);
+	Totals->SetNumberField(TEXT("Allocations"), TotalAllocations);
+	Totals->SetNumberField(TEXT("PoolHits"), FVRPerfCounters::PoolHits - StartPoolHits);
+	Totals->SetNumberField(TEXT("PoolMisses"), FVRPerfCounters::PoolMisses - StartPoolMisses);
+	Totals->SetNumberField(TEXT("PhysicsStateRebuilds"), FVRPerfCounters::PhysicsStateRebuilds - StartPhysicsStateRebuilds);
+	Totals->SetNumberField(TEXT("RenderWritesAvoided"), FVRPerfCounters::RenderWritesAvoided - StartRenderWritesAvoided);
+	Totals->SetNumberField(TEXT("UILayerRedraws"), FVRPerfCounters::UILayerRedraws - StartUILayerRedraws);
+	Summary->SetObjectField(TEXT("Totals"), Totals);
+
+	// Settle is not measured, the route starts at the walk
+	TArray<TSharedPtr<FJsonValue>> Steps;
+	for (uint8 StepIndex = static_cast<uint8>(EStep::Walk); StepIndex < static_cast<uint8>(EStep::Done); ++StepIndex)
+	{
+		TArray<float> StepGameThreadMs;
+		TArray<float> StepCollisionQueries;
+		TArray<float> StepAllocations;
+		for (const FFrameSample& Sample : Samples)
+		{
+			if (static_cast<uint8>(Sample.Step) == StepIndex)
+			{
+				StepGameThreadMs.Add(Sample.GameThreadMs);
+				StepCollisionQueries.Add(Sample.CollisionQueries);
+				StepAllocations.Add(Sample.Allocations);
+			}
+		}
+
+		TSharedRef<FJsonObject> StepSummary = MakeShared<FJsonObject>();
+		StepSummary->SetStringField(TEXT("Name"), GetStepName(static_cast<EStep>(StepIndex)));
+		StepSummary->SetBoolField(TEXT("Completed"), (CompletedSteps & (1u << StepIndex)) != 0);
+		StepSummary->SetNumberField(TEXT("Frames"), StepGameThreadMs.Num());
+		StepSummary->SetObjectField(TEXT("GameThreadMs"), MakeDistribution(StepGameThreadMs));
+		StepSummary->SetObjectField(TEXT("CollisionQueriesPerFrame"), MakeDistribution(StepCollisionQueries));
+		StepSummary->SetObjectField(TEXT("AllocationsPerFrame"), MakeDistribution(StepAllocations));
+		Steps.Add(MakeShared<FJsonValueObject>(StepSummary));
+	}
+	Summary->SetArrayField(TEXT("Steps"), Steps);
+
+	FString Text;
+	const FString OutputPath = FPaths::ProfilingDir() / TEXT("VRPerf") / RunName + TEXT(".json");
+	if (!FJsonSerializer::Serialize(Summary, TJsonWriterFactory<>::Create(&Text)) || !FFileHelper::SaveStringToFile(Text, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("VRPerfScenario: could not write %s"), *OutputPath);
+		return;
+	}
+
+	if (!GameThreadMs.IsEmpty())
+	{
+		GameThreadMs.Sort();
+		UE_LOG(LogTemp, Display, TEXT("VRPerfScenario: %d frames, game thread p50 %.2f p95 %.2f p99 %.2f max %.2f ms, %.1f queries and %.1f allocations per frame"),
+			Samples.Num(), GetPercentile(GameThreadMs, 50.0f), GetPercentile(GameThreadMs, 95.0f), GetPercentile(GameThreadMs, 99.0f), GameThreadMs.Last(),
+			static_cast<double>(TotalCollisionQueries) / Samples.Num(), static_cast<double>(TotalAllocations) / Samples.Num());
+	}
+	UE_LOG(LogTemp, Display, TEXT("VRPerfScenario: summary written to %s"), *OutputPath);
+}
+
+#pragma endregion
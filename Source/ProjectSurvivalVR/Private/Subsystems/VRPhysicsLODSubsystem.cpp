@@ -0,0 +1,254 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRPhysicsLODSubsystem.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Core/VRCollisionQuery.h"
+#include "Core/VRPerfCounters.h"
+#include "Engine/World.h"
+
+UVRPhysicsLODSubsystem* UVRPhysicsLODSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVRPhysicsLODSubsystem>() : nullptr;
+}
+
+void UVRPhysicsLODSubsystem::Deinitialize()
+{
+	AdjustCounters(-ActiveBodyCount, -DormantBodyCount);
+	Entries.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UVRPhysicsLODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRPhysicsLODSubsystem, STATGROUP_Tickables);
+}
+
+void UVRPhysicsLODSubsystem::RegisterGrabbable(AVRGrabbableActor* Grabbable)
+{
+	if (!Grabbable)
+		return;
+
+	FPhysicsLODEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Grabbable = Grabbable;
+	Entry.LastEvaluationTime = GetWorld()->GetTimeSeconds();
+
+	UpdateCountedState(Entry);
+}
+
+void UVRPhysicsLODSubsystem::UnregisterGrabbable(AVRGrabbableActor* Grabbable)
+{
+	const int32 Index = Entries.IndexOfByPredicate([Grabbable](const FPhysicsLODEntry& Entry)
+	{
+		return Entry.Grabbable.Get() == Grabbable;
+	});
+
+	if (Index == INDEX_NONE)
+		return;
+
+	Entries[Index].Grabbable.Reset();
+	UpdateCountedState(Entries[Index]);
+
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UVRPhysicsLODSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Entries.Num() == 0)
+		return;
+
+	FocusPoints.Gather(GetWorld());
+
+	// Spread one full pass over EvaluationInterval, so cost per frame scales with the interval, not the frame rate
+	const int32 Budget = FMath::Clamp(
+		FMath::CeilToInt(Entries.Num() * DeltaTime / FMath::Max(EvaluationInterval, UE_KINDA_SMALL_NUMBER)),
+		1, FMath::Max(MaxEvaluationsPerFrame, 1));
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (int32 Evaluated = 0; Evaluated < Budget && Entries.Num() > 0; ++Evaluated)
+	{
+		if (NextEntryIndex >= Entries.Num())
+		{
+			NextEntryIndex = 0;
+		}
+
+		FPhysicsLODEntry& Entry = Entries[NextEntryIndex];
+
+		// Actors that went away without EndPlay (e.g. level streaming out) are dropped here
+		if (!Entry.Grabbable.IsValid())
+		{
+			UpdateCountedState(Entry);
+			Entries.RemoveAtSwap(NextEntryIndex, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		EvaluateEntry(Entry, CurrentTime);
+
+		// Grabs, releases and pooling change simulation outside of this subsystem
+		UpdateCountedState(Entry);
+		++NextEntryIndex;
+	}
+}
+
+void UVRPhysicsLODSubsystem::EvaluateEntry(FPhysicsLODEntry& Entry, double CurrentTime)
+{
+	AVRGrabbableActor* Grabbable = Entry.Grabbable.Get();
+	UPrimitiveComponent* Body = Grabbable->GetPhysicsComponent();
+
+	const float ElapsedTime = static_cast<float>(CurrentTime - Entry.LastEvaluationTime);
+	Entry.LastEvaluationTime = CurrentTime;
+
+	// Pooled or hidden items keep whatever state they have until they are back in the world
+	if (!Body || Grabbable->IsHidden())
+		return;
+
+	if (Grabbable->IsBeingHeld())
+	{
+		Entry.RestingTime = 0.0f;
+		PromoteGrabbable(Grabbable);
+		return;
+	}
+
+	const float DistanceSquared = FocusPoints.GetDistanceSquared(Body->GetComponentLocation());
+
+	if (Grabbable->IsPhysicsDemoted())
+	{
+		if (DistanceSquared < FMath::Square(PromoteDistance))
+		{
+			Entry.RestingTime = 0.0f;
+			PromoteGrabbable(Grabbable);
+		}
+		return;
+	}
+
+	// Kinematic grabbables (bStartSimulatePhysics off, never grabbed) cost nothing to keep as they are
+	if (!Body->IsSimulatingPhysics())
+		return;
+
+	const bool bIsAwake = Body->RigidBodyIsAwake();
+	Entry.RestingTime = bIsAwake ? 0.0f : Entry.RestingTime + ElapsedTime;
+
+	const float SpeedSquared = bIsAwake ? Body->GetPhysicsLinearVelocity().SizeSquared() : 0.0f;
+	if (SpeedSquared > FMath::Square(ImpactSpeedThreshold))
+	{
+		PromoteNearImpact(Grabbable);
+	}
+
+	const bool bIsFar = DistanceSquared > FMath::Square(DemoteDistance) && SpeedSquared < FMath::Square(DemoteSpeedThreshold);
+	const bool bHasSettled = Entry.RestingTime >= SleepDemoteDelay && DistanceSquared > FMath::Square(PromoteDistance);
+
+	if (bIsFar || bHasSettled)
+	{
+		DemoteGrabbable(Grabbable);
+	}
+}
+
+void UVRPhysicsLODSubsystem::PromoteNearImpact(const AVRGrabbableActor* MovingGrabbable)
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PhysicsLODImpact), false, MovingGrabbable);
+
+	ImpactOverlaps.Reset();
+	VRCollisionQuery::OverlapMultiByObjectType(GetWorld(), ImpactOverlaps, MovingGrabbable->GetActorLocation(), FQuat::Identity,
+		FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllDynamicObjects),
+		FCollisionShape::MakeSphere(ImpactPromoteRadius), QueryParams);
+
+	for (const FOverlapResult& Overlap : ImpactOverlaps)
+	{
+		AVRGrabbableActor* Other = Cast<AVRGrabbableActor>(Overlap.GetActor());
+		if (Other && Other->IsPhysicsDemoted())
+		{
+			PromoteGrabbable(Other);
+		}
+	}
+}
+
+void UVRPhysicsLODSubsystem::PromoteInRadius(const FVector& Location, float Radius)
+{
+	const float RadiusSquared = FMath::Square(Radius);
+
+	for (const FPhysicsLODEntry& Entry : Entries)
+	{
+		AVRGrabbableActor* Grabbable = Entry.Grabbable.Get();
+		if (Grabbable && Grabbable->IsPhysicsDemoted()
+			&& FVector::DistSquared(Grabbable->GetActorLocation(), Location) <= RadiusSquared)
+		{
+			PromoteGrabbable(Grabbable);
+		}
+	}
+}
+
+void UVRPhysicsLODSubsystem::PromoteGrabbable(AVRGrabbableActor* Grabbable)
+{
+	if (Grabbable && Grabbable->IsPhysicsDemoted())
+	{
+		Grabbable->PromotePhysics();
+
+		if (FPhysicsLODEntry* Entry = FindEntry(Grabbable))
+		{
+			UpdateCountedState(*Entry);
+		}
+	}
+}
+
+void UVRPhysicsLODSubsystem::DemoteGrabbable(AVRGrabbableActor* Grabbable)
+{
+	if (Grabbable && !Grabbable->IsPhysicsDemoted())
+	{
+		Grabbable->DemotePhysics();
+
+		if (FPhysicsLODEntry* Entry = FindEntry(Grabbable))
+		{
+			UpdateCountedState(*Entry);
+		}
+	}
+}
+
+UVRPhysicsLODSubsystem::FPhysicsLODEntry* UVRPhysicsLODSubsystem::FindEntry(const AVRGrabbableActor* Grabbable)
+{
+	return Entries.FindByPredicate([Grabbable](const FPhysicsLODEntry& Entry)
+	{
+		return Entry.Grabbable.Get() == Grabbable;
+	});
+}
+
+void UVRPhysicsLODSubsystem::UpdateCountedState(FPhysicsLODEntry& Entry)
+{
+	EBodyState State = EBodyState::None;
+	if (AVRGrabbableActor* Grabbable = Entry.Grabbable.Get())
+	{
+		const UPrimitiveComponent* Body = Grabbable->GetPhysicsComponent();
+		if (Grabbable->IsPhysicsDemoted())
+		{
+			State = EBodyState::Dormant;
+		}
+		else if (Body && Body->IsSimulatingPhysics())
+		{
+			State = EBodyState::Active;
+		}
+	}
+
+	if (State == Entry.CountedState)
+		return;
+
+	const auto CountOf = [](EBodyState InState, EBodyState CountedAs) { return InState == CountedAs ? 1 : 0; };
+	AdjustCounters(
+		CountOf(State, EBodyState::Active) - CountOf(Entry.CountedState, EBodyState::Active),
+		CountOf(State, EBodyState::Dormant) - CountOf(Entry.CountedState, EBodyState::Dormant));
+	Entry.CountedState = State;
+}
+
+void UVRPhysicsLODSubsystem::AdjustCounters(int32 ActiveDelta, int32 DormantDelta)
+{
+	ActiveBodyCount += ActiveDelta;
+	DormantBodyCount += DormantDelta;
+
+	INC_DWORD_STAT_BY(STAT_VRPhysicsActiveBodies, ActiveDelta);
+	INC_DWORD_STAT_BY(STAT_VRPhysicsDormantBodies, DormantDelta);
+
+	FVRPerfCounters::PhysicsActiveBodies += ActiveDelta;
+	FVRPerfCounters::PhysicsDormantBodies += DormantDelta;
+}
@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRPoolSubsystem.h"
+#include "Interfaces/VRPoolable.h"
+#include "Core/VRPerfCounters.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+UVRPoolSubsystem* UVRPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVRPoolSubsystem>() : nullptr;
+}
+
+void UVRPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (const FVRPoolPrewarm& Prewarm : PrewarmActorClasses)
+	{
+		if (UClass* ActorClass = Prewarm.ActorClass.LoadSynchronous())
+		{
+			PrewarmActors(ActorClass, Prewarm.Count);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("VRPool: Could not load prewarm class %s"), *Prewarm.ActorClass.ToString());
+		}
+	}
+}
+
+void UVRPoolSubsystem::Deinitialize()
+{
+	// The world owns the actors and tears them down itself, only the references go
+	FreeActors.Reset();
+	FreeWidgets.Reset();
+
+	Super::Deinitialize();
+}
+
+AActor* UVRPoolSubsystem::AcquireActor(UClass* ActorClass, const FTransform& Transform, AActor* Owner)
+{
+	if (!ActorClass)
+		return nullptr;
+
+	if (FVRActorFreeList* FreeList = FreeActors.Find(ActorClass))
+	{
+		while (FreeList->Actors.Num() > 0)
+		{
+			AActor* Actor = FreeList->Actors.Pop(EAllowShrinking::No);
+
+			// Something else may have destroyed it while parked (level streaming, kill Z)
+			if (!IsValid(Actor))
+				continue;
+
+			Actor->SetOwner(Owner);
+			Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+			Actor->SetActorHiddenInGame(false);
+			Actor->SetActorEnableCollision(true);
+			Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+
+			if (IVRPoolable* Poolable = Cast<IVRPoolable>(Actor))
+			{
+				Poolable->OnAcquiredFromPool();
+			}
+
+			CountHit();
+			return Actor;
+		}
+	}
+
+	CountMiss();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = Owner;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld()->SpawnActor<AActor>(ActorClass, Transform, SpawnParams);
+}
+
+void UVRPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+		return;
+
+	FVRActorFreeList& FreeList = FreeActors.FindOrAdd(Actor->GetClass());
+
+	// Releasing twice would hand the same actor out twice
+	if (FreeList.Actors.Contains(Actor))
+		return;
+
+	IVRPoolable* Poolable = Cast<IVRPoolable>(Actor);
+	if (Poolable)
+	{
+		Poolable->OnReleasedToPool();
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	if (FreeList.Actors.Num() >= MaxFreeActorsPerClass)
+	{
+		if (!Poolable || !Poolable->DestroyFromFullPool())
+		{
+			Actor->Destroy();
+		}
+		return;
+	}
+
+	FreeList.Actors.Add(Actor);
+}
+
+void UVRPoolSubsystem::PrewarmActors(UClass* ActorClass, int32 Count)
+{
+	if (!ActorClass)
+		return;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const int32 ToSpawn = FMath::Min(Count, MaxFreeActorsPerClass) - GetFreeActorCount(ActorClass);
+	for (int32 Index = 0; Index < ToSpawn; ++Index)
+	{
+		ReleaseActor(GetWorld()->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParams));
+	}
+}
+
+UUserWidget* UVRPoolSubsystem::AcquireWidget(APlayerController* OwningPlayer, TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (!OwningPlayer || !WidgetClass)
+		return nullptr;
+
+	if (FVRWidgetFreeList* FreeList = FreeWidgets.Find(WidgetClass.Get()))
+	{
+		const int32 Index = FreeList->Widgets.IndexOfByPredicate([OwningPlayer](const UUserWidget* Widget)
+		{
+			return IsValid(Widget) && Widget->GetOwningPlayer() == OwningPlayer;
+		});
+
+		if (Index != INDEX_NONE)
+		{
+			UUserWidget* Widget = FreeList->Widgets[Index];
+			FreeList->Widgets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+			if (IVRPoolable* Poolable = Cast<IVRPoolable>(Widget))
+			{
+				Poolable->OnAcquiredFromPool();
+			}
+
+			CountHit();
+			return Widget;
+		}
+	}
+
+	CountMiss();
+	return CreateWidget<UUserWidget>(OwningPlayer, WidgetClass);
+}
+
+void UVRPoolSubsystem::ReleaseWidget(UUserWidget* Widget)
+{
+	if (!IsValid(Widget))
+		return;
+
+	FVRWidgetFreeList& FreeList = FreeWidgets.FindOrAdd(Widget->GetClass());
+	if (FreeList.Widgets.Contains(Widget))
+		return;
+
+	if (IVRPoolable* Poolable = Cast<IVRPoolable>(Widget))
+	{
+		Poolable->OnReleasedToPool();
+	}
+
+	// Removing releases the Slate widget, NativeConstruct runs again when it is added back
+	Widget->RemoveFromParent();
+	FreeList.Widgets.Add(Widget);
+}
+
+void UVRPoolSubsystem::PrewarmWidgets(APlayerController* OwningPlayer, TSubclassOf<UUserWidget> WidgetClass, int32 Count)
+{
+	if (!OwningPlayer || !WidgetClass)
+		return;
+
+	// Tops up rather than adds, several owners may prewarm the same class
+	const FVRWidgetFreeList* FreeList = FreeWidgets.Find(WidgetClass.Get());
+	const int32 ToCreate = Count - (FreeList ? FreeList->Widgets.Num() : 0);
+	for (int32 Index = 0; Index < ToCreate; ++Index)
+	{
+		ReleaseWidget(CreateWidget<UUserWidget>(OwningPlayer, WidgetClass));
+	}
+}
+
+int32 UVRPoolSubsystem::GetFreeActorCount(UClass* ActorClass) const
+{
+	const FVRActorFreeList* FreeList = FreeActors.Find(ActorClass);
+	return FreeList ? FreeList->Actors.Num() : 0;
+}
+
+bool UVRPoolSubsystem::IsPooled(const AActor* Actor) const
+{
+	const FVRActorFreeList* FreeList = Actor ? FreeActors.Find(Actor->GetClass()) : nullptr;
+	return FreeList && FreeList->Actors.Contains(Actor);
+}
+
+void UVRPoolSubsystem::CountHit()
+{
+	++HitCount;
+	INC_DWORD_STAT(STAT_VRPoolHits);
+	++FVRPerfCounters::PoolHits;
+}
+
+void UVRPoolSubsystem::CountMiss()
+{
+	++MissCount;
+	INC_DWORD_STAT(STAT_VRPoolMisses);
+	++FVRPerfCounters::PoolMisses;
+}
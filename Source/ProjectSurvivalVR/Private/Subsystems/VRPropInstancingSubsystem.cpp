@@ -0,0 +1,230 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRPropInstancingSubsystem.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "Core/VRPerfCounters.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+
+UVRPropInstancingSubsystem* UVRPropInstancingSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVRPropInstancingSubsystem>() : nullptr;
+}
+
+void UVRPropInstancingSubsystem::Deinitialize()
+{
+	AdjustInstanceCount(-InstanceCount);
+	PropSets.Reset();
+	Grabbables.Reset();
+	InstanceHost = nullptr;
+
+	Super::Deinitialize();
+}
+
+TStatId UVRPropInstancingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRPropInstancingSubsystem, STATGROUP_Tickables);
+}
+
+void UVRPropInstancingSubsystem::RegisterGrabbable(AVRGrabbableActor* Grabbable)
+{
+	if (Grabbable)
+	{
+		Grabbables.AddUnique(Grabbable);
+	}
+}
+
+void UVRPropInstancingSubsystem::UnregisterGrabbable(AVRGrabbableActor* Grabbable)
+{
+	Grabbables.RemoveSingleSwap(Grabbable, EAllowShrinking::No);
+}
+
+void UVRPropInstancingSubsystem::GatherRecords(TArray<FGrabbableStateRecord>& OutRecords) const
+{
+	for (const TPair<TSubclassOf<AVRGrabbableActor>, FInstancedPropSet>& Pair : PropSets)
+	{
+		const FInstancedPropSet& PropSet = Pair.Value;
+		for (int32 Slot = 0; Slot < PropSet.Records.Num(); ++Slot)
+		{
+			// Free slots keep a default record with no class
+			if (PropSet.Records[Slot].ActorClass)
+			{
+				OutRecords.Add(PropSet.Records[Slot]);
+			}
+		}
+	}
+}
+
+void UVRPropInstancingSubsystem::ClearInstances()
+{
+	for (TPair<TSubclassOf<AVRGrabbableActor>, FInstancedPropSet>& Pair : PropSets)
+	{
+		FInstancedPropSet& PropSet = Pair.Value;
+		if (PropSet.Component)
+		{
+			PropSet.Component->ClearInstances();
+		}
+		PropSet.Records.Reset();
+		PropSet.FreeSlots.Reset();
+	}
+
+	AdjustInstanceCount(-InstanceCount);
+}
+
+void UVRPropInstancingSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceEvaluation += DeltaTime;
+	if (TimeSinceEvaluation < EvaluationInterval)
+		return;
+
+	TimeSinceEvaluation = 0.0f;
+	FocusPoints.Gather(GetWorld());
+
+	if (FocusPoints.IsEmpty())
+		return;
+
+	const float DemoteDistanceSquared = FMath::Square(DemoteDistance);
+	const float PromoteDistanceSquared = FMath::Square(PromoteDistance);
+
+	// Actors resting far away collapse into instances
+	for (int32 Index = Grabbables.Num() - 1; Index >= 0; --Index)
+	{
+		AVRGrabbableActor* Grabbable = Grabbables[Index].Get();
+		if (!Grabbable)
+		{
+			Grabbables.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// Forage items (owned by their spawner) are already pooled by it once the player walks away
+		if (Grabbable->IsHidden() || Grabbable->IsBeingHeld() || !Grabbable->IsPhysicsDemoted() || Grabbable->GetOwner())
+			continue;
+
+		if (FocusPoints.GetDistanceSquared(Grabbable->GetActorLocation()) > DemoteDistanceSquared)
+		{
+			DemoteToInstance(Grabbable);
+		}
+	}
+
+	// Instances the player walked up to become actors again
+	for (TPair<TSubclassOf<AVRGrabbableActor>, FInstancedPropSet>& Pair : PropSets)
+	{
+		FInstancedPropSet& PropSet = Pair.Value;
+		for (int32 Slot = 0; Slot < PropSet.Records.Num(); ++Slot)
+		{
+			if (!PropSet.Records[Slot].ActorClass)
+				continue;
+
+			if (FocusPoints.GetDistanceSquared(PropSet.Records[Slot].Transform.GetLocation()) < PromoteDistanceSquared)
+			{
+				PromoteInstance(PropSet, Slot);
+			}
+		}
+	}
+}
+
+void UVRPropInstancingSubsystem::DemoteToInstance(AVRGrabbableActor* Grabbable)
+{
+	FInstancedPropSet& PropSet = FindOrAddPropSet(Grabbable);
+	if (!PropSet.Component)
+		return;
+
+	FGrabbableStateRecord Record;
+	Grabbable->SaveState(Record);
+
+	int32 Slot;
+	if (PropSet.FreeSlots.Num() > 0)
+	{
+		Slot = PropSet.FreeSlots.Pop(EAllowShrinking::No);
+		PropSet.Component->UpdateInstanceTransform(Slot, Record.Transform, true, true, true);
+		PropSet.Records[Slot] = Record;
+	}
+	else
+	{
+		Slot = PropSet.Component->AddInstance(Record.Transform, true);
+		PropSet.Records.SetNum(FMath::Max(PropSet.Records.Num(), Slot + 1));
+		PropSet.Records[Slot] = Record;
+	}
+
+	AdjustInstanceCount(1);
+
+	// The pool parks it for the next promotion, or destroys it once enough of this class are parked
+	if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+	{
+		Pool->ReleaseActor(Grabbable);
+	}
+	else
+	{
+		Grabbable->Destroy();
+	}
+}
+
+void UVRPropInstancingSubsystem::PromoteInstance(FInstancedPropSet& PropSet, int32 Slot)
+{
+	const FGrabbableStateRecord Record = PropSet.Records[Slot];
+
+	UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+	AVRGrabbableActor* Grabbable = Pool ? Pool->AcquireActor<AVRGrabbableActor>(Record.ActorClass, Record.Transform) : nullptr;
+	if (!Grabbable)
+		return;
+
+	Grabbable->LoadState(Record);
+
+	// Free the slot, a zero-scaled instance is cheaper than removing and re-indexing the HISM
+	PropSet.Records[Slot] = FGrabbableStateRecord();
+	PropSet.FreeSlots.Add(Slot);
+	PropSet.Component->UpdateInstanceTransform(Slot, FTransform(FQuat::Identity, Record.Transform.GetLocation(), FVector::ZeroVector), true, true, true);
+
+	AdjustInstanceCount(-1);
+}
+
+FInstancedPropSet& UVRPropInstancingSubsystem::FindOrAddPropSet(AVRGrabbableActor* Template)
+{
+	FInstancedPropSet& PropSet = PropSets.FindOrAdd(Template->GetClass());
+	if (PropSet.Component)
+		return PropSet;
+
+	UStaticMeshComponent* TemplateMesh = Template->GetActorMesh();
+	if (!TemplateMesh || !TemplateMesh->GetStaticMesh())
+		return PropSet;
+
+	if (!InstanceHost)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Name = TEXT("VRPropInstanceHost");
+		SpawnParams.ObjectFlags = RF_Transient;
+		InstanceHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+		USceneComponent* HostRoot = NewObject<USceneComponent>(InstanceHost, TEXT("Root"));
+		InstanceHost->SetRootComponent(HostRoot);
+		HostRoot->RegisterComponent();
+	}
+
+	// Visual only, players never touch props this far away and promotion happens well before
+	UHierarchicalInstancedStaticMeshComponent* Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstanceHost);
+	Component->SetStaticMesh(TemplateMesh->GetStaticMesh());
+	for (int32 MaterialIndex = 0; MaterialIndex < TemplateMesh->GetNumMaterials(); ++MaterialIndex)
+	{
+		Component->SetMaterial(MaterialIndex, TemplateMesh->GetMaterial(MaterialIndex));
+	}
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->SetGenerateOverlapEvents(false);
+	// Instances come and go at runtime, which static lighting, navigation and cooked static data do not allow
+	Component->SetMobility(EComponentMobility::Movable);
+	Component->SetupAttachment(InstanceHost->GetRootComponent());
+	Component->RegisterComponent();
+
+	PropSet.Component = Component;
+	return PropSet;
+}
+
+void UVRPropInstancingSubsystem::AdjustInstanceCount(int32 Delta)
+{
+	InstanceCount += Delta;
+	INC_DWORD_STAT_BY(STAT_VRInstancedProps, Delta);
+	FVRPerfCounters::InstancedProps += Delta;
+}
@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRSaveSubsystem.h"
+#include "Async/Async.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	// "PSVR", tells a save apart from a truncated or foreign file before anything is decompressed
+	constexpr uint32 SaveFileMagic = 0x52565350;
+
+	// Far above any real save, a larger size in the header is corruption and nothing is allocated for it
+	constexpr int32 MaxRawSaveSize = 64 * 1024 * 1024;
+
+	bool WriteSaveFile(const FString& Path, FVRSaveGame& Save)
+	{
+		TArray<uint8> RawData;
+		FMemoryWriter RawWriter(RawData);
+		Save.Serialize(RawWriter);
+
+		int32 RawSize = RawData.Num();
+		if (RawSize > MaxRawSaveSize)
+			return false;
+
+		TArray<uint8> CompressedData;
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, RawSize);
+		CompressedData.SetNumUninitialized(CompressedSize);
+
+		if (!FCompression::CompressMemory(NAME_Oodle, CompressedData.GetData(), CompressedSize, RawData.GetData(), RawSize))
+			return false;
+
+		TArray<uint8> FileData;
+		FMemoryWriter FileWriter(FileData);
+		uint32 Magic = SaveFileMagic;
+		int32 Version = Save.Version;
+		uint32 Checksum = FCrc::MemCrc32(CompressedData.GetData(), CompressedSize);
+		FileWriter << Magic << Version << RawSize << Checksum;
+		FileData.Append(CompressedData.GetData(), CompressedSize);
+
+		// Written aside and swapped in, so a crash mid-write never costs the last good save
+		const FString TempPath = Path + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(FileData, *TempPath))
+			return false;
+
+		return IFileManager::Get().Move(*Path, *TempPath, true, true);
+	}
+
+	TUniquePtr<FVRSaveGame> ReadSaveFile(const FString& Path)
+	{
+		TArray<uint8> FileData;
+		if (!FFileHelper::LoadFileToArray(FileData, *Path, FILEREAD_Silent))
+			return nullptr;
+
+		FMemoryReader FileReader(FileData);
+		uint32 Magic = 0;
+		int32 Version = 0;
+		int32 RawSize = 0;
+		FileReader << Magic << Version << RawSize;
+
+		if (FileReader.IsError() || Magic != SaveFileMagic || RawSize < 0 || RawSize > MaxRawSaveSize)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("VRSave: %s is not a save file, ignoring it"), *Path);
+			return nullptr;
+		}
+
+		if (Version < static_cast<int32>(EVRSaveVersion::Initial) || Version > static_cast<int32>(EVRSaveVersion::Latest))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("VRSave: %s has unknown version %d, ignoring it"), *Path, Version);
+			return nullptr;
+		}
+
+		// Files from before the checksum are taken as they are, the count checks still catch most damage
+		uint32 Checksum = 0;
+		if (Version >= static_cast<int32>(EVRSaveVersion::Checksum))
+		{
+			FileReader << Checksum;
+		}
+
+		const int32 HeaderSize = static_cast<int32>(FileReader.Tell());
+		if (FileReader.IsError() || (Version >= static_cast<int32>(EVRSaveVersion::Checksum)
+			&& Checksum != FCrc::MemCrc32(FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize)))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("VRSave: %s fails its checksum, ignoring it"), *Path);
+			return nullptr;
+		}
+
+		TArray<uint8> RawData;
+		RawData.SetNumUninitialized(RawSize);
+
+		if (!FCompression::UncompressMemory(NAME_Oodle, RawData.GetData(), RawSize, FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("VRSave: %s could not be decompressed, ignoring it"), *Path);
+			return nullptr;
+		}
+
+		TUniquePtr<FVRSaveGame> Save = MakeUnique<FVRSaveGame>();
+		FMemoryReader RawReader(RawData);
+		Save->Serialize(RawReader);
+
+		if (RawReader.IsError())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("VRSave: %s is corrupt, ignoring it"), *Path);
+			return nullptr;
+		}
+
+		// Read in whatever layout it was written in, from here on it is the current one
+		Save->Version = static_cast<int32>(EVRSaveVersion::Latest);
+		return Save;
+	}
+}
+
+UVRSaveSubsystem* UVRSaveSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UVRSaveSubsystem>() : nullptr;
+}
+
+void UVRSaveSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LoadFromDisk();
+}
+
+void UVRSaveSubsystem::Deinitialize()
+{
+	// The last autosave has to reach the disk before the game goes away
+	IOTask.Wait();
+
+	Super::Deinitialize();
+}
+
+FString UVRSaveSubsystem::GetSavePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".sav");
+}
+
+void UVRSaveSubsystem::LoadFromDisk()
+{
+	TWeakObjectPtr<UVRSaveSubsystem> WeakThis(this);
+	const FString Path = GetSavePath();
+
+	IOTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Path]()
+	{
+		TUniquePtr<FVRSaveGame> LoadedSave = ReadSaveFile(Path);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, LoadedSave = MoveTemp(LoadedSave)]() mutable
+		{
+			if (UVRSaveSubsystem* This = WeakThis.Get())
+			{
+				This->OnLoadFinished(MoveTemp(LoadedSave));
+			}
+		});
+	}, UE::Tasks::Prerequisites(IOTask));
+}
+
+void UVRSaveSubsystem::OnLoadFinished(TUniquePtr<FVRSaveGame> LoadedSave)
+{
+	if (LoadedSave)
+	{
+		SaveGame = MoveTemp(*LoadedSave);
+		UE_LOG(LogTemp, Log, TEXT("VRSave: Loaded %s (%d levels, %.1f game hours)"), *SlotName, SaveGame.Levels.Num(), SaveGame.TotalGameHours);
+	}
+
+	bLoaded = true;
+}
+
+void UVRSaveSubsystem::WriteToDisk()
+{
+	TWeakObjectPtr<UVRSaveSubsystem> WeakThis(this);
+	const FString Path = GetSavePath();
+
+	++PendingWrites;
+	IOTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Path, Snapshot = SaveGame]() mutable
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const bool bWritten = WriteSaveFile(Path, Snapshot);
+		const double WriteSeconds = FPlatformTime::Seconds() - StartTime;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Path, bWritten, WriteSeconds]()
+		{
+			if (UVRSaveSubsystem* This = WeakThis.Get())
+			{
+				--This->PendingWrites;
+			}
+
+			if (bWritten)
+			{
+				UE_LOG(LogTemp, Log, TEXT("VRSave: Wrote %s in %.1f ms (background)"), *Path, WriteSeconds * 1000.0);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("VRSave: Failed to write %s"), *Path);
+			}
+		});
+	}, UE::Tasks::Prerequisites(IOTask));
+}
+
+void UVRSaveSubsystem::DeleteSave()
+{
+	SaveGame = FVRSaveGame();
+
+	const FString Path = GetSavePath();
+	IOTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Path]()
+	{
+		IFileManager::Get().Delete(*Path, false, false, true);
+	}, UE::Tasks::Prerequisites(IOTask));
+}
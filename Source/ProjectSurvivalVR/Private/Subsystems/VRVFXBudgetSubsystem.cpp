@@ -0,0 +1,282 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRVFXBudgetSubsystem.h"
+#include "Core/VRPerfCounters.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("VFX Budget Evaluate"), STAT_VRVFXBudgetEvaluate, STATGROUP_ProjectSurvivalVR);
+
+namespace
+{
+	const FName QualityScaleParameter(TEXT("User.QualityScale"));
+}
+
+UVRVFXBudgetSubsystem* UVRVFXBudgetSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVRVFXBudgetSubsystem>() : nullptr;
+}
+
+void UVRVFXBudgetSubsystem::Deinitialize()
+{
+	for (const FVFXBudgetEntry& Entry : Entries)
+	{
+		AdjustTierCount(Entry.Tier, -1);
+	}
+	Entries.Reset();
+	RankedEntries.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UVRVFXBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRVFXBudgetSubsystem, STATGROUP_Tickables);
+}
+
+#pragma region Registration
+
+void UVRVFXBudgetSubsystem::RegisterEffect(UNiagaraComponent* Component, UNiagaraSystem* ReducedSystem, bool bWanted)
+{
+	if (!Component || FindEntry(Component))
+		return;
+
+	FVFXBudgetEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Component = Component;
+	Entry.FullSystem = Component->GetAsset();
+	Entry.ReducedSystem = ReducedSystem;
+	AdjustTierCount(EVFXBudgetTier::Inactive, 1);
+
+	// From here on the budget decides when the component ticks
+	Component->SetAutoActivate(false);
+	Component->Deactivate();
+
+	SetEffectWanted(Component, bWanted);
+}
+
+void UVRVFXBudgetSubsystem::UnregisterEffect(UNiagaraComponent* Component)
+{
+	const int32 Index = Entries.IndexOfByPredicate([Component](const FVFXBudgetEntry& Entry)
+	{
+		return Entry.Component.Get() == Component;
+	});
+
+	if (Index != INDEX_NONE)
+	{
+		AdjustTierCount(Entries[Index].Tier, -1);
+		Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void UVRVFXBudgetSubsystem::SetEffectWanted(UNiagaraComponent* Component, bool bWanted)
+{
+	FVFXBudgetEntry* Entry = FindEntry(Component);
+	if (!Entry || Entry->bWanted == bWanted)
+		return;
+
+	Entry->bWanted = bWanted;
+
+	if (!bWanted)
+	{
+		ApplyTier(*Entry, EVFXBudgetTier::Inactive);
+	}
+	else
+	{
+		// Rank it on the next tick rather than waiting out the interval, a fire lit in view shows at once
+		TimeSinceEvaluation = EvaluationInterval;
+	}
+}
+
+FVFXBudgetEntry* UVRVFXBudgetSubsystem::FindEntry(const UNiagaraComponent* Component)
+{
+	return Entries.FindByPredicate([Component](const FVFXBudgetEntry& Entry)
+	{
+		return Entry.Component.Get() == Component;
+	});
+}
+
+#pragma endregion
+
+#pragma region Ranking
+
+void UVRVFXBudgetSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceEvaluation += DeltaTime;
+	if (TimeSinceEvaluation < EvaluationInterval)
+		return;
+
+	TimeSinceEvaluation = 0.0f;
+	Evaluate();
+}
+
+void UVRVFXBudgetSubsystem::Evaluate()
+{
+	SCOPE_CYCLE_COUNTER(STAT_VRVFXBudgetEvaluate);
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const APlayerCameraManager* CameraManager = PlayerController ? PlayerController->PlayerCameraManager.Get() : nullptr;
+	if (!CameraManager)
+		return;
+
+	const FVector ViewLocation = CameraManager->GetCameraLocation();
+	const FVector ViewDirection = CameraManager->GetCameraRotation().Vector();
+	const float HalfFOVDegrees = FMath::Clamp(CameraManager->GetFOVAngle() * 0.5f, 1.0f, 89.0f);
+	const float CosViewCone = FMath::Cos(FMath::DegreesToRadians(FMath::Min(HalfFOVDegrees + ViewConeMarginDegrees, 180.0f)));
+	const float ScreenScale = 1.0f / FMath::Tan(FMath::DegreesToRadians(HalfFOVDegrees));
+
+	// Owners destroyed without unregistering, dropped before ranking so indices stay stable
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Entries[Index].Component.IsValid())
+		{
+			AdjustTierCount(Entries[Index].Tier, -1);
+			Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	RankedEntries.Reset();
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		FVFXBudgetEntry& Entry = Entries[Index];
+		if (!Entry.bWanted)
+			continue;
+
+		Entry.Score = ScoreEntry(Entry, ViewLocation, ViewDirection, CosViewCone, ScreenScale);
+		if (Entry.Score > 0.0f)
+		{
+			RankedEntries.Add(Index);
+		}
+		else
+		{
+			ApplyTier(Entry, EVFXBudgetTier::Paused);
+		}
+	}
+
+	RankedEntries.Sort([this](int32 A, int32 B)
+	{
+		return Entries[A].Score > Entries[B].Score;
+	});
+
+	for (int32 Rank = 0; Rank < RankedEntries.Num(); ++Rank)
+	{
+		EVFXBudgetTier Tier = EVFXBudgetTier::Paused;
+		if (Rank < MaxFullQualitySystems)
+		{
+			Tier = EVFXBudgetTier::Full;
+		}
+		else if (Rank < MaxFullQualitySystems + MaxReducedQualitySystems)
+		{
+			Tier = EVFXBudgetTier::Reduced;
+		}
+
+		ApplyTier(Entries[RankedEntries[Rank]], Tier);
+	}
+}
+
+float UVRVFXBudgetSubsystem::ScoreEntry(const FVFXBudgetEntry& Entry, const FVector& ViewLocation, const FVector& ViewDirection,
+	float CosViewCone, float ScreenScale) const
+{
+	const UNiagaraComponent* Component = Entry.Component.Get();
+	const FBoxSphereBounds& Bounds = Component->Bounds;
+
+	const FVector ToEffect = Bounds.Origin - ViewLocation;
+	const float Distance = ToEffect.Size();
+	if (Distance > MaxActiveDistance)
+		return 0.0f;
+
+	// Standing inside the effect always counts as on-screen
+	if (Distance > Bounds.SphereRadius && FVector::DotProduct(ToEffect / Distance, ViewDirection) < CosViewCone)
+		return 0.0f;
+
+	// Projected radius as a fraction of the half screen
+	float Score = Bounds.SphereRadius * ScreenScale / FMath::Max(Distance, 1.0f);
+	if (Entry.Tier == EVFXBudgetTier::Full)
+	{
+		Score *= FullQualityStickiness;
+	}
+	return FMath::Max(Score, UE_KINDA_SMALL_NUMBER);
+}
+
+void UVRVFXBudgetSubsystem::ApplyTier(FVFXBudgetEntry& Entry, EVFXBudgetTier NewTier)
+{
+	if (Entry.Tier == NewTier)
+		return;
+
+	UNiagaraComponent* Component = Entry.Component.Get();
+	if (!Component)
+		return;
+
+	AdjustTierCount(Entry.Tier, -1);
+	AdjustTierCount(NewTier, 1);
+	Entry.Tier = NewTier;
+
+	switch (NewTier)
+	{
+	case EVFXBudgetTier::Inactive:
+		Component->SetPaused(false);
+		Component->Deactivate();
+		break;
+
+	case EVFXBudgetTier::Full:
+	case EVFXBudgetTier::Reduced:
+	{
+		const bool bReduced = (NewTier == EVFXBudgetTier::Reduced);
+
+		// Swapping the asset restarts the system, only done when it actually changes
+		UNiagaraSystem* TargetSystem = (bReduced && Entry.ReducedSystem) ? Entry.ReducedSystem.Get() : Entry.FullSystem.Get();
+		if (TargetSystem && Component->GetAsset() != TargetSystem)
+		{
+			Component->SetAsset(TargetSystem);
+		}
+
+		Component->SetVariableFloat(QualityScaleParameter, (bReduced && !Entry.ReducedSystem) ? ReducedQualityScale : 1.0f);
+		Component->SetPaused(false);
+
+		if (!Component->IsActive())
+		{
+			Component->Activate();
+		}
+		break;
+	}
+
+	case EVFXBudgetTier::Paused:
+		// Paused systems keep their particles on screen but stop simulating
+		Component->SetPaused(true);
+		break;
+	}
+}
+
+void UVRVFXBudgetSubsystem::AdjustTierCount(EVFXBudgetTier Tier, int32 Delta)
+{
+	TierCounts[static_cast<int32>(Tier)] += Delta;
+
+	switch (Tier)
+	{
+	case EVFXBudgetTier::Full:
+		INC_DWORD_STAT_BY(STAT_VRVFXFullQuality, Delta);
+		FVRPerfCounters::VFXFullQuality += Delta;
+		break;
+
+	case EVFXBudgetTier::Reduced:
+		INC_DWORD_STAT_BY(STAT_VRVFXReducedQuality, Delta);
+		FVRPerfCounters::VFXReducedQuality += Delta;
+		break;
+
+	case EVFXBudgetTier::Paused:
+		INC_DWORD_STAT_BY(STAT_VRVFXPaused, Delta);
+		FVRPerfCounters::VFXPaused += Delta;
+		break;
+
+	default:
+		break;
+	}
+}
+
+#pragma endregion
@@ -0,0 +1,707 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/VRWorldSaveSubsystem.h"
+#include "Subsystems/VRSaveSubsystem.h"
+#include "Subsystems/VRPoolSubsystem.h"
+#include "Subsystems/VRFireSubsystem.h"
+#include "Subsystems/VRPropInstancingSubsystem.h"
+#include "Subsystems/InteractionEventSubsystem.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Actors/FireplaceActor.h"
+#include "Actors/VRForageSpawner.h"
+#include "Components/SurvivalComponent.h"
+#include "Components/VRBuildSiteComponent.h"
+#include "Components/VRInventoryComponent.h"
+#include "Environment/DayNightManager.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CoreDelegates.h"
+
+namespace
+{
+	bool IsSavedSite(const FVRSavedBuildSite& SavedSite, const UVRBuildSiteComponent* BuildSite)
+	{
+		return SavedSite.SiteName == BuildSite->GetFName() && SavedSite.OwnerName == BuildSite->GetOwner()->GetFName();
+	}
+}
+
+UVRWorldSaveSubsystem* UVRWorldSaveSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UVRWorldSaveSubsystem>() : nullptr;
+}
+
+bool UVRWorldSaveSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Editor worlds must never autosave
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UVRWorldSaveSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UInteractionEventSubsystem* EventSubsystem = UInteractionEventSubsystem::Get(this))
+	{
+		EventSubsystem->OnAnyGrabbed.AddUniqueDynamic(this, &UVRWorldSaveSubsystem::HandleGrabbed);
+	}
+
+	// Standalone headsets suspend or kill the app when it leaves the foreground
+	WillDeactivateHandle = FCoreDelegates::ApplicationWillEnterBackgroundDelegate.AddUObject(this, &UVRWorldSaveSubsystem::HandleApplicationWillDeactivate);
+	WillTerminateHandle = FCoreDelegates::ApplicationWillTerminateDelegate.AddUObject(this, &UVRWorldSaveSubsystem::HandleApplicationWillDeactivate);
+}
+
+void UVRWorldSaveSubsystem::Deinitialize()
+{
+	if (UInteractionEventSubsystem* EventSubsystem = UInteractionEventSubsystem::Get(this))
+	{
+		EventSubsystem->OnAnyGrabbed.RemoveDynamic(this, &UVRWorldSaveSubsystem::HandleGrabbed);
+	}
+
+	FCoreDelegates::ApplicationWillEnterBackgroundDelegate.Remove(WillDeactivateHandle);
+	FCoreDelegates::ApplicationWillTerminateDelegate.Remove(WillTerminateHandle);
+
+	CaptureQueue.Reset();
+	CaptureCallback.Unbind();
+	BuildSites.Reset();
+	bCapturing = false;
+
+	Super::Deinitialize();
+}
+
+TStatId UVRWorldSaveSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRWorldSaveSubsystem, STATGROUP_Tickables);
+}
+
+void UVRWorldSaveSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UVRSaveSubsystem* SaveSubsystem = UVRSaveSubsystem::Get(this);
+	if (!SaveSubsystem || !SaveSubsystem->IsLoaded())
+		return;
+
+	if (!bAppliedSave)
+	{
+		ApplyLoadedSave();
+		return;
+	}
+
+	if (bCapturing && ContinueCapture(FPlatformTime::Seconds() + CaptureBudgetMs / 1000.0))
+	{
+		FinishCapture();
+	}
+
+	TimeSinceRestore += DeltaTime;
+	if (TimeSinceRestore >= RestoreInterval)
+	{
+		TimeSinceRestore = 0.0f;
+		RestorePendingFires();
+		RestorePendingForage();
+		RestorePendingBuildSites();
+		RestoreNearbyCells();
+	}
+
+	if (AutosaveInterval > 0.0f)
+	{
+		TimeSinceAutosave += DeltaTime;
+		if (TimeSinceAutosave >= AutosaveInterval)
+		{
+			RequestSave();
+		}
+	}
+}
+
+#pragma region Saving
+
+void UVRWorldSaveSubsystem::RequestSave()
+{
+	if (RequestCapture(FOnLevelCaptured::CreateUObject(this, &UVRWorldSaveSubsystem::WriteCapturedLevel)))
+	{
+		TimeSinceAutosave = 0.0f;
+	}
+}
+
+void UVRWorldSaveSubsystem::SaveNow()
+{
+	// Saving before the save was applied would overwrite it with an untouched world
+	if (!bAppliedSave)
+		return;
+
+	// Whoever started the running capture still gets it, finished now
+	if (bCapturing)
+	{
+		ContinueCapture(TNumericLimits<double>::Max());
+		FinishCapture();
+	}
+
+	TimeSinceAutosave = 0.0f;
+	BeginCapture(FOnLevelCaptured::CreateUObject(this, &UVRWorldSaveSubsystem::WriteCapturedLevel));
+	ContinueCapture(TNumericLimits<double>::Max());
+	FinishCapture();
+}
+
+bool UVRWorldSaveSubsystem::RequestCapture(FOnLevelCaptured OnCaptured)
+{
+	if (bCapturing || !bAppliedSave)
+		return false;
+
+	BeginCapture(MoveTemp(OnCaptured));
+	return true;
+}
+
+void UVRWorldSaveSubsystem::HandleApplicationWillDeactivate()
+{
+	SaveNow();
+}
+
+void UVRWorldSaveSubsystem::BeginCapture(FOnLevelCaptured OnCaptured)
+{
+	bCapturing = true;
+	CaptureCallback = MoveTemp(OnCaptured);
+
+	Snapshot = FVRLevelSave();
+	Snapshot.RemovedPlacedActors = RemovedPlacedActors;
+	SnapshotClassIndices.Reset();
+
+	if (const UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this))
+	{
+		for (int32 FireIndex = 0; FireIndex < FireSubsystem->GetFireCount(); ++FireIndex)
+		{
+			if (const AFireplaceActor* Fire = FireSubsystem->GetFire(FireIndex))
+			{
+				FVRSavedFire& SavedFire = Snapshot.Fires.AddDefaulted_GetRef();
+				SavedFire.FireplaceName = Fire->GetFName();
+				SavedFire.FuelMass = FireSubsystem->GetFuelMass(FireIndex);
+				SavedFire.bLit = FireSubsystem->IsBurning(FireIndex);
+			}
+		}
+	}
+
+	for (TActorIterator<AVRForageSpawner> It(GetWorld()); It; ++It)
+	{
+		// A spawner that streamed in since the last restore pass still has its state pending, added below
+		const FName SpawnerName = It->GetFName();
+		if (PendingState.Forage.ContainsByPredicate([SpawnerName](const FVRSavedForage& SavedForage) { return SavedForage.SpawnerName == SpawnerName; }))
+			continue;
+
+		FVRSavedForage SavedForage;
+		It->SaveCells(SavedForage);
+		if (!SavedForage.Cells.IsEmpty())
+		{
+			Snapshot.Forage.Add(MoveTemp(SavedForage));
+		}
+	}
+
+	for (const TWeakObjectPtr<UVRBuildSiteComponent>& BuildSitePtr : BuildSites)
+	{
+		const UVRBuildSiteComponent* BuildSite = BuildSitePtr.Get();
+		if (!BuildSite || !BuildSite->GetOwner()->HasAnyFlags(RF_WasLoaded))
+			continue;
+
+		// As with spawners, a site still waiting for its loaded counts is added from the pending state
+		if (PendingState.BuildSites.ContainsByPredicate([BuildSite](const FVRSavedBuildSite& SavedSite) { return IsSavedSite(SavedSite, BuildSite); }))
+			continue;
+
+		const TArray<int32>& PlacedCounts = BuildSite->GetPlacedCounts();
+		if (!PlacedCounts.ContainsByPredicate([](int32 Count) { return Count > 0; }))
+			continue;
+
+		FVRSavedBuildSite& SavedSite = Snapshot.BuildSites.AddDefaulted_GetRef();
+		SavedSite.OwnerName = BuildSite->GetOwner()->GetFName();
+		SavedSite.SiteName = BuildSite->GetFName();
+		SavedSite.PlacedCounts = PlacedCounts;
+	}
+
+	// Loaded state that has not been restored yet is still part of the world
+	Snapshot.Fires.Append(PendingState.Fires);
+	Snapshot.Forage.Append(PendingState.Forage);
+	Snapshot.BuildSites.Append(PendingState.BuildSites);
+	Snapshot.ClassPaths = PendingState.ClassPaths;
+	Snapshot.Cells = PendingState.Cells;
+
+	// Collapsed props already are records, no actor to visit
+	if (const UVRPropInstancingSubsystem* PropInstancing = UVRPropInstancingSubsystem::Get(this))
+	{
+		TArray<FGrabbableStateRecord> Records;
+		PropInstancing->GatherRecords(Records);
+		for (const FGrabbableStateRecord& Record : Records)
+		{
+			AddItem(Snapshot, SnapshotClassIndices, Record);
+		}
+	}
+
+	CaptureQueue.Reset();
+	CaptureCursor = 0;
+	for (TActorIterator<AVRGrabbableActor> It(GetWorld()); It; ++It)
+	{
+		CaptureQueue.Add(*It);
+	}
+}
+
+bool UVRWorldSaveSubsystem::ContinueCapture(double Deadline)
+{
+	while (CaptureCursor < CaptureQueue.Num())
+	{
+		if (AVRGrabbableActor* Grabbable = CaptureQueue[CaptureCursor].Get())
+		{
+			CaptureGrabbable(Grabbable);
+		}
+		++CaptureCursor;
+
+		// Reading the clock every few actors keeps the budget check itself cheap
+		if ((CaptureCursor % 16) == 0 && FPlatformTime::Seconds() >= Deadline)
+			return false;
+	}
+
+	return true;
+}
+
+void UVRWorldSaveSubsystem::CaptureGrabbable(AVRGrabbableActor* Grabbable)
+{
+	if (Grabbable->IsActorBeingDestroyed() || IsPristinePlacedActor(Grabbable))
+		return;
+
+	// Still lying in a forage field, its spawner grows it again from the seed
+	if (Cast<AVRForageSpawner>(Grabbable->GetOwner()))
+		return;
+
+	const UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+	if (Pool && Pool->IsPooled(Grabbable))
+		return;
+
+	FGrabbableStateRecord Record;
+	Grabbable->SaveState(Record);
+	AddItem(Snapshot, SnapshotClassIndices, Record);
+}
+
+void UVRWorldSaveSubsystem::AddItem(FVRLevelSave& Level, TMap<UClass*, uint16>& ClassIndices, const FGrabbableStateRecord& Record) const
+{
+	UClass* ItemClass = Record.ActorClass.Get();
+	if (!ItemClass)
+		return;
+
+	uint16* ClassIndex = ClassIndices.Find(ItemClass);
+	if (!ClassIndex)
+	{
+		const FString ClassPath = ItemClass->GetPathName();
+		int32 PathIndex = Level.ClassPaths.Find(ClassPath);
+		if (PathIndex == INDEX_NONE)
+		{
+			PathIndex = Level.ClassPaths.Add(ClassPath);
+		}
+		ClassIndex = &ClassIndices.Add(ItemClass, static_cast<uint16>(PathIndex));
+	}
+
+	FVRSavedItem& Item = Level.Cells.FindOrAdd(GetCell(Record.Transform.GetLocation())).Items.AddDefaulted_GetRef();
+	Item.ClassIndex = *ClassIndex;
+	Item.Transform = Record.Transform;
+	Item.StateValue = Record.StateValue;
+	Item.StateFlags = Record.StateFlags;
+}
+
+void UVRWorldSaveSubsystem::FinishCapture()
+{
+	bCapturing = false;
+	CaptureQueue.Reset();
+
+	FVRLevelSave LevelState = MoveTemp(Snapshot);
+	Snapshot = FVRLevelSave();
+	SnapshotClassIndices.Reset();
+
+	// Unbound first, the callback may start the next capture
+	FOnLevelCaptured OnCaptured = MoveTemp(CaptureCallback);
+	CaptureCallback.Unbind();
+	OnCaptured.ExecuteIfBound(LevelState);
+}
+
+void UVRWorldSaveSubsystem::WriteCapturedLevel(FVRLevelSave& LevelState)
+{
+	UVRSaveSubsystem* SaveSubsystem = UVRSaveSubsystem::Get(this);
+	if (!SaveSubsystem)
+		return;
+
+	FVRSaveGame& SaveGame = SaveSubsystem->GetSaveGame();
+
+	// Player and clock are read last, they are tiny and should be as fresh as possible
+	if (const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0))
+	{
+		if (const USurvivalComponent* Survival = PlayerPawn->FindComponentByClass<USurvivalComponent>())
+		{
+			SaveGame.bHasPlayerState = true;
+			SaveGame.Survival.Hunger = Survival->Hunger;
+			SaveGame.Survival.Thirst = Survival->Thirst;
+			SaveGame.Survival.Temperature = Survival->Temperature;
+			SaveGame.Survival.Stamina = Survival->Stamina;
+		}
+
+		if (const UVRInventoryComponent* Inventory = PlayerPawn->FindComponentByClass<UVRInventoryComponent>())
+		{
+			SaveGame.Inventory = FVRInventorySave();
+			Inventory->SaveInventory(SaveGame.Inventory);
+		}
+	}
+
+	if (const ADayNightManager* DayNightManager = ADayNightManager::GetInstance(GetWorld()))
+	{
+		SaveGame.CurrentHour = DayNightManager->GetCurrentHour();
+		SaveGame.TotalGameHours = DayNightManager->GetTotalGameHours();
+	}
+
+	SaveGame.Levels.Add(GetLevelKey(), MoveTemp(LevelState));
+
+	SaveSubsystem->WriteToDisk();
+}
+
+#pragma endregion
+
+#pragma region Restoring
+
+void UVRWorldSaveSubsystem::ApplyLoadedSave()
+{
+	// Survival stats go on the player, wait for it to be spawned
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	if (!PlayerPawn)
+		return;
+
+	bAppliedSave = true;
+
+	const FVRSaveGame& SaveGame = UVRSaveSubsystem::Get(this)->GetSaveGame();
+
+	if (SaveGame.bHasPlayerState)
+	{
+		if (USurvivalComponent* Survival = PlayerPawn->FindComponentByClass<USurvivalComponent>())
+		{
+			Survival->Hunger = SaveGame.Survival.Hunger;
+			Survival->Thirst = SaveGame.Survival.Thirst;
+			Survival->Temperature = SaveGame.Survival.Temperature;
+			Survival->Stamina = SaveGame.Survival.Stamina;
+			Survival->RefreshViewModel();
+		}
+
+		if (UVRInventoryComponent* Inventory = PlayerPawn->FindComponentByClass<UVRInventoryComponent>())
+		{
+			Inventory->LoadInventory(SaveGame.Inventory);
+		}
+	}
+
+	if (SaveGame.TotalGameHours > 0.0)
+	{
+		if (ADayNightManager* DayNightManager = ADayNightManager::GetInstance(GetWorld()))
+		{
+			DayNightManager->RestoreClock(SaveGame.CurrentHour, SaveGame.TotalGameHours);
+		}
+	}
+
+	const FVRLevelSave* LevelSave = SaveGame.Levels.Find(GetLevelKey());
+	if (!LevelSave)
+		return;
+
+	RemovedPlacedActors = LevelSave->RemovedPlacedActors;
+	PendingState.Fires = LevelSave->Fires;
+	PendingState.Forage = LevelSave->Forage;
+	PendingState.BuildSites = LevelSave->BuildSites;
+	PendingState.Cells = LevelSave->Cells;
+	PendingState.ClassPaths = LevelSave->ClassPaths;
+
+	// Placed actors that began play before the save was read, later ones are caught in NotifyGrabbableBeganPlay
+	if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+	{
+		TArray<AVRGrabbableActor*> ToPark;
+		for (TActorIterator<AVRGrabbableActor> It(GetWorld()); It; ++It)
+		{
+			if (It->HasAnyFlags(RF_WasLoaded) && RemovedPlacedActors.Contains(It->GetFName()))
+			{
+				ToPark.Add(*It);
+			}
+		}
+
+		for (AVRGrabbableActor* Grabbable : ToPark)
+		{
+			Pool->ReleaseActor(Grabbable);
+		}
+	}
+
+	RestorePendingFires();
+	RestorePendingForage();
+	RestorePendingBuildSites();
+	RestoreNearbyCells();
+}
+
+void UVRWorldSaveSubsystem::RestoreLevel(const FVRLevelSave& LevelState)
+{
+	// A capture half way through would mix the world from before and after the restore
+	bCapturing = false;
+	CaptureQueue.Reset();
+	CaptureCallback.Unbind();
+	Snapshot = FVRLevelSave();
+	SnapshotClassIndices.Reset();
+
+	UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+	if (!Pool)
+		return;
+
+	// Everything the captured state describes as an item is spawned again, so every item goes first
+	TArray<AVRGrabbableActor*> ToRelease;
+	for (TActorIterator<AVRGrabbableActor> It(GetWorld()); It; ++It)
+	{
+		if (!It->IsActorBeingDestroyed() && !IsPristinePlacedActor(*It) && !Pool->IsPooled(*It))
+		{
+			ToRelease.Add(*It);
+		}
+	}
+
+	for (AVRGrabbableActor* Grabbable : ToRelease)
+	{
+		Pool->ReleaseActor(Grabbable);
+	}
+
+	if (UVRPropInstancingSubsystem* PropInstancing = UVRPropInstancingSubsystem::Get(this))
+	{
+		PropInstancing->ClearInstances();
+	}
+
+	// Fields picked since the capture grow back, those with captured state get it from the pending pass
+	for (TActorIterator<AVRForageSpawner> It(GetWorld()); It; ++It)
+	{
+		It->RestoreCells(FVRSavedForage());
+	}
+
+	// Items placed in a site since the capture come back as items, so the site must not keep them too
+	for (const TWeakObjectPtr<UVRBuildSiteComponent>& BuildSitePtr : BuildSites)
+	{
+		if (UVRBuildSiteComponent* BuildSite = BuildSitePtr.Get())
+		{
+			BuildSite->RestorePlacedCounts({});
+		}
+	}
+
+	PendingState = FVRLevelSave();
+	PendingState.Fires = LevelState.Fires;
+	PendingState.Forage = LevelState.Forage;
+	PendingState.BuildSites = LevelState.BuildSites;
+	PendingState.Cells = LevelState.Cells;
+	PendingState.ClassPaths = LevelState.ClassPaths;
+
+	// Placed actors stay parked once touched, those touched after the capture come back as items where they were placed
+	TMap<UClass*, uint16> ClassIndices;
+	for (const FName& PlacedName : RemovedPlacedActors)
+	{
+		if (LevelState.RemovedPlacedActors.Contains(PlacedName))
+			continue;
+
+		if (const FGrabbableStateRecord* Original = PlacedOriginals.Find(PlacedName))
+		{
+			AddItem(PendingState, ClassIndices, *Original);
+		}
+	}
+
+	RestorePendingFires();
+	RestorePendingForage();
+	RestorePendingBuildSites();
+	RestoreNearbyCells();
+}
+
+void UVRWorldSaveSubsystem::RestorePendingFires()
+{
+	UVRFireSubsystem* FireSubsystem = UVRFireSubsystem::Get(this);
+	TArray<FVRSavedFire>& PendingFires = PendingState.Fires;
+	if (PendingFires.IsEmpty() || !FireSubsystem)
+		return;
+
+	// Fireplaces register as they stream in, so a fire may only find its fireplace on a later pass
+	for (int32 FireIndex = 0; FireIndex < FireSubsystem->GetFireCount(); ++FireIndex)
+	{
+		const AFireplaceActor* Fire = FireSubsystem->GetFire(FireIndex);
+		if (!Fire)
+			continue;
+
+		const FName FireName = Fire->GetFName();
+		const int32 PendingIndex = PendingFires.IndexOfByPredicate([FireName](const FVRSavedFire& SavedFire)
+		{
+			return SavedFire.FireplaceName == FireName;
+		});
+
+		if (PendingIndex != INDEX_NONE)
+		{
+			FireSubsystem->RestoreFire(FireIndex, PendingFires[PendingIndex].FuelMass, PendingFires[PendingIndex].bLit);
+			PendingFires.RemoveAtSwap(PendingIndex, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+void UVRWorldSaveSubsystem::RestorePendingForage()
+{
+	TArray<FVRSavedForage>& PendingForage = PendingState.Forage;
+	if (PendingForage.IsEmpty())
+		return;
+
+	// Spawners stream in like fireplaces, each one picks up its state once it is there
+	for (TActorIterator<AVRForageSpawner> It(GetWorld()); It; ++It)
+	{
+		const FName SpawnerName = It->GetFName();
+		const int32 PendingIndex = PendingForage.IndexOfByPredicate([SpawnerName](const FVRSavedForage& SavedForage)
+		{
+			return SavedForage.SpawnerName == SpawnerName;
+		});
+
+		if (PendingIndex != INDEX_NONE)
+		{
+			It->RestoreCells(PendingForage[PendingIndex]);
+			PendingForage.RemoveAtSwap(PendingIndex, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+void UVRWorldSaveSubsystem::RestorePendingBuildSites()
+{
+	TArray<FVRSavedBuildSite>& PendingSites = PendingState.BuildSites;
+	if (PendingSites.IsEmpty())
+		return;
+
+	// Restored on a pass rather than in the site's BeginPlay, owners may still set their recipe there
+	for (const TWeakObjectPtr<UVRBuildSiteComponent>& BuildSitePtr : BuildSites)
+	{
+		UVRBuildSiteComponent* BuildSite = BuildSitePtr.Get();
+		if (!BuildSite)
+			continue;
+
+		const int32 PendingIndex = PendingSites.IndexOfByPredicate([BuildSite](const FVRSavedBuildSite& SavedSite)
+		{
+			return IsSavedSite(SavedSite, BuildSite);
+		});
+
+		if (PendingIndex != INDEX_NONE)
+		{
+			BuildSite->RestorePlacedCounts(PendingSites[PendingIndex].PlacedCounts);
+			PendingSites.RemoveAtSwap(PendingIndex, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+void UVRWorldSaveSubsystem::RestoreNearbyCells()
+{
+	if (PendingState.Cells.IsEmpty())
+		return;
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this);
+	if (!PlayerPawn || !Pool)
+		return;
+
+	const FVector2D PlayerLocation(PlayerPawn->GetActorLocation());
+	const double RestoreRadiusSquared = FMath::Square(RestoreRadius);
+
+	const TArray<FString>& PendingClassPaths = PendingState.ClassPaths;
+	for (auto It = PendingState.Cells.CreateIterator(); It; ++It)
+	{
+		const FVector2D CellCentre = (FVector2D(It.Key()) + FVector2D(0.5, 0.5)) * CellSize;
+		if (FVector2D::DistSquared(CellCentre, PlayerLocation) > RestoreRadiusSquared)
+			continue;
+
+		for (const FVRSavedItem& Item : It.Value().Items)
+		{
+			if (!PendingClassPaths.IsValidIndex(Item.ClassIndex))
+				continue;
+
+			// Item classes are the level's own, so they are normally in memory already and this does not load
+			const TSoftClassPtr<AVRGrabbableActor> ItemClass{FSoftObjectPath(PendingClassPaths[Item.ClassIndex])};
+			UClass* LoadedClass = ItemClass.LoadSynchronous();
+			if (!LoadedClass)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("VRWorldSave: Saved item class %s no longer exists"), *PendingClassPaths[Item.ClassIndex]);
+				continue;
+			}
+
+			AVRGrabbableActor* Grabbable = Pool->AcquireActor<AVRGrabbableActor>(LoadedClass, Item.Transform);
+			if (!Grabbable)
+				continue;
+
+			FGrabbableStateRecord Record;
+			Record.ActorClass = LoadedClass;
+			Record.Transform = Item.Transform;
+			Record.StateValue = Item.StateValue;
+			Record.StateFlags = Item.StateFlags;
+			Grabbable->LoadState(Record);
+		}
+
+		It.RemoveCurrent();
+	}
+}
+
+#pragma endregion
+
+#pragma region Placed Actors
+
+void UVRWorldSaveSubsystem::NotifyGrabbableBeganPlay(AVRGrabbableActor* Grabbable)
+{
+	// Before the save is applied ApplyLoadedSave sweeps the whole world instead
+	if (!bAppliedSave || !Grabbable || !Grabbable->HasAnyFlags(RF_WasLoaded))
+		return;
+
+	if (RemovedPlacedActors.Contains(Grabbable->GetFName()))
+	{
+		if (UVRPoolSubsystem* Pool = UVRPoolSubsystem::Get(this))
+		{
+			Pool->ReleaseActor(Grabbable);
+		}
+	}
+}
+
+void UVRWorldSaveSubsystem::NotifyGrabbableRemoved(AVRGrabbableActor* Grabbable)
+{
+	MarkPlacedActorRemoved(Grabbable);
+}
+
+void UVRWorldSaveSubsystem::HandleGrabbed(AVRGrabbableActor* GrabbedActor, USkeletalMeshComponent* HandMesh)
+{
+	// Once picked up a placed actor is saved like any other item, wherever it ends up
+	MarkPlacedActorRemoved(GrabbedActor);
+}
+
+void UVRWorldSaveSubsystem::MarkPlacedActorRemoved(AVRGrabbableActor* Grabbable)
+{
+	if (!Grabbable || !Grabbable->HasAnyFlags(RF_WasLoaded))
+		return;
+
+	bool bAlreadyRemoved = false;
+	RemovedPlacedActors.Add(Grabbable->GetFName(), &bAlreadyRemoved);
+
+	// First touch, it still is as the level placed it
+	if (!bAlreadyRemoved)
+	{
+		Grabbable->SaveState(PlacedOriginals.Add(Grabbable->GetFName()));
+	}
+}
+
+void UVRWorldSaveSubsystem::NotifyBuildSiteBeganPlay(UVRBuildSiteComponent* BuildSite)
+{
+	if (BuildSite && BuildSite->GetOwner())
+	{
+		BuildSites.AddUnique(BuildSite);
+	}
+}
+
+void UVRWorldSaveSubsystem::NotifyBuildSiteEndPlay(UVRBuildSiteComponent* BuildSite)
+{
+	BuildSites.RemoveSwap(BuildSite);
+}
+
+bool UVRWorldSaveSubsystem::IsPristinePlacedActor(const AVRGrabbableActor* Grabbable) const
+{
+	return Grabbable->HasAnyFlags(RF_WasLoaded) && !RemovedPlacedActors.Contains(Grabbable->GetFName());
+}
+
+#pragma endregion
+
+FIntPoint UVRWorldSaveSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+FString UVRWorldSaveSubsystem::GetLevelKey() const
+{
+	return UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+}
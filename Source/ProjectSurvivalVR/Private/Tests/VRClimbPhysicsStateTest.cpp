@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Actors/VRClimbableActor.h"
+#include "Characters/VRCharacterBase.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Core/VRPerfCounters.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Hands/VRHand.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRClimbPhysicsStateTest, "ProjectSurvivalVR.Interaction.ClimbDoesNotRebuildPhysicsState",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+namespace
+{
+	constexpr int32 MeasuredCycles = 8;
+
+	// The Blueprint hand carries the skeletal mesh and physics asset the climb path works on
+	const TCHAR* HandClassPath = TEXT("/Game/Blueprints/Hands/BP_RightHand.BP_RightHand_C");
+
+	template <typename T>
+	T* SpawnAt(UWorld* World, UClass* Class, const FTransform& Transform, AActor* Owner = nullptr)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = Owner;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return World->SpawnActor<T>(Class, Transform, SpawnParams);
+	}
+
+	void RunClimbCycle(AVRHand* Hand)
+	{
+		Hand->TestUpdateHoveredGrabbable();
+		Hand->TestGrabHovered();
+		Hand->ReleaseObject();
+	}
+}
+
+bool FVRClimbPhysicsStateTest::RunTest(const FString& Parameters)
+{
+	UClass* HandClass = LoadClass<AVRHand>(nullptr, HandClassPath);
+	if (!HandClass)
+	{
+		AddError(FString::Printf(TEXT("Hand class %s not found"), HandClassPath));
+		return false;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("VRClimbPhysicsStateTestWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	AVRCharacterBase* Character = SpawnAt<AVRCharacterBase>(World, AVRCharacterBase::StaticClass(), FTransform(FVector(-60.0f, 0.0f, 100.0f)));
+
+	AVRClimbableActor* Climbable = SpawnAt<AVRClimbableActor>(World, AVRClimbableActor::StaticClass(), FTransform(FRotator::ZeroRotator, FVector(0.0f, 0.0f, 100.0f), FVector(0.1f)));
+	Climbable->GetActorMesh()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+
+	AVRHand* Hand = SpawnAt<AVRHand>(World, HandClass, FTransform(FVector(0.0f, -15.0f, 100.0f)), Character);
+	Hand->TestAddOverlappingInteractable(TScriptInterface<IInteractable>(Climbable));
+
+	USkeletalMeshComponent* HandMesh = Hand->FindComponentByClass<USkeletalMeshComponent>();
+	if (!TestTrue(TEXT("The hand mesh has physics bodies"), HandMesh && HandMesh->Bodies.Num() > 0))
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return false;
+	}
+	HandMesh->SetSimulatePhysics(true);
+
+	Hand->TestUpdateHoveredGrabbable();
+	Hand->TestGrabHovered();
+	TestTrue(TEXT("The hand holds the climbable"), Hand->IsGrabbing());
+	Hand->ReleaseObject();
+
+	const uint64 RebuildsBefore = FVRPerfCounters::PhysicsStateRebuilds;
+	for (int32 Cycle = 0; Cycle < MeasuredCycles; ++Cycle)
+	{
+		RunClimbCycle(Hand);
+	}
+	TestEqual(TEXT("Physics state rebuilds while climbing hand over hand"),
+		static_cast<int64>(FVRPerfCounters::PhysicsStateRebuilds - RebuildsBefore), static_cast<int64>(0));
+
+	// A hand that lost simulation elsewhere is restored by the next grab, and that write is counted
+	HandMesh->SetSimulatePhysics(false);
+	const uint64 RebuildsBeforeRestore = FVRPerfCounters::PhysicsStateRebuilds;
+	RunClimbCycle(Hand);
+	TestEqual(TEXT("Physics state rebuilds restoring a non-simulating hand"),
+		static_cast<int64>(FVRPerfCounters::PhysicsStateRebuilds - RebuildsBeforeRestore), static_cast<int64>(1));
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Actors/VRGrabbableActor.h"
+#include "Core/VRAllocationCounter.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Hands/VRHand.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRGrabAllocationTest, "ProjectSurvivalVR.Interaction.GrabDoesNotAllocate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+namespace
+{
+	// First use of a constraint slot, the timer manager and the reserved arrays happen while warming up
+	constexpr int32 WarmUpCycles = 2;
+	constexpr int32 MeasuredCycles = 16;
+
+	template <typename T>
+	T* SpawnAt(UWorld* World, const FTransform& Transform)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return World->SpawnActor<T>(T::StaticClass(), Transform, SpawnParams);
+	}
+
+	// One hand picks the item up, the other takes hold of it too, then both let go
+	void RunGrabCycle(AVRHand* FirstHand, AVRHand* SecondHand)
+	{
+		FirstHand->TestUpdateHoveredGrabbable();
+		FirstHand->TestGrabHovered();
+		SecondHand->TestUpdateHoveredGrabbable();
+		SecondHand->TestGrabHovered();
+
+		SecondHand->ReleaseObject();
+		FirstHand->ReleaseObject();
+	}
+}
+
+bool FVRGrabAllocationTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("VRGrabAllocationTestWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	AVRGrabbableActor* Grabbable = SpawnAt<AVRGrabbableActor>(World, FTransform(FRotator::ZeroRotator, FVector(0.0f, 0.0f, 100.0f), FVector(0.1f)));
+	Grabbable->GetActorMesh()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+
+	AVRHand* FirstHand = SpawnAt<AVRHand>(World, FTransform(FVector(0.0f, -15.0f, 100.0f)));
+	AVRHand* SecondHand = SpawnAt<AVRHand>(World, FTransform(FVector(0.0f, 15.0f, 100.0f)));
+	FirstHand->TestAddOverlappingInteractable(TScriptInterface<IInteractable>(Grabbable));
+	SecondHand->TestAddOverlappingInteractable(TScriptInterface<IInteractable>(Grabbable));
+
+	FirstHand->TestUpdateHoveredGrabbable();
+	FirstHand->TestGrabHovered();
+	TestTrue(TEXT("The first hand holds the item"), FirstHand->IsGrabbing());
+	FirstHand->ReleaseObject();
+
+	for (int32 Cycle = 0; Cycle < WarmUpCycles; ++Cycle)
+	{
+		RunGrabCycle(FirstHand, SecondHand);
+	}
+
+	// Errors still go through UE_LOG and allocate, the bare fixture hands may report missing setup
+	const ELogVerbosity::Type TempVerbosity = LogTemp.GetVerbosity();
+	LogTemp.SetVerbosity(ELogVerbosity::NoLogging);
+
+	FVRAllocationCounter::Start();
+	const uint64 AllocationsBefore = FVRAllocationCounter::GetAllocations();
+
+	for (int32 Cycle = 0; Cycle < MeasuredCycles; ++Cycle)
+	{
+		RunGrabCycle(FirstHand, SecondHand);
+	}
+
+	const uint64 Allocations = FVRAllocationCounter::GetAllocations() - AllocationsBefore;
+	FVRAllocationCounter::Stop();
+	LogTemp.SetVerbosity(TempVerbosity);
+
+	TestEqual(TEXT("Game thread heap allocations while grabbing and releasing"), static_cast<int64>(Allocations), static_cast<int64>(0));
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -12,8 +12,14 @@ public class ProjectSurvivalVR : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 
-		// Uncomment if you are using Slate UI
-		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
+		// Uncomment to get grab/release/hover logging back (allocates, keep it out of device builds)
+		// PublicDefinitions.Add("VR_INTERACTION_LOGGING=1");
+
+		// Slate draws the UI layer widgets offscreen (FWidgetRenderer)
+		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
+
+		// The perf scenario writes its summary as Json
+		PrivateDependencyModuleNames.Add("Json");
 		
 		// Uncomment if you are using online features
 		// PrivateDependencyModuleNames.Add("OnlineSubsystem");
@@ -4,3 +4,14 @@
 
 #include "CoreMinimal.h"
 
+// Grab, release and hover paths must not allocate after warm-up, so their logging is compiled out
+// unless VR_INTERACTION_LOGGING=1 is added to the module definitions. Errors still use UE_LOG directly.
+#ifndef VR_INTERACTION_LOGGING
+#define VR_INTERACTION_LOGGING 0
+#endif
+
+#if VR_INTERACTION_LOGGING
+#define VR_INTERACTION_LOG(Verbosity, Format, ...) UE_LOG(LogTemp, Verbosity, Format, ##__VA_ARGS__)
+#else
+#define VR_INTERACTION_LOG(Verbosity, Format, ...)
+#endif
@@ -8,11 +8,15 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h"
 #include "NiagaraComponent.h"
+#include "Subsystems/VRFireSubsystem.h"
 #include "FireplaceActor.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFireComplete);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFireBurntOut);
 
-class AWoodLog;
+class UInstancedStaticMeshComponent;
+class UVRBuildSiteComponent;
+class UVRConstructionRecipe;
 
 UCLASS()
 class PROJECTSURVIVALVR_API AFireplaceActor : public AActor
@@ -22,9 +26,11 @@ class PROJECTSURVIVALVR_API AFireplaceActor : public AActor
 public:
 	AFireplaceActor();
 
+	virtual void PostLoad() override;
+
 protected:
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnConstruction(const FTransform& Transform) override;
 
 #pragma region Components
@@ -33,23 +39,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UStaticMeshComponent* FireplaceMesh;
 
-	// Wood log mesh components
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	UStaticMeshComponent* WoodLog1;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	UStaticMeshComponent* WoodLog2;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	UStaticMeshComponent* WoodLog3;
-
-	// Fireplace detection sphere 
+	// Takes the logs in, draws the placed ones and the ghost of the next. Its Recipe is what the fireplace is
+	// built from, the first input being the fuel. Without one it builds from the log settings below
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	USphereComponent* FireplaceDetectionSphere;
-
-	// Heat zone sphere (for intense heat when fireplace complete)
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	USphereComponent* HeatZoneSphere;
+	TObjectPtr<UVRBuildSiteComponent> BuildSite;
 
 	// Sheltered zone box (for shelter from cold)
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -67,15 +60,48 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fireplace Settings")
 	bool bEnableFireplace = true;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fireplace Settings", meta = (EditCondition = "bEnableFireplace"))
+	// Logs needed before the fire lights, at most one per log slot
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fireplace Settings", meta = (EditCondition = "bEnableFireplace", ClampMin = "1"))
 	int32 RequiredLogsCount = 3;
 
+	// Where placed logs go, relative to the fireplace mesh, the slot count is how many logs the fire holds
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fireplace Settings", meta = (EditCondition = "bEnableFireplace", MakeEditWidget))
+	TArray<FTransform> LogSlots;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fireplace Settings", meta = (EditCondition = "bEnableFireplace"))
+	UStaticMesh* LogMesh = nullptr;
+
 	// === HEAT ZONE SETTINGS ===
+
+	// Gives off heat while burning, or all the time for a fireplace without logs
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heat Zone Settings")
 	bool bEnableHeatZone = true;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heat Zone Settings", meta = (EditCondition = "bEnableHeatZone"))
-	float IntenseHeatRecoveryRate = 0.2f;
+	// Fuel, burn rate and heat falloff, simulated by UVRFireSubsystem
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heat Zone Settings")
+	FFireDescription FireDescription;
+
+#if WITH_EDITORONLY_DATA
+	// The heat zone sphere and its flat rate became FireDescription's HeatRadius and HeatOutput, copied over on load
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set HeatOutput in FireDescription"))
+	float IntenseHeatRecoveryRate_DEPRECATED = 0.2f;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set HeatRadius in FireDescription"))
+	TObjectPtr<USphereComponent> HeatZoneSphere_DEPRECATED;
+
+	// The recipe and the log detection sphere moved to BuildSite, the log meshes are drawn by it. Copied over on load
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set Recipe on the BuildSite component"))
+	TObjectPtr<UVRConstructionRecipe> Recipe_DEPRECATED;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set the radius of the BuildSite component"))
+	TObjectPtr<USphereComponent> FireplaceDetectionSphere_DEPRECATED;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Placed logs are drawn by the BuildSite component"))
+	TObjectPtr<UInstancedStaticMeshComponent> LogInstances_DEPRECATED;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "The ghost log is shown by the BuildSite component"))
+	TObjectPtr<UStaticMeshComponent> GhostLog_DEPRECATED;
+#endif
 
 	// === SHELTERED ZONE SETTINGS ===
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sheltered Zone Settings")
@@ -91,72 +117,61 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Materials", meta = (EditCondition = "bEnableFireplace"))
 	UMaterialInterface* WoodMaterial = nullptr;
 
+	// === VFX ===
+
+	// Cheaper fire the VFX budget swaps in when this fire is not among the closest, optional
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX")
+	UNiagaraSystem* ReducedFireEffects = nullptr;
+
 #pragma endregion
 
 private:
 
 #pragma region Fireplace State
 
-	// Array-based log management
-	UPROPERTY(VisibleAnywhere, Category = "Fireplace State")
-	TArray<bool> LogSlotStates;
-
-	UPROPERTY()
-	TArray<UStaticMeshComponent*> LogMeshes;
-
+	// Logs showing, slots fill from the first and burn down from the last
 	UPROPERTY(VisibleAnywhere, Category = "Fireplace State")
 	int32 PlacedLogsCount = 0;
 
-	// Current ghost effect tracking
-	UPROPERTY()
-	AWoodLog* CurrentDetectedLog = nullptr;
-
-	int32 CurrentGhostSlot = -1;
+	// Index into UVRFireSubsystem, kept up to date by the subsystem
+	int32 FireIndex = INDEX_NONE;
 
 	// State flags
 	bool bFireplaceComplete = false;
-	bool bHeatZoneActive = false;
 
 #pragma endregion
 
 #pragma region Fireplace Functions
 
-	UFUNCTION()
-	void InitializeLogArrays();
-
-	// Fireplace overlap events
-	UFUNCTION()
-	void OnFireplaceDetectionBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	UFUNCTION()
-	void OnFireplaceDetectionEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+	// The recipe from the log settings, for fireplaces without a Recipe asset
+	UVRConstructionRecipe* MakeLogRecipe();
 
 	// Fireplace logic
-	void ShowGhostEffect(AWoodLog* WoodLog);
-	void HideGhostEffect();
-	void PlaceLog();
+	void OnInputPlaced(UVRBuildSiteComponent* Site, int32 InputIndex);
 	void OnFireplaceComplete();
 
-	// Fireplace utilities
-	int32 GetNextAvailableSlot() const;
-	UStaticMeshComponent* GetLogMeshByIndex(int32 Index) const;
-	void SetLogVisibilityAndMaterial(int32 LogIndex, bool bVisible, UMaterialInterface* Material);
 	bool IsFireplaceComplete() const;
 
 #pragma endregion
 
-#pragma region Heat Zone Functions
+#pragma region Fire Simulation
 
-	// Heat zone overlap events
-	UFUNCTION()
-	void OnHeatZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	friend class UVRFireSubsystem;
 
-	UFUNCTION()
-	void OnHeatZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+	void SetFireIndex(int32 NewFireIndex) { FireIndex = NewFireIndex; }
+
+	// Called by UVRFireSubsystem after a simulation pass
+	void OnLogCountChanged(int32 NewLogCount);
+	void OnBurntOut();
+
+	// Called by UVRFireSubsystem when a save puts the fire back
+	void OnRestored(int32 NewLogCount, bool bLit);
+
+	void SetFireEffectsActive(bool bActive);
+
+#pragma endregion
+
+#pragma region Sheltered Zone Functions
 
 	// Sheltered zone overlap events  
 	UFUNCTION()
@@ -167,10 +182,6 @@ private:
 	void OnShelteredZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
-	// Heat zone management
-	void ActivateHeatZone();
-	void DeactivateHeatZone();
-
 #pragma endregion
 
 public:
@@ -178,6 +189,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Time Events")
 	FOnFireComplete OnFireComplete;
 
+	// Fired when the last of the fuel is gone, the fireplace can be refilled and relit
+	UPROPERTY(BlueprintAssignable, Category = "Time Events")
+	FOnFireBurntOut OnFireBurntOut;
+
 #pragma region Public Interface
 
 	// Check states
@@ -185,7 +200,14 @@ public:
 	bool CanLightFire() const { return bEnableFireplace && IsFireplaceComplete(); }
 
 	UFUNCTION(BlueprintCallable, Category = "Fireplace")
-	bool IsHeatZoneActive() const { return bHeatZoneActive; }
+	bool IsHeatZoneActive() const { return bEnableHeatZone && IsBurning(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Fireplace")
+	bool IsBurning() const;
+
+	// Game hours until the fire burns out unless refuelled
+	UFUNCTION(BlueprintCallable, Category = "Fireplace")
+	float GetRemainingBurnHours() const;
 
 	UFUNCTION(BlueprintCallable, Category = "Fireplace")
 	bool IsFireplaceEnabled() const { return bEnableFireplace; }
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "VRBuildSiteActor.generated.h"
+
+class UVRBuildSiteComponent;
+class UStaticMeshComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnConstructionFinished, AActor*, Result);
+
+/**
+ * A place where a recipe gets built, shelters, drying racks and snow melters alike. Once every input is in
+ * the site spawns the recipe's ResultClass in its place and removes itself. Costs nothing until an item
+ * of the recipe comes near: no tick, and placed items are instances rather than actors.
+ */
+UCLASS()
+class PROJECTSURVIVALVR_API AVRBuildSiteActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AVRBuildSiteActor();
+
+	UVRBuildSiteComponent* GetBuildSite() const { return BuildSite; }
+
+	UPROPERTY(BlueprintAssignable, Category = "Construction")
+	FOnConstructionFinished OnConstructionFinished;
+
+protected:
+	virtual void BeginPlay() override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	TObjectPtr<UVRBuildSiteComponent> BuildSite;
+
+	// Marks the spot on the ground, optional
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	TObjectPtr<UStaticMeshComponent> SiteMarker;
+
+private:
+	UFUNCTION()
+	void OnSiteCompleted(UVRBuildSiteComponent* Site);
+};
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Actors/VRActor.h"
 #include "Interfaces/Interactable.h"
+#include "Core/ClimbHoldIndex.h"
+#include "Structures/ClimbMetadata.h"
 #include "VRClimbableActor.generated.h"
 
 class AVRHand;
@@ -46,9 +48,39 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climbing|Setup")
     EClimbType ClimbType = EClimbType::Surface;
 
-    // Just track which hands are currently grabbing this climbable
+    // Just track which hands are currently grabbing this climbable, reserved for both on BeginPlay so grabbing never allocates
     UPROPERTY()
-    TArray<USkeletalMeshComponent*> GrabbingHands;
+    TArray<TObjectPtr<USkeletalMeshComponent>> GrabbingHands;
+
+#pragma region Holds
+
+    // Indexes the mesh sockets once, called on BeginPlay
+    void BuildHoldIndex();
+
+    // Holds are stored relative to the mesh, unrotated but scaled, so distances stay in world units
+    FVector3f ToHoldSpace(const FVector& WorldLocation) const;
+
+    // Socket names of the holds, the index payload is a position in this array
+    TArray<FName> HoldSocketNames;
+
+    FClimbHoldIndex HoldIndex;
+
+#pragma endregion
+
+#pragma region Baked Metadata
+
+    // Ledges, stand points and hand proxies baked offline by the ClimbBake commandlet
+    UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Climbing|Baked")
+    FClimbMetadata ClimbMetadata;
+
+    // Stand points in hold space, payload is the index in ClimbMetadata.StandPoints
+    FClimbHoldIndex StandPointIndex;
+
+    bool bUseBakedMetadata = false;
+
+    void BuildStandPointIndex();
+
+#pragma endregion
 
 public:
     // Getter for climb type
@@ -56,4 +88,31 @@ public:
     EClimbType GetClimbType() const { return ClimbType; }
     
     FName GetClosestSocketToHand(const FVector& HandLocation) const;
+
+    // Appends the hold indices within Radius of WorldLocation, keep OutHoldIndices around to avoid allocating
+    int32 GetHoldsInRadius(const FVector& WorldLocation, float Radius, TArray<int32>& OutHoldIndices) const;
+
+    int32 GetNumHolds() const { return HoldSocketNames.Num(); }
+    FName GetHoldSocketName(int32 Index) const { return HoldSocketNames.IsValidIndex(Index) ? HoldSocketNames[Index] : NAME_None; }
+    FVector GetHoldLocation(int32 Index) const;
+
+    UStaticMeshComponent* GetActorMesh() const { return ActorMesh; }
+
+    // Closest baked stand point within Radius of WorldLocation, false when there is none or nothing is baked
+    bool FindStandPoint(const FVector& WorldLocation, float Radius, FVector& OutStandLocation) const;
+
+    bool HasHandProxies() const { return bUseBakedMetadata && ClimbMetadata.HandProxies.Num() > 0; }
+
+    // Segment test against the baked hand proxies, OutTime is the hit fraction along Start-End
+    bool LineTraceHandProxies(const FVector& Start, const FVector& End, float& OutTime) const;
+
+#if WITH_EDITOR
+    void SetClimbMetadata(const FClimbMetadata& InMetadata) { ClimbMetadata = InMetadata; }
+    const FClimbMetadata& GetClimbMetadata() const { return ClimbMetadata; }
+#endif
+
+#if !UE_BUILD_SHIPPING
+    // Indexes holds of a climbable that never had BeginPlay, for the hot path benchmark
+    void TestBuildHoldIndex() { BuildHoldIndex(); }
+#endif
 };
\ No newline at end of file
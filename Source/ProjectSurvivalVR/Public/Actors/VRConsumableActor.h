@@ -8,6 +8,9 @@
 
 class USurvivalComponent;
 class AVRCharacterBase;
+class AVRConsumableActor;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnConsumableConsumed, AVRConsumableActor*, Consumable);
 
 UCLASS(Abstract)
 class PROJECTSURVIVALVR_API AVRConsumableActor : public AVRGrabbableActor
@@ -21,7 +24,6 @@ protected:
     virtual void BeginPlay() override;
     virtual void OnConstruction(const FTransform& Transform) override;
     virtual void PrepareForDestroy() override;
-    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // References to character and survival component
     UPROPERTY()
@@ -30,17 +32,31 @@ protected:
     UPROPERTY()
     USurvivalComponent* SurvivalComponent;
 
-public:
-    // Array for Reusable Consumables
-    static TArray<AVRConsumableActor*> ReusableConsumables;
+    // Fires OnConsumed and the consume events, call once per bite or sip
+    void NotifyConsumed();
 
+public:
+    // Takes a parked consumable of this class from UVRPoolSubsystem, or spawns one
     static AVRConsumableActor* GetOrCreate(UWorld* World, TSubclassOf<AVRConsumableActor> ConsumableClass, FVector Location);
+
+    // Hands the consumable back to UVRPoolSubsystem once it is used up
     void Deactivate();
-    void Reactivate(FVector NewLocation);
+
+    // Stamina restored per bite or sip, from the item table
+    UFUNCTION(BlueprintPure, Category = "VR|Consumption")
+    float GetStaminaRestorationValue() const;
 
     // Pure virtual function - must be implemented by children
     virtual void Consume() PURE_VIRTUAL(AVRConsumableActor::Consume, );
 
+    // Called by the character when the held item enters or leaves the mouth, by default consumes on contact
+    virtual void OnMouthContactBegin() { Consume(); }
+    virtual void OnMouthContactEnd() {}
+
     UFUNCTION(BlueprintImplementableEvent, Category = "VR|Consumption")
     void OnConsumed();
+
+    // Fired each time the item is eaten or sipped
+    UPROPERTY(BlueprintAssignable, Category = "VR|Events")
+    FOnConsumableConsumed OnItemConsumed;
 };
\ No newline at end of file
@@ -19,30 +19,52 @@ protected:
     virtual void PrepareForDestroy() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-    // Drink settings
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drink Settings")
-    float HydrationValue = 5.0f;
-
+    // Water left in this bottle, the rest of the drink settings come from the item table
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drink Settings")
     float TotalWaterPercentage = 100.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drink Settings")
-    float WaterDecreaseRate = 10.0f;
+#if WITH_EDITORONLY_DATA
+    // Moved to the item table, kept so the ItemTableMigration commandlet can still read them
+    UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+    float HydrationValue_DEPRECATED = 5.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drink Settings")
-    float MinimumTiltAngleForDrinking = 45.0f;
+    UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+    float WaterDecreaseRate_DEPRECATED = 10.0f;
+
+    UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+    float MinimumTiltAngleForDrinking_DEPRECATED = 45.0f;
+
+    UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+    float SipInterval_DEPRECATED = 1.0f;
 
-    // Timer for repeated consumption
+    UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+    float StaminaRestorationValue_DEPRECATED = 8.0f;
+#endif
+
+    // Timer for repeated consumption, only runs between mouth contact begin and end/release
     FTimerHandle ConsumptionTimerHandle;
 
     // Helper function
     UFUNCTION(BlueprintPure, Category = "Drink")
     bool IsProperlyTiltedForDrinking() const;
 
+    UFUNCTION()
+    void HandleReleased(AVRGrabbableActor* ReleasedActor, USkeletalMeshComponent* HandMesh);
+
+    void StopDrinking();
+
 public:
+    // Takes a single sip if the bottle is tilted and the player is thirsty
     virtual void Consume() override;
 
-    // Stamina restoration || How much stamina this drink restores per consumption
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drink")
-    float StaminaRestorationValue = 8.0f;
+    // Remaining water travels with the record
+    virtual void SaveState(FGrabbableStateRecord& OutRecord) const override;
+    virtual void LoadState(const FGrabbableStateRecord& Record) override;
+
+    virtual void OnMouthContactBegin() override;
+    virtual void OnMouthContactEnd() override;
+
+#if WITH_EDITOR
+    virtual void CopyLegacyItemSettings(FVRItemDefinition& OutDefinition) const override;
+#endif
 };
\ No newline at end of file
@@ -15,14 +15,19 @@ public:
     AVRFoodActor();
 
 protected:
-    // How much nutrition the food provides
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Food Settings")
-    float NutritionValue = 25.0f;
+#if WITH_EDITORONLY_DATA
+    // Nutrition and stamina moved to the item table, kept so the ItemTableMigration commandlet can still read them
+    UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+    float NutritionValue_DEPRECATED = 25.0f;
+
+    UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+    float StaminaRestorationValue_DEPRECATED = 15.0f;
+#endif
 
 public:
     virtual void Consume() override;
 
-    // Stamina restoration | How much stamina this food restores
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Food")
-    float StaminaRestorationValue = 15.0f;
+#if WITH_EDITOR
+    virtual void CopyLegacyItemSettings(FVRItemDefinition& OutDefinition) const override;
+#endif
 };
\ No newline at end of file
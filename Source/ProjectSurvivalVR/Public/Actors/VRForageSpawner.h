@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Structures/VRSaveData.h"
+#include "VRForageSpawner.generated.h"
+
+class AVRGrabbableActor;
+class ADayNightManager;
+class UBoxComponent;
+class USkeletalMeshComponent;
+
+// One kind of item a forage area grows
+USTRUCT(BlueprintType)
+struct FVRForageEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage")
+	TSubclassOf<AVRGrabbableActor> ItemClass;
+
+	// Spawn points per cell, all entries together get at most AVRForageSpawner::MaxSlotsPerCell
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage", meta = (ClampMin = "0", ClampMax = "16"))
+	int32 CountPerCell = 2;
+
+	// Chance a spawn point exists in a given cell, lower gives patchier fields
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Density = 1.0f;
+
+	// Game hours until the points of this entry picked in a cell grow back
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage", meta = (ClampMin = "0.0"))
+	float RespawnHours = 24.0f;
+};
+
+/**
+ * Grows food, water and wood over a large area without placing them. The area is split into square cells,
+ * each cell's spawn points come from a random stream seeded by the cell, so every visit finds the same field.
+ * Only cells within ActivationRadius of the player have actors, taken from and returned to UVRPoolSubsystem,
+ * which keeps the live item count bounded however large the area is.
+ *
+ * Picking an item up takes it out of the field for good: it becomes a normal world item and its spawn point
+ * is marked in the cell's depletion mask. An entry's picked points in a cell grow back its RespawnHours of game
+ * time after the first of them was picked. Untouched cells cost nothing, picked ones a few bytes, saved by
+ * UVRWorldSaveSubsystem.
+ */
+UCLASS()
+class PROJECTSURVIVALVR_API AVRForageSpawner : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 MaxSlotsPerCell = 16;
+
+	AVRForageSpawner();
+
+	// Picked cells, for the save
+	void SaveCells(FVRSavedForage& OutForage) const;
+
+	// Replaces the picked cells and respawns the field around the player from them
+	void RestoreCells(const FVRSavedForage& Forage);
+
+	UFUNCTION(BlueprintPure, Category = "Forage")
+	int32 GetLiveItemCount() const { return LiveItems.Num(); }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Items only grow inside this box, on whatever static ground a trace down from its top finds
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	TObjectPtr<UBoxComponent> ForageArea;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage")
+	TArray<FVRForageEntry> Entries;
+
+	// Side of one cell (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage", meta = (ClampMin = "100.0"))
+	float CellSize = 2000.0f;
+
+	// Cells whose centre is this close to the player have their items spawned (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage", meta = (ClampMin = "0.0"))
+	float ActivationRadius = 3000.0f;
+
+	// Seconds between two checks of the player's position and the respawn schedule
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage", meta = (ClampMin = "0.05"))
+	float UpdateInterval = 0.5f;
+
+	// Changes every field of this spawner, two spawners with the same seed and cell size grow alike
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage")
+	int32 Seed = 0;
+
+	// Items are placed this high above the ground they were traced on (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Forage")
+	float SurfaceOffset = 5.0f;
+
+private:
+	struct FForageSlot
+	{
+		FIntPoint Cell;
+		int32 Slot = 0;
+	};
+
+	void UpdateCells();
+	void RespawnDueCells(double Now);
+
+	// Spawns the points of SlotMask in Cell that exist and find ground
+	void SpawnSlots(const FIntPoint& Cell, uint32 SlotMask);
+	void ReleaseCell(const FIntPoint& Cell);
+	void ReleaseAll();
+	void ReleaseItem(AVRGrabbableActor* Item);
+
+	// The entry a spawn point belongs to, INDEX_NONE past the last one
+	int32 GetSlotEntry(int32 Slot) const;
+
+	// One bit per spawn point of the entry
+	uint32 GetEntrySlots(int32 EntryIndex) const;
+
+	UFUNCTION()
+	void HandleItemGrabbed(AVRGrabbableActor* GrabbedActor, USkeletalMeshComponent* HandMesh);
+
+	double GetGameHours() const;
+
+	// Cells with their items spawned
+	TSet<FIntPoint> LiveCells;
+
+	// Every spawned item still lying where it grew
+	TMap<TWeakObjectPtr<AVRGrabbableActor>, FForageSlot> LiveItems;
+
+	// Picked cells only
+	TMap<FIntPoint, FVRSavedForageCell> CellStates;
+
+	// Earliest respawn hour in CellStates, skips the scan while nothing is due
+	double NextRespawnHour = TNumericLimits<double>::Max();
+
+	int32 SlotCount = 0;
+
+	// Looked up once, the clock is asked on every update
+	mutable TWeakObjectPtr<ADayNightManager> DayNightManager;
+
+	FTimerHandle UpdateTimerHandle;
+};
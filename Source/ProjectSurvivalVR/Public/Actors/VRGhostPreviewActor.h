@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Interfaces/VRPoolable.h"
+#include "VRGhostPreviewActor.generated.h"
+
+class UStaticMeshComponent;
+class UStaticMesh;
+class UMaterialInterface;
+
+// Placement preview handed out by UVRPoolSubsystem, so dozens of build sites share the few ghosts on screen
+UCLASS(NotBlueprintable)
+class PROJECTSURVIVALVR_API AVRGhostPreviewActor : public AActor, public IVRPoolable
+{
+	GENERATED_BODY()
+
+public:
+	AVRGhostPreviewActor();
+
+	void Show(UStaticMesh* Mesh, UMaterialInterface* Material);
+
+	virtual void OnReleasedToPool() override;
+
+protected:
+	UPROPERTY(VisibleAnywhere, Category = "Components")
+	TObjectPtr<UStaticMeshComponent> GhostMesh;
+};
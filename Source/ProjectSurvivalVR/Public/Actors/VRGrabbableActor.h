@@ -5,10 +5,19 @@
 #include "CoreMinimal.h"
 #include "Actors/VRActor.h"
 #include "Interfaces/Interactable.h"
+#include "Interfaces/VRPoolable.h"
+#include "Structures/GrabPointData.h"
+#include "Structures/GrabbableStateRecord.h"
 #include "VRGrabbableActor.generated.h"
 
 class UBoxComponent;
 class UPhysicsConstraintComponent;
+class AVRGrabbableActor;
+struct FVRItemDefinition;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGrabbableGrabbed, AVRGrabbableActor*, GrabbedActor, USkeletalMeshComponent*, HandMesh);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGrabbableReleased, AVRGrabbableActor*, ReleasedActor, USkeletalMeshComponent*, HandMesh);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGrabbableHoverChanged, AVRGrabbableActor*, HoveredActor, bool, bIsHovered);
 
 UENUM(BlueprintType)
 enum class EGrabType : uint8 {
@@ -40,7 +49,7 @@ enum class EGrabState : uint8 {
 };
 
 UCLASS()
-class PROJECTSURVIVALVR_API AVRGrabbableActor : public AVRActor, public IInteractable
+class PROJECTSURVIVALVR_API AVRGrabbableActor : public AVRActor, public IInteractable, public IVRPoolable
 {
 GENERATED_BODY()
 
@@ -49,6 +58,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void OnConstruction(const FTransform& Transform) override;
 
@@ -59,6 +69,9 @@ protected:
 	virtual void OnRelease(USkeletalMeshComponent* InComponent) override;
 
 public:
+	virtual void OnHoverBegin(USkeletalMeshComponent* InComponent) override;
+	virtual void OnHoverEnd(USkeletalMeshComponent* InComponent) override;
+
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "VR|Interaction")
 	void ShowCanBeGrabbed(bool bIsGrabbable) override;
 
@@ -85,12 +98,6 @@ public:
 
 #pragma region Setup Properties
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Setup|Physics")
-    float Weight = 1.0f;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Setup|Physics")
-    bool bUseCustomWeight = false;
-
 	// Enables physics simulation on BeginPlay/Construction
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VR|Setup|Physics")
 	bool bStartSimulatePhysics = true;
@@ -104,9 +111,30 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VR|Setup")
 	EGrabType GrabType = EGrabType::None;
 
-	// Controls which grab points are available for this object
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Setup")
-	EGrabPointBehavior GrabPointBehavior = EGrabPointBehavior::None;
+	// Lets the prop instancing subsystem replace this actor by a mesh instance while it rests far away.
+	// On by default for food, drink and logs, forage fields are full of them
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Setup|Performance")
+	bool bCanBecomeInstance = false;
+
+	// Grasp data for the main grab point (baked finger curls and optional pose)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VR|GrabData")
+	FGrabPointData MainGrabData;
+
+	// Grasp data for the secondary grab point (baked finger curls and optional pose)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VR|GrabData")
+	FGrabPointData SecondaryGrabData;
+
+#if WITH_EDITORONLY_DATA
+	// Moved to the item's row in the item table, kept so the ItemTableMigration commandlet can still read them
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+	float Weight_DEPRECATED = 1.0f;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+	bool bUseCustomWeight_DEPRECATED = false;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set in the item table, see UVRItemRegistrySubsystem"))
+	EGrabPointBehavior GrabPointBehavior_DEPRECATED = EGrabPointBehavior::None;
+#endif
 
 #pragma endregion
 
@@ -140,17 +168,27 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "VR|Info")
 	USkeletalMeshComponent* SecondaryGrabPointHand = nullptr;
 
-	// Track hands that are free grabbing (not at grab points)
+	// Track hands that are free grabbing (not at grab points). Room for both hands is reserved on BeginPlay
+	// and removals never shrink it, so grabbing does not allocate
 	UPROPERTY(BlueprintReadOnly, Category = "VR|Info")
-	TArray<USkeletalMeshComponent*> FreeGrabbingHands;
+	TArray<TObjectPtr<USkeletalMeshComponent>> FreeGrabbingHands;
+
+	// Number of hands currently hovering, hover events fire on 0 <-> 1
+	uint8 HoveringHandCount = 0;
+
+	// Index of the item definition, resolved on first use
+	mutable uint16 ItemId = MAX_uint16;
 
 #pragma endregion
 
 #pragma region Physics System
 
-	// Physics constraints for second hand grabs
-	UPROPERTY(BlueprintReadOnly, Category = "VR|Physics")
-	TMap<USkeletalMeshComponent*, UPhysicsConstraintComponent*> SecondHandConstraints;
+	// Preallocated second hand constraint slots, one per grab point, reused on every grab
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VR|Physics")
+	TObjectPtr<UPhysicsConstraintComponent> MainHandConstraint;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VR|Physics")
+	TObjectPtr<UPhysicsConstraintComponent> SecondaryHandConstraint;
 
 	// Store transforms for two-handed interaction
 	FTransform InitialGripTransform;
@@ -174,25 +212,49 @@ public:
 	void ForceReleaseAllFreeGrabs();
 	EGrabPointType GetHandGrabPointType(USkeletalMeshComponent* Hand) const;
 
-	// Second hand constraint creation
+	// Second hand constraint setup on the preallocated slot of the grab point
 	void CreateSecondHandConstraint(USkeletalMeshComponent* HandMesh, UStaticMeshComponent* GrabPointComponent, bool bIsLeftHand);
+	UPhysicsConstraintComponent* GetHandConstraintSlot(EGrabPointType GrabPointType) const;
 
 	// Physics setup
 	void SetupPhysics();
 
+	// Broadcast held state transitions locally and on the world interaction bus
+	void NotifyGrabbed(USkeletalMeshComponent* HandMesh);
+	void NotifyReleased(USkeletalMeshComponent* HandMesh);
+
 #pragma endregion
 
 public:
 
+#pragma region Events
+
+	// Fired once when the object goes from not held to held
+	UPROPERTY(BlueprintAssignable, Category = "VR|Events")
+	FOnGrabbableGrabbed OnGrabbed;
+
+	// Fired once when the last hand lets go
+	UPROPERTY(BlueprintAssignable, Category = "VR|Events")
+	FOnGrabbableReleased OnReleased;
+
+	// Fired when the first hand starts or the last hand stops hovering
+	UPROPERTY(BlueprintAssignable, Category = "VR|Events")
+	FOnGrabbableHoverChanged OnHoverChanged;
+
+#pragma endregion
+
 #pragma region Getters
 
 	// Get the current grab type for this object (for special objects only)
     UFUNCTION(BlueprintPure, Category = "VR|Interaction")
 	EGrabType GetGrabType() const { return GrabType; }
 
+	// Shared tuning of this item class, one row of the item table
+	const FVRItemDefinition& GetItemDefinition() const;
+
 	// Get the grab point behavior
 	UFUNCTION(BlueprintPure, Category = "VR|Interaction")
-	EGrabPointBehavior GetGrabPointBehavior() const { return GrabPointBehavior; }
+	EGrabPointBehavior GetGrabPointBehavior() const;
 
 	// Get current grab state
 	UFUNCTION(BlueprintPure, Category = "VR|Interaction")
@@ -216,6 +278,18 @@ public:
 	UFUNCTION(BlueprintPure, Category =  "VR|Interaction")
 	bool IsBeingHeld() const { return bIsHeld; }
 
+	// True while the physics LOD has the body parked as a query-only kinematic body
+	bool IsPhysicsDemoted() const { return bPhysicsDemoted; }
+
+	// Returns how many hands are free grabbing the item
+	UFUNCTION(BlueprintPure, Category = "VR|Interaction")
+	int32 GetFreeGrabbingHandCount() const { return FreeGrabbingHands.Num(); }
+
+	// Constraint holding Hand at its grab point as the second hand, null for free grabs and the attached first hand.
+	// Replaces lookups into the former SecondHandConstraints map
+	UFUNCTION(BlueprintPure, Category = "VR|Physics")
+	UPhysicsConstraintComponent* GetSecondHandConstraint(USkeletalMeshComponent* Hand) const;
+
 #pragma endregion
 
 #pragma region Grab Point Queries
@@ -257,6 +331,18 @@ public:
 	UFUNCTION(BlueprintPure, Category = "VR|GrabPoints")
 	bool IsSecondaryGrabPointAvailable() const { return !bSecondaryGrabPointOccupied; }
 
+	// Get the grasp data for a grab point (main data is returned for None)
+	const FGrabPointData& GetGrabPointData(EGrabPointType GrabPointType) const;
+
+#if WITH_EDITOR
+	// The settings this actor carried before the item table, used by the ItemTableMigration commandlet
+	virtual void CopyLegacyItemSettings(FVRItemDefinition& OutDefinition) const;
+
+	// Used by the GraspBake commandlet to store precomputed finger curls
+	void SetBakedGrasp(EGrabPointType GrabPointType, const FBakedGrasp& InBakedGrasp);
+	void SetGrabAnimation(EGrabPointType GrabPointType, const TSoftObjectPtr<UAnimationAsset>& InGrabAnimation);
+#endif
+
 #pragma endregion
 
 #pragma region Grab System
@@ -267,6 +353,47 @@ public:
 
 #pragma endregion
 
+#pragma region State Record
+
+	// Captures class, transform and gameplay state, overridden by subclasses with extra state
+	virtual void SaveState(FGrabbableStateRecord& OutRecord) const;
+
+	// Restores what SaveState captured, the actor must not be held
+	virtual void LoadState(const FGrabbableStateRecord& Record);
+
+	bool CanBecomeInstance() const { return bCanBecomeInstance; }
+
+	// Called when a build site takes the item in, it lives on as part of the build and the actor goes back to the pool
+	virtual void NotifyPlaced();
+
+#pragma endregion
+
+#pragma region IVRPoolable
+
+	// Lets go of any hand, parks the body and drops every tick reason before the pool hides the actor
+	virtual void OnReleasedToPool() override;
+
+	// Goes through SafeDestroy, so hand constraints are broken before the actor is gone
+	virtual bool DestroyFromFullPool() override;
+
+#pragma endregion
+
+#pragma region Physics LOD
+
+	// Parks the body as query-only kinematic without overlap events, remembering its velocity
+	void DemotePhysics();
+
+	// Restores simulation, collision, overlap events and the velocity saved on demotion
+	void PromotePhysics();
+
+private:
+	bool bPhysicsDemoted = false;
+	bool bDemotedGenerateOverlapEvents = true;
+	FVector DemotedLinearVelocity = FVector::ZeroVector;
+	FVector DemotedAngularVelocity = FVector::ZeroVector;
+
+#pragma endregion
+
 #pragma region Cleanup
 
 protected:
@@ -275,6 +402,11 @@ protected:
 	virtual void PrepareForDestroy();
 	void SafeDestroy();
 
+private:
+	void FinishSafeDestroy();
+
+	FTimerHandle SafeDestroyTimerHandle;
+
 #pragma endregion
 
 };
\ No newline at end of file
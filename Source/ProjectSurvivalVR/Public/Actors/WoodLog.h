@@ -17,7 +17,4 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-
-public:
-	void NotifyPlaced();
 };
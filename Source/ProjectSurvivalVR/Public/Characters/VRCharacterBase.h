@@ -16,8 +16,11 @@
 class UCameraComponent;
 class UInputAction;
 class AVRHand;
+class AVRClimbableActor;
 class UNiagaraComponent;
 class UNavAreaBase;
+class UVRUILayerComponent;
+class UVRInventoryComponent;
 
 // Enum to manage the character's primary movement state.
 UENUM(BlueprintType)
@@ -66,6 +69,24 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Survival")
     USurvivalComponent* SurvivalComponent;
 
+    // Holsters and backpack, stored items are records rather than actors
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VR|Inventory")
+    TObjectPtr<UVRInventoryComponent> Inventory;
+
+    // Compositor layer for the survival HUD, set its WidgetClass to the HUD widget
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VR|UI")
+    TObjectPtr<UVRUILayerComponent> HUDLayer;
+
+    // Compositor layer for full screen menus (death screen, sleep fade), drawn over the HUD
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VR|UI")
+    TObjectPtr<UVRUILayerComponent> MenuLayer;
+
+public:
+    UVRUILayerComponent* GetMenuLayer() const { return MenuLayer; }
+    UVRInventoryComponent* GetInventory() const { return Inventory; }
+
+protected:
+
 #pragma endregion
 
 #pragma region Hands
@@ -214,6 +235,13 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VR|Climbing")
     float EdgeDetectionDistance = 30.0f;
 
+    // How far from the last releasing hand a baked stand point is looked for when letting go of a climbable
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VR|Climbing")
+    float LedgeStandSearchRadius = 60.0f;
+
+    // Places the character on the climbable's closest baked stand point, false when the climbable has none in reach
+    bool TryStandOnBakedLedge(const AVRHand* ReleasingHand, const AVRClimbableActor* Climbable);
+
     bool IsCharacterAtEdge() const;
     bool WouldCharacterGetPushedSideways() const;
 	FVector GetEdgeAvoidanceDirection() const;
@@ -285,7 +313,7 @@ public:
 	bool IsSprinting() const { return bIsSprinting; }
 
 	void StartClimbing(AVRHand* GrabbingHand);
-	void StopClimbing(AVRHand* ReleasingHand);
+	void StopClimbing(AVRHand* ReleasingHand, const AVRClimbableActor* Climbable = nullptr);
 
 #pragma endregion
 
@@ -321,6 +349,9 @@ protected:
     UFUNCTION(BlueprintCallable, Category = "VR|Movement|Teleport")
     void TryTeleport();
 
+    // Hands the visualizer back to UVRPoolSubsystem, it is acquired again on the next StartTeleport
+    void ReleaseTeleportVisualizer();
+
     // NavMesh area validation for teleport
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VR|Movement|Teleport")
     bool bValidateReachability = true;
@@ -353,6 +384,8 @@ private:
 public:
     bool IsOverlappingMouth() { return bIsOverlappingMouth; };
 
+    EVRMovementState GetMovementState() const { return CurrentMovementState; }
+
 #pragma endregion
 
 #pragma region Fall Detection
@@ -391,6 +424,20 @@ protected:
     UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "VR|Death")
     void OnDeath();
 
+    // Seconds on the death screen before respawning at the last checkpoint, zero leaves it to Blueprint
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VR|Death", meta = (ClampMin = "0.0"))
+    float DeathRespawnDelay = 3.0f;
+
+    FTimerHandle DeathRespawnTimerHandle;
+
+public:
+    bool HasDied() const { return bFallDetectionTriggered; }
+
+    // Puts the world, survival stats and clock back to the last checkpoint and the player where it stood,
+    // without reloading the map. False when there is no checkpoint yet
+    UFUNCTION(BlueprintCallable, Category = "VR|Death")
+    bool RespawnFromCheckpoint();
+
 #pragma endregion
 
 #pragma region Locomotion Settings
@@ -506,4 +553,16 @@ private:
 
 #pragma endregion
 
+#if !UE_BUILD_SHIPPING
+public:
+    // Same handlers the input bindings call, for the hot path benchmark, the perf scenario and tests
+    UCameraComponent* TestGetCamera() const { return Camera; }
+    AVRHand* TestGetRightHand() const { return RightHand; }
+    void TestSetMovementInput(float Forward, float Right);
+    void TestStartTeleport() { StartTeleport(); }
+    TArray<FVector> TestTeleportTrace(const FVector& StartPosition, const FVector& ForwardVector) { return TeleportTrace(StartPosition, ForwardVector); }
+    void TestTryTeleport() { TryTeleport(); }
+    bool TestIsHeadNearWall(FVector& OutWallNormal, float& OutDistance) const { return IsHeadNearWall(OutWallNormal, OutDistance); }
+    FVector TestCalculateHeadWallPenetration() const { return CalculateHeadWallPenetration(); }
+#endif
 };
\ No newline at end of file
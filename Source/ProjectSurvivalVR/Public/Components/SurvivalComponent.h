@@ -10,6 +10,8 @@
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStaminaDepleted);
 
+class USurvivalViewModel;
+
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class PROJECTSURVIVALVR_API USurvivalComponent : public UActorComponent
@@ -23,6 +25,7 @@ public:
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Survival Stats
 	
@@ -66,6 +69,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Survival | Temperature")
 	float IntenseHeatRecoveryRate = 0.2f;
 
+	// Summed heat of the burning fires around the owner, written by UVRFireSubsystem
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Survival | Temperature")
+	float FireHeatRecoveryRate = 0.0f;
+
 	// Reference to day night manager for temperature modifiers
 	UPROPERTY()
 	ADayNightManager* DayNightManager = nullptr;
@@ -213,6 +220,13 @@ public:
 
 #pragma endregion
 
+	// What the HUD binds to, created on first use and pushed to whenever a stat changes
+	UFUNCTION(BlueprintPure, Category = "Survival UI")
+	USurvivalViewModel* GetViewModel();
+
+	// Pushes the current stats to the view model, call after writing a stat directly
+	void RefreshViewModel();
+
 	UFUNCTION(BlueprintCallable, Category = "Survival | Actions")
 	void ConsumeFood(float NutritionValue);
 
@@ -232,11 +246,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Survival|Temperature")
 	void SetIntenseHeatRecoveryRate(float NewRate) { IntenseHeatRecoveryRate = NewRate; }
 
+	void SetFireHeatRecoveryRate(float NewRate) { FireHeatRecoveryRate = NewRate; }
+
 	private:
 
+	UPROPERTY()
+	TObjectPtr<USurvivalViewModel> ViewModel;
+
 	// Internal stamina processing
 	void ProcessStamina();
 
 	// Calculate current stamina depletion rate based on activity
 	float GetCurrentStaminaDepletionRate() const;
+
+#if !UE_BUILD_SHIPPING
+public:
+	// One stat update without waiting for the timer, for the hot path benchmark
+	void TestUpdateSurvivalStats() { UpdateSurvivalStats(); }
+#endif
 };
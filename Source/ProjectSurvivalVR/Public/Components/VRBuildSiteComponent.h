@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SphereComponent.h"
+#include "VRBuildSiteComponent.generated.h"
+
+class UVRConstructionRecipe;
+class AVRGrabbableActor;
+class AVRGhostPreviewActor;
+class UInstancedStaticMeshComponent;
+class USkeletalMeshComponent;
+
+class UVRBuildSiteComponent;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBuildInputPlaced, UVRBuildSiteComponent* /* Site */, int32 /* InputIndex */);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBuildSiteCompleted, UVRBuildSiteComponent*, Site);
+
+/**
+ * Build volume for a UVRConstructionRecipe. An item of a recipe input held inside the sphere shows a pooled
+ * ghost in the next free slot, releasing it places it: the item goes back to the pool and the slot is drawn
+ * by one instanced mesh per input. Each input keeps a count, and a bit in a mask once the count is met, so
+ * an item is checked and placed in constant time. Nothing ticks, everything follows grab and overlap events.
+ */
+UCLASS(ClassGroup=(VR), meta=(BlueprintSpawnableComponent))
+class PROJECTSURVIVALVR_API UVRBuildSiteComponent : public USphereComponent
+{
+	GENERATED_BODY()
+
+public:
+	UVRBuildSiteComponent();
+
+	// Changes what the site builds, everything placed so far is dropped
+	void SetRecipe(UVRConstructionRecipe* NewRecipe);
+
+	UVRConstructionRecipe* GetRecipe() const { return Recipe; }
+
+	UFUNCTION(BlueprintPure, Category = "Construction")
+	int32 GetPlacedCount(int32 InputIndex) const;
+
+	// For owners whose inputs get used up after placing, like logs burning down in a fireplace
+	UFUNCTION(BlueprintCallable, Category = "Construction")
+	void SetPlacedCount(int32 InputIndex, int32 Count);
+
+	const TArray<int32>& GetPlacedCounts() const { return PlacedCounts; }
+
+	// Puts saved counts back without completing the site, inputs past the end of Counts are emptied
+	void RestorePlacedCounts(TConstArrayView<int32> Counts);
+
+	UFUNCTION(BlueprintPure, Category = "Construction")
+	bool IsComplete() const { return RequiredMask != 0 && SatisfiedMask == RequiredMask; }
+
+	// Every placed item, after the count went up
+	FOnBuildInputPlaced OnInputPlaced;
+
+	// Once per time the last missing input is placed
+	UPROPERTY(BlueprintAssignable, Category = "Construction")
+	FOnBuildSiteCompleted OnCompleted;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction")
+	TObjectPtr<UVRConstructionRecipe> Recipe;
+
+private:
+	UFUNCTION()
+	void OnSiteBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	UFUNCTION()
+	void OnSiteEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	// Item grab events, only bound while the item is inside the site
+	UFUNCTION()
+	void OnItemGrabbed(AVRGrabbableActor* GrabbedActor, USkeletalMeshComponent* HandMesh);
+
+	UFUNCTION()
+	void OnItemReleased(AVRGrabbableActor* ReleasedActor, USkeletalMeshComponent* HandMesh);
+
+	void BindItemEvents(AVRGrabbableActor* Item);
+	void UnbindItemEvents(AVRGrabbableActor* Item);
+
+	// The recipe input Item counts for, cached per class. INDEX_NONE if it is no input
+	int32 ResolveInput(const AVRGrabbableActor* Item);
+
+	// As ResolveInput, but also INDEX_NONE while the input is full
+	int32 FindOpenInput(const AVRGrabbableActor* Item);
+
+	void BeginPreview(AVRGrabbableActor* Item);
+	void EndPreview();
+	void PlacePreviewItem();
+
+	// Sets the input's mask bit from its count and refreshes its instances
+	void OnCountChanged(int32 InputIndex);
+	void RebuildForRecipe();
+
+	// One per recipe input, created on demand
+	UPROPERTY()
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> PlacedInstances;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, int32> InputByClass;
+
+	TArray<int32> PlacedCounts;
+	uint8 SatisfiedMask = 0;
+	uint8 RequiredMask = 0;
+
+	UPROPERTY()
+	TObjectPtr<AVRGrabbableActor> PreviewItem;
+
+	UPROPERTY()
+	TObjectPtr<AVRGhostPreviewActor> Ghost;
+
+	int32 PreviewInput = INDEX_NONE;
+};
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Structures/VRInventoryItem.h"
+#include "Structures/VRSaveData.h"
+#include "VRInventoryComponent.generated.h"
+
+class AVRGrabbableActor;
+class UCameraComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryChanged);
+
+// A spot on the body that holds one item (or one stack of identical items)
+USTRUCT(BlueprintType)
+struct FVRHolster
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Inventory")
+	FName Name;
+
+	// Relative to the head, turned with its yaw only so holsters stay level (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Inventory")
+	FVector Offset = FVector::ZeroVector;
+
+	// A hand releasing or grabbing this close to the holster uses it (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Inventory", meta = (ClampMin = "1.0"))
+	float Radius = 15.0f;
+
+	// Classes this holster takes, subclasses included. Empty takes anything
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Inventory")
+	TArray<TSubclassOf<AVRGrabbableActor>> AllowedClasses;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "VR|Inventory")
+	FVRInventoryItem Item;
+};
+
+/**
+ * Body holsters and a backpack that store grabbables as FVRInventoryItem values. A hand releasing an item
+ * at a holster or over the shoulder stores it: its state is recorded and the actor goes back to
+ * UVRPoolSubsystem. Grabbing there with an empty hand takes an actor from the pool and loads the
+ * state into it, so carried items cost no actors, ticks or physics bodies.
+ */
+UCLASS(ClassGroup=(VR), meta=(BlueprintSpawnableComponent))
+class PROJECTSURVIVALVR_API UVRInventoryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UVRInventoryComponent();
+
+	// Stores an item the hand at HandLocation just let go of, if the hand is at a holster or the backpack
+	bool TryStore(AVRGrabbableActor* Grabbable, const FVector& HandLocation);
+
+	// Takes out the item at HandLocation's holster or the top of the backpack, placed at SpawnTransform
+	AVRGrabbableActor* TryWithdraw(const FVector& HandLocation, const FTransform& SpawnTransform);
+
+	UFUNCTION(BlueprintCallable, Category = "VR|Inventory")
+	bool StoreInHolster(AVRGrabbableActor* Grabbable, int32 HolsterIndex);
+
+	UFUNCTION(BlueprintCallable, Category = "VR|Inventory")
+	bool StoreInBackpack(AVRGrabbableActor* Grabbable);
+
+	UFUNCTION(BlueprintCallable, Category = "VR|Inventory")
+	AVRGrabbableActor* WithdrawFromHolster(int32 HolsterIndex, const FTransform& SpawnTransform);
+
+	UFUNCTION(BlueprintCallable, Category = "VR|Inventory")
+	AVRGrabbableActor* WithdrawFromBackpack(int32 Slot, const FTransform& SpawnTransform);
+
+	UFUNCTION(BlueprintPure, Category = "VR|Inventory")
+	FVector GetHolsterLocation(int32 HolsterIndex) const;
+
+	UFUNCTION(BlueprintPure, Category = "VR|Inventory")
+	FVector GetBackpackLocation() const;
+
+	const TArray<FVRHolster>& GetHolsters() const { return Holsters; }
+	const TArray<FVRInventoryItem>& GetBackpack() const { return Backpack; }
+
+	void SaveInventory(FVRInventorySave& OutSave) const;
+	void LoadInventory(const FVRInventorySave& Save);
+
+	UPROPERTY(BlueprintAssignable, Category = "VR|Inventory")
+	FOnInventoryChanged OnInventoryChanged;
+
+protected:
+	virtual void BeginPlay() override;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Inventory")
+	TArray<FVRHolster> Holsters;
+
+	// Behind the head, reached for over the shoulder (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Inventory")
+	FVector BackpackOffset = FVector(-20.0f, 0.0f, -10.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Inventory", meta = (ClampMin = "1.0"))
+	float BackpackRadius = 20.0f;
+
+	// Entries the backpack holds, a stack counts once
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Inventory", meta = (ClampMin = "0"))
+	int32 BackpackCapacity = 12;
+
+	// Identical items per entry
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|Inventory", meta = (ClampMin = "1"))
+	int32 MaxStackSize = 8;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "VR|Inventory")
+	TArray<FVRInventoryItem> Backpack;
+
+private:
+	// Head position with its yaw only, holster and backpack offsets are in this space
+	FTransform GetBodyTransform() const;
+
+	int32 FindHolsterAt(const FVector& Location) const;
+	bool IsInBackpackReach(const FVector& Location) const;
+	bool CanStore(const AVRGrabbableActor* Grabbable) const;
+
+	// Adds the record to Item if it stacks, false when it does not or the stack is full
+	bool AddToStack(FVRInventoryItem& Item, const FGrabbableStateRecord& Record) const;
+
+	// Returns a stored actor to the pool, its state already lives in an item
+	void Dematerialize(AVRGrabbableActor* Grabbable);
+
+	// Takes one item off Item into an actor from the pool
+	AVRGrabbableActor* Materialize(FVRInventoryItem& Item, const FTransform& SpawnTransform);
+
+	UPROPERTY()
+	TObjectPtr<UCameraComponent> Camera;
+};
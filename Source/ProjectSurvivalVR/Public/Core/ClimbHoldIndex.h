@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Static k-d tree over the holds of one climbable, stored implicitly in a flat array
+ * (the median of every range is its node). Positions are in the climbable's space,
+ * each hold carries an int32 payload chosen by the owner.
+ *
+ * Built once, queries are O(log n) and never allocate: the radius query appends
+ * to a caller-owned array that callers are expected to keep around.
+ */
+struct PROJECTSURVIVALVR_API FClimbHoldIndex
+{
+    struct FHold
+    {
+        FVector3f Position = FVector3f::ZeroVector;
+        int32 Payload = INDEX_NONE;
+    };
+
+    // Replaces the content of the index, Holds is consumed
+    void Build(TArray<FHold>&& Holds);
+    void Reset();
+
+    int32 Num() const { return Nodes.Num(); }
+    bool IsEmpty() const { return Nodes.Num() == 0; }
+
+    // Payload of the hold closest to Point, INDEX_NONE if none lies within MaxDistance
+    int32 FindNearest(const FVector3f& Point, float MaxDistance = FLT_MAX) const;
+
+    // Appends the payload of every hold within Radius of Point, returns how many were added
+    template<typename AllocatorType>
+    int32 FindInRadius(const FVector3f& Point, float Radius, TArray<int32, AllocatorType>& OutPayloads) const
+    {
+        const int32 StartNum = OutPayloads.Num();
+        ForEachInRadius(Point, Radius, [&OutPayloads](const FHold& Hold)
+        {
+            OutPayloads.Add(Hold.Payload);
+        });
+        return OutPayloads.Num() - StartNum;
+    }
+
+    // Calls Visitor(const FHold&) for every hold within Radius of Point
+    template<typename VisitorType>
+    void ForEachInRadius(const FVector3f& Point, float Radius, VisitorType&& Visitor) const
+    {
+        if (Nodes.Num() > 0)
+        {
+            VisitRadius(0, Nodes.Num(), Point, FMath::Square(Radius), Visitor);
+        }
+    }
+
+private:
+    struct FNode
+    {
+        FHold Hold;
+        uint8 SplitAxis = 0;
+    };
+
+    void BuildRange(int32 Begin, int32 End);
+    void SearchNearest(int32 Begin, int32 End, const FVector3f& Point, int32& BestNode, float& BestDistanceSquared) const;
+
+    template<typename VisitorType>
+    void VisitRadius(int32 Begin, int32 End, const FVector3f& Point, float RadiusSquared, VisitorType& Visitor) const
+    {
+        while (Begin < End)
+        {
+            const int32 Mid = Begin + (End - Begin) / 2;
+            const FNode& Node = Nodes[Mid];
+
+            if (FVector3f::DistSquared(Node.Hold.Position, Point) <= RadiusSquared)
+            {
+                Visitor(Node.Hold);
+            }
+
+            const float Delta = Point[Node.SplitAxis] - Node.Hold.Position[Node.SplitAxis];
+            const bool bFarSideInRange = FMath::Square(Delta) <= RadiusSquared;
+
+            // Recurse into the far half only when the sphere crosses the split plane, loop on the near one
+            if (Delta < 0.0f)
+            {
+                if (bFarSideInRange)
+                {
+                    VisitRadius(Mid + 1, End, Point, RadiusSquared, Visitor);
+                }
+                End = Mid;
+            }
+            else
+            {
+                if (bFarSideInRange)
+                {
+                    VisitRadius(Begin, Mid, Point, RadiusSquared, Visitor);
+                }
+                Begin = Mid + 1;
+            }
+        }
+    }
+
+    TArray<FNode> Nodes;
+};
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+/**
+ * Counts game thread heap allocations by putting a forwarding allocator in front of GMalloc.
+ * Meant for measurement runs only (benchmarks, the perf scenario), every allocation pays a thread check
+ * while it is started. The count keeps running across Start/Stop pairs, read it before and after.
+ * Not compiled into Shipping, like the perf scenario. Game thread only.
+ */
+struct PROJECTSURVIVALVR_API FVRAllocationCounter
+{
+    static void Start();
+    static void Stop();
+
+    static bool IsStarted();
+    static uint64 GetAllocations();
+};
+#endif
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "CollisionQueryParams.h"
+#include "CollisionShape.h"
+
+class UWorld;
+class UPrimitiveComponent;
+struct FOverlapResult;
+struct FPredictProjectilePathParams;
+struct FPredictProjectilePathResult;
+
+/**
+ * Counted forms of the physics queries the game issues. Each function forwards to the engine call
+ * of the same name and counts it in STAT_VRCollisionQueries and FVRPerfCounters, so every trace,
+ * sweep, overlap and closest point query made from game code goes through here.
+ * Queries the engine issues itself, such as CharacterMovement floor checks, are not counted.
+ */
+namespace VRCollisionQuery
+{
+    PROJECTSURVIVALVR_API bool LineTraceSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel TraceChannel,
+        const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam);
+
+    PROJECTSURVIVALVR_API bool LineTraceSingleByObjectType(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, const FCollisionObjectQueryParams& ObjectQueryParams,
+        const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam);
+
+    PROJECTSURVIVALVR_API bool LineTraceSingleByProfile(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, FName ProfileName,
+        const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam);
+
+    PROJECTSURVIVALVR_API bool SweepSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, const FQuat& Rot, ECollisionChannel TraceChannel,
+        const FCollisionShape& CollisionShape, const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam);
+
+    PROJECTSURVIVALVR_API bool OverlapMultiByChannel(const UWorld* World, TArray<FOverlapResult>& OutOverlaps, const FVector& Pos, const FQuat& Rot, ECollisionChannel TraceChannel,
+        const FCollisionShape& CollisionShape, const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam);
+
+    PROJECTSURVIVALVR_API bool OverlapMultiByObjectType(const UWorld* World, TArray<FOverlapResult>& OutOverlaps, const FVector& Pos, const FQuat& Rot, const FCollisionObjectQueryParams& ObjectQueryParams,
+        const FCollisionShape& CollisionShape, const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam);
+
+    PROJECTSURVIVALVR_API bool LineTraceComponent(UPrimitiveComponent* Component, FHitResult& OutHit, const FVector& Start, const FVector& End, const FCollisionQueryParams& Params);
+
+    // Returns the distance to the closest point like the component does, below zero when it has no collision
+    PROJECTSURVIVALVR_API float GetClosestPointOnCollision(const UPrimitiveComponent* Component, const FVector& Point, FVector& OutPointOnBody);
+
+    // The whole path counts as one query, it is a single call even though it traces every step
+    PROJECTSURVIVALVR_API bool PredictProjectilePath(const UObject* WorldContextObject, const FPredictProjectilePathParams& PredictParams, FPredictProjectilePathResult& PredictResult);
+}
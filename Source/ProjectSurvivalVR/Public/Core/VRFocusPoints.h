@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * Where the player is this frame: the pawn and every hand. Distance-based LOD (physics, prop
+ * instancing) measures against the closest of these, gather once per evaluation and reuse.
+ */
+struct PROJECTSURVIVALVR_API FVRFocusPoints
+{
+    void Gather(const UWorld* World);
+
+    // FLT_MAX when nothing was gathered
+    float GetDistanceSquared(const FVector& Location) const;
+
+    bool IsEmpty() const { return Points.Num() == 0; }
+
+private:
+    TArray<FVector, TInlineAllocator<3>> Points;
+};
@@ -2,10 +2,44 @@
 
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
+#include "Engine/EngineBaseTypes.h"
 #include "VRGameInstance.generated.h"
 
+class UTexture;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLevelTransition, FString, LevelName);
 
+// Where the time of one level transition went, reported once the new map is up
+USTRUCT(BlueprintType)
+struct FVRLevelTransitionTiming
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Level Management")
+    FString LevelName;
+
+    // Request until the map packages finished loading in the background
+    UPROPERTY(BlueprintReadOnly, Category = "Level Management")
+    float AsyncLoadSeconds = 0.0f;
+
+    // Loaded until the switch, waiting out the minimum transition delay
+    UPROPERTY(BlueprintReadOnly, Category = "Level Management")
+    float WaitSeconds = 0.0f;
+
+    // OpenLevel until the new world began play, the only part that blocks the game thread
+    UPROPERTY(BlueprintReadOnly, Category = "Level Management")
+    float MapLoadSeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Level Management")
+    float TotalSeconds = 0.0f;
+
+    // False if the background load failed and the map was loaded synchronously instead
+    UPROPERTY(BlueprintReadOnly, Category = "Level Management")
+    bool bWasPreloaded = false;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLevelTransitionCompleted, const FVRLevelTransitionTiming&, Timing);
+
 UCLASS()
 class PROJECTSURVIVALVR_API UVRGameInstance : public UGameInstance
 {
@@ -16,6 +50,7 @@ public:
 
 protected:
     virtual void Init() override;
+    virtual void Shutdown() override;
 
 #pragma region Level Management
 
@@ -27,6 +62,10 @@ protected:
 
     FTimerHandle LevelTransitionTimer;
 
+    // Shown by the XR compositor while the next map loads, so head tracking never freezes
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Levels")
+    TObjectPtr<UTexture> LoadingSplashTexture;
+
 #pragma endregion
 
 public:
@@ -41,11 +80,12 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Level Management")
     void GoToMenu();
 
-    // Generic level transition with delay
+    // Starts loading the level in the background right away and switches once it is loaded,
+    // but never before DelaySeconds so fades have time to play
     UFUNCTION(BlueprintCallable, Category = "Level Management")
     void TransitionToLevel(const FString& LevelName, float DelaySeconds = 0.5f);
 
-    // Immediate level transition
+    // Immediate level transition, blocks on the whole map load
     UFUNCTION(BlueprintCallable, Category = "Level Management")
     void TransitionToLevelImmediate(const FString& LevelName);
 
@@ -59,6 +99,12 @@ public:
     UFUNCTION(BlueprintPure, Category = "Level Management")
     FString GetGameLevelName() const { return GameLevelName; }
 
+    UFUNCTION(BlueprintPure, Category = "Level Management")
+    bool IsTransitionInProgress() const { return !PendingLevelName.IsEmpty(); }
+
+    UFUNCTION(BlueprintPure, Category = "Level Management")
+    const FVRLevelTransitionTiming& GetLastTransitionTiming() const { return LastTransitionTiming; }
+
     UFUNCTION(BlueprintCallable, Category = "Level Management")
     void SetMenuLevelName(const FString& NewMenuLevel) { MenuLevelName = NewMenuLevel; }
 
@@ -72,6 +118,9 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Level Management")
     FOnLevelTransition OnLevelTransition;
 
+    UPROPERTY(BlueprintAssignable, Category = "Level Management")
+    FOnLevelTransitionCompleted OnLevelTransitionCompleted;
+
     UFUNCTION(BlueprintImplementableEvent, Category = "Level Management")
     void OnReturnToGameStarted();
 
@@ -82,4 +131,30 @@ public:
 
 protected:
     void ExecuteLevelTransition(const FString& LevelName);
+
+private:
+    void OnLevelPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+    void OnTransitionDelayElapsed();
+    void TryFinishTransition();
+    void OnTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString);
+    void OnPostLoadMap(UWorld* LoadedWorld);
+
+    // Back to no transition in progress, after the level opened, failed to open or was replaced
+    void ResetTransition();
+
+    // Keeps the preloaded map alive until OpenLevel picks it up
+    UPROPERTY()
+    TObjectPtr<UPackage> PreloadedLevelPackage;
+
+    FVRLevelTransitionTiming LastTransitionTiming;
+
+    // Set while a transition is running
+    FString PendingLevelName;
+    FName PendingPackageName;
+    bool bLevelPackageLoaded = false;
+    bool bTransitionDelayElapsed = false;
+
+    double TransitionRequestTime = 0.0;
+    double LevelLoadedTime = 0.0;
+    double OpenLevelTime = 0.0;
 };
\ No newline at end of file
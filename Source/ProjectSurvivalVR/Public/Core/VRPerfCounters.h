@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// "stat ProjectSurvivalVR" in the console shows every counter below
+DECLARE_STATS_GROUP(TEXT("ProjectSurvivalVR"), STATGROUP_ProjectSurvivalVR, STATCAT_Advanced);
+
+// Per-frame counters, reset by the stats system every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Render Writes Avoided"), STAT_VRRenderWritesAvoided, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Physics State Rebuilds"), STAT_VRPhysicsStateRebuilds, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pool Hits"), STAT_VRPoolHits, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pool Misses"), STAT_VRPoolMisses, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("UI Layer Redraws"), STAT_VRUILayerRedraws, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Collision Queries"), STAT_VRCollisionQueries, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+
+// Persistent gauges, kept up to date as state changes
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Tick Demand Active Actors"), STAT_VRTickDemandActiveActors, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Physics LOD Active Bodies"), STAT_VRPhysicsActiveBodies, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Physics LOD Dormant Bodies"), STAT_VRPhysicsDormantBodies, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Instanced Props"), STAT_VRInstancedProps, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Burning Fires"), STAT_VRBurningFires, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("VFX Full Quality"), STAT_VRVFXFullQuality, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("VFX Reduced Quality"), STAT_VRVFXReducedQuality, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("VFX Paused"), STAT_VRVFXPaused, STATGROUP_ProjectSurvivalVR, PROJECTSURVIVALVR_API);
+
+/**
+ * Running totals of the same counters. Stats are compiled out of Shipping builds,
+ * these are not, so benchmarks and automation can read them in any configuration.
+ * Game thread only.
+ */
+struct PROJECTSURVIVALVR_API FVRPerfCounters
+{
+    static uint64 RenderWritesAvoided;
+    static uint64 PhysicsStateRebuilds;
+    static uint64 PoolHits;
+    static uint64 PoolMisses;
+    static uint64 UILayerRedraws;
+    static uint64 CollisionQueries;
+    static int32 TickDemandActiveActors;
+    static int32 PhysicsActiveBodies;
+    static int32 PhysicsDormantBodies;
+    static int32 InstancedProps;
+    static int32 BurningFires;
+    static int32 VFXFullQuality;
+    static int32 VFXReducedQuality;
+    static int32 VFXPaused;
+
+    static void ResetAll();
+
+    // Called by VRCollisionQuery for every physics query game code issues, engine queries such as CharacterMovement are not seen
+    static void CountCollisionQueries(uint32 Count = 1);
+};
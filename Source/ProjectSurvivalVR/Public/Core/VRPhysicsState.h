@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UPrimitiveComponent;
+class USkeletalMeshComponent;
+
+/**
+ * Counted writes for state that makes the physics scene rebuild bodies or collision filter data.
+ * Writes matching the current value are dropped, the others are counted in
+ * STAT_VRPhysicsStateRebuilds and FVRPerfCounters so interaction paths can be checked for churn.
+ * Each function returns true if the component was written.
+ */
+namespace VRPhysicsState
+{
+    PROJECTSURVIVALVR_API bool SetCollisionResponseToChannel(UPrimitiveComponent* Component, ECollisionChannel Channel, ECollisionResponse NewResponse);
+
+    PROJECTSURVIVALVR_API bool SetCollisionEnabled(UPrimitiveComponent* Component, ECollisionEnabled::Type NewType);
+
+    PROJECTSURVIVALVR_API bool SetSimulatePhysics(UPrimitiveComponent* Component, bool bSimulate);
+
+    // Written when any body below the bone differs, bodies with custom physics type are left alone like the engine does
+    PROJECTSURVIVALVR_API bool SetAllBodiesBelowSimulatePhysics(USkeletalMeshComponent* Component, FName BoneName, bool bSimulate);
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USceneComponent;
+class UPrimitiveComponent;
+class ULightComponent;
+
+/**
+ * Change-detected writes for render state and transforms. Every setter compares against the
+ * component's current value first and only pushes when it differs beyond the tolerance, so
+ * per-frame callers stop marking render state and transforms dirty when nothing changed.
+ * Each function returns true if the component was written.
+ */
+namespace VRRenderState
+{
+    // Counts one skipped write in STAT_VRRenderWritesAvoided and FVRPerfCounters
+    PROJECTSURVIVALVR_API void CountAvoidedWrite();
+
+    PROJECTSURVIVALVR_API bool SetWorldLocation(USceneComponent* Component, const FVector& NewLocation, double Tolerance = UE_KINDA_SMALL_NUMBER);
+
+    // Tolerance is the angular distance in radians
+    PROJECTSURVIVALVR_API bool SetWorldRotation(USceneComponent* Component, const FQuat& NewRotation, double Tolerance = UE_KINDA_SMALL_NUMBER);
+
+    PROJECTSURVIVALVR_API bool SetRelativeTransform(USceneComponent* Component, const FTransform& NewTransform, double Tolerance = UE_KINDA_SMALL_NUMBER);
+
+    // Compares against the component's own visible flag, children are assumed to follow it when propagating
+    PROJECTSURVIVALVR_API bool SetVisibility(USceneComponent* Component, bool bNewVisibility, bool bPropagateToChildren = false);
+
+    PROJECTSURVIVALVR_API bool SetRenderCustomDepth(UPrimitiveComponent* Component, bool bNewRenderCustomDepth);
+
+    PROJECTSURVIVALVR_API bool SetIntensity(ULightComponent* Component, float NewIntensity, float Tolerance = UE_KINDA_SMALL_NUMBER);
+}
+
+/**
+ * Remembers the last value written through it, for state the owner exclusively drives
+ * and that has no cheap engine getter (e.g. hidden-in-game of a helper mesh).
+ * Call Invalidate() if anything else may have written the value.
+ */
+template<typename ValueType>
+struct TVRWriteCache
+{
+    // Returns true if NewValue differs from the last written one and should be pushed
+    bool Update(const ValueType& NewValue)
+    {
+        if (LastValue.IsSet() && LastValue.GetValue() == NewValue)
+        {
+            VRRenderState::CountAvoidedWrite();
+            return false;
+        }
+
+        LastValue = NewValue;
+        return true;
+    }
+
+    void Invalidate() { LastValue.Reset(); }
+
+private:
+    TOptional<ValueType> LastValue;
+};
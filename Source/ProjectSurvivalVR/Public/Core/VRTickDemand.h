@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UActorComponent;
+
+// Why an actor currently needs to tick, several can be active at once
+enum class ETickReason : uint8
+{
+    None        = 0,
+    Held        = 1 << 0,
+    TwoHanded   = 1 << 1,
+    Hovering    = 1 << 2,
+    MenuOpen    = 1 << 3,
+    TimeOfDay   = 1 << 4,
+
+    All         = 0xFF
+};
+ENUM_CLASS_FLAGS(ETickReason);
+
+/**
+ * Switches an actor's tick, and the tick/activation of components that depend on it, on and off
+ * as reasons to tick appear and disappear. Owners start with tick disabled and only ever pay for
+ * a tick while something is actually in use.
+ */
+struct PROJECTSURVIVALVR_API FTickDemand
+{
+    // Takes over the owner's primary tick, turning it off until a reason in OwnerReasons is added
+    void Initialize(AActor* InOwner, ETickReason InOwnerReasons = ETickReason::All);
+
+    // Component is activated while any of Reasons is active and deactivated otherwise
+    void AddDependentComponent(UActorComponent* Component, ETickReason Reasons);
+
+    void SetReason(ETickReason Reason, bool bActive);
+    void AddReason(ETickReason Reason) { SetReason(Reason, true); }
+    void RemoveReason(ETickReason Reason) { SetReason(Reason, false); }
+
+    // Drops every reason, used when the owner is torn down or pooled
+    void Reset();
+
+    bool HasReason(ETickReason Reason) const { return EnumHasAnyFlags(ActiveReasons, Reason); }
+    ETickReason GetActiveReasons() const { return ActiveReasons; }
+
+private:
+    void Apply(ETickReason PreviousReasons);
+
+    struct FDependentComponent
+    {
+        TWeakObjectPtr<UActorComponent> Component;
+        ETickReason Reasons = ETickReason::None;
+    };
+
+    TWeakObjectPtr<AActor> Owner;
+    ETickReason OwnerReasons = ETickReason::All;
+    ETickReason ActiveReasons = ETickReason::None;
+    TArray<FDependentComponent, TInlineAllocator<2>> DependentComponents;
+};
@@ -6,10 +6,12 @@
 #include "GameFramework/Actor.h"
 #include "Engine/DirectionalLight.h"
 #include "Components/DirectionalLightComponent.h"
+#include "Core/VRTickDemand.h"
 #include "DayNightManager.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDayStarted);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnNightStarted);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTimeSkipped, float, SkippedHours);
 
 UCLASS()
 class PROJECTSURVIVALVR_API ADayNightManager : public AActor
@@ -21,6 +23,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 
 #pragma region Settings
@@ -37,6 +40,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Settings", meta = (ClampMin = "0.0", ClampMax = "24.0"))
 	float StartingHour = 12.0f;
 
+	// Seconds between time updates, the clock advances by the real elapsed time so this only affects smoothness
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Settings", meta = (ClampMin = "0.0", ClampMax = "5.0"))
+	float TimeUpdateInterval = 0.1f;
+
 	// Hour when day begins (sunrise)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Settings", meta = (ClampMin = "0.0", ClampMax = "24.0"))
 	float DayStartHour = 6.0f;
@@ -57,6 +64,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lighting", meta = (ClampMin = "0.0", ClampMax = "20.0"))
 	float NightLightIntensity = 0.8f;
 
+	// Sun rotation is only pushed to the light once it has moved this far, avoids re-marking the light dirty every frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lighting", meta = (ClampMin = "0.0", ClampMax = "5.0"))
+	float SunRotationToleranceDegrees = 0.05f;
+
 	// Temperature modifier during day (added to base temperature)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Temperature")
 	float DayTemperatureModifier = 1.0f;
@@ -77,6 +88,11 @@ protected:
 	UPROPERTY(BlueprintAssignable, Category = "Time Events")
 	FOnNightStarted OnNightStarted;
 
+public:
+	// Called when the clock jumps forward (sleeping) with the game hours that were skipped
+	UPROPERTY(BlueprintAssignable, Category = "Time Events")
+	FOnTimeSkipped OnTimeSkipped;
+
 #pragma endregion
 
 private:
@@ -87,12 +103,18 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Current Time", meta = (AllowPrivateAccess = "true"))
 	float CurrentHour = 12.0f;
 
+	// Game hours since the save was started, never wraps. Survives level changes through the save
+	double TotalGameHours = 0.0;
+
 	// Track previous day/night state for event triggering
 	bool bWasNight = false;
 
 	// Cache for performance
 	float CachedDayLengthInSeconds = 0.0f;
 
+	// Ticks for as long as the clock runs
+	FTickDemand TickDemand;
+
 #pragma endregion
 
 #pragma region Internal Functions
@@ -113,6 +135,11 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Time")
 	float GetCurrentHour() const { return CurrentHour; }
 
+	double GetTotalGameHours() const { return TotalGameHours; }
+
+	// Puts the clock back where a save left it
+	void RestoreClock(float Hour, double InTotalGameHours);
+
 	// Check if it's currently day
 	UFUNCTION(BlueprintPure, Category = "Time")
 	bool IsDay() const {
@@ -130,6 +157,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Temperature")
 	float GetTemperatureModifier() const { return IsDay() ? DayTemperatureModifier : NightTemperatureModifier; }
 
+	// Game hours that pass per real second right now, night runs faster
+	UFUNCTION(BlueprintPure, Category = "Time")
+	float GetGameHoursPerSecond() const;
+
 	// Get current time as formatted string (e.g., "14:30")
 	UFUNCTION(BlueprintPure, Category = "Time")
 	FString GetFormattedTime() const;
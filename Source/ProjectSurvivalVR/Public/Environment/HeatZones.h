@@ -26,6 +26,7 @@ public:
 protected:
 	
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	TObjectPtr<USceneComponent> SceneRoot;
@@ -58,6 +59,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heat Zone | Settings")
 	bool bUseShelteredZone = true;
 
+	// Cheaper effect the VFX budget swaps in when this zone is not among the closest, optional
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heat Zone | VFX")
+	TObjectPtr<UNiagaraSystem> ReducedNiagaraSystem;
+
 	// Overlap Event Handlers
     UFUNCTION()
     void OnHeatZoneOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
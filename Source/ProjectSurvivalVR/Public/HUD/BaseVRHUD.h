@@ -7,6 +7,10 @@
 #include "Components/SurvivalComponent.h"
 #include "BaseVRHUD.generated.h"
 
+class AVRGrabbableActor;
+class USurvivalViewModel;
+
+DECLARE_MULTICAST_DELEGATE(FOnHUDDisplayChanged);
 
 UCLASS()
 class PROJECTSURVIVALVR_API UBaseVRHUD : public UUserWidget
@@ -17,9 +21,13 @@ private:
 
 	USurvivalComponent* SurvivalComponent;
 
+	UPROPERTY()
+	TObjectPtr<USurvivalViewModel> ViewModel;
+
 protected:
 	// Called when the widget is constructed
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 	float Hunger;
 
@@ -27,30 +35,70 @@ protected:
 
 	float Temperature;
 
-	FTimerHandle UpdateUITimer;
+	// View model pushes, the only place the HUD learns about stat changes
+	UFUNCTION()
+	void HandleHungerChanged(float Percent);
+
+	UFUNCTION()
+	void HandleThirstChanged(float Percent);
+
+	UFUNCTION()
+	void HandleStaminaChanged(float Percent);
+
+	UFUNCTION()
+	void HandleTemperatureChanged(int32 Degrees, const FText& Text);
+
+	// Update the matching bar or label, only called when the shown value changes
+	UFUNCTION(BlueprintImplementableEvent, Category = "Survival UI")
+	void OnHungerDisplayChanged(float Percent);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Survival UI")
+	void OnThirstDisplayChanged(float Percent);
 
-	void RefreshUI();
+	UFUNCTION(BlueprintImplementableEvent, Category = "Survival UI")
+	void OnStaminaDisplayChanged(float Percent);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Survival UI")
+	void OnTemperatureDisplayChanged(int32 Degrees, const FText& Text);
 
 	// Returns the Hunger Percentage
-	UFUNCTION(BlueprintPure, Category = "Survival")
+	UFUNCTION(BlueprintPure, Category = "Survival", meta = (DeprecatedFunction, DeprecationMessage = "Property bindings poll every frame, use OnHungerDisplayChanged"))
 	float GetHungerPercentage();
 
 	// Returns the Thirst Percentage
-	UFUNCTION(BlueprintPure, Category = "Survival")
+	UFUNCTION(BlueprintPure, Category = "Survival", meta = (DeprecatedFunction, DeprecationMessage = "Property bindings poll every frame, use OnThirstDisplayChanged"))
 	float GetThirstPercentage();
 
-	// Returns the Temperature Text
-	UFUNCTION(BlueprintPure)
+	// Returns the Temperature Text, kept as FString for existing bindings. The FText is on the view model
+	UFUNCTION(BlueprintPure, meta = (DeprecatedFunction, DeprecationMessage = "Property bindings poll every frame, use OnTemperatureDisplayChanged or GetViewModel -> GetTemperatureText"))
 	FString GetTemperatureText() const;
+
+	// The quantized stats this HUD shows, null until the widget is constructed with a survival component
+	UFUNCTION(BlueprintPure, Category = "Survival UI")
+	USurvivalViewModel* GetViewModel() const { return ViewModel; }
+
+	// Interaction hints, driven by the world interaction events
+	UFUNCTION()
+	void HandleHoverChanged(AVRGrabbableActor* HoveredActor, bool bIsHovered);
+
+	UFUNCTION()
+	void HandleGrabbed(AVRGrabbableActor* GrabbedActor, USkeletalMeshComponent* HandMesh);
+
+	// Show or hide the grab hint for an interactable
+	UFUNCTION(BlueprintImplementableEvent, Category = "Survival UI")
+	void OnInteractionHintChanged(AVRGrabbableActor* Interactable, bool bShowHint);
 	
 public:
 
+	// Fires after anything shown changed, so a UVRUILayerComponent knows when to redraw its texture
+	FOnHUDDisplayChanged OnDisplayChanged;
+
 	// Stamina UI Property
 	UPROPERTY(BlueprintReadOnly, Category = "Survival UI")
 	float Stamina = 100.0f;
 
 	// Add this function declaration
-	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Survival UI")
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Survival UI", meta = (DeprecatedFunction, DeprecationMessage = "Property bindings poll every frame, use OnStaminaDisplayChanged"))
 	float GetStaminaPercentage();
 
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "SurvivalViewModel.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSurvivalPercentChanged, float, Percent);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSurvivalTemperatureChanged, int32, Degrees, const FText&, Text);
+
+/**
+ * What the HUD shows of a USurvivalComponent, quantized to display precision. The component pushes
+ * raw values after every change and events only fire when the displayed value actually moves, so a
+ * cached (invalidation/retainer) HUD is only redrawn on those frames.
+ */
+UCLASS(BlueprintType)
+class PROJECTSURVIVALVR_API USurvivalViewModel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Called by USurvivalComponent, values are raw stat values and their maximum
+	void SetHunger(float Value, float MaxValue);
+	void SetThirst(float Value, float MaxValue);
+	void SetStamina(float Value, float MaxValue);
+	void SetTemperature(float Value);
+
+	UFUNCTION(BlueprintPure, Category = "Survival UI")
+	float GetHungerPercent() const { return ToPercent(HungerSteps); }
+
+	UFUNCTION(BlueprintPure, Category = "Survival UI")
+	float GetThirstPercent() const { return ToPercent(ThirstSteps); }
+
+	UFUNCTION(BlueprintPure, Category = "Survival UI")
+	float GetStaminaPercent() const { return ToPercent(StaminaSteps); }
+
+	UFUNCTION(BlueprintPure, Category = "Survival UI")
+	int32 GetTemperatureDegrees() const { return TemperatureDegrees; }
+
+	// Built once per displayed change, never per frame
+	UFUNCTION(BlueprintPure, Category = "Survival UI")
+	const FText& GetTemperatureText() const { return TemperatureText; }
+
+	UPROPERTY(BlueprintAssignable, Category = "Survival UI")
+	FOnSurvivalPercentChanged OnHungerChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Survival UI")
+	FOnSurvivalPercentChanged OnThirstChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Survival UI")
+	FOnSurvivalPercentChanged OnStaminaChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Survival UI")
+	FOnSurvivalTemperatureChanged OnTemperatureChanged;
+
+	// Bars move in steps of 1/PercentSteps, finer changes are not visible in the headset
+	static constexpr int32 PercentSteps = 100;
+
+private:
+	static int32 Quantize(float Value, float MaxValue);
+	static float ToPercent(int32 Steps) { return static_cast<float>(Steps) / PercentSteps; }
+
+	// INDEX_NONE until the first push, so the first value always broadcasts
+	int32 HungerSteps = INDEX_NONE;
+	int32 ThirstSteps = INDEX_NONE;
+	int32 StaminaSteps = INDEX_NONE;
+	int32 TemperatureDegrees = TNumericLimits<int32>::Min();
+
+	FText TemperatureText;
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/StereoLayerComponent.h"
+#include "VRUILayerComponent.generated.h"
+
+class FWidgetRenderer;
+class UTextureRenderTarget2D;
+class UUserWidget;
+
+/**
+ * Presents a UMG widget as a compositor quad layer instead of drawing it into the scene. The widget
+ * is rendered offscreen into a render target only when it changes (a UBaseVRHUD display change, a new
+ * widget or RequestRedraw), and the compositor reprojects the quad on its own, so static UI costs
+ * nothing per eye per frame.
+ *
+ * Without a stereo layer capable HMD, or with bUseStereoLayers=False under
+ * [/Script/ProjectSurvivalVR.VRUILayerComponent] in DefaultGame.ini, widgets go to the viewport instead.
+ * "VR.UI.DumpLayers [Dir]" renders every layer offscreen to PNG, which also works headless with -RenderOffscreen.
+ */
+UCLASS(Config = Game, ClassGroup = (VR), meta = (BlueprintSpawnableComponent))
+class PROJECTSURVIVALVR_API UVRUILayerComponent : public UStereoLayerComponent
+{
+	GENERATED_BODY()
+
+public:
+	UVRUILayerComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Shows Widget on this layer, replacing the current one. Animated widgets are redrawn every frame while shown
+	UFUNCTION(BlueprintCallable, Category = "VR|UI")
+	void SetWidget(UUserWidget* InWidget, bool bInAnimated = false);
+
+	// Hides the layer, the widget itself is left to its owner (usually released to the pool)
+	UFUNCTION(BlueprintCallable, Category = "VR|UI")
+	void ClearWidget();
+
+	// Redraws the layer texture on the next tick, for widgets that change outside of a UBaseVRHUD push
+	UFUNCTION(BlueprintCallable, Category = "VR|UI")
+	void RequestRedraw() { bRedrawRequested = true; }
+
+	UFUNCTION(BlueprintPure, Category = "VR|UI")
+	UUserWidget* GetWidget() const { return Widget; }
+
+	// True when widgets are composited as a quad layer rather than added to the viewport
+	UFUNCTION(BlueprintPure, Category = "VR|UI")
+	bool IsUsingStereoLayer() const { return bUsingStereoLayer; }
+
+	void SetViewportZOrder(int32 InZOrder) { ViewportZOrder = InZOrder; }
+
+	// Renders the current widget offscreen and writes the layer texture to Filename, regardless of presentation
+	bool DumpToPNG(const FString& Filename);
+
+protected:
+	// Created and shown at BeginPlay when set, e.g. the survival HUD
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|UI")
+	TSubclassOf<UUserWidget> WidgetClass;
+
+	// Layer texture resolution in pixels, the quad's world size is QuadSize
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|UI")
+	FIntPoint DrawSize = FIntPoint(1024, 512);
+
+	// Z order used when falling back to the viewport
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VR|UI")
+	int32 ViewportZOrder = 0;
+
+	UPROPERTY(Config)
+	bool bUseStereoLayers = true;
+
+private:
+	bool ShouldUseStereoLayer() const;
+	void EnsureRenderTarget();
+	bool DrawLayer(float DeltaTime);
+
+	void HandleDisplayChanged() { bRedrawRequested = true; }
+
+	UPROPERTY()
+	TObjectPtr<UUserWidget> Widget;
+
+	UPROPERTY()
+	TObjectPtr<UTextureRenderTarget2D> RenderTarget;
+
+	FWidgetRenderer* WidgetRenderer = nullptr;
+
+	FDelegateHandle DisplayChangedHandle;
+
+	// Widget time since the last draw, handed to Slate so animations advance correctly
+	float TimeSinceDraw = 0.0f;
+
+	bool bUsingStereoLayer = false;
+	bool bAnimated = false;
+	bool bRedrawRequested = false;
+};
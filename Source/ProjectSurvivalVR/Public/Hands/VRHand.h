@@ -8,6 +8,8 @@
 #include "Structures/FingerData.h"
 #include "TimerManager.h"
 #include "Actors/VRGrabbableActor.h"
+#include "Core/VRRenderState.h"
+#include "Core/VRTickDemand.h"
 #include "VRHand.generated.h"
 
 class UMotionControllerComponent;
@@ -19,6 +21,7 @@ struct FInputActionValue;
 class USplineComponent;
 class UPhysicsConstraintComponent;
 class AVRClimbableActor;
+class UVRInventoryComponent;
 
 USTRUCT(BlueprintType)
 struct FGrabPointInfo
@@ -57,6 +60,10 @@ protected:
 
 	static TArray<AVRHand*> VRHands;
 
+public:
+	// Every hand currently in play
+	static const TArray<AVRHand*>& GetAllHands() { return VRHands; }
+
 #pragma region InputActions
 
 protected:
@@ -175,6 +182,13 @@ protected:
 protected:
 	FGrabPointInfo GetClosestAvailableGrabPoint(AVRGrabbableActor* Object);
 
+	// Indicator writes go through these so an unchanged indicator is never re-marked dirty
+	void SetGrabPointIndicatorHidden(bool bHidden);
+	void SetGrabPointIndicatorLocation(const FVector& Location);
+
+private:
+	TVRWriteCache<bool> GrabPointIndicatorHidden;
+
 #pragma endregion
 
 #pragma region Hand Data
@@ -220,10 +234,17 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VR|Hand|ProceduralFingers")
 	FFingerData FingerData;
 
+	// Optional pose asset of the baked grasp currently applied (null when tracing)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VR|Hand|ProceduralFingers")
+	TSoftObjectPtr<UAnimationAsset> ActiveGrabAnimation;
+
 protected:
 	void SetupFingerAnimationData();
 	TArray<FVector> GetFingerSteps(USplineComponent* FingerSpline);
-	float TraceFingerSegment(TArray<FVector> FingerCacheArray);
+	float TraceFingerSegment(const TArray<FVector>& FingerCacheArray, const FTransform& HandTransform, UPrimitiveComponent* TargetComponent) const;
+
+	// Applies baked finger curls for a snap grab, returns false when the grab point has no bake
+	bool ApplyBakedGrasp(const AVRGrabbableActor* GrabbableActor, EGrabPointType GrabPointType);
 
 public:
 	// Returns current finger curl data for hand animation
@@ -234,6 +255,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "VR|Hand|ProceduralFingers", meta = (ToolTip = "Updates finger data by tracing collision with currently grabbed object"))
 	void TraceFingerData();
 
+	// Returns the pose asset of the applied baked grasp, if any
+	UFUNCTION(BlueprintPure, Category = "VR|Hand|ProceduralFingers")
+	TSoftObjectPtr<UAnimationAsset> GetActiveGrabAnimation() const { return ActiveGrabAnimation; }
+
+#if WITH_EDITOR
+	// Offline grasp bake: finger curls for this hand with its grip socket placed at GripWorldTransform
+	FFingerData ComputeGraspAgainst(UPrimitiveComponent* TargetComponent, const FTransform& GripWorldTransform);
+#endif
+
 #pragma endregion
 
 #pragma region Grab System
@@ -266,9 +296,20 @@ protected:
 
 	void UpdateHoveredGrabbable();
 
+	// Tells the hovered interactable this hand stopped hovering it
+	void NotifyHoverEnd();
+
 	UFUNCTION(BlueprintCallable)
 	void GrabObject();
 
+	// Grab release input: lets go, and stores the item when the hand is at a holster or the backpack
+	void ReleaseObjectFromInput();
+
+	// Takes the item stored where the hand is, with nothing else in reach
+	AVRGrabbableActor* WithdrawFromInventory();
+
+	UVRInventoryComponent* GetInventory() const;
+
 public:
 	// Releases the currently grabbed object
 	UFUNCTION(BlueprintCallable, meta = (ToolTip = "Releases any object currently being held by this hand"))
@@ -323,5 +364,41 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "VR|Menu", meta = (ToolTip = "Toggles the hand menu on or off"))
 	void ToggleMenu();
 
+public:
+	// The menu input already calls this, menus opened some other way call it when they open or close.
+	// Widget interaction only runs while a menu is open, unless bAlwaysEnableWidgetInteraction is set
+	UFUNCTION(BlueprintCallable, Category = "VR|Menu")
+	void SetMenuOpen(bool bIsOpen);
+
+protected:
+	// Keeps widget interaction tracing at all times. On by default since menus placed in the level
+	// (BP_MenuDisplay, the pause menu) do not report themselves, turn off for hands that only use the hand menu
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VR|Menu")
+	bool bAlwaysEnableWidgetInteraction = true;
+
+private:
+	// Bound to the menu input, tracks the hand menu before the Blueprint toggles it
+	void HandleMenuInput();
+
+	bool bMenuOpen = false;
+
+	// Hands tick only while something is in grab range, widget interaction only while a menu is open
+	FTickDemand TickDemand;
+
 #pragma endregion
+
+#if !UE_BUILD_SHIPPING
+public:
+	// Drive the hand without overlap events or input, for the hot path benchmark, the perf scenario and tests
+	void TestAddOverlappingInteractable(const TScriptInterface<IInteractable>& Interactable) { OverlappingInteractables.AddUnique(Interactable); }
+	void TestUpdateHoveredGrabbable() { UpdateHoveredGrabbable(); }
+	bool TestIsHovering(const UObject* Object) const { return Object && HoveredInteractable.GetObject() == Object; }
+	void TestGrabHovered() { GrabObject(); }
+	FGrabPointInfo TestGetClosestAvailableGrabPoint(AVRGrabbableActor* Object) { return GetClosestAvailableGrabPoint(Object); }
+
+	float TestTraceFingerSegment(const TArray<FVector>& FingerCacheArray, const FTransform& HandTransform, UPrimitiveComponent* TargetComponent) const
+	{
+		return TraceFingerSegment(FingerCacheArray, HandTransform, TargetComponent);
+	}
+#endif
 };
\ No newline at end of file
@@ -32,4 +32,8 @@ public:
     // Sets render custom depth to the receiving value, can be overridden for further customization.
     virtual void ShowCanBeGrabbed(bool bIsGrabbable) = 0;
 
+    // Called by a hand when it starts or stops hovering this interactable, once per hand per transition
+    virtual void OnHoverBegin(USkeletalMeshComponent* InComponent) {}
+    virtual void OnHoverEnd(USkeletalMeshComponent* InComponent) {}
+
 };
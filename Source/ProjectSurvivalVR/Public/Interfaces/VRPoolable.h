@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "VRPoolable.generated.h"
+
+
+UINTERFACE(MinimalAPI)
+class UVRPoolable : public UInterface
+{
+    GENERATED_BODY()
+};
+
+
+// Reset hooks for actors and widgets handed out by UVRPoolSubsystem
+class PROJECTSURVIVALVR_API IVRPoolable
+{
+    GENERATED_BODY()
+
+
+public:
+    // Called after the object left the pool, already visible and placed
+    virtual void OnAcquiredFromPool() {}
+
+    // Called before the object is hidden and parked, drop references and in-flight state here
+    virtual void OnReleasedToPool() {}
+
+    // Called instead of parking when the pool is already full. Return true if the object destroys itself
+    // (after a delay, say), otherwise the pool destroys it right away
+    virtual bool DestroyFromFullPool() { return false; }
+};
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PhysicsEngine/BoxElem.h"
+#include "ClimbMetadata.generated.h"
+
+// Top edge of a climbable surface, points in the mesh's component space (unscaled)
+USTRUCT(BlueprintType)
+struct FClimbLedge
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Climbing|Baked")
+    TArray<FVector> Points;
+};
+
+// Written by the ClimbBake commandlet, read instead of tracing when the player lets go or curls fingers
+USTRUCT(BlueprintType)
+struct FClimbMetadata
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Climbing|Baked")
+    TArray<FClimbLedge> Ledges;
+
+    // Floor locations behind the ledges with standing headroom verified at bake time (component space, unscaled)
+    UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Climbing|Baked")
+    TArray<FVector> StandPoints;
+
+    // Boxes approximating the mesh for finger traces (component space, unscaled)
+    UPROPERTY(VisibleDefaultsOnly, Category = "Climbing|Baked")
+    TArray<FKBoxElem> HandProxies;
+
+    // Mesh the data was baked from, a climbable showing a different mesh ignores the bake
+    UPROPERTY(VisibleDefaultsOnly, Category = "Climbing|Baked")
+    FName SourceMesh = NAME_None;
+
+    UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Climbing|Baked")
+    bool bIsBaked = false;
+};
@@ -3,8 +3,33 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Structures/FingerData.h"
 #include "GrabPointData.generated.h"
 
+// Finger curls precomputed offline by the GraspBake commandlet, quantized to a byte per finger
+USTRUCT(BlueprintType)
+struct FBakedGrasp
+{
+	GENERATED_BODY()
+
+	FBakedGrasp();
+
+	// Thumb, Index, Middle, Ring, Pinky (0 = fully extended, 255 = fully curled)
+	UPROPERTY(VisibleDefaultsOnly, Category = "VR|GrabData")
+	uint8 LeftHandCurls[5];
+
+	// Thumb, Index, Middle, Ring, Pinky (0 = fully extended, 255 = fully curled)
+	UPROPERTY(VisibleDefaultsOnly, Category = "VR|GrabData")
+	uint8 RightHandCurls[5];
+
+	// False until the bake has run for this grab point
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "VR|GrabData")
+	bool bIsBaked = false;
+
+	FFingerData GetFingerData(bool bIsLeftHand) const;
+	void SetFingerData(bool bIsLeftHand, const FFingerData& InFingerData);
+};
+
 USTRUCT(BlueprintType)
 struct FGrabPointData
 {
@@ -15,4 +40,8 @@ struct FGrabPointData
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "VR|GrabData")
 	TSoftObjectPtr<UAnimationAsset> GrabAnimation;
+
+	// Written by the GraspBake commandlet, applied by AVRHand on snap grabs instead of tracing
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "VR|GrabData")
+	FBakedGrasp BakedGrasp;
 };
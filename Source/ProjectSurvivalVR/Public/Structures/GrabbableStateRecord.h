@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GrabbableStateRecord.generated.h"
+
+class AVRGrabbableActor;
+
+// Everything needed to bring a grabbable back exactly as it was, without keeping the actor alive
+USTRUCT(BlueprintType)
+struct FGrabbableStateRecord
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "VR|State")
+    TSubclassOf<AVRGrabbableActor> ActorClass;
+
+    UPROPERTY(BlueprintReadOnly, Category = "VR|State")
+    FTransform Transform = FTransform::Identity;
+
+    // Class-specific gameplay value, e.g. the water left in a drink
+    UPROPERTY(BlueprintReadOnly, Category = "VR|State")
+    float StateValue = 0.0f;
+
+    // Class-specific gameplay flags
+    UPROPERTY(BlueprintReadOnly, Category = "VR|State")
+    int32 StateFlags = 0;
+};
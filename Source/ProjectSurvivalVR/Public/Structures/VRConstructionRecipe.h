@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "VRConstructionRecipe.generated.h"
+
+class AVRGrabbableActor;
+class UStaticMesh;
+class UMaterialInterface;
+
+// One kind of item a recipe takes
+USTRUCT(BlueprintType)
+struct FVRRecipeInput
+{
+	GENERATED_BODY()
+
+	// Items of this class or a subclass count for this input
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction")
+	TSubclassOf<AVRGrabbableActor> ItemClass;
+
+	// Items needed before the recipe is complete
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction", meta = (ClampMin = "1"))
+	int32 RequiredCount = 1;
+
+	// Where placed items show, relative to the build site. More slots than RequiredCount lets the site take extra
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction", meta = (MakeEditWidget))
+	TArray<FTransform> Slots;
+
+	// Drawn in a slot once an item is placed there, and as the ghost of the next slot
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction")
+	TObjectPtr<UStaticMesh> PlacedMesh = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction")
+	TObjectPtr<UMaterialInterface> PlacedMaterial = nullptr;
+};
+
+/**
+ * What a build site needs and what it turns into: a shelter, a drying rack, a snow melter or the fireplace.
+ * Inputs are matched as bits of a mask against per-input counts, so a site checks an item in constant time.
+ */
+UCLASS(BlueprintType)
+class PROJECTSURVIVALVR_API UVRConstructionRecipe : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// One bit per input in the site's mask
+	static constexpr int32 MaxInputs = 8;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction")
+	FText DisplayName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction", meta = (TitleProperty = "ItemClass"))
+	TArray<FVRRecipeInput> Inputs;
+
+	// Drawn over PlacedMesh for the slot the held item would go to
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction")
+	TObjectPtr<UMaterialInterface> GhostMaterial = nullptr;
+
+	// Spawned in place of the site once complete. Empty for sites that act on completion themselves
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction")
+	TSubclassOf<AActor> ResultClass;
+
+	// Where the result goes, relative to the build site
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Construction")
+	FTransform ResultTransform;
+
+	int32 GetInputCount() const { return FMath::Min(Inputs.Num(), MaxInputs); }
+
+	// Bits of every input, a site whose mask equals this is complete
+	uint8 GetRequiredMask() const { return static_cast<uint8>((1u << GetInputCount()) - 1u); }
+
+	// Items an input holds, the extra slots beyond RequiredCount included
+	int32 GetCapacity(int32 InputIndex) const;
+
+	// First input ItemClass counts for, INDEX_NONE if none
+	int32 FindInputIndex(const UClass* ItemClass) const;
+};
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Structures/GrabbableStateRecord.h"
+#include "VRInventoryItem.generated.h"
+
+class AVRGrabbableActor;
+
+// A stored grabbable as a value: no actor, tick or physics body behind it until it is taken out again
+USTRUCT(BlueprintType)
+struct FVRInventoryItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "VR|Inventory")
+	TSubclassOf<AVRGrabbableActor> ItemClass;
+
+	// Identical items share one entry
+	UPROPERTY(BlueprintReadOnly, Category = "VR|Inventory")
+	int32 Quantity = 0;
+
+	// Class-specific gameplay value, e.g. the water left in a drink
+	UPROPERTY(BlueprintReadOnly, Category = "VR|Inventory")
+	float StateValue = 0.0f;
+
+	// Class-specific gameplay flags
+	UPROPERTY(BlueprintReadOnly, Category = "VR|Inventory")
+	int32 StateFlags = 0;
+
+	bool IsEmpty() const { return Quantity <= 0 || !ItemClass; }
+
+	bool CanStackWith(const FGrabbableStateRecord& Record) const
+	{
+		return ItemClass == Record.ActorClass && StateValue == Record.StateValue && StateFlags == Record.StateFlags;
+	}
+
+	static FVRInventoryItem FromRecord(const FGrabbableStateRecord& Record)
+	{
+		FVRInventoryItem Item;
+		Item.ItemClass = Record.ActorClass;
+		Item.Quantity = 1;
+		Item.StateValue = Record.StateValue;
+		Item.StateFlags = Record.StateFlags;
+		return Item;
+	}
+
+	FGrabbableStateRecord ToRecord(const FTransform& Transform) const
+	{
+		FGrabbableStateRecord Record;
+		Record.ActorClass = ItemClass;
+		Record.Transform = Transform;
+		Record.StateValue = StateValue;
+		Record.StateFlags = StateFlags;
+		return Record;
+	}
+};
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Actors/VRGrabbableActor.h"
+#include "VRItemDefinition.generated.h"
+
+/**
+ * Tuning shared by every item of one class, one row of the item table. Never changes at runtime, so placed,
+ * pooled, instanced and stored copies of an item all read the same row through a small id instead of each
+ * carrying its own copy. Fields that do not apply to an item (nutrition on a log) are simply ignored.
+ */
+USTRUCT(BlueprintType)
+struct FVRItemDefinition : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	static constexpr uint16 InvalidId = MAX_uint16;
+
+	// The class this row describes, subclasses without a row of their own use it too
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+	TSoftClassPtr<AVRGrabbableActor> ItemClass;
+
+#pragma region Grabbing
+
+	// Controls which grab points are available for this item
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item|Grabbing")
+	EGrabPointBehavior GrabPointBehavior = EGrabPointBehavior::None;
+
+	// Reported as the item's weight instead of its physics mass
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item|Grabbing")
+	bool bUseCustomWeight = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item|Grabbing", meta = (EditCondition = "bUseCustomWeight"))
+	float Weight = 1.0f;
+
+#pragma endregion
+
+#pragma region Consumable
+
+	// Hunger restored per bite
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item|Consumable")
+	float NutritionValue = 25.0f;
+
+	// Thirst restored per sip
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item|Consumable")
+	float HydrationValue = 5.0f;
+
+	// Stamina restored per bite or sip
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item|Consumable")
+	float StaminaRestorationValue = 15.0f;
+
+	// Percent of the water gone with each sip
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item|Consumable")
+	float WaterDecreaseRate = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item|Consumable")
+	float MinimumTiltAngleForDrinking = 45.0f;
+
+	// Seconds between sips while the bottle stays at the mouth
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item|Consumable", meta = (ClampMin = "0.1"))
+	float SipInterval = 1.0f;
+
+#pragma endregion
+};
@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * On-disk layout of a save. These are plain structs serialized by hand rather than USTRUCTs, so
+ * the format is explicit, compact and read back through Version: add a new EVRSaveVersion entry for
+ * every layout change and guard the new fields with it in Serialize.
+ */
+enum class EVRSaveVersion : int32
+{
+	Initial = 1,
+	Inventory,
+	Forage,
+	// The file header carries a CRC of the compressed data
+	Checksum,
+	BuildSites,
+	// Forage cells keep a regrowth time per spawn point
+	ForageSlotRespawn,
+
+	// Add new versions above this line
+	VersionPlusOne,
+	Latest = VersionPlusOne - 1
+};
+
+// One grabbable that is not where the level placed it, or was never placed at all
+struct FVRSavedItem
+{
+	// Index into FVRLevelSave::ClassPaths
+	uint16 ClassIndex = 0;
+	FTransform Transform = FTransform::Identity;
+	float StateValue = 0.0f;
+	int32 StateFlags = 0;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+struct FVRSavedFire
+{
+	// Fireplaces are placed in the level, their name is stable between sessions
+	FName FireplaceName;
+	float FuelMass = 0.0f;
+	bool bLit = false;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+// A forage cell something was picked from, untouched cells are seeded again from the map and need nothing
+struct FVRSavedForageCell
+{
+	// One bit per spawn point of the cell
+	uint16 DepletedMask = 0;
+
+	// Total game hours at which each picked point grows back, by spawn point
+	TArray<float> RespawnHours;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+struct FVRSavedForage
+{
+	// Spawners are placed in the level, their name is stable between sessions
+	FName SpawnerName;
+	TMap<FIntPoint, FVRSavedForageCell> Cells;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+// A build site with something placed in it, empty sites need nothing
+struct FVRSavedBuildSite
+{
+	// Sites sit on level placed actors, their owner's and their own name are stable between sessions
+	FName OwnerName;
+	FName SiteName;
+
+	// One per recipe input
+	TArray<int32> PlacedCounts;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+// Changes inside one square of the save grid, restored once the player comes near it
+struct FVRCellDelta
+{
+	TArray<FVRSavedItem> Items;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+// Everything one level's world differs by from the map as shipped
+struct FVRLevelSave
+{
+	// Each distinct item class once, items refer to it by index
+	TArray<FString> ClassPaths;
+
+	// Level placed grabbables that were taken, eaten, burnt or moved (moved ones come back as items)
+	TSet<FName> RemovedPlacedActors;
+
+	TArray<FVRSavedFire> Fires;
+
+	TMap<FIntPoint, FVRCellDelta> Cells;
+
+	TArray<FVRSavedForage> Forage;
+
+	TArray<FVRSavedBuildSite> BuildSites;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+struct FVRSurvivalSave
+{
+	float Hunger = 0.0f;
+	float Thirst = 0.0f;
+	float Temperature = 0.0f;
+	float Stamina = 0.0f;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+// One inventory entry, an empty ClassPath is an empty holster
+struct FVRSavedInventoryItem
+{
+	FString ClassPath;
+	int32 Quantity = 0;
+	float StateValue = 0.0f;
+	int32 StateFlags = 0;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+struct FVRInventorySave
+{
+	// One entry per holster, in the inventory component's order
+	TArray<FVRSavedInventoryItem> Holsters;
+	TArray<FVRSavedInventoryItem> Backpack;
+
+	void Serialize(FArchive& Ar, int32 Version);
+};
+
+struct FVRSaveGame
+{
+	int32 Version = static_cast<int32>(EVRSaveVersion::Latest);
+
+	bool bHasPlayerState = false;
+	FVRSurvivalSave Survival;
+	FVRInventorySave Inventory;
+
+	float CurrentHour = 0.0f;
+	double TotalGameHours = 0.0;
+
+	// Keyed by map name without PIE prefix
+	TMap<FString, FVRLevelSave> Levels;
+
+	void Serialize(FArchive& Ar);
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Actors/VRConsumableActor.h"
+#include "InteractionEventSubsystem.generated.h"
+
+/**
+ * World-wide relay of the per-actor interaction events, for listeners that care about
+ * every interactable (HUD hints, analytics) without binding to each actor individually.
+ * Interactables forward their own transitions here, nothing in this subsystem ticks or polls.
+ */
+UCLASS()
+class PROJECTSURVIVALVR_API UInteractionEventSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Fired once when any grabbable goes from not held to held
+	UPROPERTY(BlueprintAssignable, Category = "VR|Events")
+	FOnGrabbableGrabbed OnAnyGrabbed;
+
+	// Fired once when any grabbable is released by its last hand
+	UPROPERTY(BlueprintAssignable, Category = "VR|Events")
+	FOnGrabbableReleased OnAnyReleased;
+
+	// Fired when the first hand starts or the last hand stops hovering any grabbable
+	UPROPERTY(BlueprintAssignable, Category = "VR|Events")
+	FOnGrabbableHoverChanged OnAnyHoverChanged;
+
+	// Fired each time any consumable is eaten or sipped
+	UPROPERTY(BlueprintAssignable, Category = "VR|Events")
+	FOnConsumableConsumed OnAnyConsumed;
+
+	static UInteractionEventSubsystem* Get(const UObject* WorldContextObject);
+};
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Structures/VRSaveData.h"
+#include "VRCheckpointSubsystem.generated.h"
+
+class AVRCharacterBase;
+
+// The player and the level as they were at one safe moment
+struct FVRCheckpoint
+{
+	FTransform PlayerTransform;
+	FRotator ControlRotation = FRotator::ZeroRotator;
+
+	FVRSurvivalSave Survival;
+	FVRInventorySave Inventory;
+	float CurrentHour = 0.0f;
+	double TotalGameHours = 0.0;
+
+	FVRLevelSave World;
+};
+
+/**
+ * Keeps the last few checkpoints of this world in memory so a death can be undone in place, without
+ * reloading the map or reading the save file. A checkpoint is only started once the player has stood
+ * on the ground for SafeGroundedSeconds; the player, survival stats and clock are taken right then,
+ * the level is captured over the next frames by UVRWorldSaveSubsystem within its autosave budget.
+ *
+ * Tuning lives in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRCheckpointSubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRCheckpointSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRCheckpointSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	UFUNCTION(BlueprintPure, Category = "Checkpoint")
+	bool HasCheckpoint() const { return Checkpoints.Num() > 0; }
+
+	// Puts the level, survival stats and clock back to a checkpoint, StepsBack 0 is the newest.
+	// The player is not moved, OutTransform and OutControlRotation are where it stood
+	bool RestoreCheckpoint(int32 StepsBack, FTransform& OutTransform, FRotator& OutControlRotation);
+
+	// Drops every checkpoint, for a new game
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	void ClearCheckpoints();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Seconds between two checkpoints, zero disables them
+	UPROPERTY(Config)
+	float CheckpointInterval = 20.0f;
+
+	// Checkpoints kept, the oldest is dropped first
+	UPROPERTY(Config)
+	int32 MaxCheckpoints = 3;
+
+	// Seconds the player must have walked on the ground before its position counts as safe
+	UPROPERTY(Config)
+	float SafeGroundedSeconds = 2.0f;
+
+private:
+	bool IsPlayerSafe(const AVRCharacterBase* Character) const;
+
+	void BeginCheckpoint(AVRCharacterBase* Character);
+	void OnLevelCaptured(FVRLevelSave& LevelState);
+
+	// Newest last
+	TArray<FVRCheckpoint> Checkpoints;
+
+	// Player part of the checkpoint waiting for its level capture
+	FVRCheckpoint PendingCheckpoint;
+	bool bCapturing = false;
+
+	float TimeSinceCheckpoint = 0.0f;
+	float SafeTime = 0.0f;
+};
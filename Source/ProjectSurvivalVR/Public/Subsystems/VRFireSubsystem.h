@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRFireSubsystem.generated.h"
+
+class AFireplaceActor;
+class ADayNightManager;
+class USurvivalComponent;
+
+// What a fire burns and gives off, authored per fireplace and copied into the simulation on registration
+USTRUCT(BlueprintType)
+struct FFireDescription
+{
+	GENERATED_BODY()
+
+	// Fuel one log adds (kg)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fire", meta = (ClampMin = "0.01"))
+	float LogFuelMass = 2.0f;
+
+	// Fuel burnt per game hour while lit (kg), zero for a heat source that never goes out
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fire", meta = (ClampMin = "0.0"))
+	float BurnRatePerHour = 1.0f;
+
+	// Temperature recovered per survival update at the centre of a well-fed fire
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fire", meta = (ClampMin = "0.0"))
+	float HeatOutput = 0.2f;
+
+	// Distance at which the heat has fallen off to nothing (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fire", meta = (ClampMin = "1.0"))
+	float HeatRadius = 150.0f;
+};
+
+/**
+ * Simulates every fire in the world in one batched pass at a low rate. Fire state is kept as
+ * parallel arrays (fuel, burn rate, heat) indexed by fire, fireplaces only hold their index and
+ * are told when their visible log count changes or they burn out. Heat falls off quadratically
+ * with distance and is summed into the registered survival components.
+ * Time skips (sleeping) advance all fires analytically in a single step.
+ *
+ * Tuning lives in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRFireSubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRFireSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRFireSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Called by fireplaces on BeginPlay/EndPlay, returns the fire's index into the simulation
+	int32 RegisterFire(AFireplaceActor* Fire, const FFireDescription& Description);
+	void UnregisterFire(AFireplaceActor* Fire);
+
+	// Called by survival components on BeginPlay/EndPlay
+	void RegisterHeatReceiver(USurvivalComponent* Receiver);
+	void UnregisterHeatReceiver(USurvivalComponent* Receiver);
+
+	// Adds one log worth of fuel, unlit fires only store it until they are lit. Returns the logs left to show
+	int32 AddLog(int32 FireIndex);
+
+	// Starts burning the stored fuel, returns false when there is none
+	bool Ignite(int32 FireIndex);
+
+	// Moves every fire forward by GameHours in one step, as if that much time had been simulated
+	void AdvanceFires(float GameHours);
+
+	bool IsBurning(int32 FireIndex) const;
+	float GetFuelMass(int32 FireIndex) const;
+
+	// Game hours until the fire burns out at its current rate, zero when unlit
+	float GetRemainingBurnHours(int32 FireIndex) const;
+
+	// Summed heat of all burning fires at Location
+	float GetHeatAtLocation(const FVector& Location) const;
+
+	int32 GetFireCount() const { return Fires.Num(); }
+	AFireplaceActor* GetFire(int32 FireIndex) const { return Fires.IsValidIndex(FireIndex) ? Fires[FireIndex].Get() : nullptr; }
+
+	// Puts a fire back to saved fuel and lit state, the fireplace is told as after a simulation pass
+	void RestoreFire(int32 FireIndex, float FuelMass, bool bLit);
+	int32 GetBurningFireCount() const { return BurningFireCount; }
+
+protected:
+	// Seconds between two simulation passes, fires change slowly
+	UPROPERTY(Config)
+	float SimulationInterval = 0.5f;
+
+	// Game hours per real second used when the world has no ADayNightManager
+	UPROPERTY(Config)
+	float FallbackGameHoursPerSecond = 0.02f;
+
+private:
+	UFUNCTION()
+	void HandleTimeSkipped(float SkippedHours);
+
+	void RemoveFireAt(int32 FireIndex);
+	void UpdateHeatReceivers();
+	void AdjustBurningCount(int32 Delta);
+
+	// One entry per fire in every array below
+	UPROPERTY()
+	TArray<TObjectPtr<AFireplaceActor>> Fires;
+
+	// Fireplaces never move, their location is captured once on registration
+	TArray<FVector> Locations;
+	TArray<float> FuelMasses;
+	TArray<float> LogFuelMasses;
+	TArray<float> BurnRates;
+	TArray<float> HeatOutputs;
+	TArray<float> HeatRadii;
+	TArray<int32> VisibleLogCounts;
+	TArray<bool> LitFlags;
+
+	TArray<TWeakObjectPtr<USurvivalComponent>> HeatReceivers;
+
+	UPROPERTY()
+	TObjectPtr<ADayNightManager> DayNightManager;
+
+	float TimeSinceSimulation = 0.0f;
+	int32 BurningFireCount = 0;
+};
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Structures/VRItemDefinition.h"
+#include "UObject/ObjectKey.h"
+#include "VRItemRegistrySubsystem.generated.h"
+
+class UDataTable;
+
+/**
+ * Every item definition of the game in one array, read once from the item table on first use and never
+ * changed after. Items refer to their definition by its index, a uint16 resolved once per class and cached
+ * on the actor, so balance lives in one table instead of on every placed actor. A class without a row
+ * uses its closest parent's, the native grabbable, food and drink classes always have one with the
+ * historical defaults.
+ *
+ * Engine-wide rather than per game instance so commandlets and editor tools see the same definitions.
+ * Settings live in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRItemRegistrySubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRItemRegistrySubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRItemRegistrySubsystem* Get();
+
+	// The definition for ItemClass, InOutItemId caches its id across calls. Defaults if there is no registry yet
+	static const FVRItemDefinition& GetDefinition(const UClass* ItemClass, uint16& InOutItemId);
+
+	virtual void Deinitialize() override;
+
+	// Id of the definition ItemClass uses, resolved once per class
+	uint16 FindItemId(const UClass* ItemClass);
+
+	const FVRItemDefinition& GetDefinition(uint16 ItemId) const;
+
+	int32 GetNumDefinitions() const { return Definitions.Num(); }
+
+#if WITH_EDITOR
+	// Points registries created from now on at Table and writes it to DefaultGame.ini, for tools that create the table
+	static void SetItemTable(UDataTable* Table);
+
+	// Gives ItemClass its own definition without a table row until the registry goes away, for fixtures built by tools
+	uint16 AddFixtureDefinition(const UClass* ItemClass, const FVRItemDefinition& Definition);
+#endif
+
+protected:
+	// Rows keyed by anything, each row names the class it describes
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> ItemTable;
+
+private:
+	void LoadDefinitions();
+	void ReadTable(const UDataTable& Table);
+	uint16 AddDefinition(const FSoftObjectPath& ClassPath, const FVRItemDefinition& Definition);
+
+	// Contiguous and append-only, an id is an index
+	TArray<FVRItemDefinition> Definitions;
+
+	TMap<FSoftObjectPath, uint16> IdByClassPath;
+
+	// Every class resolved so far, subclasses included
+	TMap<TObjectKey<UClass>, uint16> IdByClass;
+
+	bool bLoaded = false;
+};
@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRPerfScenarioSubsystem.generated.h"
+
+class AActor;
+class AVRCharacterBase;
+class AVRBed;
+class AVRHand;
+
+/**
+ * Scripted performance run, only created when a non-Shipping game is started with -VRPerfScenario. It possesses an
+ * AVRCharacterBase and drives it through the same entry points as the input bindings along a fixed route:
+ * walk, teleport, climb the nearest climbable, pick up an item, eat, drink and sleep in the nearest bed. The
+ * character is warped next to each target first so the route works on any map; a step without a target is
+ * skipped and reported as such.
+ *
+ * While the route runs the CSV profiler is captured with the game's counters added per frame (VRPerf category),
+ * and at the end a Json summary is written to Saved/Profiling/VRPerf: game thread time percentiles, collision
+ * queries and game thread allocations per frame, overall and per step. Runs are only comparable with the same
+ * map and flags, the fixed timestep keeps the route itself identical:
+ *
+ * UnrealEditor-Cmd ProjectSurvivalVR.uproject <Alpine or stress map> -game -nullrhi -unattended -benchmark -fps=72
+ *     -VRPerfScenario [-VRPerfLabel=<commit>]
+ *
+ * Settings live in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRPerfScenarioSubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRPerfScenarioSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRPerfScenarioSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	bool IsRunning() const { return bRunning; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Spawned and possessed when the game mode's pawn is not a VR character
+	UPROPERTY(Config)
+	TSoftClassPtr<AVRCharacterBase> CharacterClass;
+
+	// Seconds for streaming and physics to settle before measuring starts
+	UPROPERTY(Config)
+	float SettleSeconds = 3.0f;
+
+	UPROPERTY(Config)
+	float WalkSeconds = 8.0f;
+
+	UPROPERTY(Config)
+	int32 TeleportCount = 4;
+
+	// Frames the teleport arc is aimed before each teleport
+	UPROPERTY(Config)
+	int32 TeleportAimFrames = 10;
+
+	// Longest a hand waits to hover its target before the step is given up
+	UPROPERTY(Config)
+	float ReachTimeout = 3.0f;
+
+	// Seconds a hold or an item is kept in hand
+	UPROPERTY(Config)
+	float HoldSeconds = 2.0f;
+
+	UPROPERTY(Config)
+	float SleepSeconds = 10.0f;
+
+	// The clock is set to this hour before the sleep step when it is still day
+	UPROPERTY(Config)
+	float SleepHour = 22.0f;
+
+	// Quits once the summary is written, off to keep playing after the route
+	UPROPERTY(Config)
+	bool bExitWhenDone = true;
+
+private:
+	enum class EStep : uint8
+	{
+		Settle,
+		Walk,
+		Teleport,
+		Climb,
+		Grab,
+		Eat,
+		Drink,
+		Sleep,
+		Done
+	};
+
+	enum class EReachPhase : uint8
+	{
+		Reach,
+		Hold
+	};
+
+	struct FFrameSample
+	{
+		float GameThreadMs = 0.0f;
+		uint32 CollisionQueries = 0;
+		uint32 Allocations = 0;
+		EStep Step = EStep::Settle;
+	};
+
+	static const TCHAR* GetStepName(EStep InStep);
+
+	void EnterStep(EStep NewStep);
+
+	// Returns true once the current step is over
+	bool TickStep();
+
+	// Climb, grab, eat and drink: reach the target with the right hand, grab it, move it, let go
+	bool TickReachStep();
+
+	// Where the hand goes while holding, by step and time held
+	FTransform GetHoldTransform() const;
+
+	// Makes it night and lies down, the step only counts when the bed reports the sleep started
+	void StartSleep(AVRBed* Bed);
+
+	UFUNCTION()
+	void HandleSleepStarted();
+
+	bool PossessCharacter();
+
+	// Nearest actor of Class to the character that is in play, ties broken by name so runs pick the same one
+	AActor* FindNearest(UClass* Class, TArrayView<UClass* const> ExcludedClasses = TArrayView<UClass* const>()) const;
+
+	void WarpNextTo(const AActor* InTarget);
+
+	AVRHand* GetHand() const;
+
+#pragma region Measuring
+
+	void StartMeasuring();
+	void StopMeasuring();
+
+	void HandleBeginFrame();
+	void HandleEndFrame();
+
+	void WriteSummary() const;
+
+#pragma endregion
+
+	TWeakObjectPtr<AVRCharacterBase> Character;
+	TWeakObjectPtr<AActor> Target;
+
+	EStep Step = EStep::Settle;
+	float StepTime = 0.0f;
+	int32 StepFrame = 0;
+
+	EReachPhase ReachPhase = EReachPhase::Reach;
+	float PhaseTime = 0.0f;
+
+	// World space, taken when the hand grabbed
+	FTransform GrabTransform;
+
+	// One bit per EStep that actually did what it says
+	uint32 CompletedSteps = 0;
+
+	bool bRunning = false;
+	bool bMeasuring = false;
+
+	FString RunName;
+	double RunStartSeconds = 0.0;
+
+	TArray<FFrameSample> Samples;
+
+	bool bFrameStarted = false;
+	uint64 LastCollisionQueries = 0;
+	uint64 LastAllocations = 0;
+
+	// Counter totals when measuring started
+	uint64 StartPoolHits = 0;
+	uint64 StartPoolMisses = 0;
+	uint64 StartPhysicsStateRebuilds = 0;
+	uint64 StartRenderWritesAvoided = 0;
+	uint64 StartUILayerRedraws = 0;
+
+	FDelegateHandle BeginFrameHandle;
+	FDelegateHandle EndFrameHandle;
+};
@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/OverlapResult.h"
+#include "Core/VRFocusPoints.h"
+#include "VRPhysicsLODSubsystem.generated.h"
+
+class AVRGrabbableActor;
+
+/**
+ * Keeps only the grabbables near the player simulating. Resting or far-away bodies are demoted to
+ * query-only kinematic bodies without overlap events, and promoted back (with their velocity)
+ * when the player, a hand or a moving body comes near. Evaluation is amortized over several frames.
+ *
+ * Tuning lives in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRPhysicsLODSubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRPhysicsLODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRPhysicsLODSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Called by simulating grabbables on BeginPlay/EndPlay
+	void RegisterGrabbable(AVRGrabbableActor* Grabbable);
+	void UnregisterGrabbable(AVRGrabbableActor* Grabbable);
+
+	// Promotes every demoted body within Radius of Location, e.g. for explosions or scripted events
+	void PromoteInRadius(const FVector& Location, float Radius);
+
+	// Promotes one body right away, used when a hand grabs something that is still dormant
+	void PromoteGrabbable(AVRGrabbableActor* Grabbable);
+
+	// Parks one simulating body right away, used when a grabbable goes back to the pool
+	void DemoteGrabbable(AVRGrabbableActor* Grabbable);
+
+	// Registered grabbables that are simulating and that are demoted, kinematic ones are in neither
+	int32 GetActiveBodyCount() const { return ActiveBodyCount; }
+	int32 GetDormantBodyCount() const { return DormantBodyCount; }
+
+protected:
+	// Bodies further than this from the player and hands are demoted without waiting for SleepDemoteDelay,
+	// once they are asleep or slower than DemoteSpeedThreshold (cm)
+	UPROPERTY(Config)
+	float DemoteDistance = 1500.0f;
+
+	// Far bodies moving faster than this keep simulating so thrown or falling props land first (cm/s)
+	UPROPERTY(Config)
+	float DemoteSpeedThreshold = 20.0f;
+
+	// Bodies closer than this are always promoted, keep below DemoteDistance for hysteresis (cm)
+	UPROPERTY(Config)
+	float PromoteDistance = 800.0f;
+
+	// Seconds a body must have been asleep before it is demoted
+	UPROPERTY(Config)
+	float SleepDemoteDelay = 2.0f;
+
+	// Seconds between two evaluations of the same body
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.25f;
+
+	// Upper bound of bodies evaluated in one frame
+	UPROPERTY(Config)
+	int32 MaxEvaluationsPerFrame = 64;
+
+	// Moving bodies faster than this wake demoted bodies within ImpactPromoteRadius (cm/s)
+	UPROPERTY(Config)
+	float ImpactSpeedThreshold = 150.0f;
+
+	UPROPERTY(Config)
+	float ImpactPromoteRadius = 150.0f;
+
+private:
+	enum class EBodyState : uint8
+	{
+		None,
+		Active,
+		Dormant
+	};
+
+	struct FPhysicsLODEntry
+	{
+		TWeakObjectPtr<AVRGrabbableActor> Grabbable;
+		float RestingTime = 0.0f;
+		double LastEvaluationTime = 0.0;
+
+		// What the entry is currently counted as in the active and dormant counters
+		EBodyState CountedState = EBodyState::None;
+	};
+
+	void EvaluateEntry(FPhysicsLODEntry& Entry, double CurrentTime);
+	void PromoteNearImpact(const AVRGrabbableActor* MovingGrabbable);
+
+	FPhysicsLODEntry* FindEntry(const AVRGrabbableActor* Grabbable);
+
+	// Moves the entry between the counters to match its grabbable, None once the grabbable is gone
+	void UpdateCountedState(FPhysicsLODEntry& Entry);
+
+	void AdjustCounters(int32 ActiveDelta, int32 DormantDelta);
+
+	TArray<FPhysicsLODEntry> Entries;
+	int32 NextEntryIndex = 0;
+
+	// Player and hand locations for this frame
+	FVRFocusPoints FocusPoints;
+
+	// Reused by impact queries so steady-state evaluation does not allocate
+	TArray<FOverlapResult> ImpactOverlaps;
+
+	int32 ActiveBodyCount = 0;
+	int32 DormantBodyCount = 0;
+};
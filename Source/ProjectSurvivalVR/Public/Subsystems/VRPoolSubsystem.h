@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRPoolSubsystem.generated.h"
+
+class APlayerController;
+class UUserWidget;
+
+// One [/Script/ProjectSurvivalVR.VRPoolSubsystem] +PrewarmActorClasses=(ActorClass=...,Count=...) entry
+USTRUCT()
+struct FVRPoolPrewarm
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSoftClassPtr<AActor> ActorClass;
+
+	UPROPERTY()
+	int32 Count = 0;
+};
+
+USTRUCT()
+struct FVRActorFreeList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> Actors;
+};
+
+USTRUCT()
+struct FVRWidgetFreeList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UUserWidget>> Widgets;
+};
+
+/**
+ * Per-world free lists of actors and widgets, keyed by class, so short-lived objects are
+ * hidden and reused instead of spawned, destroyed and garbage collected during play.
+ * Pooled actors are hidden with collision off, objects implementing IVRPoolable get reset hooks.
+ *
+ * Prewarm counts live in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRPoolSubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Reuses a free actor of exactly ActorClass or spawns one, placed at Transform either way
+	AActor* AcquireActor(UClass* ActorClass, const FTransform& Transform, AActor* Owner = nullptr);
+
+	template<typename T>
+	T* AcquireActor(TSubclassOf<T> ActorClass, const FTransform& Transform, AActor* Owner = nullptr)
+	{
+		return Cast<T>(AcquireActor(ActorClass.Get(), Transform, Owner));
+	}
+
+	// Hides and parks the actor, destroys it instead when its class already has MaxFreeActorsPerClass waiting,
+	// through IVRPoolable::DestroyFromFullPool when the actor has its own way to go
+	void ReleaseActor(AActor* Actor);
+
+	// Spawns actors straight into the pool so the first acquires are hits
+	void PrewarmActors(UClass* ActorClass, int32 Count);
+
+	// Reuses a free widget of exactly WidgetClass owned by OwningPlayer or creates one, the caller adds it to the viewport
+	UUserWidget* AcquireWidget(APlayerController* OwningPlayer, TSubclassOf<UUserWidget> WidgetClass);
+
+	// Removes the widget from its parent and parks it
+	void ReleaseWidget(UUserWidget* Widget);
+
+	void PrewarmWidgets(APlayerController* OwningPlayer, TSubclassOf<UUserWidget> WidgetClass, int32 Count);
+
+	int32 GetFreeActorCount(UClass* ActorClass) const;
+
+	// True while Actor is parked in a free list
+	bool IsPooled(const AActor* Actor) const;
+
+	uint64 GetHitCount() const { return HitCount; }
+	uint64 GetMissCount() const { return MissCount; }
+
+protected:
+	// Actors spawned into the free lists when the world begins play
+	UPROPERTY(Config)
+	TArray<FVRPoolPrewarm> PrewarmActorClasses;
+
+	// Free actors kept per class, releases beyond this destroy the actor
+	UPROPERTY(Config)
+	int32 MaxFreeActorsPerClass = 16;
+
+private:
+	void CountHit();
+	void CountMiss();
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FVRActorFreeList> FreeActors;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FVRWidgetFreeList> FreeWidgets;
+
+	uint64 HitCount = 0;
+	uint64 MissCount = 0;
+};
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Structures/GrabbableStateRecord.h"
+#include "Core/VRFocusPoints.h"
+#include "VRPropInstancingSubsystem.generated.h"
+
+class AVRGrabbableActor;
+class UHierarchicalInstancedStaticMeshComponent;
+
+// All dormant instances of one grabbable class, drawn by a single HISM
+USTRUCT()
+struct FInstancedPropSet
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UHierarchicalInstancedStaticMeshComponent> Component;
+
+	// Indexed like the HISM instances, slots in FreeSlots are zero-scaled and unused
+	UPROPERTY()
+	TArray<FGrabbableStateRecord> Records;
+
+	TArray<int32> FreeSlots;
+};
+
+/**
+ * Replaces grabbables that rest far from the player by instances of a hierarchical instanced static mesh,
+ * one per class, and brings a real actor back (with its saved transform and gameplay state) when the
+ * player or a hand comes near. Works on top of the physics LOD: only physics-demoted actors are collapsed.
+ * Collapsed actors go back to UVRPoolSubsystem and promotions take one from it.
+ *
+ * Tuning lives in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRPropInstancingSubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRPropInstancingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRPropInstancingSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Called by grabbables with bCanBecomeInstance on BeginPlay/EndPlay
+	void RegisterGrabbable(AVRGrabbableActor* Grabbable);
+	void UnregisterGrabbable(AVRGrabbableActor* Grabbable);
+
+	int32 GetInstanceCount() const { return InstanceCount; }
+
+	// Appends the record of every live instance, for saving
+	void GatherRecords(TArray<FGrabbableStateRecord>& OutRecords) const;
+
+	// Drops every instance without spawning anything, for restoring a captured world in place
+	void ClearInstances();
+
+protected:
+	// Physics-dormant actors further than this are collapsed to instances (cm)
+	UPROPERTY(Config)
+	float DemoteDistance = 2500.0f;
+
+	// Instances closer than this become actors again, keep below DemoteDistance for hysteresis (cm)
+	UPROPERTY(Config)
+	float PromoteDistance = 1200.0f;
+
+	// Seconds between two passes over actors and instances
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.5f;
+
+private:
+	void DemoteToInstance(AVRGrabbableActor* Grabbable);
+	void PromoteInstance(FInstancedPropSet& PropSet, int32 Slot);
+
+	FInstancedPropSet& FindOrAddPropSet(AVRGrabbableActor* Template);
+
+
+	void AdjustInstanceCount(int32 Delta);
+
+	UPROPERTY()
+	TMap<TSubclassOf<AVRGrabbableActor>, FInstancedPropSet> PropSets;
+
+	// Holds the HISM components
+	UPROPERTY()
+	TObjectPtr<AActor> InstanceHost;
+
+	TArray<TWeakObjectPtr<AVRGrabbableActor>> Grabbables;
+
+	FVRFocusPoints FocusPoints;
+
+	float TimeSinceEvaluation = 0.0f;
+	int32 InstanceCount = 0;
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Structures/VRSaveData.h"
+#include "Tasks/Task.h"
+#include "VRSaveSubsystem.generated.h"
+
+/**
+ * Owns the save for the whole session, across level transitions, and its file. Reading, decompressing,
+ * serializing, compressing and writing all run on a background task, one at a time in request order,
+ * so neither autosave nor load touches the game thread beyond handing over a snapshot.
+ * What goes into the save is captured per world by UVRWorldSaveSubsystem.
+ *
+ * File: <magic> <version> <uncompressed size> <Oodle compressed FVRSaveGame>, in Saved/SaveGames.
+ * Settings live in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRSaveSubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRSaveSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRSaveSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// False until the file read started at startup has finished, world state is applied after that
+	bool IsLoaded() const { return bLoaded; }
+
+	// The session's save, written back by WriteToDisk
+	FVRSaveGame& GetSaveGame() { return SaveGame; }
+	const FVRSaveGame& GetSaveGame() const { return SaveGame; }
+
+	// Copies the current save and writes it in the background, the game thread only pays for the copy
+	void WriteToDisk();
+
+	// Forgets everything and deletes the file, for a new game
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	void DeleteSave();
+
+	UFUNCTION(BlueprintPure, Category = "Save")
+	bool IsWriting() const { return PendingWrites > 0; }
+
+protected:
+	UPROPERTY(Config)
+	FString SlotName = TEXT("Autosave");
+
+private:
+	FString GetSavePath() const;
+
+	void LoadFromDisk();
+	void OnLoadFinished(TUniquePtr<FVRSaveGame> LoadedSave);
+
+	// Background work, in the order it was requested
+	UE::Tasks::FTask IOTask;
+
+	FVRSaveGame SaveGame;
+
+	bool bLoaded = false;
+	int32 PendingWrites = 0;
+};
@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRVFXBudgetSubsystem.generated.h"
+
+class UNiagaraComponent;
+class UNiagaraSystem;
+
+UENUM()
+enum class EVFXBudgetTier : uint8
+{
+	Inactive,   // The owner does not want the effect, it is deactivated
+	Full,       // Full-quality system, ticking
+	Reduced,    // Cheaper system or lower quality scale, ticking
+	Paused      // Off-screen, too far or over budget, simulation paused
+};
+
+USTRUCT()
+struct FVFXBudgetEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<UNiagaraComponent> Component;
+
+	// The asset the component was registered with
+	UPROPERTY()
+	TObjectPtr<UNiagaraSystem> FullSystem;
+
+	// Swapped in for the Reduced tier, optional
+	UPROPERTY()
+	TObjectPtr<UNiagaraSystem> ReducedSystem;
+
+	EVFXBudgetTier Tier = EVFXBudgetTier::Inactive;
+	bool bWanted = false;
+	float Score = 0.0f;
+};
+
+/**
+ * Ranks registered fire and heat Niagara systems by screen size, distance and view direction and
+ * keeps only the best few at full quality. The next ones fall back to a cheaper system (or a lower
+ * User.QualityScale), and everything off-screen, too far or beyond both caps is paused.
+ * Owners say whether they want their effect with SetEffectWanted instead of activating it themselves.
+ *
+ * Tuning lives in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRVFXBudgetSubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRVFXBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRVFXBudgetSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Called by owners on BeginPlay/EndPlay, the component's current asset is its full-quality system
+	void RegisterEffect(UNiagaraComponent* Component, UNiagaraSystem* ReducedSystem = nullptr, bool bWanted = false);
+	void UnregisterEffect(UNiagaraComponent* Component);
+
+	// Whether the owner wants the effect at all (fire lit, zone enabled), the budget picks the quality
+	void SetEffectWanted(UNiagaraComponent* Component, bool bWanted);
+
+	int32 GetTierCount(EVFXBudgetTier Tier) const { return TierCounts[static_cast<int32>(Tier)]; }
+
+protected:
+	// Systems ticking at full quality at once
+	UPROPERTY(Config)
+	int32 MaxFullQualitySystems = 4;
+
+	// Systems ticking at reduced quality beyond the full-quality ones
+	UPROPERTY(Config)
+	int32 MaxReducedQualitySystems = 8;
+
+	// Systems further than this are paused whatever their rank (cm)
+	UPROPERTY(Config)
+	float MaxActiveDistance = 6000.0f;
+
+	// Extra degrees beyond the camera's half FOV still counted as on-screen, covers head turns between passes
+	UPROPERTY(Config)
+	float ViewConeMarginDegrees = 15.0f;
+
+	// Systems already at full quality rank this much higher, keeps them from flickering between tiers
+	UPROPERTY(Config)
+	float FullQualityStickiness = 1.25f;
+
+	// Written to the User.QualityScale parameter in the Reduced tier when there is no reduced system
+	UPROPERTY(Config)
+	float ReducedQualityScale = 0.35f;
+
+	// Seconds between two ranking passes
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.25f;
+
+private:
+	void Evaluate();
+	float ScoreEntry(const FVFXBudgetEntry& Entry, const FVector& ViewLocation, const FVector& ViewDirection, float CosViewCone, float ScreenScale) const;
+	void ApplyTier(FVFXBudgetEntry& Entry, EVFXBudgetTier NewTier);
+	void AdjustTierCount(EVFXBudgetTier Tier, int32 Delta);
+	FVFXBudgetEntry* FindEntry(const UNiagaraComponent* Component);
+
+	UPROPERTY()
+	TArray<FVFXBudgetEntry> Entries;
+
+	TArray<int32> RankedEntries;
+
+	int32 TierCounts[4] = { 0, 0, 0, 0 };
+	float TimeSinceEvaluation = 0.0f;
+};
@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Structures/VRSaveData.h"
+#include "Structures/GrabbableStateRecord.h"
+#include "VRWorldSaveSubsystem.generated.h"
+
+class AVRGrabbableActor;
+class UVRBuildSiteComponent;
+class USkeletalMeshComponent;
+
+DECLARE_DELEGATE_OneParam(FOnLevelCaptured, FVRLevelSave& /* LevelState */);
+
+/**
+ * Captures this world into the UVRSaveSubsystem save and restores it from there. The world is saved
+ * as deltas against the map: level placed grabbables that are gone, every other grabbable as a small
+ * record bucketed by grid cell, fire fuel, picked forage cells, what lies in build sites, plus the player's
+ * survival stats and the clock.
+ *
+ * Autosave captures on the game thread a few actors at a time within CaptureBudgetMs per frame, the
+ * file work runs in the background. On load, removed placed actors are pooled as they stream in and
+ * a cell's items are only spawned once the player comes within RestoreRadius of it.
+ *
+ * Tuning lives in DefaultGame.ini under [/Script/ProjectSurvivalVR.VRWorldSaveSubsystem].
+ */
+UCLASS(Config = Game)
+class PROJECTSURVIVALVR_API UVRWorldSaveSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UVRWorldSaveSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Starts a budgeted capture followed by a background write, ignored while one is running
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	void RequestSave();
+
+	// Captures everything this frame and writes it, for level transitions and quitting where a hitch is hidden
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	void SaveNow();
+
+	// Starts a budgeted capture of this level's state and hands it to OnCaptured once done, false while another one runs
+	bool RequestCapture(FOnLevelCaptured OnCaptured);
+
+	// Puts the level back to a captured state in place: grabbables moved or spawned since go back to the pool,
+	// fires take their captured fuel and the captured items return as the player nears their cells
+	void RestoreLevel(const FVRLevelSave& LevelState);
+
+	// Called by grabbables at the end of BeginPlay, parks placed actors the save says are gone
+	void NotifyGrabbableBeganPlay(AVRGrabbableActor* Grabbable);
+
+	// Called when a grabbable leaves its placed state (pooled, consumed, collapsed to an instance)
+	void NotifyGrabbableRemoved(AVRGrabbableActor* Grabbable);
+
+	// Build sites keep what was placed in them as counts rather than actors, so they are tracked while in play
+	void NotifyBuildSiteBeganPlay(UVRBuildSiteComponent* BuildSite);
+	void NotifyBuildSiteEndPlay(UVRBuildSiteComponent* BuildSite);
+
+	bool IsCapturing() const { return bCapturing; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Seconds between two autosaves, zero disables autosave
+	UPROPERTY(Config)
+	float AutosaveInterval = 120.0f;
+
+	// Game thread time an autosave may spend capturing per frame (ms)
+	UPROPERTY(Config)
+	float CaptureBudgetMs = 0.5f;
+
+	// Side of one save grid cell (cm), matches the default World Partition loading cell
+	UPROPERTY(Config)
+	float CellSize = 12800.0f;
+
+	// A cell's saved items are spawned once the player is this close to its centre (cm)
+	UPROPERTY(Config)
+	float RestoreRadius = 12800.0f;
+
+	// Seconds between two checks for cells and fires waiting to be restored
+	UPROPERTY(Config)
+	float RestoreInterval = 0.5f;
+
+private:
+	UFUNCTION()
+	void HandleGrabbed(AVRGrabbableActor* GrabbedActor, USkeletalMeshComponent* HandMesh);
+
+	void HandleApplicationWillDeactivate();
+
+	// Restores the clock, survival stats and this level's deltas once the save is loaded
+	void ApplyLoadedSave();
+	void RestorePendingFires();
+	void RestorePendingForage();
+	void RestorePendingBuildSites();
+	void RestoreNearbyCells();
+
+	void BeginCapture(FOnLevelCaptured OnCaptured);
+	// Returns true once every gathered grabbable has been captured
+	bool ContinueCapture(double Deadline);
+	void FinishCapture();
+	void CaptureGrabbable(AVRGrabbableActor* Grabbable);
+	void WriteCapturedLevel(FVRLevelSave& LevelState);
+
+	// Adds Record to Level's cell for its location, ClassIndices caches Level's class table lookups
+	void AddItem(FVRLevelSave& Level, TMap<UClass*, uint16>& ClassIndices, const FGrabbableStateRecord& Record) const;
+
+	// True for actors loaded with the level and still untouched
+	bool IsPristinePlacedActor(const AVRGrabbableActor* Grabbable) const;
+	void MarkPlacedActorRemoved(AVRGrabbableActor* Grabbable);
+
+	FIntPoint GetCell(const FVector& Location) const;
+	FString GetLevelKey() const;
+
+	// Placed actors already gone in this session or the loaded save
+	TSet<FName> RemovedPlacedActors;
+
+	// Build sites in play, captured and restored by their owner's and their own name
+	TArray<TWeakObjectPtr<UVRBuildSiteComponent>> BuildSites;
+
+	// How placed actors removed this session looked before, so a restore can put them back
+	TMap<FName, FGrabbableStateRecord> PlacedOriginals;
+
+	// Fires and cells loaded or restored but not applied yet, carried into every capture until they are
+	FVRLevelSave PendingState;
+
+	// Capture in progress
+	FVRLevelSave Snapshot;
+	TMap<UClass*, uint16> SnapshotClassIndices;
+	FOnLevelCaptured CaptureCallback;
+	TArray<TWeakObjectPtr<AVRGrabbableActor>> CaptureQueue;
+	int32 CaptureCursor = 0;
+
+	FDelegateHandle WillDeactivateHandle;
+	FDelegateHandle WillTerminateHandle;
+
+	float TimeSinceAutosave = 0.0f;
+	float TimeSinceRestore = 0.0f;
+
+	bool bAppliedSave = false;
+	bool bCapturing = false;
+};
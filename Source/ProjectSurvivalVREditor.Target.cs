@@ -10,6 +10,6 @@ public class ProjectSurvivalVREditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 
-		ExtraModuleNames.AddRange( new string[] { "ProjectSurvivalVR" } );
+		ExtraModuleNames.AddRange( new string[] { "ProjectSurvivalVR", "ProjectSurvivalVREditor" } );
 	}
 }
@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/BakeCommandletUtils.h"
+#include "ActorFactories/ActorFactory.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "Builders/CubeBuilder.h"
+#include "Engine/Blueprint.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "NavigationSystem.h"
+#include "NavMesh/NavMeshBoundsVolume.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "UObject/SavePackage.h"
+
+namespace BakeCommandletUtils
+{
+	void FindBlueprints(const FString& RootPath, UClass* BaseClass, TArray<UBlueprint*>& OutBlueprints)
+	{
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+		Filter.PackagePaths.Add(FName(*RootPath));
+		Filter.bRecursivePaths = true;
+
+		TArray<FAssetData> Assets;
+		IAssetRegistry::GetChecked().GetAssets(Filter, Assets);
+
+		for (const FAssetData& Asset : Assets)
+		{
+			// Filter on the registry tag first so unrelated Blueprints are never loaded
+			FString NativeParentPath;
+			if (!Asset.GetTagValue(FBlueprintTags::NativeParentClassPath, NativeParentPath))
+				continue;
+
+			const UClass* NativeParent = FindObject<UClass>(nullptr, *FPackageName::ExportTextPathToObjectPath(NativeParentPath));
+			if (!NativeParent || !NativeParent->IsChildOf(BaseClass))
+				continue;
+
+			UBlueprint* Blueprint = Cast<UBlueprint>(Asset.GetAsset());
+			if (Blueprint && Blueprint->GeneratedClass && Blueprint->GeneratedClass->IsChildOf(BaseClass))
+			{
+				OutBlueprints.Add(Blueprint);
+			}
+		}
+	}
+
+	bool SaveBlueprint(UBlueprint* Blueprint)
+	{
+		return SaveAsset(Blueprint);
+	}
+
+	bool SaveAsset(UObject* Asset)
+	{
+		UPackage* Package = Asset->GetOutermost();
+		Package->MarkPackageDirty();
+
+		const FString& Extension = Asset->IsA<UWorld>() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension();
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), Extension);
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+
+		return UPackage::SavePackage(Package, Asset, *Filename, SaveArgs);
+	}
+
+	UStaticMesh* MakeHoldMesh(UObject* Outer, FName Name, int32 HoldCount, FRandomStream& Stream)
+	{
+		constexpr float CubeHalfSize = 50.0f;
+
+		UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		if (!Cube)
+			return nullptr;
+
+		UStaticMesh* HoldMesh = DuplicateObject<UStaticMesh>(Cube, Outer, Name);
+
+		// Holds stay off the top and bottom edges, where a hand would rather take the ledge
+		const FVector SideNormals[] = { FVector::ForwardVector, FVector::BackwardVector, FVector::RightVector, FVector::LeftVector };
+		for (int32 Index = 0; Index < HoldCount; ++Index)
+		{
+			const FVector Normal = SideNormals[Stream.RandHelper(UE_ARRAY_COUNT(SideNormals))];
+			const FVector Tangent = FVector::CrossProduct(FVector::UpVector, Normal);
+			const float Across = Stream.FRandRange(-0.9f, 0.9f) * CubeHalfSize;
+			const float Up = Stream.FRandRange(-0.9f, 0.9f) * CubeHalfSize;
+
+			UStaticMeshSocket* Socket = NewObject<UStaticMeshSocket>(HoldMesh);
+			Socket->SocketName = FName(TEXT("Hold"), Index + 1);
+			Socket->RelativeLocation = Normal * CubeHalfSize + Tangent * Across + FVector::UpVector * Up;
+			Socket->RelativeRotation = Normal.Rotation();
+			HoldMesh->AddSocket(Socket);
+		}
+
+		return HoldMesh;
+	}
+
+	bool BuildNavigation(UWorld* World, const FVector& Extent)
+	{
+		FNavigationSystem::AddNavigationSystemToWorld(*World, FNavigationSystemRunMode::EditorMode);
+
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		if (!NavSys)
+			return false;
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ANavMeshBoundsVolume* Bounds = World->SpawnActor<ANavMeshBoundsVolume>(ANavMeshBoundsVolume::StaticClass(), FTransform::Identity, SpawnParams);
+
+		UCubeBuilder* Builder = NewObject<UCubeBuilder>();
+		Builder->X = Extent.X * 2.0f;
+		Builder->Y = Extent.Y * 2.0f;
+		Builder->Z = Extent.Z * 2.0f;
+		UActorFactory::CreateBrushForVolumeActor(Bounds, Builder);
+
+		NavSys->OnNavigationBoundsUpdated(Bounds);
+
+		// Blocks until every tile is built
+		NavSys->Build();
+
+		const ARecastNavMesh* NavMesh = Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate));
+		return NavMesh && NavMesh->GetNavMeshTilesCount() > 0;
+	}
+}
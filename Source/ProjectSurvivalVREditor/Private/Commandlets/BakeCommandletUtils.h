@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UStaticMesh;
+class UWorld;
+struct FRandomStream;
+
+// Asset and fixture helpers shared by the offline commandlets
+namespace BakeCommandletUtils
+{
+	// Loads every Blueprint under RootPath whose native parent derives from BaseClass
+	void FindBlueprints(const FString& RootPath, UClass* BaseClass, TArray<UBlueprint*>& OutBlueprints);
+
+	bool SaveBlueprint(UBlueprint* Blueprint);
+
+	// Saves the package of a top level asset, maps get the map extension
+	bool SaveAsset(UObject* Asset);
+
+	// Copy of the 100 cm engine cube with HoldCount sockets named Hold_N spread over its sides, facing out
+	UStaticMesh* MakeHoldMesh(UObject* Outer, FName Name, int32 HoldCount, FRandomStream& Stream);
+
+	// Adds navmesh bounds of Extent around the origin and builds the navmesh, false without a navigation system
+	// or when the build left the navmesh without a single tile
+	bool BuildNavigation(UWorld* World, const FVector& Extent);
+}
@@ -0,0 +1,427 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/ClimbBakeCommandlet.h"
+#include "Commandlets/BakeCommandletUtils.h"
+#include "Actors/VRClimbableActor.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "PhysicsEngine/BodySetup.h"
+
+namespace
+{
+	struct FBakeTriangle
+	{
+		FVector A;
+		FVector B;
+		FVector C;
+		FVector Normal;
+		bool bWalkable = false;
+	};
+
+	struct FLedgeEdge
+	{
+		FVertexID Start;
+		FVertexID End;
+		FVector StartPosition;
+		FVector EndPosition;
+
+		// Horizontal direction from the edge towards the floor it borders
+		FVector Inward;
+		bool bChained = false;
+	};
+
+	// Closest hit along Start-End against the triangles, optionally floors only
+	bool SegmentHitsMesh(const TArray<FBakeTriangle>& Triangles, const FVector& Start, const FVector& End, bool bWalkableOnly, FVector& OutHit)
+	{
+		bool bHit = false;
+		double ClosestSquared = TNumericLimits<double>::Max();
+
+		for (const FBakeTriangle& Triangle : Triangles)
+		{
+			if (bWalkableOnly && !Triangle.bWalkable)
+				continue;
+
+			FVector HitPoint;
+			FVector HitNormal;
+			if (FMath::SegmentTriangleIntersection(Start, End, Triangle.A, Triangle.B, Triangle.C, HitPoint, HitNormal))
+			{
+				const double DistanceSquared = FVector::DistSquared(Start, HitPoint);
+				if (DistanceSquared < ClosestSquared)
+				{
+					ClosestSquared = DistanceSquared;
+					OutHit = HitPoint;
+					bHit = true;
+				}
+			}
+		}
+
+		return bHit;
+	}
+
+	FVector Unscale(const FVector& Position, const FVector& Scale)
+	{
+		return FVector(
+			Scale.X != 0.0 ? Position.X / Scale.X : Position.X,
+			Scale.Y != 0.0 ? Position.Y / Scale.Y : Position.Y,
+			Scale.Z != 0.0 ? Position.Z / Scale.Z : Position.Z);
+	}
+
+	FKBoxElem MakeBox(const FTransform& Transform, const FVector& Size)
+	{
+		FKBoxElem Box;
+		Box.Center = Transform.GetLocation();
+		Box.Rotation = Transform.Rotator();
+		Box.X = Size.X;
+		Box.Y = Size.Y;
+		Box.Z = Size.Z;
+		return Box;
+	}
+}
+
+UClimbBakeCommandlet::UClimbBakeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UClimbBakeCommandlet::Main(const FString& Params)
+{
+	FString RootPath = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), RootPath);
+	FParse::Value(*Params, TEXT("StandHeight="), StandHeight);
+	FParse::Value(*Params, TEXT("StandInset="), StandInset);
+	FParse::Value(*Params, TEXT("Spacing="), StandPointSpacing);
+	FParse::Value(*Params, TEXT("WalkableSlope="), WalkableSlope);
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	StandPointSpacing = FMath::Max(StandPointSpacing, 1.0f);
+
+	IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+	TArray<UBlueprint*> ClimbableBlueprints;
+	BakeCommandletUtils::FindBlueprints(RootPath, AVRClimbableActor::StaticClass(), ClimbableBlueprints);
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("ClimbBakeWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+	WorldContext.SetCurrentWorld(World);
+
+	int32 BakedCount = 0;
+	int32 FailedSaves = 0;
+
+	for (UBlueprint* Blueprint : ClimbableBlueprints)
+	{
+		if (!BakeClimbable(World, Blueprint))
+			continue;
+
+		++BakedCount;
+
+		if (!bDryRun && !BakeCommandletUtils::SaveBlueprint(Blueprint))
+		{
+			UE_LOG(LogTemp, Error, TEXT("ClimbBake: Failed to save %s"), *Blueprint->GetPathName());
+			++FailedSaves;
+		}
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	UE_LOG(LogTemp, Display, TEXT("ClimbBake: %d of %d climbables updated%s"),
+		BakedCount, ClimbableBlueprints.Num(), bDryRun ? TEXT(" (dry run, nothing saved)") : TEXT(""));
+
+	return FailedSaves > 0 ? 1 : 0;
+}
+
+bool UClimbBakeCommandlet::BakeClimbable(UWorld* World, UBlueprint* Blueprint) const
+{
+	UClass* ClimbableClass = Blueprint->GeneratedClass;
+	if (ClimbableClass->HasAnyClassFlags(CLASS_Abstract))
+		return false;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags = RF_Transient;
+
+	// Spawned so the mesh and scale include everything the Blueprint overrides
+	AVRClimbableActor* Instance = World->SpawnActor<AVRClimbableActor>(ClimbableClass, FTransform::Identity, SpawnParams);
+	if (!Instance)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ClimbBake: Could not spawn %s"), *ClimbableClass->GetName());
+		return false;
+	}
+
+	const UStaticMeshComponent* MeshComponent = Instance->GetActorMesh();
+	const UStaticMesh* StaticMesh = MeshComponent ? MeshComponent->GetStaticMesh() : nullptr;
+	const FVector MeshScale = MeshComponent ? MeshComponent->GetRelativeScale3D() : FVector::OneVector;
+	Instance->Destroy();
+
+	if (!StaticMesh)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ClimbBake: %s has no mesh, skipped"), *Blueprint->GetPathName());
+		return false;
+	}
+
+	FClimbMetadata Metadata;
+	Metadata.SourceMesh = StaticMesh->GetFName();
+	Metadata.bIsBaked = true;
+
+	BakeLedges(StaticMesh, MeshScale, Metadata);
+	BakeHandProxies(StaticMesh, Metadata);
+
+	AVRClimbableActor* Defaults = ClimbableClass->GetDefaultObject<AVRClimbableActor>();
+	if (FClimbMetadata::StaticStruct()->CompareScriptStruct(&Defaults->GetClimbMetadata(), &Metadata, PPF_None))
+		return false;
+
+	Defaults->SetClimbMetadata(Metadata);
+
+	UE_LOG(LogTemp, Display, TEXT("ClimbBake: Baked %s (%d ledges, %d stand points, %d proxies)"),
+		*Blueprint->GetPathName(), Metadata.Ledges.Num(), Metadata.StandPoints.Num(), Metadata.HandProxies.Num());
+
+	return true;
+}
+
+void UClimbBakeCommandlet::BakeLedges(const UStaticMesh* StaticMesh, const FVector& MeshScale, FClimbMetadata& OutMetadata) const
+{
+	const FMeshDescription* MeshDescription = StaticMesh->GetMeshDescription(0);
+	if (!MeshDescription)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ClimbBake: %s has no mesh description, only proxies baked"), *StaticMesh->GetName());
+		return;
+	}
+
+	FStaticMeshConstAttributes Attributes(*MeshDescription);
+	TVertexAttributesConstRef<FVector3f> Positions = Attributes.GetVertexPositions();
+	TVertexInstanceAttributesConstRef<FVector3f> Normals = Attributes.GetVertexInstanceNormals();
+
+	const float WalkableFloorZ = FMath::Cos(FMath::DegreesToRadians(WalkableSlope));
+
+	// Work in scaled component space so heights and spacing are real centimetres
+	TArray<FBakeTriangle> Triangles;
+	TMap<FTriangleID, int32> TriangleIndices;
+	Triangles.Reserve(MeshDescription->Triangles().Num());
+
+	for (const FTriangleID TriangleID : MeshDescription->Triangles().GetElementIDs())
+	{
+		const TArrayView<const FVertexID> Vertices = MeshDescription->GetTriangleVertices(TriangleID);
+		const TArrayView<const FVertexInstanceID> VertexInstances = MeshDescription->GetTriangleVertexInstances(TriangleID);
+
+		FBakeTriangle& Triangle = Triangles.AddDefaulted_GetRef();
+		Triangle.A = FVector(Positions[Vertices[0]]) * MeshScale;
+		Triangle.B = FVector(Positions[Vertices[1]]) * MeshScale;
+		Triangle.C = FVector(Positions[Vertices[2]]) * MeshScale;
+
+		// The authored normals decide which side is up, winding conventions differ between importers
+		FVector Normal = FVector::CrossProduct(Triangle.B - Triangle.A, Triangle.C - Triangle.A).GetSafeNormal();
+		const FVector AuthoredNormal = FVector(Normals[VertexInstances[0]] + Normals[VertexInstances[1]] + Normals[VertexInstances[2]]) * MeshScale.GetSignVector();
+		if (FVector::DotProduct(Normal, AuthoredNormal) < 0.0)
+		{
+			Normal = -Normal;
+		}
+
+		Triangle.Normal = Normal;
+		Triangle.bWalkable = Normal.Z >= WalkableFloorZ;
+		TriangleIndices.Add(TriangleID, Triangles.Num() - 1);
+	}
+
+	// A ledge edge borders a floor on one side and a wall or nothing on the other
+	TArray<FLedgeEdge> LedgeEdges;
+	TMultiMap<FVertexID, int32> EdgesByVertex;
+
+	for (const FEdgeID EdgeID : MeshDescription->Edges().GetElementIDs())
+	{
+		const TArrayView<const FTriangleID> EdgeTriangles = MeshDescription->GetEdgeConnectedTriangleIDs(EdgeID);
+
+		int32 FloorTriangle = INDEX_NONE;
+		int32 FloorCount = 0;
+		bool bBordersWall = EdgeTriangles.Num() == 1;
+
+		for (const FTriangleID TriangleID : EdgeTriangles)
+		{
+			const int32 TriangleIndex = TriangleIndices.FindChecked(TriangleID);
+			if (Triangles[TriangleIndex].bWalkable)
+			{
+				FloorTriangle = TriangleIndex;
+				++FloorCount;
+			}
+			else if (Triangles[TriangleIndex].Normal.Z > -0.5)
+			{
+				bBordersWall = true;
+			}
+		}
+
+		if (FloorCount != 1 || !bBordersWall)
+			continue;
+
+		FLedgeEdge& Edge = LedgeEdges.AddDefaulted_GetRef();
+		Edge.Start = MeshDescription->GetEdgeVertex(EdgeID, 0);
+		Edge.End = MeshDescription->GetEdgeVertex(EdgeID, 1);
+		Edge.StartPosition = FVector(Positions[Edge.Start]) * MeshScale;
+		Edge.EndPosition = FVector(Positions[Edge.End]) * MeshScale;
+
+		const FBakeTriangle& Floor = Triangles[FloorTriangle];
+		const FVector Centroid = (Floor.A + Floor.B + Floor.C) / 3.0;
+		const FVector Midpoint = (Edge.StartPosition + Edge.EndPosition) * 0.5;
+		Edge.Inward = FVector(Centroid.X - Midpoint.X, Centroid.Y - Midpoint.Y, 0.0).GetSafeNormal();
+
+		const int32 EdgeIndex = LedgeEdges.Num() - 1;
+		EdgesByVertex.Add(Edge.Start, EdgeIndex);
+		EdgesByVertex.Add(Edge.End, EdgeIndex);
+	}
+
+	// Chain connected edges into polylines
+	TArray<int32> VertexEdges;
+	for (int32 SeedIndex = 0; SeedIndex < LedgeEdges.Num(); ++SeedIndex)
+	{
+		if (LedgeEdges[SeedIndex].bChained)
+			continue;
+
+		LedgeEdges[SeedIndex].bChained = true;
+
+		TArray<FVector> Points = { LedgeEdges[SeedIndex].StartPosition, LedgeEdges[SeedIndex].EndPosition };
+		FVertexID Ends[2] = { LedgeEdges[SeedIndex].Start, LedgeEdges[SeedIndex].End };
+
+		for (int32 Side = 0; Side < 2; ++Side)
+		{
+			bool bExtended = true;
+			while (bExtended)
+			{
+				bExtended = false;
+				VertexEdges.Reset();
+				EdgesByVertex.MultiFind(Ends[Side], VertexEdges);
+
+				for (const int32 EdgeIndex : VertexEdges)
+				{
+					FLedgeEdge& Edge = LedgeEdges[EdgeIndex];
+					if (Edge.bChained)
+						continue;
+
+					Edge.bChained = true;
+					const bool bFromStart = Edge.Start == Ends[Side];
+					Ends[Side] = bFromStart ? Edge.End : Edge.Start;
+
+					const FVector Next = bFromStart ? Edge.EndPosition : Edge.StartPosition;
+					if (Side == 0)
+					{
+						Points.Insert(Next, 0);
+					}
+					else
+					{
+						Points.Add(Next);
+					}
+
+					bExtended = true;
+					break;
+				}
+			}
+		}
+
+		FClimbLedge& Ledge = OutMetadata.Ledges.AddDefaulted_GetRef();
+		Ledge.Points.Reserve(Points.Num());
+		for (const FVector& Point : Points)
+		{
+			Ledge.Points.Add(Unscale(Point, MeshScale));
+		}
+	}
+
+	// Stand points: behind the ledge, on a floor, with the whole body height free
+	const float MinStandPointDistanceSquared = FMath::Square(StandPointSpacing * 0.5f);
+	const FVector Up = FVector::UpVector;
+	const FVector SideChecks[] = { FVector::ForwardVector, FVector::BackwardVector, FVector::RightVector, FVector::LeftVector };
+	TArray<FVector> StandPoints;
+
+	for (const FLedgeEdge& Edge : LedgeEdges)
+	{
+		if (Edge.Inward.IsNearlyZero())
+			continue;
+
+		const int32 SampleCount = FMath::Max(1, FMath::CeilToInt(FVector::Dist(Edge.StartPosition, Edge.EndPosition) / StandPointSpacing));
+		for (int32 Sample = 0; Sample < SampleCount; ++Sample)
+		{
+			const float Alpha = (Sample + 0.5f) / SampleCount;
+			const FVector Candidate = FMath::Lerp(Edge.StartPosition, Edge.EndPosition, Alpha) + Edge.Inward * StandInset;
+
+			FVector Ground;
+			if (!SegmentHitsMesh(Triangles, Candidate + Up * 20.0f, Candidate - Up * 40.0f, true, Ground))
+				continue;
+
+			FVector Blocker;
+			if (SegmentHitsMesh(Triangles, Ground + Up * 1.0f, Ground + Up * StandHeight, false, Blocker))
+				continue;
+
+			// Room for the capsule around the body, not just above the feet
+			const FVector BodyCenter = Ground + Up * (StandHeight * 0.5f);
+			bool bBodyBlocked = false;
+			for (const FVector& Direction : SideChecks)
+			{
+				if (SegmentHitsMesh(Triangles, BodyCenter, BodyCenter + Direction * StandInset, false, Blocker))
+				{
+					bBodyBlocked = true;
+					break;
+				}
+			}
+
+			if (bBodyBlocked)
+				continue;
+
+			const bool bTooClose = StandPoints.ContainsByPredicate([&Ground, MinStandPointDistanceSquared](const FVector& Existing)
+			{
+				return FVector::DistSquared(Existing, Ground) < MinStandPointDistanceSquared;
+			});
+
+			if (!bTooClose)
+			{
+				StandPoints.Add(Ground);
+			}
+		}
+	}
+
+	OutMetadata.StandPoints.Reserve(StandPoints.Num());
+	for (const FVector& StandPoint : StandPoints)
+	{
+		OutMetadata.StandPoints.Add(Unscale(StandPoint, MeshScale));
+	}
+}
+
+void UClimbBakeCommandlet::BakeHandProxies(const UStaticMesh* StaticMesh, FClimbMetadata& OutMetadata) const
+{
+	const UBodySetup* BodySetup = StaticMesh->GetBodySetup();
+	if (BodySetup)
+	{
+		const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+
+		OutMetadata.HandProxies.Append(AggGeom.BoxElems);
+
+		for (const FKConvexElem& Convex : AggGeom.ConvexElems)
+		{
+			const FTransform ConvexTransform = Convex.GetTransform();
+			const FBox& Bounds = Convex.ElemBox;
+			OutMetadata.HandProxies.Add(MakeBox(
+				FTransform(ConvexTransform.GetRotation(), ConvexTransform.TransformPosition(Bounds.GetCenter())),
+				Bounds.GetSize() * ConvexTransform.GetScale3D()));
+		}
+
+		for (const FKSphereElem& Sphere : AggGeom.SphereElems)
+		{
+			OutMetadata.HandProxies.Add(MakeBox(FTransform(Sphere.Center), FVector(Sphere.Radius * 2.0f)));
+		}
+
+		for (const FKSphylElem& Capsule : AggGeom.SphylElems)
+		{
+			const float Diameter = Capsule.Radius * 2.0f;
+			OutMetadata.HandProxies.Add(MakeBox(Capsule.GetTransform(), FVector(Diameter, Diameter, Capsule.Length + Diameter)));
+		}
+	}
+
+	// Without simple collision the bounds are the best convex approximation available
+	if (OutMetadata.HandProxies.Num() == 0)
+	{
+		const FBox Bounds = StaticMesh->GetBoundingBox();
+		OutMetadata.HandProxies.Add(MakeBox(FTransform(Bounds.GetCenter()), Bounds.GetSize()));
+	}
+}
@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/GraspBakeCommandlet.h"
+#include "Commandlets/BakeCommandletUtils.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Hands/VRHand.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "Animation/AnimationAsset.h"
+#include "Engine/Blueprint.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	bool AreGraspsEqual(const FBakedGrasp& A, const FBakedGrasp& B)
+	{
+		return A.bIsBaked == B.bIsBaked
+			&& FMemory::Memcmp(A.LeftHandCurls, B.LeftHandCurls, sizeof(A.LeftHandCurls)) == 0
+			&& FMemory::Memcmp(A.RightHandCurls, B.RightHandCurls, sizeof(A.RightHandCurls)) == 0;
+	}
+}
+
+UGraspBakeCommandlet::UGraspBakeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UGraspBakeCommandlet::Main(const FString& Params)
+{
+	FString RootPath = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), RootPath);
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+	// One hand Blueprint per side is enough, the finger splines are authored per hand class
+	TArray<UBlueprint*> HandBlueprints;
+	BakeCommandletUtils::FindBlueprints(TEXT("/Game"), AVRHand::StaticClass(), HandBlueprints);
+
+	TArray<UBlueprint*> GrabbableBlueprints;
+	BakeCommandletUtils::FindBlueprints(RootPath, AVRGrabbableActor::StaticClass(), GrabbableBlueprints);
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("GraspBakeWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+	WorldContext.SetCurrentWorld(World);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags = RF_Transient;
+
+	AVRHand* LeftHand = nullptr;
+	AVRHand* RightHand = nullptr;
+
+	for (UBlueprint* HandBlueprint : HandBlueprints)
+	{
+		const AVRHand* HandDefaults = HandBlueprint->GeneratedClass->GetDefaultObject<AVRHand>();
+		AVRHand*& Slot = (HandDefaults->GetHandType() == EControllerHand::Left) ? LeftHand : RightHand;
+
+		if (!Slot && !HandBlueprint->GeneratedClass->HasAnyClassFlags(CLASS_Abstract))
+		{
+			Slot = World->SpawnActor<AVRHand>(HandBlueprint->GeneratedClass, FTransform::Identity, SpawnParams);
+		}
+	}
+
+	if (!LeftHand && !RightHand)
+	{
+		UE_LOG(LogTemp, Error, TEXT("GraspBake: No AVRHand Blueprint found, nothing to bake with"));
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return 1;
+	}
+
+	int32 BakedCount = 0;
+	int32 FailedSaves = 0;
+
+	for (UBlueprint* Blueprint : GrabbableBlueprints)
+	{
+		if (!BakeGrabbable(World, Blueprint, LeftHand, RightHand))
+			continue;
+
+		++BakedCount;
+
+		if (!bDryRun && !BakeCommandletUtils::SaveBlueprint(Blueprint))
+		{
+			UE_LOG(LogTemp, Error, TEXT("GraspBake: Failed to save %s"), *Blueprint->GetPathName());
+			++FailedSaves;
+		}
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	UE_LOG(LogTemp, Display, TEXT("GraspBake: %d of %d grabbables updated%s"),
+		BakedCount, GrabbableBlueprints.Num(), bDryRun ? TEXT(" (dry run, nothing saved)") : TEXT(""));
+
+	return FailedSaves > 0 ? 1 : 0;
+}
+
+bool UGraspBakeCommandlet::BakeGrabbable(UWorld* World, UBlueprint* Blueprint, AVRHand* LeftHand, AVRHand* RightHand) const
+{
+	UClass* GrabbableClass = Blueprint->GeneratedClass;
+	if (GrabbableClass->HasAnyClassFlags(CLASS_Abstract))
+		return false;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags = RF_Transient;
+
+	AVRGrabbableActor* Instance = World->SpawnActor<AVRGrabbableActor>(GrabbableClass, FTransform::Identity, SpawnParams);
+	if (!Instance)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GraspBake: Could not spawn %s"), *GrabbableClass->GetName());
+		return false;
+	}
+
+	AVRGrabbableActor* Defaults = GrabbableClass->GetDefaultObject<AVRGrabbableActor>();
+	UPrimitiveComponent* TargetComponent = Instance->GetGrabCollisionComponent();
+	bool bChanged = false;
+
+	const EGrabPointType GrabPointTypes[] = { EGrabPointType::Main, EGrabPointType::Secondary };
+	for (const EGrabPointType GrabPointType : GrabPointTypes)
+	{
+		const bool bIsMain = (GrabPointType == EGrabPointType::Main);
+		if (bIsMain ? !Instance->ShouldUseMainGrabPoint() : !Instance->ShouldUseSecondaryGrabPoint())
+			continue;
+
+		// Same transform OnUnifiedGrab aligns the hand socket to
+		const FTransform GripTransform = bIsMain ? Instance->GetMainGrabPointTransform() : Instance->GetSecondaryGrabPointTransform();
+
+		FBakedGrasp BakedGrasp;
+		BakedGrasp.bIsBaked = true;
+
+		if (LeftHand)
+		{
+			BakedGrasp.SetFingerData(true, LeftHand->ComputeGraspAgainst(TargetComponent, GripTransform));
+		}
+
+		if (RightHand)
+		{
+			BakedGrasp.SetFingerData(false, RightHand->ComputeGraspAgainst(TargetComponent, GripTransform));
+		}
+
+		// Without one of the hands, mirror the other one rather than leaving zero curls
+		if (!LeftHand)
+		{
+			BakedGrasp.SetFingerData(true, BakedGrasp.GetFingerData(false));
+		}
+		else if (!RightHand)
+		{
+			BakedGrasp.SetFingerData(false, BakedGrasp.GetFingerData(true));
+		}
+
+		const FGrabPointData& ExistingData = Defaults->GetGrabPointData(GrabPointType);
+		if (!AreGraspsEqual(ExistingData.BakedGrasp, BakedGrasp))
+		{
+			Defaults->SetBakedGrasp(GrabPointType, BakedGrasp);
+			bChanged = true;
+		}
+
+		// Never overwrite a hand-assigned pose
+		if (ExistingData.GrabAnimation.IsNull())
+		{
+			const TSoftObjectPtr<UAnimationAsset> GraspPose = FindGraspPose(Blueprint, bIsMain ? TEXT("Main") : TEXT("Secondary"));
+			if (!GraspPose.IsNull())
+			{
+				Defaults->SetGrabAnimation(GrabPointType, GraspPose);
+				bChanged = true;
+			}
+		}
+	}
+
+	Instance->Destroy();
+
+	if (bChanged)
+	{
+		UE_LOG(LogTemp, Display, TEXT("GraspBake: Baked %s"), *Blueprint->GetPathName());
+	}
+
+	return bChanged;
+}
+
+TSoftObjectPtr<UAnimationAsset> UGraspBakeCommandlet::FindGraspPose(const UBlueprint* Blueprint, const TCHAR* GrabPointSuffix) const
+{
+	const FString PackagePath = FPackageName::GetLongPackagePath(Blueprint->GetOutermost()->GetName());
+	const FString AssetName = FString::Printf(TEXT("%s_%s_Grasp"), *Blueprint->GetName(), GrabPointSuffix);
+	const FSoftObjectPath PosePath(FString::Printf(TEXT("%s/%s.%s"), *PackagePath, *AssetName, *AssetName));
+
+	const FAssetData PoseData = IAssetRegistry::GetChecked().GetAssetByObjectPath(PosePath);
+	if (!PoseData.IsValid())
+		return nullptr;
+
+	const UClass* PoseClass = PoseData.GetClass();
+	if (!PoseClass || !PoseClass->IsChildOf(UAnimationAsset::StaticClass()))
+		return nullptr;
+
+	return TSoftObjectPtr<UAnimationAsset>(PosePath);
+}
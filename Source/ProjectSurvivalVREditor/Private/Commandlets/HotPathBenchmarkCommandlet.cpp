@@ -0,0 +1,366 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/HotPathBenchmarkCommandlet.h"
+#include "Commandlets/BakeCommandletUtils.h"
+#include "Actors/VRClimbableActor.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Camera/CameraComponent.h"
+#include "Characters/VRCharacterBase.h"
+#include "Components/SurvivalComponent.h"
+#include "Core/VRAllocationCounter.h"
+#include "Core/VRPerfCounters.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Hands/VRHand.h"
+#include "Structures/VRItemDefinition.h"
+#include "Subsystems/VRItemRegistrySubsystem.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	const TCHAR* CubePath = TEXT("/Engine/BasicShapes/Cube.Cube");
+
+	// Extent of the fixture floor and its navmesh (cm)
+	const FVector FixtureExtent(5000.0f, 5000.0f, 1000.0f);
+
+	constexpr int32 GrabbableCount = 8;
+	constexpr int32 ClimbQueryPointCount = 64;
+
+	template <typename T>
+	T* SpawnAt(UWorld* World, UClass* Class, const FTransform& Transform)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return World->SpawnActor<T>(Class, Transform, SpawnParams);
+	}
+
+	AStaticMeshActor* SpawnBlock(UWorld* World, const FVector& Location, const FVector& Scale)
+	{
+		AStaticMeshActor* Block = SpawnAt<AStaticMeshActor>(World, AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, Location, Scale));
+		Block->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, CubePath));
+		return Block;
+	}
+}
+
+UHotPathBenchmarkCommandlet::UHotPathBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UHotPathBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString Label;
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("HotPaths-%s.json"), *FDateTime::Now().ToString());
+	FString BaselinePath;
+	FParse::Value(*Params, TEXT("Label="), Label);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Batches="), Batches);
+	FParse::Value(*Params, TEXT("Holds="), HoldCount);
+	FParse::Value(*Params, TEXT("Threshold="), Threshold);
+
+	Iterations = FMath::Max(Iterations, 1);
+	Batches = FMath::Max(Batches, 1);
+	HoldCount = FMath::Max(HoldCount, 1);
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("HotPathBenchmarkWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+	WorldContext.SetCurrentWorld(World);
+
+	BuildFixture(World);
+
+	FVRAllocationCounter::Start();
+
+	const ELogVerbosity::Type TempVerbosity = LogTemp.GetVerbosity();
+	LogTemp.SetVerbosity(ELogVerbosity::Error);
+
+	const FTransform FingerTransform = Grabbables[0]->GetActorTransform();
+	UPrimitiveComponent* FingerTarget = Grabbables[0]->GetActorMesh();
+	const FVector TeleportStart = Character->TestGetCamera()->GetComponentLocation();
+	const FVector TeleportDirection = FVector(-1.0f, 0.0f, 0.3f).GetSafeNormal();
+
+	TArray<FBenchmarkResult> Results;
+
+	Results.Add(Run(TEXT("Hand.UpdateHoveredGrabbable"), [this](int32)
+	{
+		Hand->TestUpdateHoveredGrabbable();
+	}));
+
+	Results.Add(Run(TEXT("Hand.GetClosestAvailableGrabPoint"), [this](int32 Call)
+	{
+		Hand->TestGetClosestAvailableGrabPoint(Grabbables[Call % Grabbables.Num()]);
+	}));
+
+	Results.Add(Run(TEXT("Hand.TraceFingerSegment"), [this, &FingerTransform, FingerTarget](int32)
+	{
+		Hand->TestTraceFingerSegment(FingerCache, FingerTransform, FingerTarget);
+	}));
+
+	Results.Add(Run(TEXT("Character.IsHeadNearWall"), [this](int32)
+	{
+		FVector WallNormal;
+		float WallDistance = 0.0f;
+		Character->TestIsHeadNearWall(WallNormal, WallDistance);
+	}));
+
+	Results.Add(Run(TEXT("Character.CalculateHeadWallPenetration"), [this](int32)
+	{
+		Character->TestCalculateHeadWallPenetration();
+	}));
+
+	Results.Add(Run(TEXT("Character.TeleportTrace"), [this, &TeleportStart, &TeleportDirection](int32)
+	{
+		Character->TestTeleportTrace(TeleportStart, TeleportDirection);
+	}));
+
+	Results.Add(Run(TEXT("Climbable.GetClosestSocketToHand"), [this](int32 Call)
+	{
+		Climbable->GetClosestSocketToHand(ClimbQueryPoints[Call % ClimbQueryPoints.Num()]);
+	}));
+
+	USurvivalComponent* Survival = Character->FindComponentByClass<USurvivalComponent>();
+	Results.Add(Run(TEXT("Survival.UpdateSurvivalStats"), [Survival](int32)
+	{
+		Survival->TestUpdateSurvivalStats();
+	}));
+
+	LogTemp.SetVerbosity(TempVerbosity);
+	FVRAllocationCounter::Stop();
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	for (const FBenchmarkResult& Result : Results)
+	{
+		UE_LOG(LogTemp, Display, TEXT("HotPathBenchmark: %-40s %10.1f ns (min %.1f), %.2f allocs, %.2f queries per call"),
+			*Result.Name, Result.MedianNs, Result.MinNs, Result.AllocationsPerCall, Result.QueriesPerCall);
+	}
+
+	if (!WriteReport(Results, Label, OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("HotPathBenchmark: Failed to write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("HotPathBenchmark: Report written to %s"), *OutputPath);
+
+	if (BaselinePath.IsEmpty())
+		return 0;
+
+	const int32 Regressions = CompareToBaseline(Results, BaselinePath);
+	if (Regressions < 0)
+		return 1;
+
+	UE_LOG(LogTemp, Display, TEXT("HotPathBenchmark: %d regressions against %s"), Regressions, *BaselinePath);
+	return Regressions > 0 ? 1 : 0;
+}
+
+void UHotPathBenchmarkCommandlet::BuildFixture(UWorld* World)
+{
+	FRandomStream Stream(0);
+
+	// Floor with its top at Z = 0
+	SpawnBlock(World, FVector(0.0f, 0.0f, -50.0f), FVector(FixtureExtent.X / 50.0f, FixtureExtent.Y / 50.0f, 1.0f));
+
+	// Character standing in the open, a wall 10 cm in front of its head
+	Character = SpawnAt<AVRCharacterBase>(World, AVRCharacterBase::StaticClass(), FTransform(FVector(0.0f, 0.0f, 100.0f)));
+	const FVector HeadLocation = Character->TestGetCamera()->GetComponentLocation();
+	SpawnBlock(World, HeadLocation + FVector(20.0f, 0.0f, 0.0f), FVector(0.2f, 4.0f, 4.0f));
+
+	// Hand away from the character, with a handful of small items in grab range
+	Hand = SpawnAt<AVRHand>(World, AVRHand::StaticClass(), FTransform(FVector(0.0f, 1000.0f, 100.0f)));
+	const FVector HandLocation = Hand->GetHandOriginPoint()->GetComponentLocation();
+
+	// Two-handed items so the grab point query walks both points instead of returning on a free grab
+	FVRItemDefinition TwoHanded;
+	TwoHanded.GrabPointBehavior = EGrabPointBehavior::DualHanded;
+	if (UVRItemRegistrySubsystem* Registry = UVRItemRegistrySubsystem::Get())
+	{
+		Registry->AddFixtureDefinition(AVRGrabbableActor::StaticClass(), TwoHanded);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HotPathBenchmark: No item registry, GetClosestAvailableGrabPoint only measures the free grab path"));
+	}
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, CubePath);
+	for (int32 Index = 0; Index < GrabbableCount; ++Index)
+	{
+		const FVector Offset = FRotator(0.0f, 360.0f * Index / GrabbableCount, 0.0f).Vector() * Stream.FRandRange(8.0f, 14.0f);
+		AVRGrabbableActor* Grabbable = SpawnAt<AVRGrabbableActor>(World, AVRGrabbableActor::StaticClass(), FTransform(FRotator::ZeroRotator, HandLocation + Offset, FVector(0.1f)));
+		Grabbable->GetActorMesh()->SetStaticMesh(Cube);
+
+		// On opposite faces of the 10 cm cube, some within snap range of the hand and some not
+		Grabbable->GrabPointMain->SetRelativeLocation(FVector(0.0f, 50.0f, 0.0f));
+		Grabbable->GrabPointSecond->SetRelativeLocation(FVector(0.0f, -50.0f, 0.0f));
+
+		Grabbables.Add(Grabbable);
+		Hand->TestAddOverlappingInteractable(TScriptInterface<IInteractable>(Grabbable));
+	}
+
+	// Five points bending through the 10 cm cube from above, the hit lands on the third segment
+	FingerCache.Reset();
+	for (int32 Step = 0; Step <= 4; ++Step)
+	{
+		const float Angle = FMath::DegreesToRadians(30.0f * Step);
+		FingerCache.Add(FVector(-10.0f + 10.0f * FMath::Sin(Angle), 0.0f, 10.0f * FMath::Cos(Angle)));
+	}
+
+	// Climbable with generated holds, queried from around its sides
+	UStaticMesh* HoldMesh = BakeCommandletUtils::MakeHoldMesh(GetTransientPackage(), TEXT("SM_BenchmarkHolds"), HoldCount, Stream);
+	const FVector ClimbableScale(2.0f, 2.0f, 4.0f);
+	Climbable = SpawnAt<AVRClimbableActor>(World, AVRClimbableActor::StaticClass(), FTransform(FRotator::ZeroRotator, FVector(0.0f, -1000.0f, 200.0f), ClimbableScale));
+	Climbable->GetActorMesh()->SetStaticMesh(HoldMesh);
+	Climbable->TestBuildHoldIndex();
+
+	const FBox ClimbBounds = Climbable->GetComponentsBoundingBox().ExpandBy(50.0f);
+	ClimbQueryPoints.Reset(ClimbQueryPointCount);
+	for (int32 Index = 0; Index < ClimbQueryPointCount; ++Index)
+	{
+		ClimbQueryPoints.Add(FVector(
+			Stream.FRandRange(ClimbBounds.Min.X, ClimbBounds.Max.X),
+			Stream.FRandRange(ClimbBounds.Min.Y, ClimbBounds.Max.Y),
+			Stream.FRandRange(ClimbBounds.Min.Z, ClimbBounds.Max.Z)));
+	}
+
+	// Teleport traces project onto it
+	if (!BakeCommandletUtils::BuildNavigation(World, FixtureExtent))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HotPathBenchmark: No navmesh was built, TeleportTrace skips the projection"));
+	}
+}
+
+UHotPathBenchmarkCommandlet::FBenchmarkResult UHotPathBenchmarkCommandlet::Run(const TCHAR* Name, TFunctionRef<void(int32)> Body) const
+{
+	// Lazy setup and cold caches stay out of the measurement
+	for (int32 Call = 0; Call < Iterations; ++Call)
+	{
+		Body(Call);
+	}
+
+	TArray<double> BatchNs;
+	BatchNs.Reserve(Batches);
+
+	const uint64 AllocationsBefore = FVRAllocationCounter::GetAllocations();
+	const uint64 QueriesBefore = FVRPerfCounters::CollisionQueries;
+
+	for (int32 Batch = 0; Batch < Batches; ++Batch)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Call = 0; Call < Iterations; ++Call)
+		{
+			Body(Call);
+		}
+
+		BatchNs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0 / Iterations);
+	}
+
+	const double Calls = static_cast<double>(Iterations) * Batches;
+	BatchNs.Sort();
+
+	FBenchmarkResult Result;
+	Result.Name = Name;
+	Result.MedianNs = BatchNs[BatchNs.Num() / 2];
+	Result.MinNs = BatchNs[0];
+	Result.AllocationsPerCall = (FVRAllocationCounter::GetAllocations() - AllocationsBefore) / Calls;
+	Result.QueriesPerCall = (FVRPerfCounters::CollisionQueries - QueriesBefore) / Calls;
+	return Result;
+}
+
+bool UHotPathBenchmarkCommandlet::WriteReport(const TArray<FBenchmarkResult>& Results, const FString& Label, const FString& OutputPath) const
+{
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("Label"), Label);
+	Report->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+	Report->SetStringField(TEXT("Configuration"), LexToString(FApp::GetBuildConfiguration()));
+	Report->SetStringField(TEXT("Platform"), ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()));
+	Report->SetNumberField(TEXT("Iterations"), Iterations);
+	Report->SetNumberField(TEXT("Batches"), Batches);
+
+	TArray<TSharedPtr<FJsonValue>> Benchmarks;
+	for (const FBenchmarkResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> Benchmark = MakeShared<FJsonObject>();
+		Benchmark->SetStringField(TEXT("Name"), Result.Name);
+		Benchmark->SetNumberField(TEXT("MedianNs"), Result.MedianNs);
+		Benchmark->SetNumberField(TEXT("MinNs"), Result.MinNs);
+		Benchmark->SetNumberField(TEXT("AllocationsPerCall"), Result.AllocationsPerCall);
+		Benchmark->SetNumberField(TEXT("QueriesPerCall"), Result.QueriesPerCall);
+		Benchmarks.Add(MakeShared<FJsonValueObject>(Benchmark));
+	}
+
+	Report->SetArrayField(TEXT("Benchmarks"), Benchmarks);
+
+	FString Text;
+	if (!FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&Text)))
+		return false;
+
+	return FFileHelper::SaveStringToFile(Text, *OutputPath);
+}
+
+int32 UHotPathBenchmarkCommandlet::CompareToBaseline(const TArray<FBenchmarkResult>& Results, const FString& BaselinePath) const
+{
+	FString Text;
+	TSharedPtr<FJsonObject> Baseline;
+	if (!FFileHelper::LoadFileToString(Text, *BaselinePath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Baseline) || !Baseline)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HotPathBenchmark: Could not read the baseline %s"), *BaselinePath);
+		return -1;
+	}
+
+	TMap<FString, TSharedPtr<FJsonObject>> BaselineByName;
+	for (const TSharedPtr<FJsonValue>& Value : Baseline->GetArrayField(TEXT("Benchmarks")))
+	{
+		const TSharedPtr<FJsonObject>& Benchmark = Value->AsObject();
+		if (Benchmark)
+		{
+			BaselineByName.Add(Benchmark->GetStringField(TEXT("Name")), Benchmark);
+		}
+	}
+
+	int32 Regressions = 0;
+	for (const FBenchmarkResult& Result : Results)
+	{
+		const TSharedPtr<FJsonObject>* Previous = BaselineByName.Find(Result.Name);
+		if (!Previous)
+		{
+			UE_LOG(LogTemp, Display, TEXT("HotPathBenchmark: %s is new, no baseline"), *Result.Name);
+			continue;
+		}
+
+		const double PreviousNs = (*Previous)->GetNumberField(TEXT("MedianNs"));
+		const double PreviousAllocations = (*Previous)->GetNumberField(TEXT("AllocationsPerCall"));
+		const double PreviousQueries = (*Previous)->GetNumberField(TEXT("QueriesPerCall"));
+		const double Change = PreviousNs > 0.0 ? (Result.MedianNs / PreviousNs - 1.0) * 100.0 : 0.0;
+
+		// Allocation and query counts do not depend on the machine, any increase is real
+		const bool bSlower = Change > Threshold;
+		const bool bMoreAllocations = Result.AllocationsPerCall > PreviousAllocations + UE_KINDA_SMALL_NUMBER;
+		const bool bMoreQueries = Result.QueriesPerCall > PreviousQueries + UE_KINDA_SMALL_NUMBER;
+
+		if (bSlower || bMoreAllocations || bMoreQueries)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("HotPathBenchmark: %s regressed, %.1f ns (%+.1f%%), %.2f allocs (was %.2f), %.2f queries (was %.2f)"),
+				*Result.Name, Result.MedianNs, Change, Result.AllocationsPerCall, PreviousAllocations, Result.QueriesPerCall, PreviousQueries);
+			++Regressions;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Display, TEXT("HotPathBenchmark: %s %+.1f%%"), *Result.Name, Change);
+		}
+	}
+
+	return Regressions;
+}
@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/ItemTableMigrationCommandlet.h"
+#include "Commandlets/BakeCommandletUtils.h"
+#include "Actors/VRGrabbableActor.h"
+#include "Structures/VRItemDefinition.h"
+#include "Subsystems/VRItemRegistrySubsystem.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Engine/DataTable.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	FVRItemDefinition GetLegacyDefinition(const AVRGrabbableActor& Item)
+	{
+		FVRItemDefinition Definition;
+		Item.CopyLegacyItemSettings(Definition);
+		return Definition;
+	}
+
+	bool HasSameSettings(const FVRItemDefinition& A, const FVRItemDefinition& B)
+	{
+		return FVRItemDefinition::StaticStruct()->CompareScriptStruct(&A, &B, PPF_None);
+	}
+}
+
+UItemTableMigrationCommandlet::UItemTableMigrationCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UItemTableMigrationCommandlet::Main(const FString& Params)
+{
+	FString TablePath = TEXT("/Game/Data/DT_Items");
+	FString RootPath = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Table="), TablePath);
+	FParse::Value(*Params, TEXT("Path="), RootPath);
+	const bool bSkipMaps = FParse::Param(*Params, TEXT("SkipMaps"));
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	if (!FPackageName::IsValidLongPackageName(TablePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ItemTableMigration: %s is not a valid package name"), *TablePath);
+		return 1;
+	}
+
+	IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+	UDataTable* Table = LoadOrCreateTable(TablePath);
+	if (!Table)
+		return 1;
+
+	// Sorted so rows are added in the same order on every machine
+	TArray<UBlueprint*> ItemBlueprints;
+	BakeCommandletUtils::FindBlueprints(RootPath, AVRGrabbableActor::StaticClass(), ItemBlueprints);
+	ItemBlueprints.Sort([](const UBlueprint& A, const UBlueprint& B) { return A.GetPathName() < B.GetPathName(); });
+
+	int32 MigratedCount = 0;
+	for (const UBlueprint* Blueprint : ItemBlueprints)
+	{
+		if (MigrateBlueprint(*Table, *Blueprint))
+		{
+			++MigratedCount;
+		}
+	}
+
+	const int32 OverrideCount = bSkipMaps ? 0 : ReportInstanceOverrides(RootPath);
+
+	int32 FailedSaves = 0;
+	if (!bDryRun)
+	{
+		// The registry is only pointed at a table that is on disk, a missing table would leave every item on defaults
+		if (BakeCommandletUtils::SaveAsset(Table))
+		{
+			UVRItemRegistrySubsystem::SetItemTable(Table);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("ItemTableMigration: Failed to save %s"), *Table->GetPathName());
+			++FailedSaves;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ItemTableMigration: %d of %d item Blueprints got a row in %s, %d placed items had settings of their own that are dropped%s"),
+		MigratedCount, ItemBlueprints.Num(), *Table->GetPathName(), OverrideCount, bDryRun ? TEXT(" (dry run, nothing saved)") : TEXT(""));
+
+	return FailedSaves > 0 ? 1 : 0;
+}
+
+UDataTable* UItemTableMigrationCommandlet::LoadOrCreateTable(const FString& TablePath) const
+{
+	const FString TableName = FPackageName::GetShortName(TablePath);
+
+	if (UDataTable* Existing = LoadObject<UDataTable>(nullptr, *(TablePath + TEXT(".") + TableName), nullptr, LOAD_NoWarn))
+	{
+		if (Existing->GetRowStruct() != FVRItemDefinition::StaticStruct())
+		{
+			UE_LOG(LogTemp, Error, TEXT("ItemTableMigration: %s does not have FVRItemDefinition rows"), *Existing->GetPathName());
+			return nullptr;
+		}
+		return Existing;
+	}
+
+	UPackage* Package = CreatePackage(*TablePath);
+	UDataTable* Table = NewObject<UDataTable>(Package, FName(TableName), RF_Public | RF_Standalone);
+	Table->RowStruct = FVRItemDefinition::StaticStruct();
+	IAssetRegistry::GetChecked().AssetCreated(Table);
+
+	UE_LOG(LogTemp, Display, TEXT("ItemTableMigration: Created %s"), *Table->GetPathName());
+	return Table;
+}
+
+bool UItemTableMigrationCommandlet::MigrateBlueprint(UDataTable& Table, const UBlueprint& Blueprint) const
+{
+	UClass* ItemClass = Blueprint.GeneratedClass;
+	if (!ItemClass)
+		return false;
+
+	const AVRGrabbableActor* Defaults = ItemClass->GetDefaultObject<AVRGrabbableActor>();
+	const AVRGrabbableActor* ParentDefaults = Cast<AVRGrabbableActor>(ItemClass->GetSuperClass()->GetDefaultObject());
+	if (!Defaults || !ParentDefaults)
+		return false;
+
+	const FSoftObjectPath ClassPath(ItemClass);
+	bool bHasRow = false;
+	Table.ForeachRow<FVRItemDefinition>(TEXT("ItemTableMigration"), [&ClassPath, &bHasRow](const FName& RowName, const FVRItemDefinition& Row)
+	{
+		bHasRow |= Row.ItemClass.ToSoftObjectPath() == ClassPath;
+	});
+
+	if (bHasRow)
+		return false;
+
+	// Settings equal to the parent's are already covered by the parent's row, or the native defaults
+	FVRItemDefinition Definition = GetLegacyDefinition(*Defaults);
+	if (HasSameSettings(Definition, GetLegacyDefinition(*ParentDefaults)))
+		return false;
+
+	Definition.ItemClass = TSoftClassPtr<AVRGrabbableActor>(ClassPath);
+
+	FName RowName = Blueprint.GetFName();
+	while (Table.GetRowMap().Contains(RowName))
+	{
+		RowName.SetNumber(RowName.GetNumber() + 1);
+	}
+
+	Table.AddRow(RowName, Definition);
+
+	UE_LOG(LogTemp, Display, TEXT("ItemTableMigration: Row %s for %s"), *RowName.ToString(), *Blueprint.GetPathName());
+	return true;
+}
+
+int32 UItemTableMigrationCommandlet::ReportInstanceOverrides(const FString& RootPath) const
+{
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UWorld::StaticClass()->GetClassPathName());
+	Filter.PackagePaths.Add(FName(*RootPath));
+	Filter.bRecursivePaths = true;
+
+	TArray<FAssetData> MapAssets;
+	IAssetRegistry::GetChecked().GetAssets(Filter, MapAssets);
+	MapAssets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+	int32 OverrideCount = 0;
+	for (const FAssetData& MapAsset : MapAssets)
+	{
+		const UWorld* World = Cast<UWorld>(MapAsset.GetAsset());
+		if (!World || !World->PersistentLevel)
+			continue;
+
+		for (const AActor* Actor : World->PersistentLevel->Actors)
+		{
+			const AVRGrabbableActor* Item = Cast<AVRGrabbableActor>(Actor);
+			if (!Item || HasSameSettings(GetLegacyDefinition(*Item), GetLegacyDefinition(*Item->GetClass()->GetDefaultObject<AVRGrabbableActor>())))
+				continue;
+
+			UE_LOG(LogTemp, Warning, TEXT("ItemTableMigration: %s in %s has item settings of its own, they are dropped. Make it a Blueprint with its own row to keep them"),
+				*Item->GetActorNameOrLabel(), *MapAsset.PackageName.ToString());
+			++OverrideCount;
+		}
+	}
+
+	return OverrideCount;
+}
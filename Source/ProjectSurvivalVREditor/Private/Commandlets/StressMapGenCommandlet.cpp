@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/StressMapGenCommandlet.h"
+#include "Commandlets/BakeCommandletUtils.h"
+#include "Actors/FireplaceActor.h"
+#include "Actors/VRClimbableActor.h"
+#include "Actors/VRDrinkActor.h"
+#include "Actors/VRFoodActor.h"
+#include "Actors/WoodLog.h"
+#include "Environment/HeatZones.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerStart.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	const TCHAR* CubePath = TEXT("/Engine/BasicShapes/Cube.Cube");
+	const TCHAR* SpherePath = TEXT("/Engine/BasicShapes/Sphere.Sphere");
+	const TCHAR* CylinderPath = TEXT("/Engine/BasicShapes/Cylinder.Cylinder");
+
+	// The engine cube is 100 cm wide with its pivot in the middle
+	constexpr float CubeHalfSize = 50.0f;
+
+	// Height the navmesh bounds reach above and below the floor (cm)
+	constexpr float NavBoundsHeight = 1000.0f;
+
+	// Each kind of content draws from its own stream, so changing one count leaves the rest of the map in place
+	FRandomStream MakeStream(int32 Seed, const TCHAR* Salt)
+	{
+		return FRandomStream(static_cast<int32>(HashCombine(GetTypeHash(Seed), GetTypeHash(FStringView(Salt)))));
+	}
+
+	template <typename T>
+	T* SpawnAt(UWorld* World, UClass* Class, const FTransform& Transform)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return World->SpawnActor<T>(Class, Transform, SpawnParams);
+	}
+}
+
+UStressMapGenCommandlet::UStressMapGenCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UStressMapGenCommandlet::Main(const FString& Params)
+{
+	FString MapPackageName = TEXT("/Game/Stress/StressMap");
+	FString ItemPath;
+	int32 Seed = 0;
+	FParse::Value(*Params, TEXT("Map="), MapPackageName);
+	FParse::Value(*Params, TEXT("ItemPath="), ItemPath);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Grabbables="), GrabbableCount);
+	FParse::Value(*Params, TEXT("Climbables="), ClimbableCount);
+	FParse::Value(*Params, TEXT("Holds="), HoldCount);
+	FParse::Value(*Params, TEXT("HeatZones="), HeatZoneCount);
+	FParse::Value(*Params, TEXT("Fireplaces="), FireplaceCount);
+	FParse::Value(*Params, TEXT("Size="), MapSize);
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	GrabbableCount = FMath::Max(GrabbableCount, 0);
+	ClimbableCount = FMath::Max(ClimbableCount, 0);
+	HoldCount = FMath::Max(HoldCount, 0);
+	HeatZoneCount = FMath::Max(HeatZoneCount, 0);
+	FireplaceCount = FMath::Max(FireplaceCount, 0);
+	MapSize = FMath::Max(MapSize, 1000.0f);
+
+	if (!FPackageName::IsValidLongPackageName(MapPackageName))
+	{
+		UE_LOG(LogTemp, Error, TEXT("StressMapGen: %s is not a valid package name"), *MapPackageName);
+		return 1;
+	}
+
+	// Blueprint items add their own meshes and settings to the mix, sorted so the mix does not depend on disk order
+	TArray<UClass*> ItemClasses = { AVRGrabbableActor::StaticClass(), AVRFoodActor::StaticClass(), AVRDrinkActor::StaticClass(), AWoodLog::StaticClass() };
+	if (!ItemPath.IsEmpty())
+	{
+		IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+		TArray<UBlueprint*> ItemBlueprints;
+		BakeCommandletUtils::FindBlueprints(ItemPath, AVRGrabbableActor::StaticClass(), ItemBlueprints);
+		ItemBlueprints.Sort([](const UBlueprint& A, const UBlueprint& B) { return A.GetPathName() < B.GetPathName(); });
+
+		for (const UBlueprint* Blueprint : ItemBlueprints)
+		{
+			if (Blueprint->GeneratedClass && !Blueprint->GeneratedClass->HasAnyClassFlags(CLASS_Abstract))
+			{
+				ItemClasses.Add(Blueprint->GeneratedClass);
+			}
+		}
+	}
+
+	UPackage* MapPackage = CreatePackage(*MapPackageName);
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, FName(FPackageName::GetShortName(MapPackageName)), MapPackage);
+	World->SetFlags(RF_Public | RF_Standalone);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+	WorldContext.SetCurrentWorld(World);
+
+	FRandomStream HoldStream = MakeStream(Seed, TEXT("Holds"));
+	UStaticMesh* HoldMesh = ClimbableCount > 0 ? MakeHoldMesh(HoldStream, MapPackageName) : nullptr;
+
+	FRandomStream GrabbableStream = MakeStream(Seed, TEXT("Grabbables"));
+	FRandomStream ClimbableStream = MakeStream(Seed, TEXT("Climbables"));
+	FRandomStream HeatZoneStream = MakeStream(Seed, TEXT("HeatZones"));
+	FRandomStream FireplaceStream = MakeStream(Seed, TEXT("Fireplaces"));
+
+	SpawnFloor(World);
+	SpawnGrabbables(World, GrabbableStream, ItemClasses);
+	SpawnClimbables(World, ClimbableStream, HoldMesh);
+	SpawnHeatZones(World, HeatZoneStream);
+	SpawnFireplaces(World, FireplaceStream);
+	const bool bBuiltNavigation = BuildNavigation(World);
+
+	int32 FailedSaves = 0;
+	if (!bDryRun && bBuiltNavigation)
+	{
+		// The mesh first, the map refers to it
+		for (UObject* Asset : { static_cast<UObject*>(HoldMesh), static_cast<UObject*>(World) })
+		{
+			if (Asset && !BakeCommandletUtils::SaveAsset(Asset))
+			{
+				UE_LOG(LogTemp, Error, TEXT("StressMapGen: Failed to save %s"), *Asset->GetPathName());
+				++FailedSaves;
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("StressMapGen: %s with %d grabbables of %d classes, %d climbables with %d holds, %d heat zones, %d fireplaces on %.0f cm%s"),
+		*MapPackageName, GrabbableCount, ItemClasses.Num(), ClimbableCount, HoldCount, HeatZoneCount, FireplaceCount, MapSize,
+		bDryRun ? TEXT(" (dry run, nothing saved)") : TEXT(""));
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return FailedSaves > 0 || !bBuiltNavigation ? 1 : 0;
+}
+
+void UStressMapGenCommandlet::SpawnFloor(UWorld* World) const
+{
+	// Top face at Z = 0, everything else is placed on it
+	AStaticMeshActor* Floor = SpawnAt<AStaticMeshActor>(World, AStaticMeshActor::StaticClass(),
+		FTransform(FRotator::ZeroRotator, FVector(0.0f, 0.0f, -CubeHalfSize), FVector(MapSize / (CubeHalfSize * 2.0f), MapSize / (CubeHalfSize * 2.0f), 1.0f)));
+	Floor->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, CubePath));
+
+	SpawnAt<APlayerStart>(World, APlayerStart::StaticClass(), FTransform(FVector(0.0f, 0.0f, 100.0f)));
+}
+
+void UStressMapGenCommandlet::SpawnGrabbables(UWorld* World, FRandomStream& Stream, const TArray<UClass*>& ItemClasses) const
+{
+	UStaticMesh* Shapes[] = { LoadObject<UStaticMesh>(nullptr, CubePath), LoadObject<UStaticMesh>(nullptr, SpherePath), LoadObject<UStaticMesh>(nullptr, CylinderPath) };
+
+	for (int32 Index = 0; Index < GrabbableCount; ++Index)
+	{
+		UClass* ItemClass = ItemClasses[Stream.RandHelper(ItemClasses.Num())];
+		UStaticMesh* Shape = Shapes[Stream.RandHelper(UE_ARRAY_COUNT(Shapes))];
+		const float Scale = Stream.FRandRange(0.1f, 0.4f);
+		const FVector Location = RandomFloorLocation(Stream, 100.0f) + FVector(0.0f, 0.0f, CubeHalfSize * Scale + 1.0f);
+		const FRotator Rotation(0.0f, Stream.FRandRange(0.0f, 360.0f), 0.0f);
+
+		AVRGrabbableActor* Item = SpawnAt<AVRGrabbableActor>(World, ItemClass, FTransform(Rotation, Location, FVector(Scale)));
+		if (!Item)
+			continue;
+
+		// Blueprint items keep the mesh they were authored with
+		UStaticMeshComponent* Mesh = Item->GetActorMesh();
+		if (Mesh && !Mesh->GetStaticMesh())
+		{
+			Mesh->SetStaticMesh(Shape);
+		}
+	}
+}
+
+void UStressMapGenCommandlet::SpawnClimbables(UWorld* World, FRandomStream& Stream, UStaticMesh* HoldMesh) const
+{
+	const FVector Scale(2.0f, 2.0f, 4.0f);
+
+	for (int32 Index = 0; Index < ClimbableCount; ++Index)
+	{
+		const FVector Location = RandomFloorLocation(Stream, 500.0f) + FVector(0.0f, 0.0f, CubeHalfSize * Scale.Z);
+		const FRotator Rotation(0.0f, Stream.FRandRange(0.0f, 360.0f), 0.0f);
+
+		AVRClimbableActor* Climbable = SpawnAt<AVRClimbableActor>(World, AVRClimbableActor::StaticClass(), FTransform(Rotation, Location, Scale));
+		if (Climbable && Climbable->GetActorMesh())
+		{
+			Climbable->GetActorMesh()->SetStaticMesh(HoldMesh);
+		}
+	}
+}
+
+void UStressMapGenCommandlet::SpawnHeatZones(UWorld* World, FRandomStream& Stream) const
+{
+	for (int32 Index = 0; Index < HeatZoneCount; ++Index)
+	{
+		SpawnAt<AHeatZones>(World, AHeatZones::StaticClass(), FTransform(RandomFloorLocation(Stream, 500.0f)));
+	}
+}
+
+void UStressMapGenCommandlet::SpawnFireplaces(UWorld* World, FRandomStream& Stream) const
+{
+	for (int32 Index = 0; Index < FireplaceCount; ++Index)
+	{
+		const FRotator Rotation(0.0f, Stream.FRandRange(0.0f, 360.0f), 0.0f);
+		SpawnAt<AFireplaceActor>(World, AFireplaceActor::StaticClass(), FTransform(Rotation, RandomFloorLocation(Stream, 500.0f)));
+	}
+}
+
+bool UStressMapGenCommandlet::BuildNavigation(UWorld* World) const
+{
+	// The navmesh is saved with the map, teleport and the perf scenario need it
+	if (!BakeCommandletUtils::BuildNavigation(World, FVector(MapSize * 0.5f, MapSize * 0.5f, NavBoundsHeight)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("StressMapGen: No navmesh was built, the map is not saved"));
+		return false;
+	}
+
+	return true;
+}
+
+UStaticMesh* UStressMapGenCommandlet::MakeHoldMesh(FRandomStream& Stream, const FString& MapPackageName) const
+{
+	const FString MeshName = FString::Printf(TEXT("SM_StressHolds_%d"), HoldCount);
+	UPackage* MeshPackage = CreatePackage(*(FPackageName::GetLongPackagePath(MapPackageName) / MeshName));
+
+	UStaticMesh* HoldMesh = BakeCommandletUtils::MakeHoldMesh(MeshPackage, FName(MeshName), HoldCount, Stream);
+	if (HoldMesh)
+	{
+		HoldMesh->SetFlags(RF_Public | RF_Standalone);
+	}
+
+	return HoldMesh;
+}
+
+FVector UStressMapGenCommandlet::RandomFloorLocation(FRandomStream& Stream, float Margin) const
+{
+	const float HalfRange = FMath::Max(MapSize * 0.5f - Margin, 0.0f);
+	return FVector(Stream.FRandRange(-HalfRange, HalfRange), Stream.FRandRange(-HalfRange, HalfRange), 0.0f);
+}
@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using UnrealBuildTool;
+
+public class ProjectSurvivalVREditor : ModuleRules
+{
+	public ProjectSurvivalVREditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "ProjectSurvivalVR" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "UnrealEd", "AssetRegistry", "MeshDescription", "StaticMeshDescription" });
+
+		// StressMapGen and the benchmark build navmeshes, the benchmark writes Json reports
+		PrivateDependencyModuleNames.AddRange(new string[] { "NavigationSystem", "Json" });
+	}
+}
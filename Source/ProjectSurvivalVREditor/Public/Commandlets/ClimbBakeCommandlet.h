@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbBakeCommandlet.generated.h"
+
+class UBlueprint;
+class UStaticMesh;
+struct FClimbMetadata;
+
+/**
+ * Analyzes the mesh of every climbable Blueprint and stores ledge polylines, stand points with
+ * verified headroom and box proxies for finger traces in the Blueprint's FClimbMetadata.
+ * Pure geometry on the mesh description, no rendering or physics scene, so it runs headless.
+ *
+ * UnrealEditor-Cmd ProjectSurvivalVR.uproject -run=ClimbBake [-Path=/Game] [-DryRun]
+ *     [-StandHeight=180] [-StandInset=40] [-Spacing=50] [-WalkableSlope=45]
+ */
+UCLASS()
+class PROJECTSURVIVALVREDITOR_API UClimbBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// Bakes one climbable, returns true if its metadata changed
+	bool BakeClimbable(UWorld* World, UBlueprint* Blueprint) const;
+
+	// Ledges and stand points from the render mesh, in component space scaled by MeshScale
+	void BakeLedges(const UStaticMesh* StaticMesh, const FVector& MeshScale, FClimbMetadata& OutMetadata) const;
+
+	// Boxes from the simple collision, or the mesh bounds when there is none
+	void BakeHandProxies(const UStaticMesh* StaticMesh, FClimbMetadata& OutMetadata) const;
+
+	// Height that has to be free above a stand point (cm)
+	float StandHeight = 180.0f;
+
+	// How far behind the ledge stand points are placed, about a capsule radius (cm)
+	float StandInset = 40.0f;
+
+	// Distance between two stand points along a ledge (cm)
+	float StandPointSpacing = 50.0f;
+
+	// Steepest surface still considered a floor, matches the character's walkable slope (degrees)
+	float WalkableSlope = 45.0f;
+};
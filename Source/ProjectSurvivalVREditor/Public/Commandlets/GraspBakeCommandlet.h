@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GraspBakeCommandlet.generated.h"
+
+class AVRHand;
+class UBlueprint;
+
+/**
+ * Precomputes per-hand finger curls for every grab point of every grabbable Blueprint
+ * and stores them in the Blueprint's FGrabPointData, so snap grabs need no runtime traces.
+ *
+ * UnrealEditor-Cmd ProjectSurvivalVR.uproject -run=GraspBake [-Path=/Game] [-DryRun]
+ */
+UCLASS()
+class PROJECTSURVIVALVREDITOR_API UGraspBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGraspBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// Bakes both grab points of one grabbable, returns true if anything changed
+	bool BakeGrabbable(UWorld* World, UBlueprint* Blueprint, AVRHand* LeftHand, AVRHand* RightHand) const;
+
+	// Looks for an authored pose next to the Blueprint named <Blueprint>_<Main|Secondary>_Grasp
+	TSoftObjectPtr<UAnimationAsset> FindGraspPose(const UBlueprint* Blueprint, const TCHAR* GrabPointSuffix) const;
+};
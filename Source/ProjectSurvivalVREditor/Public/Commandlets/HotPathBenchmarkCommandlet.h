@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HotPathBenchmarkCommandlet.generated.h"
+
+class AVRCharacterBase;
+class AVRClimbableActor;
+class AVRGrabbableActor;
+class AVRHand;
+class UWorld;
+
+/**
+ * Times the per-frame paths of the game in a small fixture world built on the spot: hover selection, grab
+ * point and finger queries of the hand, head collision and teleport traces of the character, the climb hold
+ * lookup and the survival stat update. Every benchmark reports nanoseconds per call (median and fastest batch),
+ * plus game thread heap allocations and collision queries per call, and the report is written as Json so two
+ * commits can be diffed. LogTemp is muted while timing, like in Shipping where its warnings are compiled out.
+ *
+ * With -Baseline the new report is compared to an older one. A benchmark more than Threshold percent slower,
+ * or allocating or querying more per call, is a regression and makes the commandlet fail.
+ *
+ * UnrealEditor-Cmd ProjectSurvivalVR.uproject -run=HotPathBenchmark -nullrhi [-Iterations=2000] [-Batches=15]
+ *     [-Holds=64] [-Label=<commit>] [-Output=<report.json>] [-Baseline=<older report.json>] [-Threshold=10]
+ */
+UCLASS()
+class PROJECTSURVIVALVREDITOR_API UHotPathBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHotPathBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FBenchmarkResult
+	{
+		FString Name;
+		double MedianNs = 0.0;
+		double MinNs = 0.0;
+		double AllocationsPerCall = 0.0;
+		double QueriesPerCall = 0.0;
+	};
+
+	void BuildFixture(UWorld* World);
+
+	FBenchmarkResult Run(const TCHAR* Name, TFunctionRef<void(int32)> Body) const;
+
+	bool WriteReport(const TArray<FBenchmarkResult>& Results, const FString& Label, const FString& OutputPath) const;
+
+	// Logs every benchmark against the baseline report, returns how many regressed
+	int32 CompareToBaseline(const TArray<FBenchmarkResult>& Results, const FString& BaselinePath) const;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AVRHand> Hand;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AVRCharacterBase> Character;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AVRClimbableActor> Climbable;
+
+	// Around the hand, all of them overlapping it
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AVRGrabbableActor>> Grabbables;
+
+	// One finger curling through the first grabbable, in its local space
+	TArray<FVector> FingerCache;
+
+	// Hand positions around the climbable, cycled so the lookup does not always hit the same hold
+	TArray<FVector> ClimbQueryPoints;
+
+	// Calls per timed batch
+	int32 Iterations = 2000;
+
+	int32 Batches = 15;
+
+	int32 HoldCount = 64;
+
+	// Slowdown over the baseline median that counts as a regression (percent)
+	float Threshold = 10.0f;
+};
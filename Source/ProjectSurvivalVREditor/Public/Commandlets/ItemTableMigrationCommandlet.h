@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ItemTableMigrationCommandlet.generated.h"
+
+class UBlueprint;
+class UDataTable;
+
+/**
+ * One-off move of the item settings Blueprints used to set on the actor (weight, grab point behavior,
+ * nutrition, drink and stamina values) into the item table. A grabbable Blueprint whose old settings differ
+ * from its parent class's gets a row with them, Blueprints that already have a row are left alone. The table
+ * is created when missing and the item registry is pointed at it in DefaultGame.ini.
+ *
+ * A per-class table has no place for values set on placed actors, those are dropped. Every map under Path is
+ * loaded and each placed item with its own values is reported, so it can become a Blueprint of its own.
+ * World partition maps only report the actors saved in the map package.
+ *
+ * UnrealEditor-Cmd ProjectSurvivalVR.uproject -run=ItemTableMigration [-Table=/Game/Data/DT_Items]
+ *     [-Path=/Game] [-SkipMaps] [-DryRun]
+ */
+UCLASS()
+class PROJECTSURVIVALVREDITOR_API UItemTableMigrationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UItemTableMigrationCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// The item table at TablePath, a new empty one when there is none yet
+	UDataTable* LoadOrCreateTable(const FString& TablePath) const;
+
+	// Adds a row for Blueprint if its old settings differ from its parent's, returns true if it did
+	bool MigrateBlueprint(UDataTable& Table, const UBlueprint& Blueprint) const;
+
+	// Logs every placed item in the maps under RootPath whose old settings differ from its class, returns how many
+	int32 ReportInstanceOverrides(const FString& RootPath) const;
+};
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "StressMapGenCommandlet.generated.h"
+
+class UStaticMesh;
+class UWorld;
+struct FRandomStream;
+
+/**
+ * Generates a flat test map with as many interactables as asked for, to measure how the game scales with
+ * content: grabbables of mixed classes, climbables whose mesh carries the requested number of hold sockets,
+ * heat zones, fireplaces, a player start and a built navmesh. Each kind of content has its own random stream
+ * derived from Seed, so the same parameters always give the same map, and nothing needs a GPU.
+ *
+ * Grabbables use the native grabbable, food, drink and log classes on engine shapes, plus every grabbable
+ * Blueprint under ItemPath when one is given.
+ *
+ * UnrealEditor-Cmd ProjectSurvivalVR.uproject -run=StressMapGen -nullrhi [-Map=/Game/Stress/StressMap]
+ *     [-Grabbables=1000] [-Climbables=50] [-Holds=32] [-HeatZones=10] [-Fireplaces=10]
+ *     [-Size=20000] [-Seed=0] [-ItemPath=/Game/Items] [-DryRun]
+ */
+UCLASS()
+class PROJECTSURVIVALVREDITOR_API UStressMapGenCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UStressMapGenCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void SpawnFloor(UWorld* World) const;
+	void SpawnGrabbables(UWorld* World, FRandomStream& Stream, const TArray<UClass*>& ItemClasses) const;
+	void SpawnClimbables(UWorld* World, FRandomStream& Stream, UStaticMesh* HoldMesh) const;
+	void SpawnHeatZones(UWorld* World, FRandomStream& Stream) const;
+	void SpawnFireplaces(UWorld* World, FRandomStream& Stream) const;
+	// False when the map would be saved without a navmesh
+	bool BuildNavigation(UWorld* World) const;
+
+	// Copy of the engine cube with HoldCount sockets spread over its sides, saved next to the map
+	UStaticMesh* MakeHoldMesh(FRandomStream& Stream, const FString& MapPackageName) const;
+
+	// Random spot on the floor, Margin away from its edge (cm)
+	FVector RandomFloorLocation(FRandomStream& Stream, float Margin) const;
+
+	int32 GrabbableCount = 1000;
+	int32 ClimbableCount = 50;
+	int32 HoldCount = 32;
+	int32 HeatZoneCount = 10;
+	int32 FireplaceCount = 10;
+
+	// Side of the square floor (cm)
+	float MapSize = 20000.0f;
+};